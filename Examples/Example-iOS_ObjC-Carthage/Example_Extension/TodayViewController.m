@@ -69,7 +69,12 @@ static NSString *const kAppAuthExampleAuthStateKey = @"authState";
   // loads SCTKAuthState from NSUSerDefaults
   NSUserDefaults* userDefaults = [[NSUserDefaults alloc] initWithSuiteName:@"group.net.openid.appauth.Example"];
   NSData *archivedAuthState = [userDefaults objectForKey:kAppAuthExampleAuthStateKey];
-  SCTKAuthState *authState = [NSKeyedUnarchiver unarchiveObjectWithData:archivedAuthState];
+  // also reads states saved as keyed archives, which are converted the next time state is saved
+  SCTKAuthState *authState =
+      archivedAuthState ? [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                                   fromData:archivedAuthState
+                                                      error:nil]
+                        : nil;
   [self setAuthState:authState];
 }
 
@@ -78,7 +83,8 @@ static NSString *const kAppAuthExampleAuthStateKey = @"authState";
 - (void)saveState {
   // for production usage consider using the OS Keychain instead
   NSUserDefaults* userDefaults = [[NSUserDefaults alloc] initWithSuiteName:@"group.net.openid.appauth.Example"];
-  NSData *archivedAuthState = [NSKeyedArchiver archivedDataWithRootObject:_authState];
+  NSData *archivedAuthState =
+      _authState ? [SCTKAuthStateCodec dataWithRootObject:_authState error:nil] : nil;
   [userDefaults setObject:archivedAuthState
                    forKey:kAppAuthExampleAuthStateKey];
   [userDefaults synchronize];
@@ -90,6 +96,14 @@ static NSString *const kAppAuthExampleAuthStateKey = @"authState";
   }
   _authState = authState;
   _authState.stateChangeDelegate = self;
+  // coordinates refreshes with the app, which shares this auth state
+  NSURL *containerURL = [[NSFileManager defaultManager]
+      containerURLForSecurityApplicationGroupIdentifier:@"group.net.openid.appauth.Example"];
+  if (containerURL) {
+    NSURL *recordURL = [containerURL URLByAppendingPathComponent:@"authState.refresh"];
+    _authState.refreshCoordinator =
+        [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:recordURL];
+  }
   [self stateChanged];
 }
 
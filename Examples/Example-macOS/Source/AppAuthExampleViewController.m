@@ -381,93 +381,22 @@ static NSString *const kAppAuthExampleAuthStateKey = @"authState";
 }
 
 - (IBAction)userinfo:(nullable id)sender {
-  NSURL *userinfoEndpoint =
-      _authState.lastAuthorizationResponse.request.configuration.discoveryDocument.userinfoEndpoint;
-  if (!userinfoEndpoint) {
-    [self logMessage:@"Userinfo endpoint not declared in discovery document"];
-    return;
-  }
-  NSString *currentAccessToken = _authState.lastTokenResponse.accessToken;
-
   [self logMessage:@"Performing userinfo request"];
 
-  [_authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
-                                             NSString *_Nullable idToken,
-                                             NSError *_Nullable error) {
-    if (error) {
-      [self logMessage:@"Error fetching fresh tokens: %@", [error localizedDescription]];
+  // attaches a fresh access token, refreshing it first if needed; a rejected token puts the auth
+  // state into an error state, and repeated lookups are answered from the userinfo cache
+  SCTKUserInfoCallback callback = ^(SCTKUserInfoResponse *_Nullable userInfo,
+                                    NSError *_Nullable error) {
+    if (!userInfo) {
+      [self logMessage:@"Userinfo request failed: %@", [error localizedDescription]];
       return;
     }
-
-    // log whether a token refresh occurred
-    if (![currentAccessToken isEqual:accessToken]) {
-      [self logMessage:@"Access token was refreshed automatically (%@ to %@)",
-                         currentAccessToken,
-                         accessToken];
-    } else {
-      [self logMessage:@"Access token was fresh and not updated [%@]", accessToken];
-    }
-
-    // creates request to the userinfo endpoint, with access token in the Authorization header
-    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:userinfoEndpoint];
-    NSString *authorizationHeaderValue = [NSString stringWithFormat:@"Bearer %@", accessToken];
-    [request addValue:authorizationHeaderValue forHTTPHeaderField:@"Authorization"];
-
-    NSURLSessionConfiguration *configuration =
-      [NSURLSessionConfiguration defaultSessionConfiguration];
-    NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration
-                                                          delegate:nil
-                                                     delegateQueue:nil];
-
-    // performs HTTP request
-    NSURLSessionDataTask *postDataTask =
-        [session dataTaskWithRequest:request
-                   completionHandler:^(NSData *_Nullable data,
-                                       NSURLResponse *_Nullable response,
-                                       NSError *_Nullable error) {
-      dispatch_async(dispatch_get_main_queue(), ^() {
-        if (error) {
-          [self logMessage:@"HTTP request failed %@", error];
-          return;
-        }
-        if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
-          [self logMessage:@"Non-HTTP response"];
-          return;
-        }
-
-        NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
-        id jsonDictionaryOrArray =
-            [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
-
-        if (httpResponse.statusCode != 200) {
-          // server replied with an error
-          NSString *responseText = [[NSString alloc] initWithData:data
-                                                         encoding:NSUTF8StringEncoding];
-          if (httpResponse.statusCode == 401) {
-            // "401 Unauthorized" generally indicates there is an issue with the authorization
-            // grant. Puts SCTKAuthState into an error state.
-            NSError *oauthError =
-                [SCTKErrorUtilities resourceServerAuthorizationErrorWithCode:0
-                                                              errorResponse:jsonDictionaryOrArray
-                                                            underlyingError:error];
-            [_authState updateWithAuthorizationError:oauthError];
-            // log error
-            [self logMessage:@"Authorization Error (%@). Response: %@", oauthError, responseText];
-          } else {
-            [self logMessage:@"HTTP: %d. Response: %@",
-                             (int)httpResponse.statusCode,
-                             responseText];
-          }
-          return;
-        }
-
-        // success response
-        [self logMessage:@"Success: %@", jsonDictionaryOrArray];
-      });
-    }];
-
-    [postDataTask resume];
-  }];
+    [self logMessage:@"Success: %@ (%@), additional claims: %@",
+                     userInfo.name,
+                     userInfo.subject,
+                     userInfo.additionalClaims];
+  };
+  [SCTKAuthorizationService performUserInfoRequestWithAuthState:_authState callback:callback];
 }
 
 /*! @fn logMessage
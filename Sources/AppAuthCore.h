@@ -42,3 +42,29 @@
 #import "SCTKURLSessionProvider.h"
 #import "SCTKEndSessionRequest.h"
 #import "SCTKEndSessionResponse.h"
+#import "SCTKAuthStateStore.h"
+#import "SCTKAuthStateRefreshScheduler.h"
+#import "SCTKAuthStateTokenSnapshot.h"
+#import "SCTKAuthStateRefreshCoordinator.h"
+#import "SCTKClockSkewEstimator.h"
+#import "SCTKAuthStateActionHandle.h"
+#import "SCTKAuthStateCodec.h"
+#import "SCTKAuthStateJournalStore.h"
+#import "SCTKAuthStateBatchRefresher.h"
+#import "SCTKRetryPolicy.h"
+#import "SCTKCircuitBreaker.h"
+#import "SCTKTokenResponsePipeline.h"
+#import "SCTKPromise.h"
+#import "SCTKAuthorizationService+Promises.h"
+#import "SCTKResponseReader.h"
+#import "SCTKServiceDiscoveryCache.h"
+#import "SCTKConnectionPrewarmer.h"
+#import "SCTKUserInfoResponse.h"
+#import "SCTKUserInfoCache.h"
+#import "SCTKRevocationRequest.h"
+#import "SCTKIntrospectionRequest.h"
+#import "SCTKIntrospectionResponse.h"
+#import "SCTKIntrospectionCache.h"
+#import "SCTKHTTPTransport.h"
+#import "SCTKURLSessionTransport.h"
+#import "SCTKLoopbackTransport.h"
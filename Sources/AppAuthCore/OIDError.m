@@ -26,6 +26,8 @@ NSString *const SCTKOAuthAuthorizationErrorDomain = @"org.openid.appauth.oauth_a
 
 NSString *const SCTKOAuthRegistrationErrorDomain = @"org.openid.appauth.oauth_registration";
 
+NSString *const SCTKOAuthRevocationErrorDomain = @"org.openid.appauth.oauth_revocation";
+
 NSString *const SCTKResourceServerAuthorizationErrorDomain = @"org.openid.appauth.resourceserver";
 
 NSString *const SCTKHTTPErrorDomain = @"org.openid.appauth.remote-http";
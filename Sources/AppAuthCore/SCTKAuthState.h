@@ -20,7 +20,12 @@
 @class SCTKAuthorizationRequest;
 @class SCTKAuthorizationResponse;
 @class SCTKAuthState;
+@class SCTKAuthStateActionHandle;
+@class SCTKAuthStateRefreshCoordinator;
+@class SCTKAuthStateTokenSnapshot;
+@class SCTKCircuitBreaker;
 @class SCTKRegistrationResponse;
+@class SCTKRetryPolicy;
 @class SCTKTokenResponse;
 @class SCTKTokenRequest;
 @protocol SCTKAuthStateChangeDelegate;
@@ -30,6 +35,22 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/*! @brief How @c SCTKAuthState.performActionWithFreshTokens: handles an access token that is about
+        to expire.
+ */
+typedef NS_ENUM(NSInteger, SCTKAuthStateRefreshPolicy) {
+  /*! @brief Actions wait for the token to be refreshed once it is within the refresh tolerance of
+          its expiry. This is the default.
+   */
+  SCTKAuthStateRefreshPolicyBlocking = 0,
+
+  /*! @brief Actions are given the current token while it has not expired, even within the refresh
+          tolerance, while a refresh runs in the background. Actions only wait once the token has
+          expired, or after @c SCTKAuthState.setNeedsTokenRefresh.
+   */
+  SCTKAuthStateRefreshPolicyStaleWhileRevalidate = 1,
+};
+
 /*! @brief Represents a block used to call an action with a fresh access token.
     @param accessToken A valid access token if available.
     @param idToken A valid ID token if available.
@@ -84,6 +105,10 @@ static NSString *const kRefreshTokenRequestException =
  */
 @property(nonatomic, readonly, nullable) SCTKTokenResponse *lastTokenResponse;
 
+/*! @brief When @c lastTokenResponse was obtained, or nil if unknown.
+ */
+@property(nonatomic, readonly, nullable) NSDate *lastTokenResponseDate;
+
 /*! @brief The most recent registration response used to update this authorization state. This will
         contain the latest client credentials.
  */
@@ -110,18 +135,65 @@ static NSString *const kRefreshTokenRequestException =
  */
 @property(nonatomic, readonly) BOOL isAuthorized;
 
+/*! @brief The current token material of this auth state.
+    @discussion Replaced as a whole whenever the state changes, so it can be read from any thread
+        without locking and the values it holds always belong together. Does not refresh the
+        tokens; to use an access token you should still call
+        @c SCTKAuthState.performActionWithFreshTokens:.
+ */
+@property(atomic, readonly) SCTKAuthStateTokenSnapshot *tokenSnapshot;
+
+/*! @brief The number of actions waiting for the token refresh in progress, or zero if no refresh
+        is in progress or nothing waits for it.
+ */
+@property(nonatomic, readonly) NSUInteger pendingActionCount;
+
 /*! @brief The @c SCTKAuthStateChangeDelegate delegate.
     @discussion Use the delegate to observe state changes (and update storage) as well as error
-        states.
+        states. Changes made by token refreshes are reported on
+        @c SCTKAuthorizationService.defaultCallbackQueue, others on the thread making them.
  */
 @property(nonatomic, weak, nullable) id<SCTKAuthStateChangeDelegate> stateChangeDelegate;
 
 /*! @brief The @c SCTKAuthStateErrorDelegate delegate.
     @discussion Use the delegate to observe state changes (and update storage) as well as error
-        states.
+        states. Errors of token refreshes are reported on
+        @c SCTKAuthorizationService.defaultCallbackQueue.
  */
 @property(nonatomic, weak, nullable) id<SCTKAuthStateErrorDelegate> errorDelegate;
 
+/*! @brief Coordinates token refreshes with other processes holding a copy of this auth state.
+    @discussion When set, a refresh first waits for any refresh in progress in another process, and
+        adopts its result if it belongs to the same authorization, was obtained after
+        @c lastTokenResponseDate and is fresh, instead of making a token request. Concurrent calls
+        to @c SCTKAuthState.performActionWithFreshTokens: within this process are still coalesced
+        into one refresh. Not archived; set it again after unarchiving the auth state.
+ */
+@property(nonatomic, strong, nullable) SCTKAuthStateRefreshCoordinator *refreshCoordinator;
+
+/*! @brief How @c SCTKAuthState.performActionWithFreshTokens: handles an access token that is about
+        to expire. Defaults to @c ::SCTKAuthStateRefreshPolicyBlocking.
+    @discussion With @c ::SCTKAuthStateRefreshPolicyStaleWhileRevalidate, the background refresh is
+        coalesced with any other refresh in progress, and its result is reported to the delegates
+        as usual. Only applies to auth states with a refresh token. Not archived.
+ */
+@property(atomic) SCTKAuthStateRefreshPolicy refreshPolicy;
+
+/*! @brief Decides whether a token refresh that failed with a transient error is retried before
+        the waiting actions are called with the error. If nil, the default, it is not.
+    @discussion Retries go on after @c SCTKAuthState.cancelTokenRefresh, as the result still
+        updates the auth state and actions asking for fresh tokens meanwhile wait for it. Not
+        archived.
+ */
+@property(nonatomic, strong, nullable) SCTKRetryPolicy *retryPolicy;
+
+/*! @brief Fails token refreshes fast while the token endpoint is known to be down, with an error
+        of code @c ::SCTKErrorCodeEndpointUnavailableError. If nil, the default, every refresh is
+        sent.
+    @discussion Share one circuit breaker between the auth states of an app. Not archived.
+ */
+@property(nonatomic, strong, nullable) SCTKCircuitBreaker *circuitBreaker;
+
 /*! @brief Convenience method to create a @c SCTKAuthState by presenting an authorization request
         and performing the authorization code exchange in the case of code flow requests. For
         the hybrid flow, the caller should validate the id_token and c_hash, then perform the token
@@ -248,8 +320,94 @@ static NSString *const kRefreshTokenRequestException =
     (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
                        dispatchQueue:(dispatch_queue_t)dispatchQueue;
 
+/*! @brief Calls the block with a valid access token (refreshing it first, if needed), or with an
+        error if the refresh failed, did not complete within the timeout, or was cancelled.
+    @param action The block to execute with a fresh token. Called exactly once.
+    @param additionalParameters Additional parameters for the token request if token is
+        refreshed.
+    @param dispatchQueue The dispatchQueue on which to dispatch the action block.
+    @param timeout How many seconds the action may wait for a token refresh before it is called
+        with an error of code @c ::SCTKErrorCodeTokenRefreshTimeoutError, or zero to wait for as
+        long as the refresh takes. The refresh itself carries on for other waiting actions.
+    @return A handle to stop waiting for the refresh.
+ */
+- (SCTKAuthStateActionHandle *)
+    performActionWithFreshTokens:(SCTKAuthStateAction)action
+     additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                   dispatchQueue:(dispatch_queue_t)dispatchQueue
+                         timeout:(NSTimeInterval)timeout;
+
+/*! @brief Stops waiting for the token refreshes in progress, if any, including those of scoped
+        tokens. Every waiting action is called straight away with an error of code
+        @c ::SCTKErrorCodeTokenRefreshCancelledError.
+    @discussion The token request already sent is not cancelled, and its result still updates the
+        auth state when it arrives. Actions asking for fresh tokens before then wait for that
+        request rather than spending the refresh token on another one.
+ */
+- (void)cancelTokenRefresh;
+
+/*! @brief Calls the block with a valid access token, synchronously on the calling thread if the
+        current token is fresh, or otherwise once it has been refreshed.
+    @param action The block to execute with a fresh token.
+    @param additionalParameters Additional parameters for the token request if token is
+        refreshed.
+    @param dispatchQueue The dispatchQueue on which to dispatch the action block if the token has to
+        be refreshed, or if it cannot be.
+    @return YES if the action was called before this method returned, NO if it was dispatched to
+        @c dispatchQueue.
+    @discussion Unlike
+        @c SCTKAuthState.performActionWithFreshTokens:additionalRefreshParameters:dispatchQueue:,
+        does not dispatch the action when the token is fresh, which is the common case. Callers
+        must be prepared for @c action to run either before or after this method returns.
+ */
+- (BOOL)performActionWithFreshTokensInline:(SCTKAuthStateAction)action
+               additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                             dispatchQueue:(dispatch_queue_t)dispatchQueue;
+
+/*! @brief Calls the block with a valid access token for the given scopes and resource, obtaining
+        one with the refresh token first if none is cached, or if a request was needed and failed,
+        with the error that caused it to fail.
+    @param scopes The scopes the access token must be granted, or nil for the scopes the
+        authorization server grants by default.
+    @param resource The resource server the access token is for, sent as the @c resource parameter
+        of RFC 8707, or nil.
+    @param action The block to execute with a fresh token. This block will be executed on the main
+        thread.
+ */
+- (void)performActionWithFreshTokensForScopes:(nullable NSArray<NSString *> *)scopes
+                                     resource:(nullable NSString *)resource
+                                       action:(SCTKAuthStateAction)action;
+
+/*! @brief Calls the block with a valid access token for the given scopes and resource, obtaining
+        one with the refresh token first if none is cached, or if a request was needed and failed,
+        with the error that caused it to fail.
+    @param scopes The scopes the access token must be granted, or nil for the scopes the
+        authorization server grants by default.
+    @param resource The resource server the access token is for, sent as the @c resource parameter
+        of RFC 8707, or nil.
+    @param action The block to execute with a fresh token.
+    @param dispatchQueue The dispatchQueue on which to dispatch the action block.
+    @discussion Each combination of scopes and resource has its own cached access token with its
+        own expiry, separate from the main access token of the auth state, so switching between
+        resource servers does not cost a round trip while the tokens are fresh. Actions asking for
+        the same combination while its token is being obtained share the one request. Scoped
+        tokens are held in memory only: they are not archived, and are discarded when the
+        authorization changes or @c SCTKAuthState.setNeedsTokenRefresh is called. The request
+        waits for any other use of the refresh token in progress, including a token refresh and,
+        with a @c refreshCoordinator, one in another process. If the server rotates the refresh
+        token in response, the auth state adopts the new one and shares it through the
+        @c refreshCoordinator.
+ */
+- (void)performActionWithFreshTokensForScopes:(nullable NSArray<NSString *> *)scopes
+                                     resource:(nullable NSString *)resource
+                                       action:(SCTKAuthStateAction)action
+                                dispatchQueue:(dispatch_queue_t)dispatchQueue;
+
 /*! @brief Forces a token refresh the next time @c SCTKAuthState.performActionWithFreshTokens: is
-        called, even if the current tokens are considered valid.
+        called, even if the current tokens are considered valid. Also discards the cached scoped
+        tokens.
  */
 - (void)setNeedsTokenRefresh;
 
@@ -18,15 +18,21 @@
 
 #import "SCTKAuthState.h"
 
+#import "SCTKAuthStateActionHandle.h"
 #import "SCTKAuthStateChangeDelegate.h"
 #import "SCTKAuthStateErrorDelegate.h"
+#import "SCTKAuthStateRefreshCoordinator.h"
+#import "SCTKAuthStateTokenSnapshot.h"
 #import "SCTKAuthorizationRequest.h"
 #import "SCTKAuthorizationResponse.h"
 #import "SCTKAuthorizationService.h"
+#import "SCTKCircuitBreaker.h"
 #import "SCTKDefines.h"
 #import "SCTKError.h"
 #import "SCTKErrorUtilities.h"
 #import "SCTKRegistrationResponse.h"
+#import "SCTKRetryPolicy.h"
+#import "SCTKScopeUtilities.h"
 #import "SCTKTokenRequest.h"
 #import "SCTKTokenResponse.h"
 #import "SCTKTokenUtilities.h"
@@ -51,6 +57,10 @@ static NSString *const kLastAuthorizationResponseKey = @"lastAuthorizationRespon
  */
 static NSString *const kLastTokenResponseKey = @"lastTokenResponse";
 
+/*! @brief Key used to encode the @c lastTokenResponseDate property for @c NSSecureCoding.
+ */
+static NSString *const kLastTokenResponseDateKey = @"lastTokenResponseDate";
+
 /*! @brief Key used to encode the @c lastOAuthError property for @c NSSecureCoding.
  */
 static NSString *const kAuthorizationErrorKey = @"authorizationError";
@@ -59,11 +69,36 @@ static NSString *const kAuthorizationErrorKey = @"authorizationError";
  */
 static const NSUInteger kExpiryTimeTolerance = 60;
 
+/*! @brief The token request parameter naming the resource a scoped access token is for.
+    @see https://tools.ietf.org/html/rfc8707#section-2
+ */
+static NSString *const kResourceParameter = @"resource";
+
+/*! @brief Key marking the @c _stateQueue of an auth state, with the auth state as its value.
+ */
+static char kStateQueueKey;
+
+/*! @brief Ends a refresh token operation, letting the next one start.
+    @param tokenResponse The token response obtained by the operation, to share with other
+        processes through the @c SCTKAuthState.refreshCoordinator, or nil.
+ */
+typedef void (^SCTKAuthStateRefreshTokenCompletion)(SCTKTokenResponse *_Nullable tokenResponse);
+
+/*! @brief An operation that spends the refresh token. Must call @c completion exactly once.
+    @param adoptedTokens Whether the state just adopted tokens another process obtained.
+    @param completion The block ending the operation.
+ */
+typedef void (^SCTKAuthStateRefreshTokenOperation)(BOOL adoptedTokens,
+                                                   SCTKAuthStateRefreshTokenCompletion completion);
+
 /*! @brief Object to hold SCTKAuthState pending actions.
  */
 @interface SCTKAuthStatePendingAction : NSObject
 @property(nonatomic, readonly, nullable) SCTKAuthStateAction action;
 @property(nonatomic, readonly, nullable) dispatch_queue_t dispatchQueue;
+/*! @brief YES once the action has been dispatched. Guarded by @c _pendingActionsSyncObject.
+ */
+@property(nonatomic) BOOL completed;
 @end
 @implementation SCTKAuthStatePendingAction
 - (id)initWithAction:(SCTKAuthStateAction)action andDispatchQueue:(dispatch_queue_t)dispatchQueue {
@@ -78,6 +113,10 @@ static const NSUInteger kExpiryTimeTolerance = 60;
 
 @interface SCTKAuthState ()
 
+/*! @brief The current token material.
+ */
+@property(atomic, readwrite) SCTKAuthStateTokenSnapshot *tokenSnapshot;
+
 /*! @brief The access token generated by the authorization server.
     @discussion Rather than using this property directly, you should call
         @c SCTKAuthState.withFreshTokenPerformAction:.
@@ -100,6 +139,14 @@ static const NSUInteger kExpiryTimeTolerance = 60;
  */
 - (void)didChangeState;
 
+/*! @brief Updates the state with a token response obtained at a given date, such as one adopted
+        from the @c refreshCoordinator or replayed from a journal.
+    @param tokenResponse The token response.
+    @param obtainedDate When the token response was obtained.
+ */
+- (void)updateWithTokenResponse:(SCTKTokenResponse *)tokenResponse
+                   obtainedDate:(nullable NSDate *)obtainedDate;
+
 @end
 
 
@@ -115,6 +162,35 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   /*! @brief If YES, tokens will be refreshed on the next API call regardless of expiry.
    */
   BOOL _needsTokenRefresh;
+
+  /*! @brief Object for serializing the publication of @c tokenSnapshot. Readers do not use it.
+   */
+  id _tokenSnapshotSyncObject;
+
+  /*! @brief Access tokens obtained with
+          @c SCTKAuthState.performActionWithFreshTokensForScopes:resource:action:dispatchQueue:,
+          by @c scopedTokenKeyForScopes:resource:. Guarded by @c _pendingActionsSyncObject.
+   */
+  NSMutableDictionary<NSString *, SCTKAuthStateTokenSnapshot *> *_scopedTokens;
+
+  /*! @brief The actions waiting for each scoped token refresh in progress, by
+          @c scopedTokenKeyForScopes:resource:. Guarded by @c _pendingActionsSyncObject.
+   */
+  NSMutableDictionary<NSString *, NSMutableArray<SCTKAuthStatePendingAction *> *>
+      *_scopedPendingActions;
+
+  /*! @brief The operations spending the refresh token, the first of which is running. Each starts
+          once the previous one has finished, so that it sends the refresh token the previous one
+          left, which with refresh token rotation is the only valid one. Guarded by
+          @c _pendingActionsSyncObject.
+   */
+  NSMutableArray<SCTKAuthStateRefreshTokenOperation> *_refreshTokenOperations;
+
+  /*! @brief Serial queue on which the state is updated with the results of its token requests,
+          whatever the default callback queue of @c SCTKAuthorizationService, which is only used
+          to call the delegates.
+   */
+  dispatch_queue_t _stateQueue;
 }
 
 #pragma mark - Convenience initializers
@@ -211,6 +287,9 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   self = [super init];
   if (self) {
     _pendingActionsSyncObject = [[NSObject alloc] init];
+    _tokenSnapshotSyncObject = [[NSObject alloc] init];
+    _stateQueue = dispatch_queue_create("org.openid.appauth.authstate", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_set_specific(_stateQueue, &kStateQueueKey, (__bridge void *)self, NULL);
 
     if (registrationResponse) {
       [self updateWithRegistrationResponse:registrationResponse];
@@ -223,6 +302,10 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     if (tokenResponse) {
       [self updateWithTokenResponse:tokenResponse error:nil];
     }
+
+    if (!self.tokenSnapshot) {
+      [self publishTokenSnapshot];
+    }
   }
   return self;
 }
@@ -268,6 +351,11 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     _scope = [aDecoder decodeObjectOfClass:[NSString class] forKey:kScopeKey];
     _refreshToken = [aDecoder decodeObjectOfClass:[NSString class] forKey:kRefreshTokenKey];
     _needsTokenRefresh = [aDecoder decodeBoolForKey:kNeedsTokenRefreshKey];
+    // unknown for archives that predate it, in which case any shared record of this
+    // authorization is newer
+    _lastTokenResponseDate =
+        [aDecoder decodeObjectOfClass:[NSDate class] forKey:kLastTokenResponseDateKey];
+    [self publishTokenSnapshot];
   }
   return self;
 }
@@ -284,40 +372,58 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   [aCoder encodeObject:_scope forKey:kScopeKey];
   [aCoder encodeObject:_refreshToken forKey:kRefreshTokenKey];
   [aCoder encodeBool:_needsTokenRefresh forKey:kNeedsTokenRefreshKey];
+  [aCoder encodeObject:_lastTokenResponseDate forKey:kLastTokenResponseDateKey];
 }
 
 #pragma mark - Private convenience getters
 
 - (NSString *)accessToken {
-  if (_authorizationError) {
-    return nil;
-  }
-  return _lastTokenResponse ? _lastTokenResponse.accessToken
-                            : _lastAuthorizationResponse.accessToken;
+  return self.tokenSnapshot.accessToken;
 }
 
 - (NSString *)tokenType {
-  if (_authorizationError) {
-    return nil;
-  }
-  return _lastTokenResponse ? _lastTokenResponse.tokenType
-                            : _lastAuthorizationResponse.tokenType;
+  return self.tokenSnapshot.tokenType;
 }
 
 - (NSDate *)accessTokenExpirationDate {
-  if (_authorizationError) {
-    return nil;
-  }
-  return _lastTokenResponse ? _lastTokenResponse.accessTokenExpirationDate
-                            : _lastAuthorizationResponse.accessTokenExpirationDate;
+  return self.tokenSnapshot.accessTokenExpirationDate;
 }
 
 - (NSString *)idToken {
-  if (_authorizationError) {
-    return nil;
+  return self.tokenSnapshot.idToken;
+}
+
+/*! @brief Publishes a new @c tokenSnapshot reflecting the current responses and error.
+    @discussion Must be called after every change to @c _lastTokenResponse,
+        @c _lastAuthorizationResponse or @c _authorizationError.
+ */
+- (void)publishTokenSnapshot {
+  @synchronized(_tokenSnapshotSyncObject) {
+    uint64_t generation = self.tokenSnapshot.generation + 1;
+    SCTKAuthStateTokenSnapshot *snapshot;
+    if (_authorizationError) {
+      snapshot = [[SCTKAuthStateTokenSnapshot alloc] initWithAccessToken:nil
+                                               accessTokenExpirationDate:nil
+                                                                 idToken:nil
+                                                               tokenType:nil
+                                                              generation:generation];
+    } else if (_lastTokenResponse) {
+      snapshot = [[SCTKAuthStateTokenSnapshot alloc]
+                initWithAccessToken:_lastTokenResponse.accessToken
+          accessTokenExpirationDate:_lastTokenResponse.accessTokenExpirationDate
+                            idToken:_lastTokenResponse.idToken
+                          tokenType:_lastTokenResponse.tokenType
+                         generation:generation];
+    } else {
+      snapshot = [[SCTKAuthStateTokenSnapshot alloc]
+                initWithAccessToken:_lastAuthorizationResponse.accessToken
+          accessTokenExpirationDate:_lastAuthorizationResponse.accessTokenExpirationDate
+                            idToken:_lastAuthorizationResponse.idToken
+                          tokenType:_lastAuthorizationResponse.tokenType
+                         generation:generation];
+    }
+    self.tokenSnapshot = snapshot;
   }
-  return _lastTokenResponse ? _lastTokenResponse.idToken
-                            : _lastAuthorizationResponse.idToken;
 }
 
 #pragma mark - Getters
@@ -326,6 +432,12 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   return !self.authorizationError && (self.accessToken || self.idToken || self.refreshToken);
 }
 
+- (NSUInteger)pendingActionCount {
+  @synchronized(_pendingActionsSyncObject) {
+    return _pendingActions.count;
+  }
+}
+
 #pragma mark - Updating the state
 
 - (void)updateWithRegistrationResponse:(SCTKRegistrationResponse *)registrationResponse {
@@ -334,7 +446,11 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   _scope = nil;
   _lastAuthorizationResponse = nil;
   _lastTokenResponse = nil;
+  _lastTokenResponseDate = nil;
   _authorizationError = nil;
+  [_refreshCoordinator resetRecord];
+  [self discardScopedTokens];
+  [self publishTokenSnapshot];
   [self didChangeState];
 }
 
@@ -354,14 +470,19 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   // clears the last token response and refresh token as these now relate to an old authorization
   // that is no longer relevant
   _lastTokenResponse = nil;
+  _lastTokenResponseDate = nil;
   _refreshToken = nil;
   _authorizationError = nil;
+  // the shared token response belongs to the previous authorization
+  [_refreshCoordinator resetRecord];
 
   // if the response's scope is nil, it means that it equals that of the request
   // see: https://tools.ietf.org/html/rfc6749#section-5.1
   _scope = (authorizationResponse.scope) ? authorizationResponse.scope
                                          : authorizationResponse.request.scope;
 
+  [self discardScopedTokens];
+  [self publishTokenSnapshot];
   [self didChangeState];
 }
 
@@ -388,7 +509,13 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     return;
   }
 
+  [self updateWithTokenResponse:tokenResponse obtainedDate:[NSDate date]];
+}
+
+- (void)updateWithTokenResponse:(SCTKTokenResponse *)tokenResponse
+                   obtainedDate:(nullable NSDate *)obtainedDate {
   _lastTokenResponse = tokenResponse;
+  _lastTokenResponseDate = obtainedDate;
 
   // updates the scope and refresh token if they are present on the TokenResponse.
   // according to the spec, these may be changed by the server, including when refreshing the
@@ -401,15 +528,21 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     _refreshToken = tokenResponse.refreshToken;
   }
 
+  [self publishTokenSnapshot];
   [self didChangeState];
 }
 
 - (void)updateWithAuthorizationError:(NSError *)oauthError {
   _authorizationError = oauthError;
 
+  [self discardScopedTokens];
+  [self publishTokenSnapshot];
   [self didChangeState];
 
-  [_errorDelegate authState:self didEncounterAuthorizationError:oauthError];
+  id<SCTKAuthStateErrorDelegate> errorDelegate = _errorDelegate;
+  [self notifyDelegates:^{
+    [errorDelegate authState:self didEncounterAuthorizationError:oauthError];
+  }];
 }
 
 #pragma mark - OAuth Requests
@@ -483,11 +616,57 @@ static const NSUInteger kExpiryTimeTolerance = 60;
 #pragma mark - Stateful Actions
 
 - (void)didChangeState {
-  [_stateChangeDelegate didChangeState:self];
+  id<SCTKAuthStateChangeDelegate> stateChangeDelegate = _stateChangeDelegate;
+  [self notifyDelegates:^{
+    [stateChangeDelegate didChangeState:self];
+  }];
+}
+
+/*! @brief Reports a token request that failed with a transient error to the error delegate.
+    @param error The error.
+ */
+- (void)notifyTransientError:(NSError *)error {
+  id<SCTKAuthStateErrorDelegate> errorDelegate = _errorDelegate;
+  if (![errorDelegate respondsToSelector:@selector(authState:didEncounterTransientError:)]) {
+    return;
+  }
+  [self notifyDelegates:^{
+    [errorDelegate authState:self didEncounterTransientError:error];
+  }];
+}
+
+/*! @brief Calls the delegates on the default callback queue of @c SCTKAuthorizationService when
+        the state was updated on @c _stateQueue, and otherwise straight away on the thread that
+        updated it.
+    @param block The block calling the delegates.
+ */
+- (void)notifyDelegates:(dispatch_block_t)block {
+  if (dispatch_get_specific(&kStateQueueKey) != (__bridge void *)self) {
+    block();
+    return;
+  }
+  dispatch_async([SCTKAuthorizationService defaultCallbackQueue], block);
 }
 
 - (void)setNeedsTokenRefresh {
   _needsTokenRefresh = YES;
+  [self discardScopedTokens];
+}
+
+/*! @brief Makes the next action refresh the main tokens, keeping the scoped access tokens, which
+        stay valid until they expire. Used by @c SCTKAuthStateRefreshScheduler to refresh ahead of
+        expiry.
+ */
+- (void)setNeedsMainTokenRefresh {
+  _needsTokenRefresh = YES;
+}
+
+/*! @brief Forgets the scoped access tokens, which belong to the current authorization.
+ */
+- (void)discardScopedTokens {
+  @synchronized(_pendingActionsSyncObject) {
+    [_scopedTokens removeAllObjects];
+  }
 }
 
 - (void)performActionWithFreshTokens:(SCTKAuthStateAction)action {
@@ -507,14 +686,344 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
                        dispatchQueue:(dispatch_queue_t)dispatchQueue {
 
-  if ([self isTokenFresh]) {
+  SCTKAuthStateTokenSnapshot *tokenSnapshot = self.tokenSnapshot;
+  if ([self canUseTokensInSnapshot:tokenSnapshot additionalParameters:additionalParameters]) {
     // access token is valid within tolerance levels, perform action
     dispatch_async(dispatchQueue, ^{
-      action(self.accessToken, self.idToken, nil);
+      action(tokenSnapshot.accessToken, tokenSnapshot.idToken, nil);
+    });
+    return;
+  }
+
+  [self refreshTokensAndPerformAction:action
+          additionalRefreshParameters:additionalParameters
+                        dispatchQueue:dispatchQueue
+                              timeout:0];
+}
+
+- (SCTKAuthStateActionHandle *)
+    performActionWithFreshTokens:(SCTKAuthStateAction)action
+     additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                   dispatchQueue:(dispatch_queue_t)dispatchQueue
+                         timeout:(NSTimeInterval)timeout {
+  SCTKAuthStateTokenSnapshot *tokenSnapshot = self.tokenSnapshot;
+  if ([self canUseTokensInSnapshot:tokenSnapshot additionalParameters:additionalParameters]) {
+    // access token is valid within tolerance levels, perform action
+    dispatch_async(dispatchQueue, ^{
+      action(tokenSnapshot.accessToken, tokenSnapshot.idToken, nil);
+    });
+    return [[SCTKAuthStateActionHandle alloc] initWithCancelBlock:nil];
+  }
+
+  return [self refreshTokensAndPerformAction:action
+                 additionalRefreshParameters:additionalParameters
+                               dispatchQueue:dispatchQueue
+                                     timeout:timeout];
+}
+
+- (void)cancelTokenRefresh {
+  NSMutableArray<SCTKAuthStatePendingAction *> *actionsToCancel = [NSMutableArray array];
+  @synchronized(_pendingActionsSyncObject) {
+    // empties the lists but keeps them, so that actions asking for fresh tokens before the
+    // refreshes in progress complete wait for them instead of spending the refresh token again
+    [actionsToCancel addObjectsFromArray:_pendingActions];
+    [_pendingActions removeAllObjects];
+    for (NSMutableArray<SCTKAuthStatePendingAction *> *pendingActions in
+         _scopedPendingActions.allValues) {
+      [actionsToCancel addObjectsFromArray:pendingActions];
+      [pendingActions removeAllObjects];
+    }
+  }
+  NSError *cancelledError =
+      [SCTKErrorUtilities errorWithCode:SCTKErrorCodeTokenRefreshCancelledError
+                        underlyingError:nil
+                            description:@"The token refresh was cancelled."];
+  for (SCTKAuthStatePendingAction *pendingAction in actionsToCancel) {
+    [self failPendingAction:pendingAction inList:nil error:cancelledError];
+  }
+}
+
+- (BOOL)performActionWithFreshTokensInline:(SCTKAuthStateAction)action
+               additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                             dispatchQueue:(dispatch_queue_t)dispatchQueue {
+  SCTKAuthStateTokenSnapshot *tokenSnapshot = self.tokenSnapshot;
+  if ([self canUseTokensInSnapshot:tokenSnapshot additionalParameters:additionalParameters]) {
+    // access token is valid within tolerance levels, perform action on the calling thread
+    action(tokenSnapshot.accessToken, tokenSnapshot.idToken, nil);
+    return YES;
+  }
+
+  [self refreshTokensAndPerformAction:action
+          additionalRefreshParameters:additionalParameters
+                        dispatchQueue:dispatchQueue
+                              timeout:0];
+  return NO;
+}
+
+- (void)performActionWithFreshTokensForScopes:(nullable NSArray<NSString *> *)scopes
+                                     resource:(nullable NSString *)resource
+                                       action:(SCTKAuthStateAction)action {
+  [self performActionWithFreshTokensForScopes:scopes
+                                     resource:resource
+                                       action:action
+                                dispatchQueue:dispatch_get_main_queue()];
+}
+
+- (void)performActionWithFreshTokensForScopes:(nullable NSArray<NSString *> *)scopes
+                                     resource:(nullable NSString *)resource
+                                       action:(SCTKAuthStateAction)action
+                                dispatchQueue:(dispatch_queue_t)dispatchQueue {
+  NSString *key = [[self class] scopedTokenKeyForScopes:scopes resource:resource];
+  SCTKAuthStateTokenSnapshot *tokenSnapshot;
+  @synchronized(_pendingActionsSyncObject) {
+    tokenSnapshot = _scopedTokens[key];
+  }
+  if (tokenSnapshot && [[self class] isAccessTokenFreshInSnapshot:tokenSnapshot]) {
+    // the cached token for these scopes is valid within tolerance levels, perform action
+    dispatch_async(dispatchQueue, ^{
+      action(tokenSnapshot.accessToken, tokenSnapshot.idToken, nil);
     });
     return;
   }
 
+  if (!_refreshToken) {
+    NSError *tokenRefreshError = [
+      SCTKErrorUtilities errorWithCode:SCTKErrorCodeTokenRefreshError
+                      underlyingError:nil
+                          description:@"Unable to obtain a scoped token without a refresh token."];
+    dispatch_async(dispatchQueue, ^{
+        action(nil, nil, tokenRefreshError);
+    });
+    return;
+  }
+
+  SCTKAuthStatePendingAction* pendingAction =
+      [[SCTKAuthStatePendingAction alloc] initWithAction:action andDispatchQueue:dispatchQueue];
+  NSMutableArray<SCTKAuthStatePendingAction *> *pendingActions;
+  @synchronized(_pendingActionsSyncObject) {
+    // if a token for these scopes is already being obtained, waits for it
+    pendingActions = _scopedPendingActions[key];
+    if (pendingActions) {
+      [pendingActions addObject:pendingAction];
+      return;
+    }
+    if (!_scopedPendingActions) {
+      _scopedPendingActions = [NSMutableDictionary dictionary];
+    }
+    pendingActions = [NSMutableArray arrayWithObject:pendingAction];
+    _scopedPendingActions[key] = pendingActions;
+  }
+
+  // waits for any refresh in progress, which may rotate the refresh token
+  [self enqueueRefreshTokenOperation:^(BOOL adoptedTokens,
+                                       SCTKAuthStateRefreshTokenCompletion completion) {
+    [self performScopedTokenRequestForScopes:scopes
+                                    resource:resource
+                              pendingActions:pendingActions
+                                  completion:completion];
+  }];
+}
+
+/*! @brief Obtains a token for a set of scopes and a resource with the refresh token, then performs
+        the actions waiting for it. Must run as a refresh token operation.
+    @param scopes The scopes of the token, if any.
+    @param resource The resource the token is for, if any.
+    @param pendingActions The list of actions waiting for the token.
+    @param completion Ends the refresh token operation.
+ */
+- (void)performScopedTokenRequestForScopes:(nullable NSArray<NSString *> *)scopes
+                                  resource:(nullable NSString *)resource
+                            pendingActions:
+    (NSMutableArray<SCTKAuthStatePendingAction *> *)pendingActions
+                                completion:(SCTKAuthStateRefreshTokenCompletion)completion {
+  NSString *key = [[self class] scopedTokenKeyForScopes:scopes resource:resource];
+  NSString *refreshToken = _refreshToken;
+  if (!refreshToken) {
+    // a refresh before this one was rejected
+    completion(nil);
+    @synchronized(_pendingActionsSyncObject) {
+      if (_scopedPendingActions[key] == pendingActions) {
+        [_scopedPendingActions removeObjectForKey:key];
+      }
+    }
+    NSError *tokenRefreshError = [
+      SCTKErrorUtilities errorWithCode:SCTKErrorCodeTokenRefreshError
+                      underlyingError:nil
+                          description:@"Unable to obtain a scoped token without a refresh token."];
+    [self performPendingActions:pendingActions tokenSnapshot:nil error:tokenRefreshError];
+    return;
+  }
+
+  NSDictionary<NSString *, NSString *> *additionalParameters =
+      resource ? @{ kResourceParameter : resource } : nil;
+  SCTKTokenRequest *tokenRequest = [[SCTKTokenRequest alloc]
+      initWithConfiguration:_lastAuthorizationResponse.request.configuration
+                  grantType:SCTKGrantTypeRefreshToken
+          authorizationCode:nil
+                redirectURL:nil
+                   clientID:_lastAuthorizationResponse.request.clientID
+               clientSecret:_lastAuthorizationResponse.request.clientSecret
+                      scope:scopes.count ? [SCTKScopeUtilities scopesWithArray:scopes] : nil
+               refreshToken:refreshToken
+               codeVerifier:nil
+       additionalParameters:additionalParameters
+          additionalHeaders:nil];
+  __weak SCTKAuthState *weakSelf = self;
+  [self performTokenRequest:tokenRequest
+                      retry:0
+                shouldRetry:^BOOL {
+    SCTKAuthState *strongSelf = weakSelf;
+    if (!strongSelf) {
+      return NO;
+    }
+    @synchronized(strongSelf->_pendingActionsSyncObject) {
+      return strongSelf->_scopedPendingActions[key] == pendingActions;
+    }
+  }
+                   callback:^(SCTKTokenResponse *_Nullable response, NSError *_Nullable error) {
+    SCTKAuthStateTokenSnapshot *scopedTokenSnapshot;
+    SCTKTokenResponse *rotatedTokenResponse;
+    if (response) {
+      scopedTokenSnapshot = [[SCTKAuthStateTokenSnapshot alloc]
+                initWithAccessToken:response.accessToken
+          accessTokenExpirationDate:response.accessTokenExpirationDate
+                            idToken:response.idToken
+                          tokenType:response.tokenType
+                         generation:0];
+      @synchronized(self->_pendingActionsSyncObject) {
+        if (!self->_scopedTokens) {
+          self->_scopedTokens = [NSMutableDictionary dictionary];
+        }
+        self->_scopedTokens[key] = scopedTokenSnapshot;
+      }
+      if (response.refreshToken
+          && ![response.refreshToken isEqualToString:self->_refreshToken]) {
+        // the server rotated the refresh token, which every other token of this state, and every
+        // other process sharing it, needs too
+        rotatedTokenResponse = [self lastTokenResponseWithRefreshToken:response.refreshToken];
+        if (rotatedTokenResponse) {
+          [self updateWithTokenResponse:rotatedTokenResponse obtainedDate:[NSDate date]];
+        } else {
+          self->_refreshToken = response.refreshToken;
+          [self didChangeState];
+        }
+      }
+    } else if (error.domain == SCTKOAuthTokenErrorDomain) {
+      // errors such as invalid_scope only concern this token, but a rejected refresh token
+      // concerns them all, unless the state has been reauthorized since
+      if (error.code == SCTKErrorCodeOAuthInvalidGrant
+          && [refreshToken isEqualToString:self->_refreshToken]) {
+        [self updateWithAuthorizationError:error];
+      }
+    } else {
+      [self notifyTransientError:error];
+    }
+    completion(rotatedTokenResponse);
+
+    @synchronized(self->_pendingActionsSyncObject) {
+      if (self->_scopedPendingActions[key] == pendingActions) {
+        [self->_scopedPendingActions removeObjectForKey:key];
+      }
+    }
+    [self performPendingActions:pendingActions tokenSnapshot:scopedTokenSnapshot error:error];
+  }];
+}
+
+/*! @brief Returns the last token response with a new refresh token, which records a refresh token
+        rotated by a scoped token request, or nil if there is no last token response.
+    @param refreshToken The new refresh token.
+ */
+- (nullable SCTKTokenResponse *)lastTokenResponseWithRefreshToken:(NSString *)refreshToken {
+  SCTKTokenResponse *lastTokenResponse = _lastTokenResponse;
+  if (!lastTokenResponse) {
+    return nil;
+  }
+  NSMutableDictionary<NSString *, NSObject<NSCopying> *> *parameters =
+      [NSMutableDictionary dictionaryWithDictionary:lastTokenResponse.additionalParameters ?: @{}];
+  parameters[@"access_token"] = lastTokenResponse.accessToken;
+  parameters[@"id_token"] = lastTokenResponse.idToken;
+  parameters[@"token_type"] = lastTokenResponse.tokenType;
+  parameters[@"scope"] = lastTokenResponse.scope;
+  parameters[@"refresh_token"] = refreshToken;
+  NSDate *expirationDate = lastTokenResponse.accessTokenExpirationDate;
+  if (expirationDate) {
+    // anchored to the current expiry, which keeps the exact date
+    parameters[@"expires_in"] = @0;
+  }
+  return [[SCTKTokenResponse alloc] initWithRequest:lastTokenResponse.request
+                                         parameters:parameters
+                                        requestDate:expirationDate ?: [NSDate date]];
+}
+
+/*! @brief Returns the key of the scoped token for a set of scopes and a resource.
+    @param scopes The scopes of the token, in any order.
+    @param resource The resource the token is for, if any.
+ */
++ (NSString *)scopedTokenKeyForScopes:(nullable NSArray<NSString *> *)scopes
+                             resource:(nullable NSString *)resource {
+  NSArray<NSString *> *sortedScopes =
+      [[[NSSet setWithArray:scopes ?: @[]] allObjects]
+          sortedArrayUsingSelector:@selector(compare:)];
+  // neither scopes nor URIs contain a line feed, so distinct pairs give distinct keys
+  return [NSString stringWithFormat:@"%@\n%@",
+                                    [sortedScopes componentsJoinedByString:@" "],
+                                    resource ?: @""];
+}
+
+/*! @brief Determines whether an action can be performed with the tokens of a snapshot straight
+        away, starting a background refresh if the @c refreshPolicy calls for one.
+    @param tokenSnapshot The snapshot to check.
+    @param additionalParameters Additional parameters for the token request if one is started.
+ */
+- (BOOL)canUseTokensInSnapshot:(SCTKAuthStateTokenSnapshot *)tokenSnapshot
+          additionalParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters {
+  if ([self isTokenFreshInSnapshot:tokenSnapshot]) {
+    return YES;
+  }
+  if (self.refreshPolicy != SCTKAuthStateRefreshPolicyStaleWhileRevalidate
+      || _needsTokenRefresh || !_refreshToken || !tokenSnapshot.accessToken
+      || [tokenSnapshot.accessTokenExpirationDate timeIntervalSinceNow] <= 0) {
+    return NO;
+  }
+  // stale but not expired, serves it while refreshing in the background
+  [self revalidateTokensWithAdditionalParameters:additionalParameters];
+  return YES;
+}
+
+/*! @brief Starts a token refresh that no action waits for, unless one is already in progress.
+    @param additionalParameters Additional parameters for the token request.
+ */
+- (void)revalidateTokensWithAdditionalParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters {
+  NSMutableArray<SCTKAuthStatePendingAction *> *pendingActions;
+  @synchronized(_pendingActionsSyncObject) {
+    if (_pendingActions) {
+      // actions joining the refresh in progress will be performed once it completes
+      return;
+    }
+    _pendingActions = [NSMutableArray array];
+    pendingActions = _pendingActions;
+  }
+  [self coordinateTokenRefreshForPendingActions:pendingActions
+                           additionalParameters:additionalParameters];
+}
+
+/*! @brief Refreshes the tokens, or joins a refresh in progress, then dispatches the action.
+    @param action The block to execute with the refreshed tokens.
+    @param additionalParameters Additional parameters for the token request.
+    @param dispatchQueue The dispatchQueue on which to dispatch the action block.
+    @param timeout How many seconds the action may wait, or zero for no limit.
+    @return A handle to stop waiting for the refresh.
+ */
+- (SCTKAuthStateActionHandle *)
+    refreshTokensAndPerformAction:(SCTKAuthStateAction)action
+      additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                    dispatchQueue:(dispatch_queue_t)dispatchQueue
+                          timeout:(NSTimeInterval)timeout {
   if (!_refreshToken) {
     // no refresh token available and token has expired
     NSError *tokenRefreshError = [
@@ -524,31 +1033,207 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     dispatch_async(dispatchQueue, ^{
         action(nil, nil, tokenRefreshError);
     });
-    return;
+    return [[SCTKAuthStateActionHandle alloc] initWithCancelBlock:nil];
   }
 
   // access token is expired, first refresh the token, then perform action
   NSAssert(_pendingActionsSyncObject, @"_pendingActionsSyncObject cannot be nil", @"");
   SCTKAuthStatePendingAction* pendingAction =
       [[SCTKAuthStatePendingAction alloc] initWithAction:action andDispatchQueue:dispatchQueue];
+  NSMutableArray<SCTKAuthStatePendingAction *> *pendingActions;
+  BOOL refreshInProgress;
   @synchronized(_pendingActionsSyncObject) {
     // if a token is already in the process of being refreshed, adds to pending actions
-    if (_pendingActions) {
+    refreshInProgress = !!_pendingActions;
+    if (refreshInProgress) {
       [_pendingActions addObject:pendingAction];
+    } else {
+      // creates a list of pending actions, starting with this one
+      _pendingActions = [NSMutableArray arrayWithObject:pendingAction];
+    }
+    pendingActions = _pendingActions;
+  }
+
+  __weak SCTKAuthState *weakSelf = self;
+  SCTKAuthStateActionHandle *handle = [[SCTKAuthStateActionHandle alloc] initWithCancelBlock:^{
+    NSError *cancelledError =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeTokenRefreshCancelledError
+                          underlyingError:nil
+                              description:@"The action was cancelled."];
+    [weakSelf failPendingAction:pendingAction inList:pendingActions error:cancelledError];
+  }];
+  if (timeout > 0) {
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)),
+                   dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+      NSString *description =
+          [NSString stringWithFormat:@"The token refresh did not complete within %.1f seconds.",
+                                     timeout];
+      NSError *timeoutError =
+          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeTokenRefreshTimeoutError
+                            underlyingError:nil
+                                description:description];
+      [weakSelf failPendingAction:pendingAction inList:pendingActions error:timeoutError];
+    });
+  }
+
+  if (refreshInProgress) {
+    return handle;
+  }
+
+  [self coordinateTokenRefreshForPendingActions:pendingActions
+                           additionalParameters:additionalParameters];
+  return handle;
+}
+
+/*! @brief Dispatches a pending action with an error, unless it has already been dispatched.
+    @param pendingAction The action to fail.
+    @param pendingActions The list to remove the action from, or nil if it was already removed.
+    @param error The error to call the action with.
+ */
+- (void)failPendingAction:(SCTKAuthStatePendingAction *)pendingAction
+                   inList:(nullable NSMutableArray<SCTKAuthStatePendingAction *> *)pendingActions
+                    error:(NSError *)error {
+  @synchronized(_pendingActionsSyncObject) {
+    if (pendingAction.completed) {
       return;
     }
+    pendingAction.completed = YES;
+    [pendingActions removeObjectIdenticalTo:pendingAction];
+  }
+  dispatch_async(pendingAction.dispatchQueue, ^{
+    pendingAction.action(nil, nil, error);
+  });
+}
 
-    // creates a list of pending actions, starting with this one
-    _pendingActions = [NSMutableArray arrayWithObject:pendingAction];
+/*! @brief Refreshes the tokens once no other refresh token operation is running, then performs
+        the pending actions.
+    @param pendingActions The list of actions waiting for this refresh.
+    @param additionalParameters Additional parameters for the token request.
+ */
+- (void)coordinateTokenRefreshForPendingActions:
+    (NSMutableArray<SCTKAuthStatePendingAction *> *)pendingActions
+                           additionalParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters {
+  [self enqueueRefreshTokenOperation:^(BOOL adoptedTokens,
+                                       SCTKAuthStateRefreshTokenCompletion completion) {
+    if (adoptedTokens && [self isTokenFreshInSnapshot:self.tokenSnapshot]) {
+      // another process already refreshed
+      completion(nil);
+      [self performPendingActions:pendingActions error:nil];
+      return;
+    }
+    [self performTokenRefreshForPendingActions:pendingActions
+                          additionalParameters:additionalParameters
+                                      callback:^(SCTKTokenResponse *_Nullable response,
+                                                 NSError *_Nullable error) {
+      completion(response);
+    }];
+  }];
+}
+
+/*! @brief Runs an operation spending the refresh token once the operations enqueued before it have
+        finished and, with a @c refreshCoordinator, once no other process is spending it.
+    @param operation The operation. Called on the calling thread if nothing is running and there is
+        no @c refreshCoordinator, otherwise on @c _stateQueue.
+ */
+- (void)enqueueRefreshTokenOperation:(SCTKAuthStateRefreshTokenOperation)operation {
+  BOOL idle;
+  @synchronized(_pendingActionsSyncObject) {
+    if (!_refreshTokenOperations) {
+      _refreshTokenOperations = [NSMutableArray array];
+    }
+    [_refreshTokenOperations addObject:operation];
+    idle = _refreshTokenOperations.count == 1;
+  }
+  if (idle) {
+    [self startRefreshTokenOperation:operation];
+  }
+}
+
+/*! @brief Runs the first enqueued refresh token operation, then starts the next one.
+    @param operation The first enqueued operation.
+ */
+- (void)startRefreshTokenOperation:(SCTKAuthStateRefreshTokenOperation)operation {
+  dispatch_block_t startNextOperation = ^{
+    SCTKAuthStateRefreshTokenOperation nextOperation;
+    @synchronized(self->_pendingActionsSyncObject) {
+      [self->_refreshTokenOperations removeObjectAtIndex:0];
+      nextOperation = self->_refreshTokenOperations.firstObject;
+    }
+    if (nextOperation) {
+      [self startRefreshTokenOperation:nextOperation];
+    }
+  };
+
+  SCTKAuthStateRefreshCoordinator *refreshCoordinator = _refreshCoordinator;
+  if (!refreshCoordinator) {
+    operation(NO, ^(SCTKTokenResponse *_Nullable tokenResponse) {
+      startNextOperation();
+    });
+    return;
   }
 
-  // refresh the tokens
+  // waits for any other process sharing this authorization to finish spending the refresh token
+  SCTKAuthStateRefreshCoordinatorBlock block = ^(SCTKTokenResponse *_Nullable sharedTokenResponse,
+                                                 NSDate *_Nullable sharedDate,
+                                                 SCTKAuthStateRefreshCoordinatorRelease release) {
+    BOOL adoptedTokens = NO;
+    NSDate *lastTokenResponseDate = self->_lastTokenResponseDate;
+    if (sharedTokenResponse && sharedDate
+        && (!lastTokenResponseDate
+            || [sharedDate compare:lastTokenResponseDate] == NSOrderedDescending)) {
+      // another process refreshed this authorization since this one obtained its tokens, adopts
+      // its result, which also carries the current refresh token if the server rotates them
+      self->_needsTokenRefresh = NO;
+      [self updateWithTokenResponse:sharedTokenResponse obtainedDate:sharedDate];
+      adoptedTokens = YES;
+    }
+    operation(adoptedTokens, ^(SCTKTokenResponse *_Nullable tokenResponse) {
+      release(tokenResponse, tokenResponse ? self->_lastTokenResponseDate : nil);
+      startNextOperation();
+    });
+  };
+  [refreshCoordinator performExclusivelyForAuthorizationKey:[self refreshCoordinatorKey]
+                                                    onQueue:_stateQueue
+                                                      block:block];
+}
+
+/*! @brief Returns the key of the current authorization in the @c refreshCoordinator record, a
+        hash of the client, token endpoint and authorization code, so that a token response is
+        never adopted across sign-ins.
+ */
+- (NSString *)refreshCoordinatorKey {
+  SCTKAuthorizationRequest *request = _lastAuthorizationResponse.request;
+  NSString *authorization =
+      [NSString stringWithFormat:@"%@\n%@\n%@",
+                                 request.clientID ?: @"",
+                                 request.configuration.tokenEndpoint.absoluteString ?: @"",
+                                 _lastAuthorizationResponse.authorizationCode ?: @""];
+  return [SCTKTokenUtilities encodeBase64urlNoPadding:[SCTKTokenUtilities sha256:authorization]];
+}
+
+/*! @brief Refreshes the tokens with the token endpoint, updates the state with the result, then
+        performs the pending actions.
+    @param pendingActions The list of actions waiting for this refresh.
+    @param additionalParameters Additional parameters for the token request.
+    @param callback Called with the result before the pending actions are performed, if not nil.
+ */
+- (void)performTokenRefreshForPendingActions:
+    (NSMutableArray<SCTKAuthStatePendingAction *> *)pendingActions
+                        additionalParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                                    callback:(nullable SCTKTokenCallback)callback {
   SCTKTokenRequest *tokenRefreshRequest =
       [self tokenRefreshRequestWithAdditionalParameters:additionalParameters];
-  [SCTKAuthorizationService performTokenRequest:tokenRefreshRequest
-                 originalAuthorizationResponse:_lastAuthorizationResponse
-                                      callback:^(SCTKTokenResponse *_Nullable response,
-                                                 NSError *_Nullable error) {
+  __weak SCTKAuthState *weakSelf = self;
+  [self performTokenRequest:tokenRefreshRequest
+                      retry:0
+                shouldRetry:^BOOL {
+    // keeps retrying after cancellation, as actions may have joined the refresh since; stops
+    // once nobody can use the result
+    return weakSelf != nil;
+  }
+                   callback:^(SCTKTokenResponse *_Nullable response, NSError *_Nullable error) {
     // update SCTKAuthState based on response
     if (response) {
       self->_needsTokenRefresh = NO;
@@ -558,45 +1243,145 @@ static const NSUInteger kExpiryTimeTolerance = 60;
         self->_needsTokenRefresh = NO;
         [self updateWithAuthorizationError:error];
       } else {
-        if ([self->_errorDelegate respondsToSelector:
-            @selector(authState:didEncounterTransientError:)]) {
-          [self->_errorDelegate authState:self didEncounterTransientError:error];
-        }
+        [self notifyTransientError:error];
       }
     }
 
-    // nil the pending queue and process everything that was queued up
-    NSArray *actionsToProcess;
-    @synchronized(self->_pendingActionsSyncObject) {
-      actionsToProcess = self->_pendingActions;
-      self->_pendingActions = nil;
+    if (callback) {
+      callback(response, error);
     }
-    for (SCTKAuthStatePendingAction* actionToProcess in actionsToProcess) {
-      dispatch_async(actionToProcess.dispatchQueue, ^{
-        actionToProcess.action(self.accessToken, self.idToken, error);
-      });
+    [self performPendingActions:pendingActions error:error];
+  }];
+}
+
+/*! @brief Sends a token request unless the @c circuitBreaker fails it fast, retrying transient
+        failures as the @c retryPolicy allows.
+    @param tokenRequest The token request.
+    @param retry The number of retries already made.
+    @param shouldRetry Returns NO if the result is no longer awaited, so retrying is pointless.
+    @param callback Called on @c _stateQueue with the final result.
+ */
+- (void)performTokenRequest:(SCTKTokenRequest *)tokenRequest
+                      retry:(NSUInteger)retry
+                shouldRetry:(BOOL (^)(void))shouldRetry
+                   callback:(SCTKTokenCallback)callback {
+  SCTKCircuitBreaker *circuitBreaker = _circuitBreaker;
+  NSURL *tokenEndpoint = tokenRequest.configuration.tokenEndpoint;
+  if (circuitBreaker && ![circuitBreaker shouldAllowRequestToEndpoint:tokenEndpoint]) {
+    NSString *description =
+        [NSString stringWithFormat:@"The token endpoint %@ is unavailable.", tokenEndpoint];
+    NSError *unavailableError =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeEndpointUnavailableError
+                          underlyingError:nil
+                              description:description];
+    dispatch_async(_stateQueue, ^{
+      callback(nil, unavailableError);
+    });
+    return;
+  }
+
+  [SCTKAuthorizationService performTokenRequest:tokenRequest
+                 originalAuthorizationResponse:_lastAuthorizationResponse
+                                 callbackQueue:_stateQueue
+                                      callback:^(SCTKTokenResponse *_Nullable response,
+                                                 NSError *_Nullable error) {
+    BOOL transientError = !response && [SCTKRetryPolicy isTransientError:error];
+    if (transientError) {
+      [circuitBreaker recordFailureForEndpoint:tokenEndpoint];
+    } else {
+      [circuitBreaker recordSuccessForEndpoint:tokenEndpoint];
+    }
+
+    SCTKRetryPolicy *retryPolicy = self.retryPolicy;
+    if (!transientError || retry >= retryPolicy.maximumRetryCount || !shouldRetry()) {
+      callback(response, error);
+      return;
     }
+    NSTimeInterval delay = [retryPolicy delayBeforeRetry:retry];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+                   self->_stateQueue, ^{
+      [self performTokenRequest:tokenRequest
+                          retry:retry + 1
+                    shouldRetry:shouldRetry
+                       callback:callback];
+    });
   }];
 }
 
+/*! @brief Ends a refresh by performing every action still waiting for it with the current tokens.
+    @param pendingActions The list of actions waiting for the refresh.
+    @param error The error that caused the refresh to fail, if any.
+ */
+- (void)performPendingActions:(NSMutableArray<SCTKAuthStatePendingAction *> *)pendingActions
+                        error:(nullable NSError *)error {
+  // nil the pending queue, so that later actions start a new refresh
+  @synchronized(_pendingActionsSyncObject) {
+    if (_pendingActions == pendingActions) {
+      _pendingActions = nil;
+    }
+  }
+  [self performPendingActions:pendingActions tokenSnapshot:self.tokenSnapshot error:error];
+}
+
+/*! @brief Performs every action still waiting for a refresh with the given tokens.
+    @param pendingActions The list of actions waiting for the refresh.
+    @param tokenSnapshot The tokens to perform the actions with, if any.
+    @param error The error that caused the refresh to fail, if any.
+ */
+- (void)performPendingActions:(NSMutableArray<SCTKAuthStatePendingAction *> *)pendingActions
+                tokenSnapshot:(nullable SCTKAuthStateTokenSnapshot *)tokenSnapshot
+                        error:(nullable NSError *)error {
+  // process everything that was queued up, unless the refresh was cancelled, in which case its
+  // waiters have already been failed
+  NSArray *actionsToProcess;
+  @synchronized(_pendingActionsSyncObject) {
+    actionsToProcess = [pendingActions copy];
+    [pendingActions removeAllObjects];
+    for (SCTKAuthStatePendingAction *pendingAction in actionsToProcess) {
+      NSAssert(!pendingAction.completed, @"Completed actions are removed from the list.");
+      pendingAction.completed = YES;
+    }
+  }
+  for (SCTKAuthStatePendingAction* actionToProcess in actionsToProcess) {
+    dispatch_async(actionToProcess.dispatchQueue, ^{
+      actionToProcess.action(tokenSnapshot.accessToken, tokenSnapshot.idToken, error);
+    });
+  }
+}
+
 #pragma mark -
 
 /*! @fn isTokenFresh
     @brief Determines whether a token refresh request must be made to refresh the tokens.
  */
 - (BOOL)isTokenFresh {
+  return [self isTokenFreshInSnapshot:self.tokenSnapshot];
+}
+
+/*! @brief Determines whether the tokens of a snapshot can be used without being refreshed.
+    @param tokenSnapshot The snapshot to check.
+ */
+- (BOOL)isTokenFreshInSnapshot:(SCTKAuthStateTokenSnapshot *)tokenSnapshot {
   if (_needsTokenRefresh) {
     // forced refresh
     return NO;
   }
+  return [[self class] isAccessTokenFreshInSnapshot:tokenSnapshot];
+}
 
-  if (!self.accessTokenExpirationDate) {
+/*! @brief Determines whether the access token of a snapshot is far enough from expiring to be
+        used, regardless of any forced refresh.
+    @param tokenSnapshot The snapshot to check.
+ */
++ (BOOL)isAccessTokenFreshInSnapshot:(SCTKAuthStateTokenSnapshot *)tokenSnapshot {
+  if (!tokenSnapshot.accessTokenExpirationDate) {
     // if there is no expiration time but we have an access token, it is assumed to never expire
-    return !!self.accessToken;
+    return !!tokenSnapshot.accessToken;
   }
 
   // has the token expired?
-  BOOL tokenFresh = [self.accessTokenExpirationDate timeIntervalSinceNow] > kExpiryTimeTolerance;
+  BOOL tokenFresh =
+      [tokenSnapshot.accessTokenExpirationDate timeIntervalSinceNow] > kExpiryTimeTolerance;
   return tokenFresh;
 }
 
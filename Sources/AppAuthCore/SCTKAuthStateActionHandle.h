@@ -0,0 +1,52 @@
+/*! @file SCTKAuthStateActionHandle.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Returned by the @c SCTKAuthState methods that take a timeout, to let the caller stop
+        waiting for the token refresh.
+ */
+@interface SCTKAuthStateActionHandle : NSObject
+
+/*! @brief YES once @c cancel has been called.
+ */
+@property(nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithCancelBlock:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param cancelBlock Called the first time the handle is cancelled, or nil if there is nothing to
+        cancel.
+ */
+- (instancetype)initWithCancelBlock:(nullable dispatch_block_t)cancelBlock
+    NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Stops waiting for the token refresh. If the action has not been called yet, it is called
+        straight away with an error of code @c ::SCTKErrorCodeTokenRefreshCancelledError. The
+        refresh itself carries on for any other waiting actions.
+ */
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
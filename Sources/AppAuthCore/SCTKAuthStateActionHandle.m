@@ -0,0 +1,67 @@
+/*! @file SCTKAuthStateActionHandle.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthStateActionHandle.h"
+
+#import "SCTKDefines.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@implementation SCTKAuthStateActionHandle {
+  /*! @brief Called by the first @c cancel, then released. Guarded by @c self.
+   */
+  dispatch_block_t _Nullable _cancelBlock;
+}
+
+@synthesize cancelled = _cancelled;
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithCancelBlock:))
+
+- (instancetype)initWithCancelBlock:(nullable dispatch_block_t)cancelBlock {
+  self = [super init];
+  if (self) {
+    _cancelBlock = [cancelBlock copy];
+  }
+  return self;
+}
+
+- (BOOL)isCancelled {
+  @synchronized(self) {
+    return _cancelled;
+  }
+}
+
+- (void)cancel {
+  dispatch_block_t cancelBlock;
+  @synchronized(self) {
+    if (_cancelled) {
+      return;
+    }
+    _cancelled = YES;
+    cancelBlock = _cancelBlock;
+    _cancelBlock = nil;
+  }
+  if (cancelBlock) {
+    cancelBlock();
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
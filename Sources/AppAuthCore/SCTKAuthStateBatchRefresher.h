@@ -0,0 +1,87 @@
+/*! @file SCTKAuthStateBatchRefresher.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class SCTKAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The number of refreshes a batch refresher created with @c init runs at once against each
+        token endpoint.
+ */
+extern const NSUInteger SCTKAuthStateBatchRefresherDefaultMaximumConcurrentRefreshes;
+
+/*! @brief Reports the progress of a batch refresh.
+    @param completedCount The number of auth states whose refresh has completed, successfully or
+        not.
+    @param totalCount The number of auth states in the batch.
+ */
+typedef void (^SCTKAuthStateBatchRefreshProgress)(NSUInteger completedCount,
+                                                  NSUInteger totalCount);
+
+/*! @brief Called once every auth state of a batch has been refreshed.
+    @param errors The errors of the refreshes that failed, by the index of their auth state in the
+        batch. Empty if every refresh succeeded.
+ */
+typedef void (^SCTKAuthStateBatchRefreshCompletion)(NSDictionary<NSNumber *, NSError *> *errors);
+
+/*! @brief Refreshes many @c SCTKAuthState objects at once, such as after a cold start or a device
+        wake, without sending every token request at the same time.
+    @discussion Auth states are queued per token endpoint, and at most
+        @c maximumConcurrentRefreshes of each queue are refreshed at once. The refreshes of all
+        batches of one refresher share these limits. When a refresh completes, the next auth state
+        is taken from the queue: first those with actions waiting for their tokens, then those
+        whose access token expires soonest.
+
+        Refreshes go through @c SCTKAuthState.performActionWithFreshTokens:, so they share the
+        session of @c SCTKURLSessionProvider, are coalesced with any refresh already in progress,
+        and report their results to the auth state's delegates as usual. Auth states whose tokens
+        are still fresh complete without a request.
+ */
+@interface SCTKAuthStateBatchRefresher : NSObject
+
+/*! @brief The maximum number of refreshes run at once against each token endpoint.
+ */
+@property(nonatomic, readonly) NSUInteger maximumConcurrentRefreshes;
+
+/*! @brief Creates a refresher that runs
+        @c ::SCTKAuthStateBatchRefresherDefaultMaximumConcurrentRefreshes refreshes at once
+        against each token endpoint.
+ */
+- (instancetype)init;
+
+/*! @brief Designated initializer.
+    @param maximumConcurrentRefreshes The maximum number of refreshes run at once against each
+        token endpoint. Must be at least one.
+ */
+- (instancetype)initWithMaximumConcurrentRefreshes:(NSUInteger)maximumConcurrentRefreshes
+    NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Refreshes the access tokens of a collection of auth states.
+    @param authStates The auth states to refresh.
+    @param progress Called on the main queue each time the refresh of an auth state completes.
+    @param completion Called on the main queue once every auth state has been refreshed.
+ */
+- (void)refreshAuthStates:(NSArray<SCTKAuthState *> *)authStates
+                 progress:(nullable SCTKAuthStateBatchRefreshProgress)progress
+               completion:(SCTKAuthStateBatchRefreshCompletion)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
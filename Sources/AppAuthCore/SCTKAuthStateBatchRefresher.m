@@ -0,0 +1,275 @@
+/*! @file SCTKAuthStateBatchRefresher.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthStateBatchRefresher.h"
+
+#import "SCTKAuthState.h"
+#import "SCTKAuthStateTokenSnapshot.h"
+#import "SCTKAuthorizationRequest.h"
+#import "SCTKAuthorizationResponse.h"
+#import "SCTKServiceConfiguration.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+const NSUInteger SCTKAuthStateBatchRefresherDefaultMaximumConcurrentRefreshes = 4;
+
+/*! @brief The progress of one call to
+        @c SCTKAuthStateBatchRefresher.refreshAuthStates:progress:completion:.
+ */
+@interface SCTKAuthStateBatchRefresh : NSObject
+
+/*! @brief The number of auth states in the batch.
+ */
+@property(nonatomic, readonly) NSUInteger totalCount;
+
+/*! @brief The number of auth states whose refresh has completed.
+ */
+@property(nonatomic) NSUInteger completedCount;
+
+/*! @brief The errors of the failed refreshes, by index of the auth state.
+ */
+@property(nonatomic, readonly) NSMutableDictionary<NSNumber *, NSError *> *errors;
+
+@property(nonatomic, readonly, nullable) SCTKAuthStateBatchRefreshProgress progress;
+@property(nonatomic, readonly) SCTKAuthStateBatchRefreshCompletion completion;
+
+- (instancetype)initWithTotalCount:(NSUInteger)totalCount
+                          progress:(nullable SCTKAuthStateBatchRefreshProgress)progress
+                        completion:(SCTKAuthStateBatchRefreshCompletion)completion;
+
+@end
+
+@implementation SCTKAuthStateBatchRefresh
+
+- (instancetype)initWithTotalCount:(NSUInteger)totalCount
+                          progress:(nullable SCTKAuthStateBatchRefreshProgress)progress
+                        completion:(SCTKAuthStateBatchRefreshCompletion)completion {
+  self = [super init];
+  if (self) {
+    _totalCount = totalCount;
+    _errors = [NSMutableDictionary dictionary];
+    _progress = progress;
+    _completion = completion;
+  }
+  return self;
+}
+
+@end
+
+/*! @brief An auth state waiting in the queue of its token endpoint.
+ */
+@interface SCTKAuthStateBatchRefreshItem : NSObject
+
+@property(nonatomic, readonly) SCTKAuthState *authState;
+
+/*! @brief The index of @c authState in its batch.
+ */
+@property(nonatomic, readonly) NSUInteger index;
+
+@property(nonatomic, readonly) SCTKAuthStateBatchRefresh *batch;
+
+- (instancetype)initWithAuthState:(SCTKAuthState *)authState
+                            index:(NSUInteger)index
+                            batch:(SCTKAuthStateBatchRefresh *)batch;
+
+@end
+
+@implementation SCTKAuthStateBatchRefreshItem
+
+- (instancetype)initWithAuthState:(SCTKAuthState *)authState
+                            index:(NSUInteger)index
+                            batch:(SCTKAuthStateBatchRefresh *)batch {
+  self = [super init];
+  if (self) {
+    _authState = authState;
+    _index = index;
+    _batch = batch;
+  }
+  return self;
+}
+
+@end
+
+@implementation SCTKAuthStateBatchRefresher {
+  /*! @brief Serial queue that guards all other instance variables and receives refresh results.
+   */
+  dispatch_queue_t _queue;
+
+  /*! @brief The auth states waiting for a refresh, by token endpoint.
+   */
+  NSMutableDictionary<NSString *, NSMutableArray<SCTKAuthStateBatchRefreshItem *> *> *_queuedItems;
+
+  /*! @brief The number of refreshes in progress, by token endpoint.
+   */
+  NSMutableDictionary<NSString *, NSNumber *> *_activeCounts;
+}
+
+- (instancetype)init {
+  return [self initWithMaximumConcurrentRefreshes:
+      SCTKAuthStateBatchRefresherDefaultMaximumConcurrentRefreshes];
+}
+
+- (instancetype)initWithMaximumConcurrentRefreshes:(NSUInteger)maximumConcurrentRefreshes {
+  self = [super init];
+  if (self) {
+    NSAssert(maximumConcurrentRefreshes > 0, @"At least one refresh must be allowed at once.");
+    _maximumConcurrentRefreshes = MAX(maximumConcurrentRefreshes, (NSUInteger)1);
+    _queue = dispatch_queue_create("org.openid.appauth.batchrefresher", DISPATCH_QUEUE_SERIAL);
+    _queuedItems = [NSMutableDictionary dictionary];
+    _activeCounts = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+#pragma mark - Public
+
+- (void)refreshAuthStates:(NSArray<SCTKAuthState *> *)authStates
+                 progress:(nullable SCTKAuthStateBatchRefreshProgress)progress
+               completion:(SCTKAuthStateBatchRefreshCompletion)completion {
+  if (authStates.count == 0) {
+    dispatch_async(dispatch_get_main_queue(), ^{
+      completion(@{});
+    });
+    return;
+  }
+
+  NSArray<SCTKAuthState *> *authStatesToRefresh = [authStates copy];
+  SCTKAuthStateBatchRefresh *batch =
+      [[SCTKAuthStateBatchRefresh alloc] initWithTotalCount:authStatesToRefresh.count
+                                                   progress:progress
+                                                 completion:completion];
+  dispatch_async(_queue, ^{
+    NSMutableSet<NSString *> *endpoints = [NSMutableSet set];
+    [authStatesToRefresh enumerateObjectsUsingBlock:^(SCTKAuthState *authState,
+                                                      NSUInteger index,
+                                                      BOOL *stop) {
+      NSString *endpoint = [[self class] tokenEndpointOfAuthState:authState];
+      NSMutableArray<SCTKAuthStateBatchRefreshItem *> *items = self->_queuedItems[endpoint];
+      if (!items) {
+        items = [NSMutableArray array];
+        self->_queuedItems[endpoint] = items;
+      }
+      [items addObject:[[SCTKAuthStateBatchRefreshItem alloc] initWithAuthState:authState
+                                                                          index:index
+                                                                          batch:batch]];
+      [endpoints addObject:endpoint];
+    }];
+    for (NSString *endpoint in endpoints) {
+      [self startQueuedRefreshesForEndpoint:endpoint];
+    }
+  });
+}
+
+#pragma mark - Private
+
+/*! @brief Returns the key of the queue an auth state is refreshed in.
+    @param authState The auth state.
+ */
++ (NSString *)tokenEndpointOfAuthState:(SCTKAuthState *)authState {
+  NSURL *tokenEndpoint =
+      authState.lastAuthorizationResponse.request.configuration.tokenEndpoint;
+  return tokenEndpoint.absoluteString ?: @"";
+}
+
+/*! @brief Starts refreshes from the queue of a token endpoint until it is empty or the endpoint's
+        limit is reached. Must be called on @c _queue.
+    @param endpoint The token endpoint.
+ */
+- (void)startQueuedRefreshesForEndpoint:(NSString *)endpoint {
+  NSMutableArray<SCTKAuthStateBatchRefreshItem *> *items = _queuedItems[endpoint];
+  NSUInteger activeCount = _activeCounts[endpoint].unsignedIntegerValue;
+  while (items.count > 0 && activeCount < _maximumConcurrentRefreshes) {
+    NSUInteger itemIndex = [[self class] indexOfNextItemInItems:items];
+    SCTKAuthStateBatchRefreshItem *item = items[itemIndex];
+    [items removeObjectAtIndex:itemIndex];
+    activeCount++;
+    [self refreshItem:item endpoint:endpoint];
+  }
+  _activeCounts[endpoint] = @(activeCount);
+  if (items.count == 0) {
+    [_queuedItems removeObjectForKey:endpoint];
+  }
+}
+
+/*! @brief Returns the index of the item to refresh next: the first one whose auth state has
+        actions waiting for its tokens, otherwise the one whose access token expires soonest.
+    @param items A non-empty queue.
+ */
++ (NSUInteger)indexOfNextItemInItems:(NSArray<SCTKAuthStateBatchRefreshItem *> *)items {
+  NSUInteger nextIndex = 0;
+  NSDate *nextExpirationDate = [NSDate distantFuture];
+  for (NSUInteger i = 0; i < items.count; i++) {
+    SCTKAuthState *authState = items[i].authState;
+    if (authState.pendingActionCount > 0) {
+      return i;
+    }
+    // an access token without expiration date never expires
+    NSDate *expirationDate =
+        authState.tokenSnapshot.accessTokenExpirationDate ?: [NSDate distantFuture];
+    if ([expirationDate compare:nextExpirationDate] == NSOrderedAscending) {
+      nextIndex = i;
+      nextExpirationDate = expirationDate;
+    }
+  }
+  return nextIndex;
+}
+
+/*! @brief Refreshes the auth state of an item, then starts the next refresh of its endpoint. Must
+        be called on @c _queue.
+    @param item The item to refresh.
+    @param endpoint The token endpoint of the item.
+ */
+- (void)refreshItem:(SCTKAuthStateBatchRefreshItem *)item endpoint:(NSString *)endpoint {
+  [item.authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                                 NSString *_Nullable idToken,
+                                                 NSError *_Nullable error) {
+    self->_activeCounts[endpoint] = @(self->_activeCounts[endpoint].unsignedIntegerValue - 1);
+    [self completeItem:item error:error];
+    [self startQueuedRefreshesForEndpoint:endpoint];
+  }
+                   additionalRefreshParameters:nil
+                                 dispatchQueue:_queue];
+}
+
+/*! @brief Records the result of a refresh and reports the progress of its batch. Must be called on
+        @c _queue.
+    @param item The item whose refresh completed.
+    @param error The error of the refresh, if it failed.
+ */
+- (void)completeItem:(SCTKAuthStateBatchRefreshItem *)item error:(nullable NSError *)error {
+  SCTKAuthStateBatchRefresh *batch = item.batch;
+  if (error) {
+    batch.errors[@(item.index)] = error;
+  }
+  NSUInteger completedCount = ++batch.completedCount;
+  NSUInteger totalCount = batch.totalCount;
+  NSDictionary<NSNumber *, NSError *> *errors =
+      completedCount == totalCount ? [batch.errors copy] : nil;
+  dispatch_async(dispatch_get_main_queue(), ^{
+    if (batch.progress) {
+      batch.progress(completedCount, totalCount);
+    }
+    if (errors) {
+      batch.completion(errors);
+    }
+  });
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,91 @@
+/*! @file SCTKAuthStateCodec.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The format version written by @c SCTKAuthStateCodec.
+ */
+extern const uint8_t SCTKAuthStateCodecFormatVersion;
+
+/*! @brief Serializes @c SCTKAuthState objects, and the rest of their object graph, in a compact
+        versioned binary format.
+    @discussion Objects are serialized through their existing @c NSSecureCoding implementations,
+        so any class that can be archived with @c NSKeyedArchiver can be serialized. The format
+        differs from a keyed archive in the following ways:
+
+        - Strings, including coding keys, are written once and referenced by index afterwards.
+        - Objects encoded more than once, such as the @c SCTKServiceConfiguration shared by
+          the requests of an auth state, are written once and decoded as a single instance.
+        - Foundation values, @c NSError and @c SCTKServiceDiscovery are written directly rather
+          than through their @c NSCoding implementations. Integers are variable-length. An
+          @c NSError keeps only its domain, code and simple @c userInfo values.
+
+        Decoding is secure: the class of every decoded object must be one of the classes allowed by
+        the caller or by the @c initWithCoder: implementation decoding it.
+
+        Data begins with a magic number and a format version. Keyed archives are recognized too, so
+        states persisted before adopting this format can still be read, and converted once with
+        @c migratedDataWithData:ofClass:error:.
+ */
+@interface SCTKAuthStateCodec : NSObject
+
+/*! @brief Serializes an object graph.
+    @param rootObject The object to serialize, typically an @c SCTKAuthState.
+    @param error The error that occurred, if any.
+    @return The serialized data, or nil if an object in the graph does not support secure coding.
+ */
++ (nullable NSData *)dataWithRootObject:(id<NSSecureCoding>)rootObject
+                                  error:(NSError **_Nullable)error;
+
+/*! @brief Deserializes an object graph written by this codec, or by @c NSKeyedArchiver.
+    @param cls The expected class of the root object.
+    @param data The serialized data.
+    @param error The error that occurred, if any.
+    @return The root object, or nil if @c data is invalid, has an unsupported format version, or
+        contains an object of a class that is not allowed.
+ */
++ (nullable id)objectOfClass:(Class)cls
+                    fromData:(NSData *)data
+                       error:(NSError **_Nullable)error;
+
+/*! @brief Returns whether data was written by this codec.
+    @param data The data to check.
+ */
++ (BOOL)isCodecData:(NSData *)data;
+
+/*! @brief Returns whether data looks like a binary keyed archive.
+    @param data The data to check.
+ */
++ (BOOL)isKeyedArchiveData:(NSData *)data;
+
+/*! @brief Converts a keyed archive to this codec's format.
+    @param data A keyed archive, or data already in this codec's format.
+    @param cls The expected class of the root object.
+    @param error The error that occurred, if any.
+    @return The data in this codec's format, which is @c data itself if no conversion was needed, or
+        nil if @c data could not be decoded.
+ */
++ (nullable NSData *)migratedDataWithData:(NSData *)data
+                                  ofClass:(Class)cls
+                                    error:(NSError **_Nullable)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
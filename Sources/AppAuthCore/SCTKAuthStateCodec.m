@@ -0,0 +1,1150 @@
+/*! @file SCTKAuthStateCodec.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthStateCodec.h"
+
+#import "SCTKError.h"
+#import "SCTKErrorUtilities.h"
+#import "SCTKServiceDiscovery.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+const uint8_t SCTKAuthStateCodecFormatVersion = 1;
+
+/*! @brief The magic number at the start of data written by the codec. Followed by one byte holding
+        the format version.
+ */
+static const uint8_t kMagic[4] = {'S', 'C', 'A', 'S'};
+
+/*! @brief The length of the magic number and format version.
+ */
+static const NSUInteger kHeaderLength = sizeof(kMagic) + 1;
+
+/*! @brief The magic number at the start of binary property lists, which keyed archives are.
+ */
+static const uint8_t kKeyedArchiveMagic[8] = {'b', 'p', 'l', 'i', 's', 't', '0', '0'};
+
+/*! @brief The maximum nesting depth of values accepted by the decoder.
+ */
+static const NSUInteger kMaximumDepth = 64;
+
+/*! @brief Identifies the type of each value in the data. Values must never be reassigned, as they
+        are part of the format.
+ */
+typedef NS_ENUM(uint8_t, SCTKAuthStateCodecTag) {
+  /*! @brief No value.
+   */
+  SCTKAuthStateCodecTagNil = 0,
+
+  /*! @brief Ends the fields of an object.
+   */
+  SCTKAuthStateCodecTagEnd = 1,
+
+  /*! @brief A boolean @c YES.
+   */
+  SCTKAuthStateCodecTagTrue = 2,
+
+  /*! @brief A boolean @c NO.
+   */
+  SCTKAuthStateCodecTagFalse = 3,
+
+  /*! @brief A zigzag-encoded variable-length integer.
+   */
+  SCTKAuthStateCodecTagInteger = 4,
+
+  /*! @brief A big-endian 64-bit floating point number.
+   */
+  SCTKAuthStateCodecTagDouble = 5,
+
+  /*! @brief A string seen for the first time: its UTF-8 length and bytes.
+   */
+  SCTKAuthStateCodecTagString = 6,
+
+  /*! @brief A string seen before: its index in the order strings were first seen.
+   */
+  SCTKAuthStateCodecTagStringReference = 7,
+
+  /*! @brief Raw bytes: their length and contents.
+   */
+  SCTKAuthStateCodecTagData = 8,
+
+  /*! @brief A date, as a double of seconds since the reference date.
+   */
+  SCTKAuthStateCodecTagDate = 9,
+
+  /*! @brief A URL, as its absolute string.
+   */
+  SCTKAuthStateCodecTagURL = 10,
+
+  /*! @brief An array: its count, then its elements.
+   */
+  SCTKAuthStateCodecTagArray = 11,
+
+  /*! @brief A dictionary: its count, then each key followed by its value.
+   */
+  SCTKAuthStateCodecTagDictionary = 12,
+
+  /*! @brief A set: its count, then its elements.
+   */
+  SCTKAuthStateCodecTagSet = 13,
+
+  /*! @brief @c NSNull.
+   */
+  SCTKAuthStateCodecTagNull = 14,
+
+  /*! @brief An error: its domain, code and user info dictionary.
+   */
+  SCTKAuthStateCodecTagError = 15,
+
+  /*! @brief An @c SCTKServiceDiscovery: its discovery dictionary.
+   */
+  SCTKAuthStateCodecTagDiscovery = 16,
+
+  /*! @brief An @c NSSecureCoding object: its class name, then key and value pairs, then
+          @c SCTKAuthStateCodecTagEnd.
+   */
+  SCTKAuthStateCodecTagObject = 17,
+
+  /*! @brief An error, discovery document or object seen before: its index in the order they were
+          first seen.
+   */
+  SCTKAuthStateCodecTagObjectReference = 18,
+};
+
+/*! @brief Returns a codec error.
+    @param description The description of the problem.
+ */
+static NSError *SCTKAuthStateCodecError(NSString *description) {
+  return [SCTKErrorUtilities errorWithCode:SCTKErrorCodeArchiveError
+                           underlyingError:nil
+                               description:description];
+}
+
+#pragma mark - Encoder
+
+/*! @brief Writes an object graph in the codec's format.
+ */
+@interface SCTKAuthStateCodecEncoder : NSCoder
+
+/*! @brief The data written so far, starting with the header.
+ */
+@property(nonatomic, readonly) NSMutableData *data;
+
+/*! @brief The first error encountered, if any.
+ */
+@property(nonatomic, readonly, nullable) NSError *error;
+
+/*! @brief Writes a value and, recursively, everything it references.
+    @param value The value to write.
+ */
+- (void)encodeValue:(nullable id)value;
+
+@end
+
+@implementation SCTKAuthStateCodecEncoder {
+  /*! @brief Index of each string written so far.
+   */
+  NSMutableDictionary<NSString *, NSNumber *> *_stringIndexes;
+
+  /*! @brief Index of each error, discovery document and object written so far, by identity.
+   */
+  NSMapTable<id, NSNumber *> *_objectIndexes;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _data = [NSMutableData dataWithCapacity:1024];
+    [_data appendBytes:kMagic length:sizeof(kMagic)];
+    [_data appendBytes:&SCTKAuthStateCodecFormatVersion length:1];
+    _stringIndexes = [NSMutableDictionary dictionary];
+    NSPointerFunctionsOptions identityOptions =
+        NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality;
+    _objectIndexes = [[NSMapTable alloc] initWithKeyOptions:identityOptions
+                                               valueOptions:NSPointerFunctionsStrongMemory
+                                                   capacity:16];
+  }
+  return self;
+}
+
+- (BOOL)allowsKeyedCoding {
+  return YES;
+}
+
+- (BOOL)requiresSecureCoding {
+  return YES;
+}
+
+#pragma mark - Writing
+
+- (void)writeTag:(SCTKAuthStateCodecTag)tag {
+  [_data appendBytes:&tag length:1];
+}
+
+- (void)writeVarint:(uint64_t)value {
+  uint8_t buffer[10];
+  size_t length = 0;
+  while (value >= 0x80) {
+    buffer[length++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buffer[length++] = (uint8_t)value;
+  [_data appendBytes:buffer length:length];
+}
+
+- (void)writeInteger:(int64_t)value {
+  [self writeTag:SCTKAuthStateCodecTagInteger];
+  // zigzag encoding keeps small negative numbers short
+  [self writeVarint:((uint64_t)value << 1) ^ (uint64_t)(value >> 63)];
+}
+
+/*! @brief Writes the eight bytes of a double, without a tag.
+ */
+- (void)writeRawDouble:(double)value {
+  CFSwappedFloat64 swapped = CFConvertDoubleHostToSwapped(value);
+  [_data appendBytes:&swapped length:sizeof(swapped)];
+}
+
+- (void)writeDouble:(double)value {
+  [self writeTag:SCTKAuthStateCodecTagDouble];
+  [self writeRawDouble:value];
+}
+
+- (void)writeString:(NSString *)string {
+  NSNumber *index = _stringIndexes[string];
+  if (index) {
+    [self writeTag:SCTKAuthStateCodecTagStringReference];
+    [self writeVarint:index.unsignedIntegerValue];
+    return;
+  }
+  _stringIndexes[string] = @(_stringIndexes.count);
+
+  [self writeTag:SCTKAuthStateCodecTagString];
+  NSUInteger length = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+  [self writeVarint:length];
+  NSUInteger offset = _data.length;
+  _data.length = offset + length;
+  [string getBytes:(uint8_t *)_data.mutableBytes + offset
+         maxLength:length
+        usedLength:NULL
+          encoding:NSUTF8StringEncoding
+           options:0
+             range:NSMakeRange(0, string.length)
+    remainingRange:NULL];
+}
+
+- (void)writeNumber:(NSNumber *)number {
+  const char *type = number.objCType;
+  if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+    [self writeTag:number.boolValue ? SCTKAuthStateCodecTagTrue : SCTKAuthStateCodecTagFalse];
+  } else if (type[0] == 'f' || type[0] == 'd'
+             || (type[0] == 'Q' && number.unsignedLongLongValue > INT64_MAX)) {
+    [self writeDouble:number.doubleValue];
+  } else {
+    [self writeInteger:number.longLongValue];
+  }
+}
+
+- (void)encodeValue:(nullable id)value {
+  if (!value) {
+    [self writeTag:SCTKAuthStateCodecTagNil];
+  } else if ([value isKindOfClass:[NSString class]]) {
+    [self writeString:value];
+  } else if ([value isKindOfClass:[NSNumber class]]) {
+    [self writeNumber:value];
+  } else if ([value isKindOfClass:[NSData class]]) {
+    NSData *data = value;
+    [self writeTag:SCTKAuthStateCodecTagData];
+    [self writeVarint:data.length];
+    [_data appendData:data];
+  } else if ([value isKindOfClass:[NSDate class]]) {
+    [self writeTag:SCTKAuthStateCodecTagDate];
+    [self writeRawDouble:[value timeIntervalSinceReferenceDate]];
+  } else if ([value isKindOfClass:[NSURL class]]) {
+    [self writeTag:SCTKAuthStateCodecTagURL];
+    [self writeString:[value absoluteString]];
+  } else if ([value isKindOfClass:[NSArray class]] || [value isKindOfClass:[NSSet class]]) {
+    id<NSFastEnumeration, NSObject> collection = value;
+    [self writeTag:[value isKindOfClass:[NSArray class]] ? SCTKAuthStateCodecTagArray
+                                                          : SCTKAuthStateCodecTagSet];
+    [self writeVarint:[value count]];
+    for (id element in collection) {
+      [self encodeValue:element];
+    }
+  } else if ([value isKindOfClass:[NSDictionary class]]) {
+    NSDictionary *dictionary = value;
+    [self writeTag:SCTKAuthStateCodecTagDictionary];
+    [self writeVarint:dictionary.count];
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+      [self encodeValue:key];
+      [self encodeValue:object];
+    }];
+  } else if (value == [NSNull null]) {
+    [self writeTag:SCTKAuthStateCodecTagNull];
+  } else {
+    [self encodeObject:value];
+  }
+}
+
+/*! @brief Writes an error, discovery document or @c NSSecureCoding object, or a reference to it if
+        it was written before.
+    @param object The object to write.
+ */
+- (void)encodeObject:(id)object {
+  NSNumber *index = [_objectIndexes objectForKey:object];
+  if (index) {
+    [self writeTag:SCTKAuthStateCodecTagObjectReference];
+    [self writeVarint:index.unsignedIntegerValue];
+    return;
+  }
+  [_objectIndexes setObject:@(_objectIndexes.count) forKey:object];
+
+  if ([object isKindOfClass:[NSError class]]) {
+    NSError *error = object;
+    // keeps only user info values that can be written directly, like a property list
+    NSMutableDictionary<NSString *, id> *userInfo = [NSMutableDictionary dictionary];
+    [error.userInfo enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+      if ([key isKindOfClass:[NSString class]]
+          && ([value isKindOfClass:[NSString class]] || [value isKindOfClass:[NSNumber class]]
+              || [value isKindOfClass:[NSURL class]] || [value isKindOfClass:[NSError class]])) {
+        userInfo[key] = value;
+      }
+    }];
+    [self writeTag:SCTKAuthStateCodecTagError];
+    [self writeString:error.domain];
+    [self writeInteger:error.code];
+    [self encodeValue:userInfo];
+    return;
+  }
+
+  if ([object isKindOfClass:[SCTKServiceDiscovery class]]) {
+    // avoids the legacy encoding SCTKServiceDiscovery adds for forward compatibility
+    [self writeTag:SCTKAuthStateCodecTagDiscovery];
+    [self encodeValue:[object discoveryDictionary]];
+    return;
+  }
+
+  Class cls = [object classForCoder];
+  if (![cls conformsToProtocol:@protocol(NSSecureCoding)] || ![cls supportsSecureCoding]) {
+    if (!_error) {
+      NSString *description = [NSString stringWithFormat:@"%@ does not support secure coding.",
+                                                         NSStringFromClass(cls)];
+      _error = SCTKAuthStateCodecError(description);
+    }
+    [self writeTag:SCTKAuthStateCodecTagNil];
+    return;
+  }
+  [self writeTag:SCTKAuthStateCodecTagObject];
+  [self writeString:NSStringFromClass(cls)];
+  [object encodeWithCoder:self];
+  [self writeTag:SCTKAuthStateCodecTagEnd];
+}
+
+#pragma mark - NSCoder
+
+- (void)encodeObject:(nullable id)object forKey:(NSString *)key {
+  if (!object) {
+    return;
+  }
+  [self writeString:key];
+  [self encodeValue:object];
+}
+
+- (void)encodeConditionalObject:(nullable id)object forKey:(NSString *)key {
+  [self encodeObject:object forKey:key];
+}
+
+- (void)encodeBool:(BOOL)value forKey:(NSString *)key {
+  [self writeString:key];
+  [self writeTag:value ? SCTKAuthStateCodecTagTrue : SCTKAuthStateCodecTagFalse];
+}
+
+- (void)encodeInt:(int)value forKey:(NSString *)key {
+  [self writeString:key];
+  [self writeInteger:value];
+}
+
+- (void)encodeInt32:(int32_t)value forKey:(NSString *)key {
+  [self writeString:key];
+  [self writeInteger:value];
+}
+
+- (void)encodeInt64:(int64_t)value forKey:(NSString *)key {
+  [self writeString:key];
+  [self writeInteger:value];
+}
+
+- (void)encodeInteger:(NSInteger)value forKey:(NSString *)key {
+  [self writeString:key];
+  [self writeInteger:value];
+}
+
+- (void)encodeFloat:(float)value forKey:(NSString *)key {
+  [self writeString:key];
+  [self writeDouble:value];
+}
+
+- (void)encodeDouble:(double)value forKey:(NSString *)key {
+  [self writeString:key];
+  [self writeDouble:value];
+}
+
+- (void)encodeBytes:(nullable const uint8_t *)bytes
+             length:(NSUInteger)length
+             forKey:(NSString *)key {
+  [self writeString:key];
+  [self writeTag:SCTKAuthStateCodecTagData];
+  [self writeVarint:length];
+  if (length > 0) {
+    [_data appendBytes:bytes length:length];
+  }
+}
+
+- (void)encodeValueOfObjCType:(const char *)type at:(const void *)addr {
+  [NSException raise:NSInvalidArchiveOperationException
+              format:@"SCTKAuthStateCodec only supports keyed coding."];
+}
+
+- (void)encodeDataObject:(NSData *)data {
+  [NSException raise:NSInvalidArchiveOperationException
+              format:@"SCTKAuthStateCodec only supports keyed coding."];
+}
+
+@end
+
+#pragma mark - Decoder
+
+/*! @brief The state of an @c SCTKAuthStateCodecRecord.
+ */
+typedef NS_ENUM(NSInteger, SCTKAuthStateCodecRecordState) {
+  /*! @brief The object has not been created yet.
+   */
+  SCTKAuthStateCodecRecordStatePending,
+
+  /*! @brief The object is being created.
+   */
+  SCTKAuthStateCodecRecordStateDecoding,
+
+  /*! @brief The object has been created, or could not be.
+   */
+  SCTKAuthStateCodecRecordStateDecoded,
+};
+
+/*! @brief An object read from the data but not created yet. Objects are created when they are
+        decoded, once the allowed classes are known.
+ */
+@interface SCTKAuthStateCodecRecord : NSObject
+
+/*! @brief The name of the object's class.
+ */
+@property(nonatomic, readonly) NSString *className;
+
+/*! @brief The object's fields, by key.
+ */
+@property(nonatomic, readonly) NSMutableDictionary<NSString *, id> *fields;
+
+/*! @brief Whether the object has been created.
+ */
+@property(nonatomic) SCTKAuthStateCodecRecordState state;
+
+/*! @brief The created object, if any.
+ */
+@property(nonatomic, nullable) id object;
+
+- (instancetype)initWithClassName:(NSString *)className;
+
+@end
+
+@implementation SCTKAuthStateCodecRecord
+
+- (instancetype)initWithClassName:(NSString *)className {
+  self = [super init];
+  if (self) {
+    _className = [className copy];
+    _fields = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+@end
+
+/*! @brief Reads an object graph written by @c SCTKAuthStateCodecEncoder.
+ */
+@interface SCTKAuthStateCodecDecoder : NSCoder
+
+/*! @brief Whether the data turned out to be invalid, or to contain a class that is not allowed.
+ */
+@property(nonatomic, readonly) BOOL failed;
+
+/*! @brief Creates a decoder for data whose header has already been checked.
+    @param data The data, including its header.
+ */
+- (instancetype)initWithData:(NSData *)data;
+
+/*! @brief Reads and creates the root object.
+    @param cls The allowed class of the root object.
+ */
+- (nullable id)decodeRootObjectOfClass:(Class)cls;
+
+@end
+
+@implementation SCTKAuthStateCodecDecoder {
+  /*! @brief The data being read, which owns the bytes between @c _cursor and @c _end.
+   */
+  NSData *_data;
+
+  /*! @brief The next byte to read.
+   */
+  const uint8_t *_cursor;
+
+  /*! @brief The end of the data.
+   */
+  const uint8_t *_end;
+
+  /*! @brief The strings read so far, in order.
+   */
+  NSMutableArray<NSString *> *_strings;
+
+  /*! @brief The errors, discovery documents and records read so far, in order.
+   */
+  NSMutableArray *_objects;
+
+  /*! @brief The current nesting depth of values.
+   */
+  NSUInteger _depth;
+
+  /*! @brief Greater than zero while reading values that must not contain objects, such as
+          dictionary keys and error user info.
+   */
+  NSUInteger _valueOnlyDepth;
+
+  /*! @brief The fields of the object whose @c initWithCoder: is running.
+   */
+  NSDictionary<NSString *, id> *_Nullable _fields;
+}
+
+- (instancetype)initWithData:(NSData *)data {
+  self = [super init];
+  if (self) {
+    _data = data;
+    _cursor = (const uint8_t *)data.bytes + kHeaderLength;
+    _end = (const uint8_t *)data.bytes + data.length;
+    _strings = [NSMutableArray array];
+    _objects = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (BOOL)allowsKeyedCoding {
+  return YES;
+}
+
+- (BOOL)requiresSecureCoding {
+  return YES;
+}
+
+- (nullable id)decodeRootObjectOfClass:(Class)cls {
+  id value = [self readValue];
+  if (_cursor != _end) {
+    _failed = YES;
+  }
+  if (_failed) {
+    return nil;
+  }
+  id object = [self resolveValue:value allowedClasses:[NSSet setWithObject:cls]];
+  return _failed ? nil : object;
+}
+
+#pragma mark - Reading
+
+- (BOOL)readVarint:(uint64_t *)value {
+  uint64_t result = 0;
+  for (unsigned shift = 0; shift < 64 && _cursor < _end; shift += 7) {
+    uint8_t byte = *_cursor++;
+    result |= (uint64_t)(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return YES;
+    }
+  }
+  _failed = YES;
+  return NO;
+}
+
+/*! @brief Reads a length or count, and checks that at least that many bytes remain.
+ */
+- (BOOL)readLength:(NSUInteger *)length {
+  uint64_t value;
+  if (![self readVarint:&value] || value > (uint64_t)(_end - _cursor)) {
+    _failed = YES;
+    return NO;
+  }
+  *length = (NSUInteger)value;
+  return YES;
+}
+
+- (BOOL)readDouble:(double *)value {
+  CFSwappedFloat64 swapped;
+  if ((size_t)(_end - _cursor) < sizeof(swapped)) {
+    _failed = YES;
+    return NO;
+  }
+  memcpy(&swapped, _cursor, sizeof(swapped));
+  _cursor += sizeof(swapped);
+  *value = CFConvertDoubleSwappedToHost(swapped);
+  return YES;
+}
+
+/*! @brief Reads a value of a given class.
+    @return The value, or nil if it is missing or of another class.
+ */
+- (nullable id)readValueOfClass:(Class)cls {
+  id value = [self readValue];
+  if (![value isKindOfClass:cls]) {
+    _failed = YES;
+    return nil;
+  }
+  return value;
+}
+
+/*! @brief Reserves the next object index, so that references made while reading an object's
+        contents are numbered the same way as when it was written.
+ */
+- (NSUInteger)reserveObjectIndex {
+  [_objects addObject:[NSNull null]];
+  return _objects.count - 1;
+}
+
+/*! @brief Reads the next value. Objects are returned as @c SCTKAuthStateCodecRecord.
+    @return The value, or nil if there is none or the data is invalid.
+ */
+- (nullable id)readValue {
+  if (_failed || _cursor >= _end || _depth >= kMaximumDepth) {
+    _failed = YES;
+    return nil;
+  }
+  SCTKAuthStateCodecTag tag = *_cursor++;
+  switch (tag) {
+    case SCTKAuthStateCodecTagNil:
+      return nil;
+    case SCTKAuthStateCodecTagTrue:
+      return @YES;
+    case SCTKAuthStateCodecTagFalse:
+      return @NO;
+    case SCTKAuthStateCodecTagInteger: {
+      uint64_t zigzag;
+      if (![self readVarint:&zigzag]) {
+        return nil;
+      }
+      return @((int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1));
+    }
+    case SCTKAuthStateCodecTagDouble: {
+      double value;
+      return [self readDouble:&value] ? @(value) : nil;
+    }
+    case SCTKAuthStateCodecTagString: {
+      NSUInteger length;
+      if (![self readLength:&length]) {
+        return nil;
+      }
+      NSString *string = [[NSString alloc] initWithBytes:_cursor
+                                                  length:length
+                                                encoding:NSUTF8StringEncoding];
+      _cursor += length;
+      if (!string) {
+        _failed = YES;
+        return nil;
+      }
+      [_strings addObject:string];
+      return string;
+    }
+    case SCTKAuthStateCodecTagStringReference: {
+      uint64_t index;
+      if (![self readVarint:&index] || index >= _strings.count) {
+        _failed = YES;
+        return nil;
+      }
+      return _strings[(NSUInteger)index];
+    }
+    case SCTKAuthStateCodecTagData: {
+      NSUInteger length;
+      if (![self readLength:&length]) {
+        return nil;
+      }
+      NSData *data = [NSData dataWithBytes:_cursor length:length];
+      _cursor += length;
+      return data;
+    }
+    case SCTKAuthStateCodecTagDate: {
+      double value;
+      if (![self readDouble:&value]) {
+        return nil;
+      }
+      return [NSDate dateWithTimeIntervalSinceReferenceDate:value];
+    }
+    case SCTKAuthStateCodecTagURL: {
+      NSString *string = [self readValueOfClass:[NSString class]];
+      NSURL *URL = string ? [NSURL URLWithString:string] : nil;
+      if (!URL) {
+        _failed = YES;
+      }
+      return URL;
+    }
+    case SCTKAuthStateCodecTagArray:
+    case SCTKAuthStateCodecTagSet: {
+      NSUInteger count;
+      if (![self readLength:&count]) {
+        return nil;
+      }
+      NSMutableArray *elements = [NSMutableArray arrayWithCapacity:count];
+      _depth++;
+      for (NSUInteger i = 0; i < count; i++) {
+        id element = [self readValue];
+        if (!element) {
+          _failed = YES;
+          return nil;
+        }
+        [elements addObject:element];
+      }
+      _depth--;
+      if (tag == SCTKAuthStateCodecTagSet) {
+        return [NSSet setWithArray:elements];
+      }
+      return [elements copy];
+    }
+    case SCTKAuthStateCodecTagDictionary: {
+      NSUInteger count;
+      if (![self readLength:&count]) {
+        return nil;
+      }
+      NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:count];
+      _depth++;
+      for (NSUInteger i = 0; i < count; i++) {
+        _valueOnlyDepth++;
+        id key = [self readValue];
+        _valueOnlyDepth--;
+        id object = [self readValue];
+        if (!key || !object) {
+          _failed = YES;
+          return nil;
+        }
+        dictionary[key] = object;
+      }
+      _depth--;
+      return [dictionary copy];
+    }
+    case SCTKAuthStateCodecTagNull:
+      return [NSNull null];
+    case SCTKAuthStateCodecTagError: {
+      NSUInteger index = [self reserveObjectIndex];
+      _depth++;
+      _valueOnlyDepth++;
+      NSString *domain = [self readValueOfClass:[NSString class]];
+      NSNumber *code = [self readValueOfClass:[NSNumber class]];
+      NSDictionary *userInfo = [self readValueOfClass:[NSDictionary class]];
+      _valueOnlyDepth--;
+      _depth--;
+      if (_failed) {
+        return nil;
+      }
+      NSError *error = [NSError errorWithDomain:domain
+                                           code:code.integerValue
+                                       userInfo:userInfo.count ? userInfo : nil];
+      _objects[index] = error;
+      return error;
+    }
+    case SCTKAuthStateCodecTagDiscovery: {
+      NSUInteger index = [self reserveObjectIndex];
+      _depth++;
+      _valueOnlyDepth++;
+      NSDictionary *dictionary = [self readValueOfClass:[NSDictionary class]];
+      _valueOnlyDepth--;
+      _depth--;
+      SCTKServiceDiscovery *discovery =
+          dictionary ? [[SCTKServiceDiscovery alloc] initWithDictionary:dictionary error:NULL]
+                     : nil;
+      if (!discovery) {
+        _failed = YES;
+        return nil;
+      }
+      _objects[index] = discovery;
+      return discovery;
+    }
+    case SCTKAuthStateCodecTagObject: {
+      if (_valueOnlyDepth > 0) {
+        _failed = YES;
+        return nil;
+      }
+      NSUInteger index = [self reserveObjectIndex];
+      NSString *className = [self readValueOfClass:[NSString class]];
+      if (!className) {
+        return nil;
+      }
+      SCTKAuthStateCodecRecord *record =
+          [[SCTKAuthStateCodecRecord alloc] initWithClassName:className];
+      _objects[index] = record;
+      _depth++;
+      while (!_failed) {
+        if (_cursor < _end && *_cursor == SCTKAuthStateCodecTagEnd) {
+          _cursor++;
+          break;
+        }
+        _valueOnlyDepth++;
+        NSString *key = [self readValueOfClass:[NSString class]];
+        _valueOnlyDepth--;
+        id value = [self readValue];
+        if (!key || !value) {
+          _failed = YES;
+          return nil;
+        }
+        record.fields[key] = value;
+      }
+      _depth--;
+      return _failed ? nil : record;
+    }
+    case SCTKAuthStateCodecTagObjectReference: {
+      uint64_t index;
+      if (![self readVarint:&index] || index >= _objects.count) {
+        _failed = YES;
+        return nil;
+      }
+      id object = _objects[(NSUInteger)index];
+      // a reference to an object that is still being read is a cycle, which is not supported
+      if (object == [NSNull null]
+          || (_valueOnlyDepth > 0 && [object isKindOfClass:[SCTKAuthStateCodecRecord class]])) {
+        _failed = YES;
+        return nil;
+      }
+      return object;
+    }
+    case SCTKAuthStateCodecTagEnd:
+      break;
+  }
+  _failed = YES;
+  return nil;
+}
+
+#pragma mark - Resolving
+
+/*! @brief Returns whether a value is of one of the allowed classes.
+    @param value The value.
+    @param classes The allowed classes, or nil to allow any class.
+ */
+- (BOOL)isValue:(id)value ofAllowedClasses:(nullable NSSet<Class> *)classes {
+  if (!classes) {
+    return YES;
+  }
+  for (Class cls in classes) {
+    if ([value isKindOfClass:cls]) {
+      return YES;
+    }
+  }
+  return NO;
+}
+
+/*! @brief Checks a value read from the data against the allowed classes, creating any objects it
+        holds.
+    @param value The value read from the data.
+    @param classes The allowed classes, or nil to allow any value but no @c NSSecureCoding object.
+    @return The value with its objects created, or nil if it holds a class that is not allowed.
+ */
+- (nullable id)resolveValue:(nullable id)value allowedClasses:(nullable NSSet<Class> *)classes {
+  if (!value) {
+    return nil;
+  }
+  if ([value isKindOfClass:[SCTKAuthStateCodecRecord class]]) {
+    return [self objectForRecord:value allowedClasses:classes];
+  }
+  if (![self isValue:value ofAllowedClasses:classes]) {
+    _failed = YES;
+    return nil;
+  }
+
+  if ([value isKindOfClass:[NSArray class]]) {
+    NSArray *array = value;
+    NSMutableArray *resolvedArray;
+    for (NSUInteger i = 0; i < array.count; i++) {
+      id element = array[i];
+      id resolvedElement = [self resolveValue:element allowedClasses:classes];
+      if (!resolvedElement) {
+        return nil;
+      }
+      if (resolvedElement != element) {
+        resolvedArray = resolvedArray ?: [array mutableCopy];
+        resolvedArray[i] = resolvedElement;
+      }
+    }
+    return resolvedArray ? [resolvedArray copy] : array;
+  }
+
+  if ([value isKindOfClass:[NSDictionary class]]) {
+    NSDictionary *dictionary = value;
+    __block NSMutableDictionary *resolvedDictionary;
+    __block BOOL failed = NO;
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+      id resolvedObject = [self resolveValue:object allowedClasses:classes];
+      if (!resolvedObject || ![self isValue:key ofAllowedClasses:classes]) {
+        failed = YES;
+        *stop = YES;
+        return;
+      }
+      if (resolvedObject != object) {
+        resolvedDictionary = resolvedDictionary ?: [dictionary mutableCopy];
+        resolvedDictionary[key] = resolvedObject;
+      }
+    }];
+    if (failed) {
+      _failed = YES;
+      return nil;
+    }
+    return resolvedDictionary ? [resolvedDictionary copy] : dictionary;
+  }
+
+  if ([value isKindOfClass:[NSSet class]]) {
+    NSSet *set = value;
+    NSMutableSet *resolvedSet = [NSMutableSet setWithCapacity:set.count];
+    BOOL changed = NO;
+    for (id element in set) {
+      id resolvedElement = [self resolveValue:element allowedClasses:classes];
+      if (!resolvedElement) {
+        return nil;
+      }
+      changed = changed || resolvedElement != element;
+      [resolvedSet addObject:resolvedElement];
+    }
+    return changed ? [resolvedSet copy] : set;
+  }
+
+  return value;
+}
+
+/*! @brief Creates the object of a record, or returns it if it was created before.
+    @param record The record.
+    @param classes The allowed classes.
+    @return The object, or nil if its class is not allowed or it could not be created.
+ */
+- (nullable id)objectForRecord:(SCTKAuthStateCodecRecord *)record
+                allowedClasses:(nullable NSSet<Class> *)classes {
+  switch (record.state) {
+    case SCTKAuthStateCodecRecordStateDecoded:
+      if (record.object && ![self isValue:record.object ofAllowedClasses:classes]) {
+        _failed = YES;
+        return nil;
+      }
+      return record.object;
+    case SCTKAuthStateCodecRecordStateDecoding:
+      _failed = YES;
+      return nil;
+    case SCTKAuthStateCodecRecordStatePending:
+      break;
+  }
+
+  Class cls = NSClassFromString(record.className);
+  BOOL allowed = NO;
+  for (Class allowedClass in classes) {
+    if ([cls isSubclassOfClass:allowedClass]) {
+      allowed = YES;
+      break;
+    }
+  }
+  if (!allowed || ![cls conformsToProtocol:@protocol(NSSecureCoding)]
+      || ![cls supportsSecureCoding]) {
+    _failed = YES;
+    return nil;
+  }
+
+  record.state = SCTKAuthStateCodecRecordStateDecoding;
+  NSDictionary<NSString *, id> *fields = _fields;
+  _fields = record.fields;
+  id object = [[cls alloc] initWithCoder:self];
+  object = [object awakeAfterUsingCoder:self];
+  _fields = fields;
+  record.object = object;
+  record.state = SCTKAuthStateCodecRecordStateDecoded;
+  return object;
+}
+
+#pragma mark - NSCoder
+
+- (BOOL)containsValueForKey:(NSString *)key {
+  return _fields[key] != nil;
+}
+
+- (nullable id)decodeObjectForKey:(NSString *)key {
+  return [self resolveValue:_fields[key] allowedClasses:nil];
+}
+
+- (nullable id)decodeObjectOfClass:(Class)aClass forKey:(NSString *)key {
+  return [self resolveValue:_fields[key] allowedClasses:[NSSet setWithObject:aClass]];
+}
+
+- (nullable id)decodeObjectOfClasses:(nullable NSSet<Class> *)classes forKey:(NSString *)key {
+  return [self resolveValue:_fields[key] allowedClasses:classes ?: [NSSet set]];
+}
+
+/*! @brief Returns the number stored for a key, or nil if there is none.
+ */
+- (nullable NSNumber *)numberForKey:(NSString *)key {
+  id value = _fields[key];
+  return [value isKindOfClass:[NSNumber class]] ? value : nil;
+}
+
+- (BOOL)decodeBoolForKey:(NSString *)key {
+  return [self numberForKey:key].boolValue;
+}
+
+- (int)decodeIntForKey:(NSString *)key {
+  return [self numberForKey:key].intValue;
+}
+
+- (int32_t)decodeInt32ForKey:(NSString *)key {
+  return [self numberForKey:key].intValue;
+}
+
+- (int64_t)decodeInt64ForKey:(NSString *)key {
+  return [self numberForKey:key].longLongValue;
+}
+
+- (NSInteger)decodeIntegerForKey:(NSString *)key {
+  return [self numberForKey:key].integerValue;
+}
+
+- (float)decodeFloatForKey:(NSString *)key {
+  return [self numberForKey:key].floatValue;
+}
+
+- (double)decodeDoubleForKey:(NSString *)key {
+  return [self numberForKey:key].doubleValue;
+}
+
+- (nullable const uint8_t *)decodeBytesForKey:(NSString *)key
+                               returnedLength:(nullable NSUInteger *)length {
+  id value = _fields[key];
+  NSData *data = [value isKindOfClass:[NSData class]] ? value : nil;
+  if (length) {
+    *length = data.length;
+  }
+  return data.bytes;
+}
+
+- (void)decodeValueOfObjCType:(const char *)type at:(void *)data size:(NSUInteger)size {
+  [NSException raise:NSInvalidUnarchiveOperationException
+              format:@"SCTKAuthStateCodec only supports keyed coding."];
+}
+
+- (nullable NSData *)decodeDataObject {
+  [NSException raise:NSInvalidUnarchiveOperationException
+              format:@"SCTKAuthStateCodec only supports keyed coding."];
+  return nil;
+}
+
+@end
+
+#pragma mark - SCTKAuthStateCodec
+
+@implementation SCTKAuthStateCodec
+
++ (nullable NSData *)dataWithRootObject:(id<NSSecureCoding>)rootObject
+                                  error:(NSError **_Nullable)error {
+  SCTKAuthStateCodecEncoder *encoder = [[SCTKAuthStateCodecEncoder alloc] init];
+  [encoder encodeValue:rootObject];
+  if (encoder.error) {
+    if (error) {
+      *error = encoder.error;
+    }
+    return nil;
+  }
+  return encoder.data;
+}
+
++ (nullable id)objectOfClass:(Class)cls
+                    fromData:(NSData *)data
+                       error:(NSError **_Nullable)error {
+  if ([self isKeyedArchiveData:data]) {
+    return [self objectOfClass:cls fromKeyedArchive:data error:error];
+  }
+
+  NSError *codecError;
+  id object;
+  if (![self isCodecData:data]) {
+    codecError = SCTKAuthStateCodecError(@"The data is not in a recognized format.");
+  } else if (((const uint8_t *)data.bytes)[sizeof(kMagic)] > SCTKAuthStateCodecFormatVersion) {
+    codecError = SCTKAuthStateCodecError(@"The data has an unsupported format version.");
+  } else {
+    SCTKAuthStateCodecDecoder *decoder = [[SCTKAuthStateCodecDecoder alloc] initWithData:data];
+    object = [decoder decodeRootObjectOfClass:cls];
+    if (!object) {
+      codecError = SCTKAuthStateCodecError(@"The data is invalid.");
+    }
+  }
+  if (codecError && error) {
+    *error = codecError;
+  }
+  return object;
+}
+
+/*! @brief Decodes a keyed archive.
+    @param cls The expected class of the root object.
+    @param data The keyed archive.
+    @param error The error that occurred, if any.
+ */
++ (nullable id)objectOfClass:(Class)cls
+            fromKeyedArchive:(NSData *)data
+                       error:(NSError **_Nullable)error {
+  id object;
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    object = [NSKeyedUnarchiver unarchivedObjectOfClass:cls fromData:data error:error];
+  } else {
+#if !TARGET_OS_IOS
+    object = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+#endif
+  }
+  if (![object isKindOfClass:cls]) {
+    if (object && error) {
+      *error = SCTKAuthStateCodecError(@"The archived object is of an unexpected class.");
+    }
+    return nil;
+  }
+  return object;
+}
+
++ (BOOL)isCodecData:(NSData *)data {
+  return data.length >= kHeaderLength && memcmp(data.bytes, kMagic, sizeof(kMagic)) == 0;
+}
+
++ (BOOL)isKeyedArchiveData:(NSData *)data {
+  return data.length >= sizeof(kKeyedArchiveMagic)
+      && memcmp(data.bytes, kKeyedArchiveMagic, sizeof(kKeyedArchiveMagic)) == 0;
+}
+
++ (nullable NSData *)migratedDataWithData:(NSData *)data
+                                  ofClass:(Class)cls
+                                    error:(NSError **_Nullable)error {
+  if ([self isCodecData:data]) {
+    return data;
+  }
+  id object = [self objectOfClass:cls fromData:data error:error];
+  if (!object) {
+    return nil;
+  }
+  return [self dataWithRootObject:object error:error];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,110 @@
+/*! @file SCTKAuthStateJournalStore.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "SCTKAuthStateStore.h"
+
+@class SCTKAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The default interval after which appended journal records are synced to disk.
+ */
+extern const NSTimeInterval SCTKAuthStateJournalStoreDefaultSyncInterval;
+
+/*! @brief Persists the auth states of many accounts in a single append-only journal file.
+    @discussion Each change is appended to the journal as a checksummed record, instead of rewriting
+        the whole state. @c storeAuthState:forAccountID: appends the full state, serialized with
+        @c SCTKAuthStateCodec. @c recordTokenUpdateForAuthState:accountID: appends only the token
+        material, usually a few hundred bytes, when nothing else about the state changed. Call it
+        from @c SCTKAuthStateChangeDelegate.didChangeState:.
+
+        Appended records are synced to disk in batches, at most @c syncInterval after they were
+        written. A record that rotates an account's refresh token is synced before the call that
+        appended it returns, since losing it could leave the account with a revoked refresh token.
+
+        The journal is compacted in the background once superseded records take up more than half
+        of it. Compaction writes the latest records of each account to a new file, then atomically
+        replaces the journal. When the journal is opened, an incomplete or corrupt record at its
+        end, left by a crash while appending, is discarded along with anything after it.
+
+        Instances can be used as the @c SCTKAuthStateStore.backingStore. Methods may be called from
+        any thread. A journal file must not be opened by more than one instance at a time.
+ */
+@interface SCTKAuthStateJournalStore : NSObject <SCTKAuthStateBackingStore>
+
+/*! @brief The journal file.
+ */
+@property(nonatomic, readonly) NSURL *fileURL;
+
+/*! @brief The maximum time appended records may wait before being synced to disk.
+ */
+@property(nonatomic, readonly) NSTimeInterval syncInterval;
+
+/*! @brief The current length of the journal file, in bytes.
+ */
+@property(nonatomic, readonly) unsigned long long fileLength;
+
+/*! @brief The identifiers of the stored accounts.
+ */
+@property(nonatomic, readonly) NSArray<NSString *> *accountIDs;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithFileURL:error:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Opens a journal, syncing appended records every
+        @c ::SCTKAuthStateJournalStoreDefaultSyncInterval seconds.
+    @param fileURL The journal file, which is created if it does not exist.
+    @param error The error that occurred, if any.
+ */
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL error:(NSError **_Nullable)error;
+
+/*! @brief Designated initializer. Opens a journal and recovers the state it records.
+    @param fileURL The journal file, which is created if it does not exist.
+    @param syncInterval The maximum time appended records may wait before being synced to disk.
+    @param error The error that occurred, if any.
+    @return The store, or nil if the file could not be opened or is not a journal.
+ */
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL
+                            syncInterval:(NSTimeInterval)syncInterval
+                                   error:(NSError **_Nullable)error NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Records the current tokens of an auth state.
+    @param authState The auth state whose tokens changed.
+    @param accountID The account identifier.
+    @discussion Appends only the token material if @c authState is the instance last stored or
+        loaded for @c accountID, and only its tokens changed since. Otherwise appends the full
+        state, as @c storeAuthState:forAccountID: does. Does nothing if the tokens are unchanged.
+ */
+- (void)recordTokenUpdateForAuthState:(SCTKAuthState *)authState accountID:(NSString *)accountID;
+
+/*! @brief Syncs every appended record to disk before returning.
+ */
+- (void)synchronize;
+
+/*! @brief Compacts the journal in the background, regardless of how much of it is superseded.
+    @param completion Called on the main queue once compaction finished, with whether it succeeded.
+ */
+- (void)compactWithCompletion:(nullable void (^)(BOOL succeeded))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
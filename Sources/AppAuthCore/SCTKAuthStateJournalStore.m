@@ -0,0 +1,837 @@
+/*! @file SCTKAuthStateJournalStore.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthStateJournalStore.h"
+
+#import <errno.h>
+#import <fcntl.h>
+#import <libkern/OSByteOrder.h>
+#import <unistd.h>
+
+#import "SCTKAuthState.h"
+#import "SCTKAuthStateCodec.h"
+#import "SCTKDefines.h"
+#import "SCTKError.h"
+#import "SCTKErrorUtilities.h"
+#import "SCTKTokenResponse.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+const NSTimeInterval SCTKAuthStateJournalStoreDefaultSyncInterval = 1;
+
+/*! @brief Identifies a journal file. Followed by the format version and three reserved bytes.
+ */
+static const uint8_t kFileMagic[4] = {'S', 'C', 'J', 'L'};
+
+/*! @brief The version of the journal format.
+ */
+static const uint8_t kFileVersion = 1;
+
+/*! @brief The length of the file header.
+ */
+static const size_t kFileHeaderLength = 8;
+
+/*! @brief The journal is not compacted while it is shorter than this many bytes.
+ */
+static const unsigned long long kMinimumCompactionLength = 64 * 1024;
+
+/*! @brief Suffix of the file compaction writes before it replaces the journal.
+ */
+static NSString *const kCompactionFileSuffix = @".compact";
+
+/*! @brief The header of each record, stored little-endian. Followed by @c length bytes of payload:
+        an @c NSDictionary serialized with @c SCTKAuthStateCodec.
+ */
+typedef struct {
+  uint32_t length;
+  uint32_t checksum;
+} SCTKAuthStateJournalRecordHeader;
+
+/*! @brief The kinds of records.
+ */
+typedef NS_ENUM(NSInteger, SCTKAuthStateJournalRecordType) {
+  /*! @brief The full state of an account, replacing anything recorded before.
+   */
+  SCTKAuthStateJournalRecordTypeState = 1,
+
+  /*! @brief The current tokens of an account, replacing any previous token update.
+   */
+  SCTKAuthStateJournalRecordTypeTokenUpdate = 2,
+
+  /*! @brief The removal of an account.
+   */
+  SCTKAuthStateJournalRecordTypeRemoval = 3,
+};
+
+/*! @brief Record key of the @c SCTKAuthStateJournalRecordType.
+ */
+static NSString *const kTypeKey = @"t";
+
+/*! @brief Record key of the account identifier.
+ */
+static NSString *const kAccountIDKey = @"a";
+
+/*! @brief State record key of the auth state serialized with @c SCTKAuthStateCodec.
+ */
+static NSString *const kStateDataKey = @"s";
+
+/*! @brief State record key of whether the auth state has a token response.
+ */
+static NSString *const kHasTokenResponseKey = @"h";
+
+/*! @brief Record key of the auth state's refresh token.
+ */
+static NSString *const kRefreshTokenKey = @"r";
+
+/*! @brief Token update key of the access token.
+ */
+static NSString *const kAccessTokenKey = @"k";
+
+/*! @brief Token update key of the access token expiration date.
+ */
+static NSString *const kAccessTokenExpirationDateKey = @"e";
+
+/*! @brief Token update key of the ID token.
+ */
+static NSString *const kIDTokenKey = @"i";
+
+/*! @brief Token update key of the token type.
+ */
+static NSString *const kTokenTypeKey = @"y";
+
+/*! @brief Token update key of the auth state's scope.
+ */
+static NSString *const kScopeKey = @"p";
+
+/*! @brief Token update key of the date the token response was obtained.
+ */
+static NSString *const kTokenResponseDateKey = @"d";
+
+/*! @brief Restores the date a replayed token response was obtained, which orders it against token
+        responses shared by other processes.
+ */
+@interface SCTKAuthState (SCTKAuthStateJournalStore)
+
+- (void)updateWithTokenResponse:(SCTKTokenResponse *)tokenResponse
+                   obtainedDate:(nullable NSDate *)obtainedDate;
+
+@end
+
+/*! @brief Returns the CRC-32 (IEEE 802.3) of a buffer.
+ */
+static uint32_t SCTKAuthStateJournalChecksum(const uint8_t *bytes, size_t length) {
+  static uint32_t table[256];
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t value = i;
+      for (int bit = 0; bit < 8; bit++) {
+        value = (value & 1) ? 0xEDB88320 ^ (value >> 1) : value >> 1;
+      }
+      table[i] = value;
+    }
+  });
+  uint32_t checksum = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    checksum = table[(checksum ^ bytes[i]) & 0xFF] ^ (checksum >> 8);
+  }
+  return checksum ^ 0xFFFFFFFF;
+}
+
+/*! @brief Writes a whole buffer to a file descriptor, retrying short writes.
+    @return YES if every byte was written.
+ */
+static BOOL SCTKAuthStateJournalWrite(int fileDescriptor, const void *bytes, size_t length) {
+  const uint8_t *cursor = bytes;
+  while (length > 0) {
+    ssize_t written = write(fileDescriptor, cursor, length);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return NO;
+    }
+    cursor += written;
+    length -= (size_t)written;
+  }
+  return YES;
+}
+
+/*! @brief Flushes a file to permanent storage, not just to the drive's cache where available.
+    @return YES if the file was flushed.
+ */
+static BOOL SCTKAuthStateJournalSync(int fileDescriptor) {
+#ifdef F_FULLFSYNC
+  if (fcntl(fileDescriptor, F_FULLFSYNC) == 0) {
+    return YES;
+  }
+#endif
+  return fsync(fileDescriptor) == 0;
+}
+
+/*! @brief Appends the framed form of a record payload to a buffer.
+ */
+static void SCTKAuthStateJournalAppendRecord(NSMutableData *buffer, NSData *payload) {
+  SCTKAuthStateJournalRecordHeader header;
+  header.length = OSSwapHostToLittleInt32((uint32_t)payload.length);
+  header.checksum =
+      OSSwapHostToLittleInt32(SCTKAuthStateJournalChecksum(payload.bytes, payload.length));
+  [buffer appendBytes:&header length:sizeof(header)];
+  [buffer appendData:payload];
+}
+
+/*! @brief What the journal records about one account.
+ */
+@interface SCTKAuthStateJournalEntry : NSObject
+
+/*! @brief The payload of the account's latest state record.
+ */
+@property(nonatomic) NSData *stateRecord;
+
+/*! @brief The auth state serialized with @c SCTKAuthStateCodec.
+ */
+@property(nonatomic) NSData *stateData;
+
+/*! @brief Whether the stored auth state has a token response, which token updates build on.
+ */
+@property(nonatomic) BOOL hasTokenResponse;
+
+/*! @brief The payload of the account's latest token update record, if any since its state record.
+ */
+@property(nonatomic, nullable) NSData *tokenUpdateRecord;
+
+/*! @brief The latest token update record, if any since the state record.
+ */
+@property(nonatomic, nullable) NSDictionary<NSString *, id> *tokenUpdate;
+
+/*! @brief The latest recorded access token.
+ */
+@property(nonatomic, nullable) NSString *accessToken;
+
+/*! @brief The latest recorded refresh token.
+ */
+@property(nonatomic, nullable) NSString *refreshToken;
+
+/*! @brief The auth state instance last stored or loaded for the account.
+ */
+@property(nonatomic, weak, nullable) SCTKAuthState *authState;
+
+/*! @brief The authorization response of @c authState when it was last stored or loaded.
+ */
+@property(nonatomic, weak, nullable) id lastAuthorizationResponse;
+
+/*! @brief The registration response of @c authState when it was last stored or loaded.
+ */
+@property(nonatomic, weak, nullable) id lastRegistrationResponse;
+
+/*! @brief The number of bytes the entry's records take up in the journal.
+ */
+@property(nonatomic, readonly) unsigned long long recordLength;
+
+@end
+
+@implementation SCTKAuthStateJournalEntry
+
+- (unsigned long long)recordLength {
+  unsigned long long length = sizeof(SCTKAuthStateJournalRecordHeader) + _stateRecord.length;
+  if (_tokenUpdateRecord) {
+    length += sizeof(SCTKAuthStateJournalRecordHeader) + _tokenUpdateRecord.length;
+  }
+  return length;
+}
+
+/*! @brief Remembers which auth state instance matches what the journal records.
+ */
+- (void)trackAuthState:(SCTKAuthState *)authState {
+  _authState = authState;
+  _lastAuthorizationResponse = authState.lastAuthorizationResponse;
+  _lastRegistrationResponse = authState.lastRegistrationResponse;
+}
+
+@end
+
+@implementation SCTKAuthStateJournalStore {
+  /*! @brief Serial queue that guards all other instance variables.
+   */
+  dispatch_queue_t _queue;
+
+  /*! @brief The open journal file, or -1 once closed.
+   */
+  int _fileDescriptor;
+
+  /*! @brief The accounts' entries, by account identifier.
+   */
+  NSMutableDictionary<NSString *, SCTKAuthStateJournalEntry *> *_entries;
+
+  /*! @brief The number of journal bytes taken up by the latest records of each account.
+   */
+  unsigned long long _liveLength;
+
+  /*! @brief Whether records were appended since the journal was last synced.
+   */
+  BOOL _dirty;
+
+  /*! @brief Whether a batched sync is scheduled.
+   */
+  BOOL _syncScheduled;
+
+  /*! @brief Payloads appended while a compaction is running, which must be copied to the compacted
+          journal before it replaces the current one. Nil when no compaction is running.
+   */
+  NSMutableArray<NSData *> *_Nullable _compactionTail;
+
+  /*! @brief Completion handlers of the running compaction.
+   */
+  NSMutableArray<void (^)(BOOL)> *_compactionCompletions;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithFileURL:error:))
+
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL error:(NSError **_Nullable)error {
+  return [self initWithFileURL:fileURL
+                  syncInterval:SCTKAuthStateJournalStoreDefaultSyncInterval
+                         error:error];
+}
+
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL
+                            syncInterval:(NSTimeInterval)syncInterval
+                                   error:(NSError **_Nullable)error {
+  self = [super init];
+  if (self) {
+    _fileURL = [fileURL copy];
+    _syncInterval = syncInterval;
+    _queue = dispatch_queue_create("org.openid.appauth.journalstore", DISPATCH_QUEUE_SERIAL);
+    _entries = [NSMutableDictionary dictionary];
+    _compactionCompletions = [NSMutableArray array];
+    _fileDescriptor = open(fileURL.fileSystemRepresentation, O_RDWR | O_CREAT | O_APPEND, 0600);
+    if (_fileDescriptor < 0) {
+      if (error) {
+        *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+      }
+      return nil;
+    }
+    // a compaction interrupted by a crash never replaced the journal, so its output is discarded
+    NSString *compactionPath = [fileURL.path stringByAppendingString:kCompactionFileSuffix];
+    unlink(compactionPath.fileSystemRepresentation);
+    if (![self recoverWithError:error]) {
+      return nil;
+    }
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_fileDescriptor >= 0) {
+    if (_dirty) {
+      SCTKAuthStateJournalSync(_fileDescriptor);
+    }
+    close(_fileDescriptor);
+  }
+}
+
+#pragma mark - Recovery
+
+/*! @brief Reads the journal, rebuilding the entries, and truncates any incomplete or corrupt
+        record at its end.
+    @param error The error that occurred, if any.
+    @return YES if the journal could be read.
+ */
+- (BOOL)recoverWithError:(NSError **_Nullable)error {
+  NSError *readError;
+  NSData *contents = [NSData dataWithContentsOfURL:_fileURL
+                                           options:NSDataReadingMappedIfSafe
+                                             error:&readError];
+  if (!contents) {
+    if (error) {
+      *error = readError;
+    }
+    return NO;
+  }
+
+  if (contents.length < kFileHeaderLength) {
+    // new, or created by a crash before its header was written
+    uint8_t header[kFileHeaderLength] = {0};
+    memcpy(header, kFileMagic, sizeof(kFileMagic));
+    header[sizeof(kFileMagic)] = kFileVersion;
+    if (ftruncate(_fileDescriptor, 0) != 0
+        || !SCTKAuthStateJournalWrite(_fileDescriptor, header, sizeof(header))
+        || !SCTKAuthStateJournalSync(_fileDescriptor)) {
+      if (error) {
+        *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+      }
+      return NO;
+    }
+    _fileLength = kFileHeaderLength;
+    return YES;
+  }
+
+  const uint8_t *bytes = contents.bytes;
+  if (memcmp(bytes, kFileMagic, sizeof(kFileMagic)) != 0
+      || bytes[sizeof(kFileMagic)] > kFileVersion) {
+    if (error) {
+      NSString *description = @"The file is not a supported auth state journal.";
+      *error = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeArchiveError
+                                 underlyingError:nil
+                                     description:description];
+    }
+    return NO;
+  }
+
+  size_t offset = kFileHeaderLength;
+  size_t length = contents.length;
+  while (length - offset >= sizeof(SCTKAuthStateJournalRecordHeader)) {
+    SCTKAuthStateJournalRecordHeader header;
+    memcpy(&header, bytes + offset, sizeof(header));
+    size_t payloadOffset = offset + sizeof(header);
+    size_t payloadLength = OSSwapLittleToHostInt32(header.length);
+    if (payloadLength > length - payloadOffset
+        || SCTKAuthStateJournalChecksum(bytes + payloadOffset, payloadLength)
+               != OSSwapLittleToHostInt32(header.checksum)) {
+      break;
+    }
+    NSData *payload = [NSData dataWithBytes:bytes + payloadOffset length:payloadLength];
+    NSError *decodeError;
+    NSDictionary *record = [SCTKAuthStateCodec objectOfClass:[NSDictionary class]
+                                                    fromData:payload
+                                                       error:&decodeError];
+    if (!record) {
+      // a complete record that cannot be read is not a torn write: truncating here would drop
+      // every later record, so the file is left as it is
+      if (error) {
+        NSString *description =
+            [NSString stringWithFormat:@"The journal record at offset %zu cannot be read.", offset];
+        *error = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeArchiveError
+                                   underlyingError:decodeError
+                                       description:description];
+      }
+      return NO;
+    }
+    [self applyRecord:record payload:payload];
+    offset = payloadOffset + payloadLength;
+  }
+
+  if (offset < length) {
+    // drops the torn record, short or failing its checksum, so that new records are appended
+    // after the last valid one
+    if (ftruncate(_fileDescriptor, (off_t)offset) != 0) {
+      if (error) {
+        *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+      }
+      return NO;
+    }
+    SCTKAuthStateJournalSync(_fileDescriptor);
+  }
+  _fileLength = offset;
+  return YES;
+}
+
+#pragma mark - Records
+
+/*! @brief Updates the entries with a record read from, or appended to, the journal. Must be called
+        on @c _queue, or during initialization.
+    @param record The record.
+    @param payload The serialized record.
+ */
+- (void)applyRecord:(NSDictionary<NSString *, id> *)record payload:(NSData *)payload {
+  NSString *accountID = record[kAccountIDKey];
+  if (![accountID isKindOfClass:[NSString class]]) {
+    return;
+  }
+  SCTKAuthStateJournalEntry *entry = _entries[accountID];
+  if (entry) {
+    _liveLength -= entry.recordLength;
+  }
+
+  switch ((SCTKAuthStateJournalRecordType)[record[kTypeKey] integerValue]) {
+    case SCTKAuthStateJournalRecordTypeState: {
+      NSData *stateData = record[kStateDataKey];
+      if (![stateData isKindOfClass:[NSData class]]) {
+        break;
+      }
+      entry = [[SCTKAuthStateJournalEntry alloc] init];
+      entry.stateRecord = payload;
+      entry.stateData = stateData;
+      entry.hasTokenResponse = [record[kHasTokenResponseKey] boolValue];
+      entry.refreshToken = record[kRefreshTokenKey];
+      _entries[accountID] = entry;
+      break;
+    }
+    case SCTKAuthStateJournalRecordTypeTokenUpdate:
+      if (!entry) {
+        break;
+      }
+      entry.tokenUpdateRecord = payload;
+      entry.tokenUpdate = record;
+      entry.accessToken = record[kAccessTokenKey];
+      entry.refreshToken = record[kRefreshTokenKey];
+      break;
+    case SCTKAuthStateJournalRecordTypeRemoval:
+      [_entries removeObjectForKey:accountID];
+      entry = nil;
+      break;
+  }
+
+  if (entry) {
+    _liveLength += entry.recordLength;
+  }
+}
+
+/*! @brief Appends a record to the journal and applies it. Must be called on @c _queue.
+    @param record The record.
+    @param syncNow Whether to sync the journal before returning, rather than in a later batch.
+    @return YES if the record was appended.
+ */
+- (BOOL)appendRecord:(NSDictionary<NSString *, id> *)record syncNow:(BOOL)syncNow {
+  NSData *payload = [SCTKAuthStateCodec dataWithRootObject:record error:nil];
+  if (!payload) {
+    return NO;
+  }
+  NSMutableData *buffer =
+      [NSMutableData dataWithCapacity:sizeof(SCTKAuthStateJournalRecordHeader) + payload.length];
+  SCTKAuthStateJournalAppendRecord(buffer, payload);
+  if (!SCTKAuthStateJournalWrite(_fileDescriptor, buffer.bytes, buffer.length)) {
+    NSLog(@"SCTKAuthStateJournalStore: unable to append to %@ (errno %d)", _fileURL, errno);
+    // a partial record would hide every record appended after it, so it is cut off
+    ftruncate(_fileDescriptor, (off_t)_fileLength);
+    return NO;
+  }
+  _fileLength += buffer.length;
+  _dirty = YES;
+  [_compactionTail addObject:payload];
+  [self applyRecord:record payload:payload];
+
+  if (syncNow) {
+    [self sync];
+  } else {
+    [self scheduleSync];
+  }
+  [self compactIfNeeded];
+  return YES;
+}
+
+/*! @brief Syncs the journal if records were appended since the last sync. Must be called on
+        @c _queue.
+ */
+- (void)sync {
+  if (_dirty && SCTKAuthStateJournalSync(_fileDescriptor)) {
+    _dirty = NO;
+  }
+}
+
+/*! @brief Schedules a sync of the journal after @c syncInterval, unless one is already scheduled.
+        Must be called on @c _queue.
+ */
+- (void)scheduleSync {
+  if (_syncScheduled) {
+    return;
+  }
+  _syncScheduled = YES;
+  __weak SCTKAuthStateJournalStore *weakSelf = self;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_syncInterval * NSEC_PER_SEC)),
+                 _queue, ^{
+    SCTKAuthStateJournalStore *strongSelf = weakSelf;
+    if (!strongSelf) {
+      return;
+    }
+    strongSelf->_syncScheduled = NO;
+    [strongSelf sync];
+  });
+}
+
+#pragma mark - Compaction
+
+/*! @brief Starts a compaction if superseded records take up more than half of the journal. Must be
+        called on @c _queue.
+ */
+- (void)compactIfNeeded {
+  if (_fileLength >= kMinimumCompactionLength && _fileLength > 2 * _liveLength) {
+    [self startCompactionWithCompletion:nil];
+  }
+}
+
+/*! @brief Writes the latest records of each account to a new file in the background, then replaces
+        the journal with it. Must be called on @c _queue.
+    @param completion Called on the main queue once compaction finished.
+ */
+- (void)startCompactionWithCompletion:(nullable void (^)(BOOL succeeded))completion {
+  if (completion) {
+    [_compactionCompletions addObject:completion];
+  }
+  if (_compactionTail) {
+    // already compacting; the caller is told about the compaction in progress
+    return;
+  }
+
+  NSMutableArray<NSData *> *payloads = [NSMutableArray arrayWithCapacity:_entries.count * 2];
+  for (SCTKAuthStateJournalEntry *entry in _entries.objectEnumerator) {
+    [payloads addObject:entry.stateRecord];
+    if (entry.tokenUpdateRecord) {
+      [payloads addObject:entry.tokenUpdateRecord];
+    }
+  }
+  _compactionTail = [NSMutableArray array];
+
+  NSString *compactionPath = [_fileURL.path stringByAppendingString:kCompactionFileSuffix];
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+    int fileDescriptor =
+        open(compactionPath.fileSystemRepresentation, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0600);
+    NSMutableData *buffer = [NSMutableData dataWithCapacity:64 * 1024];
+    uint8_t header[kFileHeaderLength] = {0};
+    memcpy(header, kFileMagic, sizeof(kFileMagic));
+    header[sizeof(kFileMagic)] = kFileVersion;
+    [buffer appendBytes:header length:sizeof(header)];
+    BOOL succeeded = fileDescriptor >= 0;
+    unsigned long long compactedLength = 0;
+    for (NSData *payload in payloads) {
+      SCTKAuthStateJournalAppendRecord(buffer, payload);
+      if (buffer.length >= 64 * 1024) {
+        succeeded = succeeded
+            && SCTKAuthStateJournalWrite(fileDescriptor, buffer.bytes, buffer.length);
+        compactedLength += buffer.length;
+        buffer.length = 0;
+      }
+    }
+    succeeded = succeeded && SCTKAuthStateJournalWrite(fileDescriptor, buffer.bytes, buffer.length);
+    compactedLength += buffer.length;
+    dispatch_async(self->_queue, ^{
+      BOOL replaced = succeeded && [self finishCompactionWithFileDescriptor:fileDescriptor
+                                                                       path:compactionPath
+                                                                     length:compactedLength];
+      if (!replaced) {
+        if (fileDescriptor >= 0) {
+          close(fileDescriptor);
+        }
+        unlink(compactionPath.fileSystemRepresentation);
+      }
+      self->_compactionTail = nil;
+      NSArray<void (^)(BOOL)> *completions = [self->_compactionCompletions copy];
+      [self->_compactionCompletions removeAllObjects];
+      dispatch_async(dispatch_get_main_queue(), ^{
+        for (void (^completion)(BOOL) in completions) {
+          completion(replaced);
+        }
+      });
+    });
+  });
+}
+
+/*! @brief Copies the records appended during compaction to the compacted file, and replaces the
+        journal with it. Must be called on @c _queue.
+    @param fileDescriptor The compacted file.
+    @param path The path of the compacted file.
+    @param length The length written to the compacted file so far.
+    @return YES if the journal was replaced.
+ */
+- (BOOL)finishCompactionWithFileDescriptor:(int)fileDescriptor
+                                      path:(NSString *)path
+                                    length:(unsigned long long)length {
+  NSMutableData *buffer = [NSMutableData data];
+  for (NSData *payload in _compactionTail) {
+    SCTKAuthStateJournalAppendRecord(buffer, payload);
+  }
+  if (!SCTKAuthStateJournalWrite(fileDescriptor, buffer.bytes, buffer.length)
+      || !SCTKAuthStateJournalSync(fileDescriptor)
+      || rename(path.fileSystemRepresentation, _fileURL.fileSystemRepresentation) != 0) {
+    return NO;
+  }
+  // makes the rename itself durable
+  int directoryDescriptor =
+      open(_fileURL.URLByDeletingLastPathComponent.fileSystemRepresentation, O_RDONLY);
+  if (directoryDescriptor >= 0) {
+    fsync(directoryDescriptor);
+    close(directoryDescriptor);
+  }
+
+  close(_fileDescriptor);
+  _fileDescriptor = fileDescriptor;
+  _fileLength = length + buffer.length;
+  _dirty = NO;
+  return YES;
+}
+
+#pragma mark - Public
+
+- (unsigned long long)fileLength {
+  __block unsigned long long fileLength;
+  dispatch_sync(_queue, ^{
+    fileLength = self->_fileLength;
+  });
+  return fileLength;
+}
+
+- (NSArray<NSString *> *)accountIDs {
+  __block NSArray<NSString *> *accountIDs;
+  dispatch_sync(_queue, ^{
+    accountIDs = self->_entries.allKeys;
+  });
+  return accountIDs;
+}
+
+- (nullable SCTKAuthState *)authStateForAccountID:(NSString *)accountID {
+  __block SCTKAuthStateJournalEntry *entry;
+  __block NSData *stateData;
+  __block NSDictionary<NSString *, id> *tokenUpdate;
+  dispatch_sync(_queue, ^{
+    entry = self->_entries[accountID];
+    stateData = entry.stateData;
+    tokenUpdate = entry.tokenUpdate;
+  });
+  if (!stateData) {
+    return nil;
+  }
+
+  SCTKAuthState *authState = [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                                      fromData:stateData
+                                                         error:nil];
+  if (authState && tokenUpdate) {
+    [[self class] applyTokenUpdate:tokenUpdate toAuthState:authState];
+  }
+  if (authState) {
+    dispatch_sync(_queue, ^{
+      // unless the account was written to meanwhile
+      if (self->_entries[accountID] == entry && entry.tokenUpdate == tokenUpdate) {
+        [entry trackAuthState:authState];
+      }
+    });
+  }
+  return authState;
+}
+
+- (void)storeAuthState:(SCTKAuthState *)authState forAccountID:(NSString *)accountID {
+  NSData *stateData = [SCTKAuthStateCodec dataWithRootObject:authState error:nil];
+  if (!stateData) {
+    return;
+  }
+  NSString *refreshToken = authState.refreshToken;
+  NSMutableDictionary<NSString *, id> *record = [NSMutableDictionary dictionary];
+  record[kTypeKey] = @(SCTKAuthStateJournalRecordTypeState);
+  record[kAccountIDKey] = accountID;
+  record[kStateDataKey] = stateData;
+  record[kHasTokenResponseKey] = @(authState.lastTokenResponse != nil);
+  record[kRefreshTokenKey] = refreshToken;
+  dispatch_sync(_queue, ^{
+    SCTKAuthStateJournalEntry *previousEntry = self->_entries[accountID];
+    BOOL rotatesRefreshToken =
+        refreshToken && ![refreshToken isEqualToString:previousEntry.refreshToken];
+    if (![self appendRecord:record syncNow:rotatesRefreshToken]) {
+      return;
+    }
+    SCTKAuthStateJournalEntry *entry = self->_entries[accountID];
+    entry.accessToken = authState.lastTokenResponse.accessToken;
+    [entry trackAuthState:authState];
+  });
+}
+
+- (void)removeAuthStateForAccountID:(NSString *)accountID {
+  NSDictionary<NSString *, id> *record = @{
+    kTypeKey : @(SCTKAuthStateJournalRecordTypeRemoval),
+    kAccountIDKey : accountID,
+  };
+  dispatch_sync(_queue, ^{
+    if (self->_entries[accountID]) {
+      // a removed account must not reappear after a crash
+      [self appendRecord:record syncNow:YES];
+    }
+  });
+}
+
+- (void)recordTokenUpdateForAuthState:(SCTKAuthState *)authState accountID:(NSString *)accountID {
+  SCTKTokenResponse *tokenResponse = authState.lastTokenResponse;
+  NSString *refreshToken = authState.refreshToken;
+  __block BOOL needsStateRecord = NO;
+  dispatch_sync(_queue, ^{
+    SCTKAuthStateJournalEntry *entry = self->_entries[accountID];
+    // anything but the tokens may have changed unless this is the instance the journal matches
+    if (!entry || !entry.hasTokenResponse || !tokenResponse || authState.authorizationError
+        || entry.authState != authState
+        || entry.lastAuthorizationResponse != authState.lastAuthorizationResponse
+        || entry.lastRegistrationResponse != authState.lastRegistrationResponse) {
+      needsStateRecord = YES;
+      return;
+    }
+    BOOL rotatesRefreshToken =
+        refreshToken && ![refreshToken isEqualToString:entry.refreshToken];
+    if (!rotatesRefreshToken && [tokenResponse.accessToken isEqualToString:entry.accessToken]) {
+      return;
+    }
+
+    NSMutableDictionary<NSString *, id> *record = [NSMutableDictionary dictionary];
+    record[kTypeKey] = @(SCTKAuthStateJournalRecordTypeTokenUpdate);
+    record[kAccountIDKey] = accountID;
+    record[kAccessTokenKey] = tokenResponse.accessToken;
+    record[kAccessTokenExpirationDateKey] = tokenResponse.accessTokenExpirationDate;
+    record[kIDTokenKey] = tokenResponse.idToken;
+    record[kTokenTypeKey] = tokenResponse.tokenType;
+    // the state's refresh token and scope, which outlive token responses that omit them
+    record[kRefreshTokenKey] = refreshToken;
+    record[kScopeKey] = authState.scope;
+    record[kTokenResponseDateKey] = authState.lastTokenResponseDate;
+    [self appendRecord:record syncNow:rotatesRefreshToken];
+  });
+  if (needsStateRecord) {
+    [self storeAuthState:authState forAccountID:accountID];
+  }
+}
+
+- (void)synchronize {
+  dispatch_sync(_queue, ^{
+    [self sync];
+  });
+}
+
+- (void)compactWithCompletion:(nullable void (^)(BOOL succeeded))completion {
+  dispatch_async(_queue, ^{
+    [self startCompactionWithCompletion:completion];
+  });
+}
+
+#pragma mark - Token updates
+
+/*! @brief Updates a decoded auth state with the tokens of a token update record.
+    @param tokenUpdate The token update record.
+    @param authState The auth state decoded from the account's state record.
+ */
++ (void)applyTokenUpdate:(NSDictionary<NSString *, id> *)tokenUpdate
+             toAuthState:(SCTKAuthState *)authState {
+  SCTKTokenRequest *request = authState.lastTokenResponse.request;
+  if (!request) {
+    return;
+  }
+  NSMutableDictionary<NSString *, NSObject<NSCopying> *> *parameters =
+      [NSMutableDictionary dictionary];
+  parameters[@"access_token"] = tokenUpdate[kAccessTokenKey];
+  parameters[@"id_token"] = tokenUpdate[kIDTokenKey];
+  parameters[@"token_type"] = tokenUpdate[kTokenTypeKey];
+  parameters[@"refresh_token"] = tokenUpdate[kRefreshTokenKey];
+  parameters[@"scope"] = tokenUpdate[kScopeKey];
+  NSDate *expirationDate = tokenUpdate[kAccessTokenExpirationDateKey];
+  if (expirationDate) {
+    // anchored to the recorded expiry, which keeps the exact date
+    parameters[@"expires_in"] = @0;
+  }
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:request
+                                      parameters:parameters
+                                     requestDate:expirationDate ?: [NSDate date]];
+  [authState updateWithTokenResponse:tokenResponse obtainedDate:tokenUpdate[kTokenResponseDateKey]];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,99 @@
+/*! @file SCTKAuthStateRefreshCoordinator.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class SCTKTokenResponse;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Ends an exclusive section of an @c SCTKAuthStateRefreshCoordinator.
+    @param tokenResponse The token response obtained by this process, to share with the others, or
+        nil if no new token response was obtained.
+    @param obtainedDate When @c tokenResponse was obtained. Ignored if @c tokenResponse is nil.
+ */
+typedef void (^SCTKAuthStateRefreshCoordinatorRelease)(
+    SCTKTokenResponse *_Nullable tokenResponse,
+    NSDate *_Nullable obtainedDate);
+
+/*! @brief Runs with exclusive access to the shared token record.
+    @param sharedTokenResponse The token response last shared by any process for the same
+        authorization, if any.
+    @param sharedDate When @c sharedTokenResponse was obtained, or nil if there is none.
+    @param release The block ending the exclusive section. Must be called exactly once.
+ */
+typedef void (^SCTKAuthStateRefreshCoordinatorBlock)(
+    SCTKTokenResponse *_Nullable sharedTokenResponse,
+    NSDate *_Nullable sharedDate,
+    SCTKAuthStateRefreshCoordinatorRelease release);
+
+/*! @brief Coordinates token refreshes of one authorization between processes, such as an app and
+        its extensions, that each hold an @c SCTKAuthState unarchived from a shared container.
+    @discussion The coordinator serializes refreshes with an exclusive @c flock(2) on a record file,
+        which should be placed in the shared container. The file holds the token response last
+        obtained by any process, with the date it was obtained and a key of the authorization it
+        belongs to, and is read and written through a shared memory mapping. A process entering
+        the exclusive section first checks whether another process has refreshed the same
+        authorization since its own token response was obtained, and adopts that response instead
+        of spending its own refresh token, which with refresh token rotation would have been
+        invalidated.
+
+        Each @c SCTKAuthState only enters the exclusive section once per refresh, as concurrent
+        actions in one process are already coalesced; see
+        @c SCTKAuthState.refreshCoordinator.
+ */
+@interface SCTKAuthStateRefreshCoordinator : NSObject
+
+/*! @brief The URL of the shared record file.
+ */
+@property(nonatomic, readonly) NSURL *fileURL;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithFileURL:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param fileURL The file URL of the shared record, created if needed. All cooperating processes
+        must use the same file, and each authorization its own.
+ */
+- (instancetype)initWithFileURL:(NSURL *)fileURL NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Waits until no other process or thread is in an exclusive section of the record, then
+        calls the block.
+    @param authorizationKey Identifies the authorization being refreshed. A record shared for
+        another authorization is not passed to the block, so that a token response is never
+        adopted across sign-ins.
+    @param dispatchQueue The queue on which the block is called.
+    @param block The block to call. It must eventually call its @c release parameter, which shares
+        the new token response, if any, under @c authorizationKey, and lets the next waiter in.
+    @discussion The wait happens on a private queue. If the record file cannot be opened, the block
+        is called without cross-process exclusion and a nil shared token response.
+ */
+- (void)performExclusivelyForAuthorizationKey:(NSString *)authorizationKey
+                                      onQueue:(dispatch_queue_t)dispatchQueue
+                                        block:(SCTKAuthStateRefreshCoordinatorBlock)block;
+
+/*! @brief Clears the shared record, once no other process or thread is in an exclusive section,
+        such as when the user authorizes again.
+ */
+- (void)resetRecord;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,283 @@
+/*! @file SCTKAuthStateRefreshCoordinator.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthStateRefreshCoordinator.h"
+
+#import <errno.h>
+#import <fcntl.h>
+#import <sys/file.h>
+#import <sys/mman.h>
+#import <unistd.h>
+
+#import "SCTKDefines.h"
+#import "SCTKTokenResponse.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Identifies a shared token record file.
+ */
+static const uint32_t kRecordMagic = 0x53435452;  // "SCTR"
+
+/*! @brief The version of the record format. Records of other versions are ignored.
+ */
+static const uint32_t kRecordVersion = 2;
+
+/*! @brief The header at the start of the record file, followed by @c keyLength bytes of the UTF-8
+        authorization key and @c length bytes of the archived token response.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  double obtainedTime;
+  uint64_t keyLength;
+  uint64_t length;
+} SCTKAuthStateRefreshRecordHeader;
+
+@implementation SCTKAuthStateRefreshCoordinator {
+  /*! @brief The open record file, or -1 if it could not be opened.
+   */
+  int _fileDescriptor;
+
+  /*! @brief Serial queue on which waiters line up for the exclusive section.
+   */
+  dispatch_queue_t _waitQueue;
+
+  /*! @brief Excludes the threads of this process from each other. @c flock(2) locks are held per
+          open file, so they do not exclude users of the same coordinator.
+   */
+  dispatch_semaphore_t _inProcessLock;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithFileURL:))
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL {
+  self = [super init];
+  if (self) {
+    _fileURL = [fileURL copy];
+    _waitQueue = dispatch_queue_create("org.openid.appauth.refreshcoordinator",
+                                       DISPATCH_QUEUE_SERIAL);
+    _inProcessLock = dispatch_semaphore_create(1);
+    _fileDescriptor = open(fileURL.fileSystemRepresentation, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (_fileDescriptor < 0) {
+      NSLog(@"SCTKAuthStateRefreshCoordinator: unable to open %@ (errno %d), refreshes will not "
+             "be coordinated with other processes", fileURL, errno);
+    }
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_fileDescriptor >= 0) {
+    close(_fileDescriptor);
+  }
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, fileURL: %@>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _fileURL];
+}
+
+#pragma mark - Exclusive section
+
+/*! @brief Waits for the threads of this process, then for other processes. Must be called on
+        @c _waitQueue, and balanced with @c unlockRecord:.
+    @return YES if the record file is locked, NO if it could not be opened or locked.
+ */
+- (BOOL)lockRecord {
+  dispatch_semaphore_wait(_inProcessLock, DISPATCH_TIME_FOREVER);
+  if (_fileDescriptor < 0) {
+    return NO;
+  }
+  int result;
+  do {
+    result = flock(_fileDescriptor, LOCK_EX);
+  } while (result != 0 && errno == EINTR);
+  return result == 0;
+}
+
+/*! @brief Lets the next waiter in.
+    @param locked Whether @c lockRecord locked the record file.
+ */
+- (void)unlockRecord:(BOOL)locked {
+  if (locked) {
+    flock(_fileDescriptor, LOCK_UN);
+  }
+  dispatch_semaphore_signal(_inProcessLock);
+}
+
+- (void)performExclusivelyForAuthorizationKey:(NSString *)authorizationKey
+                                      onQueue:(dispatch_queue_t)dispatchQueue
+                                        block:(SCTKAuthStateRefreshCoordinatorBlock)block {
+  NSString *key = [authorizationKey copy];
+  dispatch_async(_waitQueue, ^{
+    BOOL locked = [self lockRecord];
+    NSDate *sharedDate;
+    SCTKTokenResponse *sharedTokenResponse =
+        locked ? [self readTokenResponseForAuthorizationKey:key obtainedDate:&sharedDate] : nil;
+
+    __block BOOL released = NO;
+    SCTKAuthStateRefreshCoordinatorRelease release = ^(SCTKTokenResponse *_Nullable tokenResponse,
+                                                       NSDate *_Nullable obtainedDate) {
+      @synchronized(self) {
+        NSAssert(!released, @"The release block must be called exactly once.");
+        if (released) {
+          return;
+        }
+        released = YES;
+      }
+      if (locked && tokenResponse) {
+        [self writeTokenResponse:tokenResponse
+                    obtainedDate:obtainedDate ?: [NSDate date]
+                authorizationKey:key];
+      }
+      [self unlockRecord:locked];
+    };
+
+    dispatch_async(dispatchQueue, ^{
+      block(sharedTokenResponse, sharedDate, release);
+    });
+  });
+}
+
+- (void)resetRecord {
+  dispatch_async(_waitQueue, ^{
+    BOOL locked = [self lockRecord];
+    if (locked) {
+      ftruncate(self->_fileDescriptor, 0);
+    }
+    [self unlockRecord:locked];
+  });
+}
+
+#pragma mark - Record file
+
+/*! @brief Reads the shared token response. The caller must hold the file lock.
+    @param authorizationKey The key of the authorization being refreshed.
+    @param obtainedDate Set to when the shared token response was obtained, or nil if there is no
+        valid record for the authorization.
+    @return The shared token response, or nil if there is no valid record for the authorization.
+ */
+- (nullable SCTKTokenResponse *)readTokenResponseForAuthorizationKey:(NSString *)authorizationKey
+                                                        obtainedDate:
+    (NSDate *_Nullable *_Nonnull)obtainedDate {
+  *obtainedDate = nil;
+  // the size is taken by seeking rather than with fstat, which reads file timestamps that need a
+  // privacy manifest reason; the record is only ever accessed through mappings
+  off_t fileEnd = lseek(_fileDescriptor, 0, SEEK_END);
+  if (fileEnd < 0 || (size_t)fileEnd < sizeof(SCTKAuthStateRefreshRecordHeader)) {
+    return nil;
+  }
+
+  size_t fileSize = (size_t)fileEnd;
+  void *mapping = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, _fileDescriptor, 0);
+  if (mapping == MAP_FAILED) {
+    return nil;
+  }
+  SCTKAuthStateRefreshRecordHeader header;
+  memcpy(&header, mapping, sizeof(header));
+  NSString *recordKey;
+  NSData *archivedTokenResponse;
+  size_t available = fileSize - sizeof(header);
+  if (header.magic == kRecordMagic
+      && header.version == kRecordVersion
+      && header.keyLength <= available
+      && header.length <= available - header.keyLength) {
+    const uint8_t *bytes = (const uint8_t *)mapping + sizeof(header);
+    recordKey = [[NSString alloc] initWithBytes:bytes
+                                         length:(NSUInteger)header.keyLength
+                                       encoding:NSUTF8StringEncoding];
+    archivedTokenResponse = [NSData dataWithBytes:bytes + header.keyLength
+                                           length:(NSUInteger)header.length];
+  }
+  munmap(mapping, fileSize);
+  if (!archivedTokenResponse || ![recordKey isEqualToString:authorizationKey]) {
+    return nil;
+  }
+
+  SCTKTokenResponse *tokenResponse;
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    tokenResponse = [NSKeyedUnarchiver unarchivedObjectOfClass:[SCTKTokenResponse class]
+                                                      fromData:archivedTokenResponse
+                                                         error:nil];
+  } else {
+#if !TARGET_OS_IOS
+    tokenResponse = [NSKeyedUnarchiver unarchiveObjectWithData:archivedTokenResponse];
+#endif
+  }
+  if (tokenResponse) {
+    *obtainedDate = [NSDate dateWithTimeIntervalSinceReferenceDate:header.obtainedTime];
+  }
+  return tokenResponse;
+}
+
+/*! @brief Replaces the shared token response. The caller must hold the file lock.
+    @param tokenResponse The token response to share.
+    @param obtainedDate When the token response was obtained.
+    @param authorizationKey The key of the authorization the token response belongs to.
+ */
+- (void)writeTokenResponse:(SCTKTokenResponse *)tokenResponse
+              obtainedDate:(NSDate *)obtainedDate
+          authorizationKey:(NSString *)authorizationKey {
+  NSData *archivedTokenResponse;
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    archivedTokenResponse = [NSKeyedArchiver archivedDataWithRootObject:tokenResponse
+                                                  requiringSecureCoding:YES
+                                                                  error:nil];
+  } else {
+#if !TARGET_OS_IOS
+    archivedTokenResponse = [NSKeyedArchiver archivedDataWithRootObject:tokenResponse];
+#endif
+  }
+  NSData *key = [authorizationKey dataUsingEncoding:NSUTF8StringEncoding];
+  if (!archivedTokenResponse || !key) {
+    return;
+  }
+
+  size_t fileSize =
+      sizeof(SCTKAuthStateRefreshRecordHeader) + key.length + archivedTokenResponse.length;
+  if (ftruncate(_fileDescriptor, (off_t)fileSize) != 0) {
+    return;
+  }
+  void *mapping =
+      mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+  if (mapping == MAP_FAILED) {
+    return;
+  }
+  SCTKAuthStateRefreshRecordHeader header = {
+    .magic = kRecordMagic,
+    .version = kRecordVersion,
+    .obtainedTime = obtainedDate.timeIntervalSinceReferenceDate,
+    .keyLength = key.length,
+    .length = archivedTokenResponse.length,
+  };
+  uint8_t *bytes = (uint8_t *)mapping + sizeof(header);
+  memcpy(bytes, key.bytes, key.length);
+  memcpy(bytes + key.length, archivedTokenResponse.bytes, archivedTokenResponse.length);
+  memcpy(mapping, &header, sizeof(header));
+  msync(mapping, fileSize, MS_SYNC);
+  munmap(mapping, fileSize);
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,95 @@
+/*! @file SCTKAuthStateRefreshScheduler.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class SCTKAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Refreshes the access tokens of registered @c SCTKAuthState objects shortly before they
+        expire, so that @c SCTKAuthState.performActionWithFreshTokens: rarely has to wait for the
+        token endpoint.
+    @discussion Registered auth states are kept in a single schedule ordered by their next refresh
+        date, served by one timer. Each refresh date is @c leadTime plus a random jitter of up to
+        @c maximumJitter before the access token expires, so that tokens issued at the same time
+        are not all refreshed at the same time. When a date comes, it is recomputed from the
+        current expiry, so an auth state refreshed by other means in the meantime is moved to its
+        new date rather than refreshed again. The timer is cancelled whenever nothing is
+        scheduled.
+
+        Refreshes go through @c SCTKAuthState.performActionWithFreshTokens:, so they are coalesced
+        with any refresh already in progress, and results are reported to the auth state's
+        delegates as usual. Auth states are held weakly; an auth state that is deallocated is
+        dropped from the schedule. Auth states without a refresh token, or whose access token has
+        no expiration date, are registered but never scheduled.
+ */
+@interface SCTKAuthStateRefreshScheduler : NSObject
+
+/*! @brief How long before the access token expires the refresh is scheduled.
+    @discussion Should be larger than the tolerance used by
+        @c SCTKAuthState.performActionWithFreshTokens:, which is 60 seconds.
+ */
+@property(nonatomic, readonly) NSTimeInterval leadTime;
+
+/*! @brief The maximum random amount by which each refresh is moved earlier than @c leadTime.
+ */
+@property(nonatomic, readonly) NSTimeInterval maximumJitter;
+
+/*! @brief The number of registered auth states that have not been deallocated.
+ */
+@property(nonatomic, readonly) NSUInteger registeredCount;
+
+/*! @brief YES if no refresh is scheduled and the timer is not running.
+ */
+@property(nonatomic, readonly, getter=isPaused) BOOL paused;
+
+/*! @brief Creates a scheduler with a lead time of five minutes and a maximum jitter of one minute.
+ */
+- (instancetype)init;
+
+/*! @brief Designated initializer.
+    @param leadTime How long before the access token expires the refresh is scheduled.
+    @param maximumJitter The maximum random amount by which each refresh is moved earlier.
+ */
+- (instancetype)initWithLeadTime:(NSTimeInterval)leadTime
+                   maximumJitter:(NSTimeInterval)maximumJitter NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Starts refreshing an auth state ahead of its access token's expiry. Has no effect if the
+        auth state is already registered.
+    @param authState The auth state to keep fresh.
+    @discussion An auth state whose access token is already within the lead time is refreshed
+        straight away.
+ */
+- (void)registerAuthState:(SCTKAuthState *)authState;
+
+/*! @brief Stops refreshing an auth state. A refresh already in progress is not cancelled.
+    @param authState The auth state to stop refreshing.
+ */
+- (void)unregisterAuthState:(SCTKAuthState *)authState;
+
+/*! @brief Returns when the next refresh of an auth state is scheduled.
+    @param authState A registered auth state.
+    @return The scheduled refresh date, or nil if the auth state is not registered, is being
+        refreshed, or cannot be scheduled.
+ */
+- (nullable NSDate *)scheduledRefreshDateForAuthState:(SCTKAuthState *)authState;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,356 @@
+/*! @file SCTKAuthStateRefreshScheduler.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthStateRefreshScheduler.h"
+
+#import "SCTKAuthState.h"
+#import "SCTKAuthStateTokenSnapshot.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The default lead time, in seconds.
+ */
+static const NSTimeInterval kDefaultLeadTime = 300;
+
+/*! @brief The default maximum jitter, in seconds.
+ */
+static const NSTimeInterval kDefaultMaximumJitter = 60;
+
+/*! @brief Number of seconds after which a failed refresh is retried.
+ */
+static const NSTimeInterval kRetryInterval = 30;
+
+/*! @brief Minimum number of seconds between two refreshes of the same auth state. Guards against
+        refreshing in a loop when the server issues tokens shorter-lived than the lead time.
+ */
+static const NSTimeInterval kMinimumRefreshInterval = 10;
+
+/*! @brief Leeway given to the timer, in seconds.
+ */
+static const NSTimeInterval kTimerLeeway = 1;
+
+/*! @brief Forces a refresh of the main tokens without discarding the scoped access tokens, unlike
+        @c SCTKAuthState.setNeedsTokenRefresh.
+ */
+@interface SCTKAuthState (SCTKAuthStateRefreshScheduler)
+
+- (void)setNeedsMainTokenRefresh;
+
+@end
+
+/*! @brief The schedule entry of a registered auth state.
+ */
+@interface SCTKAuthStateRefreshSchedulerEntry : NSObject
+
+/*! @brief The registered auth state.
+ */
+@property(nonatomic, weak, readonly, nullable) SCTKAuthState *authState;
+
+/*! @brief When the auth state is due for refresh, if it is scheduled.
+ */
+@property(nonatomic, nullable) NSDate *fireDate;
+
+/*! @brief When the auth state was last refreshed by the scheduler.
+ */
+@property(nonatomic, nullable) NSDate *lastRefreshDate;
+
+/*! @brief The jitter drawn when the entry was last scheduled, kept so that recomputing its fire
+        date for the same expiry gives the same date.
+ */
+@property(nonatomic) NSTimeInterval jitter;
+
+- (instancetype)initWithAuthState:(SCTKAuthState *)authState;
+
+@end
+
+@implementation SCTKAuthStateRefreshSchedulerEntry
+
+- (instancetype)initWithAuthState:(SCTKAuthState *)authState {
+  self = [super init];
+  if (self) {
+    _authState = authState;
+  }
+  return self;
+}
+
+@end
+
+@implementation SCTKAuthStateRefreshScheduler {
+  /*! @brief Serial queue that guards all other instance variables and runs the timer.
+   */
+  dispatch_queue_t _queue;
+
+  /*! @brief Entries of the registered auth states, with weak keys.
+   */
+  NSMapTable<SCTKAuthState *, SCTKAuthStateRefreshSchedulerEntry *> *_entries;
+
+  /*! @brief Scheduled entries, ordered by ascending @c fireDate.
+   */
+  NSMutableArray<SCTKAuthStateRefreshSchedulerEntry *> *_schedule;
+
+  /*! @brief Timer armed for the first entry of @c _schedule, or nil if nothing is scheduled.
+   */
+  dispatch_source_t _Nullable _timer;
+}
+
+- (instancetype)init {
+  return [self initWithLeadTime:kDefaultLeadTime maximumJitter:kDefaultMaximumJitter];
+}
+
+- (instancetype)initWithLeadTime:(NSTimeInterval)leadTime
+                   maximumJitter:(NSTimeInterval)maximumJitter {
+  self = [super init];
+  if (self) {
+    _leadTime = leadTime;
+    _maximumJitter = maximumJitter;
+    _queue = dispatch_queue_create("org.openid.appauth.refreshscheduler", DISPATCH_QUEUE_SERIAL);
+    _entries = [NSMapTable weakToStrongObjectsMapTable];
+    _schedule = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_timer) {
+    dispatch_source_cancel(_timer);
+  }
+}
+
+#pragma mark - Public
+
+- (NSUInteger)registeredCount {
+  __block NSUInteger count;
+  dispatch_sync(_queue, ^{
+    count = self->_entries.keyEnumerator.allObjects.count;
+  });
+  return count;
+}
+
+- (BOOL)isPaused {
+  __block BOOL paused;
+  dispatch_sync(_queue, ^{
+    paused = !self->_timer;
+  });
+  return paused;
+}
+
+- (void)registerAuthState:(SCTKAuthState *)authState {
+  dispatch_sync(_queue, ^{
+    if ([self->_entries objectForKey:authState]) {
+      return;
+    }
+    SCTKAuthStateRefreshSchedulerEntry *entry =
+        [[SCTKAuthStateRefreshSchedulerEntry alloc] initWithAuthState:authState];
+    [self->_entries setObject:entry forKey:authState];
+    [self scheduleEntry:entry];
+    [self updateTimer];
+  });
+}
+
+- (void)unregisterAuthState:(SCTKAuthState *)authState {
+  dispatch_sync(_queue, ^{
+    SCTKAuthStateRefreshSchedulerEntry *entry = [self->_entries objectForKey:authState];
+    if (!entry) {
+      return;
+    }
+    [self->_entries removeObjectForKey:authState];
+    [self->_schedule removeObjectIdenticalTo:entry];
+    [self updateTimer];
+  });
+}
+
+- (nullable NSDate *)scheduledRefreshDateForAuthState:(SCTKAuthState *)authState {
+  __block NSDate *fireDate;
+  dispatch_sync(_queue, ^{
+    fireDate = [self->_entries objectForKey:authState].fireDate;
+  });
+  return fireDate;
+}
+
+#pragma mark - Scheduling
+
+/*! @brief Returns a random jitter between zero and @c maximumJitter.
+ */
+- (NSTimeInterval)randomJitter {
+  return _maximumJitter * ((double)arc4random() / UINT32_MAX);
+}
+
+/*! @brief Inserts an entry into the schedule according to its auth state's access token expiry.
+        Must be called on @c _queue.
+    @param entry The entry to schedule.
+ */
+- (void)scheduleEntry:(SCTKAuthStateRefreshSchedulerEntry *)entry {
+  entry.fireDate = nil;
+  entry.jitter = [self randomJitter];
+  NSDate *fireDate = [self currentFireDateForEntry:entry];
+  if (!fireDate) {
+    return;
+  }
+  [self insertEntry:entry fireDate:fireDate];
+}
+
+/*! @brief Returns when an entry is due according to the current access token expiry of its auth
+        state, which may have been refreshed by other means since the entry was scheduled.
+    @param entry The entry.
+    @return The date, or nil if the auth state is deallocated or cannot be scheduled.
+ */
+- (nullable NSDate *)currentFireDateForEntry:(SCTKAuthStateRefreshSchedulerEntry *)entry {
+  SCTKAuthState *authState = entry.authState;
+  NSDate *expirationDate = authState.tokenSnapshot.accessTokenExpirationDate;
+  if (!authState.refreshToken || !expirationDate) {
+    return nil;
+  }
+  return [expirationDate dateByAddingTimeInterval:-(_leadTime + entry.jitter)];
+}
+
+/*! @brief Drops the entries of deallocated auth states. Must be called on @c _queue.
+ */
+- (void)pruneDeallocatedEntries {
+  NSIndexSet *deallocatedIndexes = [_schedule indexesOfObjectsPassingTest:^BOOL(
+      SCTKAuthStateRefreshSchedulerEntry *entry, NSUInteger index, BOOL *stop) {
+    return !entry.authState;
+  }];
+  [_schedule removeObjectsAtIndexes:deallocatedIndexes];
+
+  // a weak-to-strong map table keeps the values of deallocated keys until it resizes
+  NSMapTable<SCTKAuthState *, SCTKAuthStateRefreshSchedulerEntry *> *liveEntries =
+      [NSMapTable weakToStrongObjectsMapTable];
+  for (SCTKAuthState *authState in _entries.keyEnumerator) {
+    [liveEntries setObject:[_entries objectForKey:authState] forKey:authState];
+  }
+  _entries = liveEntries;
+}
+
+/*! @brief Inserts an entry into the schedule at the given date, no sooner than
+        @c kMinimumRefreshInterval after its last refresh. Must be called on @c _queue.
+    @param entry The entry to schedule.
+    @param fireDate When the entry should be refreshed.
+ */
+- (void)insertEntry:(SCTKAuthStateRefreshSchedulerEntry *)entry fireDate:(NSDate *)fireDate {
+  if (entry.lastRefreshDate) {
+    NSDate *earliestDate =
+        [entry.lastRefreshDate dateByAddingTimeInterval:kMinimumRefreshInterval];
+    fireDate = [fireDate laterDate:earliestDate];
+  }
+  entry.fireDate = fireDate;
+  NSUInteger index = [_schedule indexOfObject:entry
+                                inSortedRange:NSMakeRange(0, _schedule.count)
+                                      options:NSBinarySearchingInsertionIndex
+                              usingComparator:^NSComparisonResult(
+                                  SCTKAuthStateRefreshSchedulerEntry *entry1,
+                                  SCTKAuthStateRefreshSchedulerEntry *entry2) {
+    return [entry1.fireDate compare:entry2.fireDate];
+  }];
+  [_schedule insertObject:entry atIndex:index];
+}
+
+/*! @brief Arms the timer for the first scheduled entry, or cancels it if nothing is scheduled.
+        Must be called on @c _queue.
+ */
+- (void)updateTimer {
+  if (_schedule.count == 0) {
+    if (_timer) {
+      dispatch_source_cancel(_timer);
+      _timer = nil;
+    }
+    return;
+  }
+
+  if (!_timer) {
+    _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+    __weak SCTKAuthStateRefreshScheduler *weakSelf = self;
+    dispatch_source_set_event_handler(_timer, ^{
+      [weakSelf timerDidFire];
+    });
+    dispatch_resume(_timer);
+  }
+
+  NSTimeInterval delay = MAX([_schedule.firstObject.fireDate timeIntervalSinceNow], 0);
+  // wall clock time keeps counting while the device sleeps, unlike DISPATCH_TIME_NOW
+  dispatch_source_set_timer(_timer,
+                            dispatch_walltime(NULL, (int64_t)(delay * NSEC_PER_SEC)),
+                            DISPATCH_TIME_FOREVER,
+                            (uint64_t)(kTimerLeeway * NSEC_PER_SEC));
+}
+
+/*! @brief Refreshes every entry that is still due according to its auth state's current expiry,
+        moves the others to their current date, then re-arms the timer. Runs on @c _queue.
+ */
+- (void)timerDidFire {
+  [self pruneDeallocatedEntries];
+  NSDate *now = [NSDate date];
+  while (_schedule.count > 0
+         && [_schedule.firstObject.fireDate compare:now] != NSOrderedDescending) {
+    SCTKAuthStateRefreshSchedulerEntry *entry = _schedule.firstObject;
+    [_schedule removeObjectAtIndex:0];
+    entry.fireDate = nil;
+    NSDate *currentFireDate = [self currentFireDateForEntry:entry];
+    if (!currentFireDate) {
+      // can no longer be refreshed
+      continue;
+    }
+    if ([currentFireDate compare:now] == NSOrderedDescending) {
+      // refreshed by other means since it was scheduled
+      [self insertEntry:entry fireDate:currentFireDate];
+      continue;
+    }
+    [self refreshEntry:entry];
+  }
+  [self updateTimer];
+}
+
+/*! @brief Refreshes the auth state of an entry and reschedules it once the refresh completes.
+        Must be called on @c _queue.
+    @param entry The entry to refresh.
+ */
+- (void)refreshEntry:(SCTKAuthStateRefreshSchedulerEntry *)entry {
+  SCTKAuthState *authState = entry.authState;
+  if (!authState.refreshToken) {
+    // deallocated, or can no longer be refreshed
+    return;
+  }
+  entry.lastRefreshDate = [NSDate date];
+
+  __weak SCTKAuthStateRefreshScheduler *weakSelf = self;
+  [authState setNeedsMainTokenRefresh];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    SCTKAuthStateRefreshScheduler *strongSelf = weakSelf;
+    SCTKAuthState *refreshedAuthState = entry.authState;
+    // ignores entries that were unregistered while the refresh was in progress
+    if (!strongSelf || !refreshedAuthState
+        || [strongSelf->_entries objectForKey:refreshedAuthState] != entry) {
+      return;
+    }
+    if (!error) {
+      [strongSelf scheduleEntry:entry];
+    } else if (refreshedAuthState.isAuthorized) {
+      // transient error, tries again later
+      NSTimeInterval retryDelay = kRetryInterval + [strongSelf randomJitter];
+      [strongSelf insertEntry:entry fireDate:[NSDate dateWithTimeIntervalSinceNow:retryDelay]];
+    }
+    [strongSelf updateTimer];
+  }
+                     additionalRefreshParameters:nil
+                                   dispatchQueue:_queue];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,141 @@
+/*! @file SCTKAuthStateStore.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class SCTKAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @protocol SCTKAuthStateBackingStore
+    @brief Persistent storage for auth states that are not resident in an @c SCTKAuthStateStore.
+    @discussion Methods may be called from any thread, and are called while the store holds the
+        lock for the account's stripe. Implementations must therefore not call back into the
+        @c SCTKAuthStateStore that owns them.
+ */
+@protocol SCTKAuthStateBackingStore <NSObject>
+
+/*! @brief Loads the auth state for an account.
+    @param accountID The account identifier.
+    @return The stored auth state, or nil if none is stored for @c accountID.
+ */
+- (nullable SCTKAuthState *)authStateForAccountID:(NSString *)accountID;
+
+/*! @brief Persists the auth state for an account, replacing any previously stored state.
+    @param authState The auth state to persist.
+    @param accountID The account identifier.
+ */
+- (void)storeAuthState:(SCTKAuthState *)authState forAccountID:(NSString *)accountID;
+
+/*! @brief Removes the stored auth state for an account, if any.
+    @param accountID The account identifier.
+ */
+- (void)removeAuthStateForAccountID:(NSString *)accountID;
+
+@end
+
+/*! @brief The default number of lock stripes used by an @c SCTKAuthStateStore.
+ */
+extern const NSUInteger SCTKAuthStateStoreDefaultLockStripeCount;
+
+/*! @brief Holds many @c SCTKAuthState objects keyed by account identifier.
+    @discussion Accounts are partitioned over a fixed number of lock stripes, so that operations on
+        accounts in different stripes never contend. Each stripe keeps its share of the in-memory
+        working set in least-recently-used order; when a stripe is full, its least recently used
+        auth state is written to the @c backingStore and released from memory. Lookups of
+        non-resident accounts make the account resident again, returning the evicted instance if
+        it is still in use elsewhere, and otherwise loading it from the @c backingStore.
+ */
+@interface SCTKAuthStateStore : NSObject
+
+/*! @brief The maximum number of auth states kept in memory.
+ */
+@property(nonatomic, readonly) NSUInteger capacity;
+
+/*! @brief The number of lock stripes the accounts are partitioned over.
+ */
+@property(nonatomic, readonly) NSUInteger lockStripeCount;
+
+/*! @brief The store evicted auth states are written to, and non-resident accounts are read from.
+    @discussion If nil, evicted auth states are discarded.
+ */
+@property(nonatomic, readonly, nullable) id<SCTKAuthStateBackingStore> backingStore;
+
+/*! @brief The number of auth states currently held in memory.
+ */
+@property(nonatomic, readonly) NSUInteger residentCount;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithCapacity:backingStore:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Creates a store using @c ::SCTKAuthStateStoreDefaultLockStripeCount lock stripes.
+    @param capacity The maximum number of auth states kept in memory.
+    @param backingStore The store evicted auth states are written to, if any.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+                    backingStore:(nullable id<SCTKAuthStateBackingStore>)backingStore;
+
+/*! @brief Designated initializer.
+    @param capacity The maximum number of auth states kept in memory. Divided evenly (rounding up)
+        between the lock stripes.
+    @param backingStore The store evicted auth states are written to, if any.
+    @param lockStripeCount The number of lock stripes. Must be greater than zero.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+                    backingStore:(nullable id<SCTKAuthStateBackingStore>)backingStore
+                 lockStripeCount:(NSUInteger)lockStripeCount NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Returns the auth state for an account, loading it from the @c backingStore if it is not
+        resident.
+    @param accountID The account identifier.
+    @return The auth state, or nil if the account is unknown.
+ */
+- (nullable SCTKAuthState *)authStateForAccountID:(NSString *)accountID;
+
+/*! @brief Returns the auth states for several accounts.
+    @param accountIDs The account identifiers.
+    @return A dictionary of the known accounts' auth states keyed by account identifier. Unknown
+        accounts are omitted.
+    @discussion Each lock stripe is acquired at most once, regardless of the number of accounts
+        requested.
+ */
+- (NSDictionary<NSString *, SCTKAuthState *> *)authStatesForAccountIDs:
+    (NSArray<NSString *> *)accountIDs;
+
+/*! @brief Adds or replaces the auth state for an account, writes it to the @c backingStore, and
+        marks it most recently used.
+    @param authState The auth state.
+    @param accountID The account identifier.
+ */
+- (void)setAuthState:(SCTKAuthState *)authState forAccountID:(NSString *)accountID;
+
+/*! @brief Removes the auth state for an account from memory and from the @c backingStore.
+    @param accountID The account identifier.
+ */
+- (void)removeAuthStateForAccountID:(NSString *)accountID;
+
+/*! @brief Writes every resident auth state to the @c backingStore, keeping them resident.
+    @discussion Call this before the process is suspended or terminated.
+ */
+- (void)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
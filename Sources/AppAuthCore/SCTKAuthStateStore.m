@@ -0,0 +1,271 @@
+/*! @file SCTKAuthStateStore.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthStateStore.h"
+
+#import "SCTKAuthState.h"
+#import "SCTKDefines.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+const NSUInteger SCTKAuthStateStoreDefaultLockStripeCount = 16;
+
+/*! @brief One partition of an @c SCTKAuthStateStore. The stripe object itself is the lock that
+        guards its contents.
+ */
+@interface SCTKAuthStateStoreStripe : NSObject
+
+/*! @brief The resident auth states of this stripe, keyed by account identifier.
+ */
+@property(nonatomic, readonly) NSMutableDictionary<NSString *, SCTKAuthState *> *authStates;
+
+/*! @brief The resident account identifiers, least recently used first.
+ */
+@property(nonatomic, readonly) NSMutableOrderedSet<NSString *> *recency;
+
+/*! @brief Every auth state of this stripe still alive, resident or not, held weakly and keyed by
+        account identifier, so that an evicted auth state the app still holds is made resident
+        again rather than loaded as a second instance.
+ */
+@property(nonatomic, readonly) NSMapTable<NSString *, SCTKAuthState *> *liveAuthStates;
+
+/*! @brief The maximum number of resident auth states in this stripe.
+ */
+@property(nonatomic, readonly) NSUInteger capacity;
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+@end
+
+@implementation SCTKAuthStateStoreStripe
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+  self = [super init];
+  if (self) {
+    _authStates = [NSMutableDictionary dictionaryWithCapacity:capacity];
+    _recency = [NSMutableOrderedSet orderedSetWithCapacity:capacity];
+    _liveAuthStates = [NSMapTable strongToWeakObjectsMapTable];
+    _capacity = capacity;
+  }
+  return self;
+}
+
+@end
+
+@implementation SCTKAuthStateStore {
+  /*! @brief The lock stripes. Immutable after initialization.
+   */
+  NSArray<SCTKAuthStateStoreStripe *> *_stripes;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithCapacity:backingStore:))
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+                    backingStore:(nullable id<SCTKAuthStateBackingStore>)backingStore {
+  return [self initWithCapacity:capacity
+                   backingStore:backingStore
+                lockStripeCount:SCTKAuthStateStoreDefaultLockStripeCount];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+                    backingStore:(nullable id<SCTKAuthStateBackingStore>)backingStore
+                 lockStripeCount:(NSUInteger)lockStripeCount {
+  NSAssert(lockStripeCount > 0, @"Parameter: |lockStripeCount| must be greater than zero.");
+  self = [super init];
+  if (self) {
+    _capacity = capacity;
+    _backingStore = backingStore;
+    _lockStripeCount = lockStripeCount;
+
+    NSUInteger stripeCapacity = (capacity + lockStripeCount - 1) / lockStripeCount;
+    NSMutableArray<SCTKAuthStateStoreStripe *> *stripes =
+        [NSMutableArray arrayWithCapacity:lockStripeCount];
+    for (NSUInteger i = 0; i < lockStripeCount; i++) {
+      [stripes addObject:[[SCTKAuthStateStoreStripe alloc] initWithCapacity:stripeCapacity]];
+    }
+    _stripes = [stripes copy];
+  }
+  return self;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, capacity: %lu, lockStripeCount: %lu, "
+                                     "residentCount: %lu, backingStore: %@>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    (unsigned long)_capacity,
+                                    (unsigned long)_lockStripeCount,
+                                    (unsigned long)self.residentCount,
+                                    _backingStore];
+}
+
+#pragma mark - Lookups
+
+- (NSUInteger)residentCount {
+  NSUInteger count = 0;
+  for (SCTKAuthStateStoreStripe *stripe in _stripes) {
+    @synchronized(stripe) {
+      count += stripe.authStates.count;
+    }
+  }
+  return count;
+}
+
+- (nullable SCTKAuthState *)authStateForAccountID:(NSString *)accountID {
+  SCTKAuthStateStoreStripe *stripe = [self stripeForAccountID:accountID];
+  @synchronized(stripe) {
+    return [self authStateForAccountID:accountID inStripe:stripe];
+  }
+}
+
+- (NSDictionary<NSString *, SCTKAuthState *> *)authStatesForAccountIDs:
+    (NSArray<NSString *> *)accountIDs {
+  // groups the requested accounts by stripe so that each lock is taken once
+  NSMutableDictionary<NSNumber *, NSMutableArray<NSString *> *> *accountIDsByStripe =
+      [NSMutableDictionary dictionary];
+  for (NSString *accountID in accountIDs) {
+    NSNumber *stripeIndex = @([self stripeIndexForAccountID:accountID]);
+    NSMutableArray<NSString *> *stripeAccountIDs = accountIDsByStripe[stripeIndex];
+    if (!stripeAccountIDs) {
+      stripeAccountIDs = [NSMutableArray array];
+      accountIDsByStripe[stripeIndex] = stripeAccountIDs;
+    }
+    [stripeAccountIDs addObject:accountID];
+  }
+
+  NSMutableDictionary<NSString *, SCTKAuthState *> *authStates =
+      [NSMutableDictionary dictionaryWithCapacity:accountIDs.count];
+  for (NSNumber *stripeIndex in accountIDsByStripe) {
+    SCTKAuthStateStoreStripe *stripe = _stripes[stripeIndex.unsignedIntegerValue];
+    @synchronized(stripe) {
+      for (NSString *accountID in accountIDsByStripe[stripeIndex]) {
+        SCTKAuthState *authState = [self authStateForAccountID:accountID inStripe:stripe];
+        if (authState) {
+          authStates[accountID] = authState;
+        }
+      }
+    }
+  }
+  return authStates;
+}
+
+#pragma mark - Mutations
+
+- (void)setAuthState:(SCTKAuthState *)authState forAccountID:(NSString *)accountID {
+  NSAssert(authState, @"Parameter: |authState| must be non-nil.");
+  SCTKAuthStateStoreStripe *stripe = [self stripeForAccountID:accountID];
+  @synchronized(stripe) {
+    [self insertAuthState:authState forAccountID:accountID inStripe:stripe];
+    [_backingStore storeAuthState:authState forAccountID:accountID];
+  }
+}
+
+- (void)removeAuthStateForAccountID:(NSString *)accountID {
+  SCTKAuthStateStoreStripe *stripe = [self stripeForAccountID:accountID];
+  @synchronized(stripe) {
+    [stripe.authStates removeObjectForKey:accountID];
+    [stripe.recency removeObject:accountID];
+    [stripe.liveAuthStates removeObjectForKey:accountID];
+    [_backingStore removeAuthStateForAccountID:accountID];
+  }
+}
+
+- (void)flush {
+  if (!_backingStore) {
+    return;
+  }
+  for (SCTKAuthStateStoreStripe *stripe in _stripes) {
+    @synchronized(stripe) {
+      [stripe.authStates enumerateKeysAndObjectsUsingBlock:^(NSString *accountID,
+                                                             SCTKAuthState *authState,
+                                                             BOOL *stop) {
+        [self->_backingStore storeAuthState:authState forAccountID:accountID];
+      }];
+    }
+  }
+}
+
+#pragma mark - Private
+
+/*! @brief Returns the index of the lock stripe responsible for an account.
+    @param accountID The account identifier.
+ */
+- (NSUInteger)stripeIndexForAccountID:(NSString *)accountID {
+  return accountID.hash % _stripes.count;
+}
+
+/*! @brief Returns the lock stripe responsible for an account.
+    @param accountID The account identifier.
+ */
+- (SCTKAuthStateStoreStripe *)stripeForAccountID:(NSString *)accountID {
+  return _stripes[[self stripeIndexForAccountID:accountID]];
+}
+
+/*! @brief Returns a resident auth state, marking it most recently used, or otherwise the evicted
+        instance if it is still alive, or loads it from the backing store. The caller must hold
+        the stripe lock.
+    @param accountID The account identifier.
+    @param stripe The stripe responsible for @c accountID.
+ */
+- (nullable SCTKAuthState *)authStateForAccountID:(NSString *)accountID
+                                         inStripe:(SCTKAuthStateStoreStripe *)stripe {
+  SCTKAuthState *authState = stripe.authStates[accountID];
+  if (authState) {
+    [stripe.recency removeObject:accountID];
+    [stripe.recency addObject:accountID];
+    return authState;
+  }
+
+  authState = [stripe.liveAuthStates objectForKey:accountID]
+      ?: [_backingStore authStateForAccountID:accountID];
+  if (authState) {
+    [self insertAuthState:authState forAccountID:accountID inStripe:stripe];
+  }
+  return authState;
+}
+
+/*! @brief Makes an auth state resident as the most recently used entry of its stripe, evicting
+        least recently used entries to the backing store as needed. The caller must hold the
+        stripe lock.
+    @param authState The auth state.
+    @param accountID The account identifier.
+    @param stripe The stripe responsible for @c accountID.
+ */
+- (void)insertAuthState:(SCTKAuthState *)authState
+           forAccountID:(NSString *)accountID
+               inStripe:(SCTKAuthStateStoreStripe *)stripe {
+  stripe.authStates[accountID] = authState;
+  [stripe.liveAuthStates setObject:authState forKey:accountID];
+  [stripe.recency removeObject:accountID];
+  [stripe.recency addObject:accountID];
+
+  while (stripe.recency.count > stripe.capacity) {
+    NSString *evictedAccountID = stripe.recency.firstObject;
+    SCTKAuthState *evictedAuthState = stripe.authStates[evictedAccountID];
+    [stripe.recency removeObjectAtIndex:0];
+    [stripe.authStates removeObjectForKey:evictedAccountID];
+    [_backingStore storeAuthState:evictedAuthState forAccountID:evictedAccountID];
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
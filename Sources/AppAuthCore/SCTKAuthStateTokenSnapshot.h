@@ -0,0 +1,72 @@
+/*! @file SCTKAuthStateTokenSnapshot.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief An immutable view of the token material of an @c SCTKAuthState at one point in time.
+    @discussion A new snapshot is published as a whole each time the auth state changes, so the
+        values of one snapshot always belong together: an access token is never paired with the
+        expiration date of another one.
+ */
+@interface SCTKAuthStateTokenSnapshot : NSObject
+
+/*! @brief The access token, or nil if there is none or the auth state is in an error state.
+ */
+@property(nonatomic, readonly, nullable) NSString *accessToken;
+
+/*! @brief The approximate expiration date & time of @c accessToken, if known.
+ */
+@property(nonatomic, readonly, nullable) NSDate *accessTokenExpirationDate;
+
+/*! @brief The ID Token, if any.
+ */
+@property(nonatomic, readonly, nullable) NSString *idToken;
+
+/*! @brief The type of @c accessToken, if any.
+ */
+@property(nonatomic, readonly, nullable) NSString *tokenType;
+
+/*! @brief Counts the snapshots published by the auth state. Increases with every change, so a
+        snapshot with a higher generation is always the more recent one.
+ */
+@property(nonatomic, readonly) uint64_t generation;
+
+/*! @internal
+    @brief Unavailable. Please use
+        @c initWithAccessToken:accessTokenExpirationDate:idToken:tokenType:generation:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param accessToken The access token.
+    @param accessTokenExpirationDate The expiration date of the access token.
+    @param idToken The ID Token.
+    @param tokenType The type of the access token.
+    @param generation The generation of the snapshot.
+ */
+- (instancetype)initWithAccessToken:(nullable NSString *)accessToken
+          accessTokenExpirationDate:(nullable NSDate *)accessTokenExpirationDate
+                            idToken:(nullable NSString *)idToken
+                          tokenType:(nullable NSString *)tokenType
+                         generation:(uint64_t)generation NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
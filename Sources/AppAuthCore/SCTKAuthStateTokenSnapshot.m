@@ -0,0 +1,61 @@
+/*! @file SCTKAuthStateTokenSnapshot.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthStateTokenSnapshot.h"
+
+#import "SCTKDefines.h"
+#import "SCTKTokenUtilities.h"
+
+@implementation SCTKAuthStateTokenSnapshot
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(
+        @selector(initWithAccessToken:accessTokenExpirationDate:idToken:tokenType:generation:))
+
+- (instancetype)initWithAccessToken:(nullable NSString *)accessToken
+          accessTokenExpirationDate:(nullable NSDate *)accessTokenExpirationDate
+                            idToken:(nullable NSString *)idToken
+                          tokenType:(nullable NSString *)tokenType
+                         generation:(uint64_t)generation {
+  self = [super init];
+  if (self) {
+    _accessToken = [accessToken copy];
+    _accessTokenExpirationDate = [accessTokenExpirationDate copy];
+    _idToken = [idToken copy];
+    _tokenType = [tokenType copy];
+    _generation = generation;
+  }
+  return self;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, generation: %llu, accessToken: \"%@\", "
+                                     "accessTokenExpirationDate: %@, tokenType: %@, "
+                                     "idToken: \"%@\">",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _generation,
+                                    [SCTKTokenUtilities redact:_accessToken],
+                                    _accessTokenExpirationDate,
+                                    _tokenType,
+                                    [SCTKTokenUtilities redact:_idToken]];
+}
+
+@end
@@ -0,0 +1,145 @@
+/*! @file SCTKAuthorizationService+Promises.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthorizationService.h"
+#import "SCTKPromise.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Offers the @c SCTKAuthorizationService requests as promises, so that the steps of a
+        flow can be chained, and independent steps overlapped.
+    @discussion Cancelling a returned promise rejects it immediately. Requests already sent to an
+        endpoint still complete, and their results are ignored. External user agent flows are
+        cancelled with @c SCTKExternalUserAgentSession.cancel.
+ */
+@interface SCTKAuthorizationService (Promises)
+
+/*! @brief Fetches the discovery document of an issuer.
+    @param issuerURL The base URL of the issuer.
+    @return A promise of the service configuration.
+    @see discoverServiceConfigurationForIssuer:completion:
+ */
++ (SCTKPromise<SCTKServiceConfiguration *> *)discoverServiceConfigurationForIssuer:
+    (NSURL *)issuerURL;
+
+/*! @brief Fetches a discovery document.
+    @param discoveryURL The full discovery document URL.
+    @return A promise of the service configuration.
+    @see discoverServiceConfigurationForDiscoveryURL:completion:
+ */
++ (SCTKPromise<SCTKServiceConfiguration *> *)discoverServiceConfigurationForDiscoveryURL:
+    (NSURL *)discoveryURL;
+
+/*! @brief Performs an authorization flow using the given external user agent.
+    @param request The authorization request.
+    @param externalUserAgent The external user agent presenting the request.
+    @param session If non-nil, set to the session of the flow, to be resumed with
+        @c SCTKExternalUserAgentSession.resumeExternalUserAgentFlowWithURL: when the redirect is
+        received.
+    @return A promise of the authorization response.
+    @see presentAuthorizationRequest:externalUserAgent:callback:
+ */
++ (SCTKPromise<SCTKAuthorizationResponse *> *)
+    presentAuthorizationRequest:(SCTKAuthorizationRequest *)request
+              externalUserAgent:(id<SCTKExternalUserAgent>)externalUserAgent
+                        session:(id<SCTKExternalUserAgentSession> _Nullable *_Nullable)session;
+
+/*! @brief Performs an end session flow using the given external user agent.
+    @param request The end session request.
+    @param externalUserAgent The external user agent presenting the request.
+    @param session If non-nil, set to the session of the flow, to be resumed with
+        @c SCTKExternalUserAgentSession.resumeExternalUserAgentFlowWithURL: when the redirect is
+        received.
+    @return A promise of the end session response.
+    @see presentEndSessionRequest:externalUserAgent:callback:
+ */
++ (SCTKPromise<SCTKEndSessionResponse *> *)
+    presentEndSessionRequest:(SCTKEndSessionRequest *)request
+           externalUserAgent:(id<SCTKExternalUserAgent>)externalUserAgent
+                     session:(id<SCTKExternalUserAgentSession> _Nullable *_Nullable)session;
+
+/*! @brief Performs a token request.
+    @param request The token request.
+    @return A promise of the token response.
+    @see performTokenRequest:callback:
+ */
++ (SCTKPromise<SCTKTokenResponse *> *)performTokenRequest:(SCTKTokenRequest *)request;
+
+/*! @brief Performs a token request, validating the ID Token against the authorization response.
+    @param request The token request.
+    @param authorizationResponse The original authorization response related to this token
+        request.
+    @return A promise of the token response.
+    @see performTokenRequest:originalAuthorizationResponse:callback:
+ */
++ (SCTKPromise<SCTKTokenResponse *> *)performTokenRequest:(SCTKTokenRequest *)request
+    originalAuthorizationResponse:(nullable SCTKAuthorizationResponse *)authorizationResponse;
+
+/*! @brief Performs a registration request.
+    @param request The registration request.
+    @return A promise of the registration response.
+    @see performRegistrationRequest:completion:
+ */
++ (SCTKPromise<SCTKRegistrationResponse *> *)performRegistrationRequest:
+    (SCTKRegistrationRequest *)request;
+
+/*! @brief Fetches the claims of the end-user from the userinfo endpoint.
+    @param authState The auth state whose tokens to use.
+    @return A promise of the claims.
+    @see performUserInfoRequestWithAuthState:callback:
+ */
++ (SCTKPromise<SCTKUserInfoResponse *> *)performUserInfoRequestWithAuthState:
+    (SCTKAuthState *)authState;
+
+/*! @brief Revokes a token.
+    @param request The revocation request.
+    @return A promise fulfilled with nil once the token is revoked.
+    @see performRevocationRequest:callback:
+ */
++ (SCTKPromise<NSNull *> *)performRevocationRequest:(SCTKRevocationRequest *)request;
+
+/*! @brief Revokes many tokens at once, with at most
+        @c ::SCTKAuthorizationServiceDefaultMaximumConcurrentRevocations requests in flight.
+    @param requests The revocation requests. Only the first request for each token is sent.
+    @return A promise of the errors of the revocations that failed, by token, fulfilled once every
+        request has completed or failed. Never rejected.
+    @see performRevocationRequests:callback:
+ */
++ (SCTKPromise<NSDictionary<NSString *, NSError *> *> *)performRevocationRequests:
+    (NSArray<SCTKRevocationRequest *> *)requests;
+
+/*! @brief Revokes the refresh and access tokens of auth states, such as when signing out.
+    @param authStates The auth states whose tokens to revoke.
+    @return A promise of the errors of the revocations that failed, by token, fulfilled once every
+        token has been revoked or has failed to be. Never rejected.
+    @see revokeTokensOfAuthStates:callback:
+ */
++ (SCTKPromise<NSDictionary<NSString *, NSError *> *> *)revokeTokensOfAuthStates:
+    (NSArray<SCTKAuthState *> *)authStates;
+
+/*! @brief Introspects a token, reusing a result kept by @c SCTKIntrospectionCache.sharedCache.
+    @param request The introspection request.
+    @return A promise of the introspection response, which is fulfilled for an inactive token too.
+    @see performIntrospectionRequest:callback:
+ */
++ (SCTKPromise<SCTKIntrospectionResponse *> *)performIntrospectionRequest:
+    (SCTKIntrospectionRequest *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
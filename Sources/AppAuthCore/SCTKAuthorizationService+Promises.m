@@ -0,0 +1,183 @@
+/*! @file SCTKAuthorizationService+Promises.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKAuthorizationService+Promises.h"
+
+#import "SCTKExternalUserAgentSession.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Returns the queue service completions are delivered on before resolving a promise. The
+        blocks chained to the promise are dispatched to their own queues, so the completions need
+        not hop to the main queue.
+ */
+static dispatch_queue_t SCTKPromiseCompletionQueue(void) {
+  return dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0);
+}
+
+@implementation SCTKAuthorizationService (Promises)
+
+/*! @brief Returns a completion block resolving the given promise.
+    @param promise The promise to resolve.
+ */
++ (void (^)(id _Nullable, NSError *_Nullable))resolverForPromise:(SCTKPromise *)promise {
+  return ^(id _Nullable value, NSError *_Nullable error) {
+    if (error) {
+      [promise reject:error];
+    } else {
+      [promise fulfill:value];
+    }
+  };
+}
+
++ (SCTKPromise<SCTKServiceConfiguration *> *)discoverServiceConfigurationForIssuer:
+    (NSURL *)issuerURL {
+  SCTKPromise<SCTKServiceConfiguration *> *promise = [SCTKPromise pendingPromise];
+  [self discoverServiceConfigurationForIssuer:issuerURL
+                                callbackQueue:SCTKPromiseCompletionQueue()
+                                   completion:[self resolverForPromise:promise]];
+  return promise;
+}
+
++ (SCTKPromise<SCTKServiceConfiguration *> *)discoverServiceConfigurationForDiscoveryURL:
+    (NSURL *)discoveryURL {
+  SCTKPromise<SCTKServiceConfiguration *> *promise = [SCTKPromise pendingPromise];
+  [self discoverServiceConfigurationForDiscoveryURL:discoveryURL
+                                      callbackQueue:SCTKPromiseCompletionQueue()
+                                         completion:[self resolverForPromise:promise]];
+  return promise;
+}
+
++ (SCTKPromise<SCTKAuthorizationResponse *> *)
+    presentAuthorizationRequest:(SCTKAuthorizationRequest *)request
+              externalUserAgent:(id<SCTKExternalUserAgent>)externalUserAgent
+                        session:(id<SCTKExternalUserAgentSession> _Nullable *_Nullable)session {
+  SCTKPromise<SCTKAuthorizationResponse *> *promise = [SCTKPromise pendingPromise];
+  id<SCTKExternalUserAgentSession> flowSession =
+      [self presentAuthorizationRequest:request
+                      externalUserAgent:externalUserAgent
+                               callback:[self resolverForPromise:promise]];
+  [promise onCancel:^{
+    [flowSession cancel];
+  }];
+  if (session) {
+    *session = flowSession;
+  }
+  return promise;
+}
+
++ (SCTKPromise<SCTKEndSessionResponse *> *)
+    presentEndSessionRequest:(SCTKEndSessionRequest *)request
+           externalUserAgent:(id<SCTKExternalUserAgent>)externalUserAgent
+                     session:(id<SCTKExternalUserAgentSession> _Nullable *_Nullable)session {
+  SCTKPromise<SCTKEndSessionResponse *> *promise = [SCTKPromise pendingPromise];
+  id<SCTKExternalUserAgentSession> flowSession =
+      [self presentEndSessionRequest:request
+                   externalUserAgent:externalUserAgent
+                            callback:[self resolverForPromise:promise]];
+  [promise onCancel:^{
+    [flowSession cancel];
+  }];
+  if (session) {
+    *session = flowSession;
+  }
+  return promise;
+}
+
++ (SCTKPromise<SCTKTokenResponse *> *)performTokenRequest:(SCTKTokenRequest *)request {
+  return [self performTokenRequest:request originalAuthorizationResponse:nil];
+}
+
++ (SCTKPromise<SCTKTokenResponse *> *)performTokenRequest:(SCTKTokenRequest *)request
+    originalAuthorizationResponse:(nullable SCTKAuthorizationResponse *)authorizationResponse {
+  SCTKPromise<SCTKTokenResponse *> *promise = [SCTKPromise pendingPromise];
+  [self performTokenRequest:request
+      originalAuthorizationResponse:authorizationResponse
+                      callbackQueue:SCTKPromiseCompletionQueue()
+                           callback:[self resolverForPromise:promise]];
+  return promise;
+}
+
++ (SCTKPromise<SCTKRegistrationResponse *> *)performRegistrationRequest:
+    (SCTKRegistrationRequest *)request {
+  SCTKPromise<SCTKRegistrationResponse *> *promise = [SCTKPromise pendingPromise];
+  [self performRegistrationRequest:request
+                     callbackQueue:SCTKPromiseCompletionQueue()
+                        completion:[self resolverForPromise:promise]];
+  return promise;
+}
+
++ (SCTKPromise<SCTKUserInfoResponse *> *)performUserInfoRequestWithAuthState:
+    (SCTKAuthState *)authState {
+  SCTKPromise<SCTKUserInfoResponse *> *promise = [SCTKPromise pendingPromise];
+  [self performUserInfoRequestWithAuthState:authState
+                              callbackQueue:SCTKPromiseCompletionQueue()
+                                   callback:[self resolverForPromise:promise]];
+  return promise;
+}
+
++ (SCTKPromise<NSNull *> *)performRevocationRequest:(SCTKRevocationRequest *)request {
+  SCTKPromise<NSNull *> *promise = [SCTKPromise pendingPromise];
+  [self performRevocationRequest:request
+                   callbackQueue:SCTKPromiseCompletionQueue()
+                        callback:^(NSError *_Nullable error) {
+    if (error) {
+      [promise reject:error];
+    } else {
+      [promise fulfill:nil];
+    }
+  }];
+  return promise;
+}
+
++ (SCTKPromise<NSDictionary<NSString *, NSError *> *> *)performRevocationRequests:
+    (NSArray<SCTKRevocationRequest *> *)requests {
+  SCTKPromise<NSDictionary<NSString *, NSError *> *> *promise = [SCTKPromise pendingPromise];
+  [self performRevocationRequests:requests
+        maximumConcurrentRequests:SCTKAuthorizationServiceDefaultMaximumConcurrentRevocations
+                    callbackQueue:SCTKPromiseCompletionQueue()
+                         callback:^(NSDictionary<NSString *, NSError *> *errors) {
+    [promise fulfill:errors];
+  }];
+  return promise;
+}
+
++ (SCTKPromise<NSDictionary<NSString *, NSError *> *> *)revokeTokensOfAuthStates:
+    (NSArray<SCTKAuthState *> *)authStates {
+  SCTKPromise<NSDictionary<NSString *, NSError *> *> *promise = [SCTKPromise pendingPromise];
+  [self revokeTokensOfAuthStates:authStates
+       maximumConcurrentRequests:SCTKAuthorizationServiceDefaultMaximumConcurrentRevocations
+                   callbackQueue:SCTKPromiseCompletionQueue()
+                        callback:^(NSDictionary<NSString *, NSError *> *errors) {
+    [promise fulfill:errors];
+  }];
+  return promise;
+}
+
++ (SCTKPromise<SCTKIntrospectionResponse *> *)performIntrospectionRequest:
+    (SCTKIntrospectionRequest *)request {
+  SCTKPromise<SCTKIntrospectionResponse *> *promise = [SCTKPromise pendingPromise];
+  [self performIntrospectionRequest:request
+                      callbackQueue:SCTKPromiseCompletionQueue()
+                           callback:[self resolverForPromise:promise]];
+  return promise;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
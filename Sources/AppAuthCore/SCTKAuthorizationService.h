@@ -18,21 +18,31 @@
 
 #import <Foundation/Foundation.h>
 
+@class SCTKAuthState;
 @class SCTKAuthorization;
 @class SCTKAuthorizationRequest;
 @class SCTKAuthorizationResponse;
 @class SCTKEndSessionRequest;
 @class SCTKEndSessionResponse;
+@class SCTKIntrospectionRequest;
+@class SCTKIntrospectionResponse;
 @class SCTKRegistrationRequest;
 @class SCTKRegistrationResponse;
+@class SCTKRevocationRequest;
 @class SCTKServiceConfiguration;
 @class SCTKTokenRequest;
 @class SCTKTokenResponse;
+@class SCTKUserInfoResponse;
 @protocol SCTKExternalUserAgent;
 @protocol SCTKExternalUserAgentSession;
 
 NS_ASSUME_NONNULL_BEGIN
 
+/*! @brief The number of revocation requests of a batch that @c SCTKAuthorizationService sends at
+        once, unless a different limit is given.
+ */
+extern const NSUInteger SCTKAuthorizationServiceDefaultMaximumConcurrentRevocations;
+
 /*! @brief Represents the type of block used as a callback for creating a service configuration from
         a remote OpenID Connect Discovery document.
     @param configuration The service configuration, if available.
@@ -77,6 +87,31 @@ typedef NSDictionary<NSString *, NSString *> *_Nullable SCTKTokenEndpointParamet
 typedef void (^SCTKRegistrationCompletion)(SCTKRegistrationResponse *_Nullable registrationResponse,
                                           NSError *_Nullable error);
 
+/*! @brief Block used as a callback for the userinfo requests of @c SCTKAuthorizationService.
+    @param userInfo The claims of the end-user, if available.
+    @param error The error if an error occurred.
+ */
+typedef void (^SCTKUserInfoCallback)(SCTKUserInfoResponse *_Nullable userInfo,
+                                    NSError *_Nullable error);
+
+/*! @brief Block used as a callback for the revocation requests of @c SCTKAuthorizationService.
+    @param error The error if the token could not be revoked.
+ */
+typedef void (^SCTKRevocationCallback)(NSError *_Nullable error);
+
+/*! @brief Called once every token of a batch revocation has been revoked or has failed to be.
+    @param errors The errors of the revocations that failed, by token. Empty if every token was
+        revoked.
+ */
+typedef void (^SCTKRevocationBatchCallback)(NSDictionary<NSString *, NSError *> *errors);
+
+/*! @brief Block used as a callback for the introspection requests of @c SCTKAuthorizationService.
+    @param response The introspection result, active or not, if available.
+    @param error The error if an error occurred.
+ */
+typedef void (^SCTKIntrospectionCallback)(SCTKIntrospectionResponse *_Nullable response,
+                                          NSError *_Nullable error);
+
 /*! @brief Performs various OAuth and OpenID Connect related calls via the user agent or
         \NSURLSession.
  */
@@ -95,6 +130,21 @@ typedef void (^SCTKRegistrationCompletion)(SCTKRegistrationResponse *_Nullable r
  */
 - (instancetype)init NS_UNAVAILABLE;
 
+/*! @brief The queue on which discovery, token and registration completions are called when no
+        callback queue is given. Defaults to the main queue.
+ */
++ (dispatch_queue_t)defaultCallbackQueue;
+
+/*! @brief Sets the queue on which discovery, token and registration completions are called when no
+        callback queue is given, including the token refreshes of @c SCTKAuthState.
+    @param callbackQueue The queue, or nil to restore the main queue.
+    @discussion Lets apps without UI work keep token traffic off the main thread. The queue may be
+        concurrent: @c SCTKAuthState updates itself on a private serial queue, and only calls its
+        delegates on this one. Completions of authorization and end-session requests, which
+        involve the user agent, are always called on the main queue.
+ */
++ (void)setDefaultCallbackQueue:(nullable dispatch_queue_t)callbackQueue;
+
 /*! @brief Convenience method for creating an authorization service configuration from an OpenID
         Connect compliant issuer URL.
     @param issuerURL The service provider's OpenID Connect issuer.
@@ -105,6 +155,18 @@ typedef void (^SCTKRegistrationCompletion)(SCTKRegistrationResponse *_Nullable r
 + (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
                                    completion:(SCTKDiscoveryCallback)completion;
 
+/*! @brief Convenience method for creating an authorization service configuration from an OpenID
+        Connect compliant issuer URL.
+    @param issuerURL The service provider's OpenID Connect issuer.
+    @param callbackQueue The queue on which to call the completion.
+    @param completion A block which will be invoked when the authorization service configuration has
+        been created, or when an error has occurred.
+    @see https://openid.net/specs/openid-connect-discovery-1_0.html
+ */
++ (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                callbackQueue:(dispatch_queue_t)callbackQueue
+                                   completion:(SCTKDiscoveryCallback)completion;
+
 
 /*! @brief Convenience method for creating an authorization service configuration from an OpenID
         Connect compliant identity provider's discovery document.
@@ -116,6 +178,19 @@ typedef void (^SCTKRegistrationCompletion)(SCTKRegistrationResponse *_Nullable r
 + (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
                                          completion:(SCTKDiscoveryCallback)completion;
 
+/*! @brief Convenience method for creating an authorization service configuration from an OpenID
+        Connect compliant identity provider's discovery document.
+    @param discoveryURL The URL of the service provider's OpenID Connect discovery document.
+    @param callbackQueue The queue on which to call the completion.
+    @param completion A block which will be invoked when the authorization service configuration has
+        been created, or when an error has occurred.
+    @discussion Documents are cached by @c SCTKServiceDiscoveryCache.sharedCache, if set.
+    @see https://openid.net/specs/openid-connect-discovery-1_0.html
+ */
++ (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                      callbackQueue:(dispatch_queue_t)callbackQueue
+                                         completion:(SCTKDiscoveryCallback)completion;
+
 /*! @brief Perform an authorization flow using a generic flow shim.
     @param request The authorization request.
     @param externalUserAgent Generic external user-agent that can present an authorization
@@ -158,13 +233,171 @@ typedef void (^SCTKRegistrationCompletion)(SCTKRegistrationResponse *_Nullable r
     originalAuthorizationResponse:(SCTKAuthorizationResponse *_Nullable)authorizationResponse
                          callback:(SCTKTokenCallback)callback;
 
+/*! @brief Performs a token request.
+    @param request The token request.
+    @param authorizationResponse The original authorization response related to this token request.
+    @param callbackQueue The queue on which to call the callback.
+    @param callback The method called when the request has completed or failed.
+    @discussion A request identical to one still in flight in the same URL session, that is with
+        the same token endpoint, body and client authentication, is not sent again: the response
+        to the request in flight is handed to both callers. Copies of an @c SCTKAuthState holding
+        the same rotating refresh token thus share one refresh, instead of invalidating each
+        other's refresh token.
+ */
++ (void)performTokenRequest:(SCTKTokenRequest *)request
+    originalAuthorizationResponse:(SCTKAuthorizationResponse *_Nullable)authorizationResponse
+                    callbackQueue:(dispatch_queue_t)callbackQueue
+                         callback:(SCTKTokenCallback)callback;
+
+/*! @brief The number of token requests sent since launch.
+ */
++ (NSUInteger)sentTokenRequestCount;
+
+/*! @brief The number of token requests answered since launch by an identical request already in
+        flight, rather than sent.
+ */
++ (NSUInteger)coalescedTokenRequestCount;
+
+/*! @brief Performs a registration request.
+    @param request The registration request.
+    @param completion The method called when the request has completed or failed.
+ */
++ (void)performRegistrationRequest:(SCTKRegistrationRequest *)request
+                        completion:(SCTKRegistrationCompletion)completion;
+
 /*! @brief Performs a registration request.
     @param request The registration request.
+    @param callbackQueue The queue on which to call the completion.
     @param completion The method called when the request has completed or failed.
  */
 + (void)performRegistrationRequest:(SCTKRegistrationRequest *)request
+                     callbackQueue:(dispatch_queue_t)callbackQueue
                         completion:(SCTKRegistrationCompletion)completion;
 
+/*! @brief Fetches the claims of the end-user from the userinfo endpoint, with a fresh access token
+        of an auth state.
+    @param authState The auth state whose tokens to use.
+    @param callback The method called when the request has completed or failed.
+    @discussion The endpoint is taken from the discovery document of the last token or
+        authorization request. A response is reused from @c SCTKUserInfoCache.sharedCache while
+        it is unexpired for the issuer and subject of the ID Token, the client ID and the access
+        token. An authorization error from the endpoint is passed to
+        @c SCTKAuthState.updateWithAuthorizationError:.
+    @see https://openid.net/specs/openid-connect-core-1_0.html#UserInfo
+ */
++ (void)performUserInfoRequestWithAuthState:(SCTKAuthState *)authState
+                                   callback:(SCTKUserInfoCallback)callback;
+
+/*! @brief Fetches the claims of the end-user from the userinfo endpoint, with a fresh access token
+        of an auth state.
+    @param authState The auth state whose tokens to use.
+    @param callbackQueue The queue on which to call the callback.
+    @param callback The method called when the request has completed or failed.
+    @see performUserInfoRequestWithAuthState:callback:
+ */
++ (void)performUserInfoRequestWithAuthState:(SCTKAuthState *)authState
+                              callbackQueue:(dispatch_queue_t)callbackQueue
+                                   callback:(SCTKUserInfoCallback)callback;
+
+/*! @brief Fetches the claims of the end-user from a userinfo endpoint, without caching.
+    @param userinfoEndpoint The userinfo endpoint.
+    @param accessToken The access token to send as a bearer token.
+    @param callbackQueue The queue on which to call the callback.
+    @param callback The method called when the request has completed or failed.
+ */
++ (void)performUserInfoRequestToEndpoint:(NSURL *)userinfoEndpoint
+                             accessToken:(NSString *)accessToken
+                           callbackQueue:(dispatch_queue_t)callbackQueue
+                                callback:(SCTKUserInfoCallback)callback;
+
+/*! @brief Revokes a token.
+    @param request The revocation request.
+    @param callback The method called when the request has completed or failed.
+    @discussion The server responds with success to a token that is already invalid, so an error
+        means the token may still be valid.
+    @see https://tools.ietf.org/html/rfc7009
+ */
++ (void)performRevocationRequest:(SCTKRevocationRequest *)request
+                        callback:(SCTKRevocationCallback)callback;
+
+/*! @brief Revokes a token.
+    @param request The revocation request.
+    @param callbackQueue The queue on which to call the callback.
+    @param callback The method called when the request has completed or failed.
+    @see performRevocationRequest:callback:
+ */
++ (void)performRevocationRequest:(SCTKRevocationRequest *)request
+                   callbackQueue:(dispatch_queue_t)callbackQueue
+                        callback:(SCTKRevocationCallback)callback;
+
+/*! @brief Revokes many tokens at once, with at most
+        @c ::SCTKAuthorizationServiceDefaultMaximumConcurrentRevocations requests in flight.
+    @param requests The revocation requests. Only the first request for each token is sent.
+    @param callback The method called once every request has completed or failed.
+ */
++ (void)performRevocationRequests:(NSArray<SCTKRevocationRequest *> *)requests
+                         callback:(SCTKRevocationBatchCallback)callback;
+
+/*! @brief Revokes many tokens at once.
+    @param requests The revocation requests. Only the first request for each token is sent.
+    @param maximumConcurrentRequests The maximum number of requests in flight at once. Must be at
+        least one.
+    @param callbackQueue The queue on which to call the callback.
+    @param callback The method called once every request has completed or failed.
+    @discussion When a request completes, the next one is sent, so a batch of no more than
+        @c maximumConcurrentRequests tokens takes a single round trip.
+ */
++ (void)performRevocationRequests:(NSArray<SCTKRevocationRequest *> *)requests
+        maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+                    callbackQueue:(dispatch_queue_t)callbackQueue
+                         callback:(SCTKRevocationBatchCallback)callback;
+
+/*! @brief Revokes the refresh and access tokens of auth states, such as when signing out.
+    @param authStates The auth states whose tokens to revoke.
+    @param callback The method called once every token has been revoked or has failed to be.
+    @discussion The revocation endpoint is taken from the discovery document of the last token or
+        authorization request of each auth state, and the client credentials from the request
+        itself. The tokens of an auth state without a revocation endpoint, or without a client ID
+        in either request, fail with @c ::SCTKErrorCodeEndpointNotConfiguredError whose
+        description names what is missing. The auth states are not changed.
+ */
++ (void)revokeTokensOfAuthStates:(NSArray<SCTKAuthState *> *)authStates
+                        callback:(SCTKRevocationBatchCallback)callback;
+
+/*! @brief Revokes the refresh and access tokens of auth states, such as when signing out.
+    @param authStates The auth states whose tokens to revoke.
+    @param maximumConcurrentRequests The maximum number of requests in flight at once. Must be at
+        least one.
+    @param callbackQueue The queue on which to call the callback.
+    @param callback The method called once every token has been revoked or has failed to be.
+    @see revokeTokensOfAuthStates:callback:
+ */
++ (void)revokeTokensOfAuthStates:(NSArray<SCTKAuthState *> *)authStates
+       maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+                   callbackQueue:(dispatch_queue_t)callbackQueue
+                        callback:(SCTKRevocationBatchCallback)callback;
+
+/*! @brief Introspects a token, such as an opaque access token presented to a protected resource.
+    @param request The introspection request.
+    @param callback The method called when the request has completed or failed.
+    @discussion A result is reused from @c SCTKIntrospectionCache.sharedCache while it is kept for
+        the token, and a new result is stored there. An inactive token is a successful response
+        whose @c SCTKIntrospectionResponse.active is NO.
+    @see https://tools.ietf.org/html/rfc7662
+ */
++ (void)performIntrospectionRequest:(SCTKIntrospectionRequest *)request
+                           callback:(SCTKIntrospectionCallback)callback;
+
+/*! @brief Introspects a token.
+    @param request The introspection request.
+    @param callbackQueue The queue on which to call the callback.
+    @param callback The method called when the request has completed or failed.
+    @see performIntrospectionRequest:callback:
+ */
++ (void)performIntrospectionRequest:(SCTKIntrospectionRequest *)request
+                      callbackQueue:(dispatch_queue_t)callbackQueue
+                           callback:(SCTKIntrospectionCallback)callback;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -18,8 +18,12 @@
 
 #import "SCTKAuthorizationService.h"
 
+#import "SCTKAuthState.h"
+#import "SCTKAuthStateTokenSnapshot.h"
 #import "SCTKAuthorizationRequest.h"
 #import "SCTKAuthorizationResponse.h"
+#import "SCTKClockSkewEstimator.h"
+#import "SCTKConnectionPrewarmer.h"
 #import "SCTKDefines.h"
 #import "SCTKEndSessionRequest.h"
 #import "SCTKEndSessionResponse.h"
@@ -27,14 +31,24 @@
 #import "SCTKExternalUserAgent.h"
 #import "SCTKExternalUserAgentSession.h"
 #import "SCTKIDToken.h"
+#import "SCTKIntrospectionCache.h"
+#import "SCTKIntrospectionRequest.h"
+#import "SCTKIntrospectionResponse.h"
 #import "SCTKRegistrationRequest.h"
 #import "SCTKRegistrationResponse.h"
+#import "SCTKResponseReader.h"
+#import "SCTKRevocationRequest.h"
 #import "SCTKServiceConfiguration.h"
 #import "SCTKServiceDiscovery.h"
+#import "SCTKServiceDiscoveryCache.h"
 #import "SCTKTokenRequest.h"
 #import "SCTKTokenResponse.h"
+#import "SCTKTokenResponsePipeline.h"
+#import "SCTKTokenUtilities.h"
 #import "SCTKURLQueryComponent.h"
 #import "SCTKURLSessionProvider.h"
+#import "SCTKUserInfoCache.h"
+#import "SCTKUserInfoResponse.h"
 
 /*! @brief Path appended to an OpenID Connect issuer for discovery
     @see https://openid.net/specs/openid-connect-discovery-1_0.html#ProviderConfig
@@ -48,6 +62,36 @@ static int const kOIDAuthorizationSessionIATMaxSkew = 600;
 
 NS_ASSUME_NONNULL_BEGIN
 
+const NSUInteger SCTKAuthorizationServiceDefaultMaximumConcurrentRevocations = 6;
+
+/*! @brief The number of token requests sent. Guarded by @c SCTKInFlightTokenRequests().
+ */
+static NSUInteger gSentTokenRequestCount;
+
+/*! @brief The number of token requests answered by a request in flight. Guarded by
+        @c SCTKInFlightTokenRequests().
+ */
+static NSUInteger gCoalescedTokenRequestCount;
+
+/*! @brief Returns the callbacks waiting on the token requests in flight, beyond the callback of
+        the caller that sent the request, by key of the request, by transport. Transports are held
+        weakly, so that the requests of a discarded transport are never joined. Used as its own
+        lock.
+ */
+static NSMapTable *SCTKInFlightTokenRequests(void) {
+  static NSMapTable *inFlightTokenRequests;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    inFlightTokenRequests = [NSMapTable weakToStrongObjectsMapTable];
+  });
+  return inFlightTokenRequests;
+}
+
+/*! @brief The queue on which completions are called when none is given, or nil for the main
+        queue. Guarded by @c SCTKAuthorizationService.
+ */
+static dispatch_queue_t _Nullable gDefaultCallbackQueue;
+
 @interface SCTKAuthorizationSession : NSObject<SCTKExternalUserAgentSession>
 
 - (instancetype)init NS_UNAVAILABLE;
@@ -61,6 +105,7 @@ NS_ASSUME_NONNULL_BEGIN
   SCTKAuthorizationRequest *_request;
   id<SCTKExternalUserAgent> _externalUserAgent;
   SCTKAuthorizationCallback _pendingauthorizationFlowCallback;
+  SCTKConnectionPrewarmer *_prewarmer;
 }
 
 - (instancetype)initWithRequest:(SCTKAuthorizationRequest *)request {
@@ -75,6 +120,11 @@ NS_ASSUME_NONNULL_BEGIN
                                          callback:(SCTKAuthorizationCallback)authorizationFlowCallback {
   _externalUserAgent = externalUserAgent;
   _pendingauthorizationFlowCallback = authorizationFlowCallback;
+  // the token exchange follows the user's return, so its connections are opened meanwhile
+  if ([SCTKConnectionPrewarmer prewarmsDuringAuthorization]) {
+    _prewarmer = [[SCTKConnectionPrewarmer alloc] initWithConfiguration:_request.configuration];
+    [_prewarmer start];
+  }
   BOOL authorizationFlowStarted =
       [_externalUserAgent presentExternalUserAgentRequest:_request session:self];
   if (!authorizationFlowStarted) {
@@ -187,6 +237,8 @@ NS_ASSUME_NONNULL_BEGIN
   SCTKAuthorizationCallback callback = _pendingauthorizationFlowCallback;
   _pendingauthorizationFlowCallback = nil;
   _externalUserAgent = nil;
+  [_prewarmer stop];
+  _prewarmer = nil;
   if (callback) {
     callback(response, error);
   }
@@ -314,8 +366,133 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/*! @brief The revocation requests of one batch, sent with a limited number in flight at once.
+ */
+@interface SCTKRevocationBatch : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithRequests:(NSArray<SCTKRevocationRequest *> *)requests
+                          errors:(NSDictionary<NSString *, NSError *> *)errors
+       maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+                   callbackQueue:(dispatch_queue_t)callbackQueue
+                        callback:(SCTKRevocationBatchCallback)callback
+    NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Sends the requests. The batch is kept alive until the callback is called.
+ */
+- (void)start;
+
+@end
+
+@implementation SCTKRevocationBatch {
+  /*! @brief Serial queue that guards all other instance variables and receives request results.
+   */
+  dispatch_queue_t _queue;
+
+  /*! @brief The requests not yet sent, in order.
+   */
+  NSMutableArray<SCTKRevocationRequest *> *_queuedRequests;
+
+  /*! @brief The errors of the failed requests, by token.
+   */
+  NSMutableDictionary<NSString *, NSError *> *_errors;
+
+  /*! @brief The number of requests in flight.
+   */
+  NSUInteger _activeCount;
+
+  NSUInteger _maximumConcurrentRequests;
+  dispatch_queue_t _callbackQueue;
+  SCTKRevocationBatchCallback _callback;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(
+        @selector(initWithRequests:errors:maximumConcurrentRequests:callbackQueue:callback:))
+
+- (instancetype)initWithRequests:(NSArray<SCTKRevocationRequest *> *)requests
+                          errors:(NSDictionary<NSString *, NSError *> *)errors
+       maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+                   callbackQueue:(dispatch_queue_t)callbackQueue
+                        callback:(SCTKRevocationBatchCallback)callback {
+  self = [super init];
+  if (self) {
+    NSAssert(maximumConcurrentRequests > 0, @"At least one request must be allowed at once.");
+    _queue = dispatch_queue_create("org.openid.appauth.revocation", DISPATCH_QUEUE_SERIAL);
+    _queuedRequests = [NSMutableArray array];
+    _errors = [errors mutableCopy];
+    _maximumConcurrentRequests = MAX(maximumConcurrentRequests, (NSUInteger)1);
+    _callbackQueue = callbackQueue;
+    _callback = [callback copy];
+
+    // a token is revoked once, however many requests name it
+    NSMutableSet<NSString *> *tokens = [NSMutableSet setWithArray:errors.allKeys];
+    for (SCTKRevocationRequest *request in requests) {
+      if (![tokens containsObject:request.token]) {
+        [tokens addObject:request.token];
+        [_queuedRequests addObject:request];
+      }
+    }
+  }
+  return self;
+}
+
+- (void)start {
+  dispatch_async(_queue, ^{
+    [self startQueuedRequests];
+  });
+}
+
+/*! @brief Sends queued requests until the queue is empty or the limit is reached, and calls the
+        callback once nothing is left. Must be called on @c _queue.
+ */
+- (void)startQueuedRequests {
+  while (_queuedRequests.count > 0 && _activeCount < _maximumConcurrentRequests) {
+    SCTKRevocationRequest *request = _queuedRequests.firstObject;
+    [_queuedRequests removeObjectAtIndex:0];
+    _activeCount++;
+    [SCTKAuthorizationService performRevocationRequest:request
+                                         callbackQueue:_queue
+                                              callback:^(NSError *_Nullable error) {
+      self->_activeCount--;
+      if (error) {
+        self->_errors[request.token] = error;
+      }
+      [self startQueuedRequests];
+    }];
+  }
+
+  if (_queuedRequests.count == 0 && _activeCount == 0 && _callback) {
+    NSDictionary<NSString *, NSError *> *errors = [_errors copy];
+    SCTKRevocationBatchCallback callback = _callback;
+    _callback = nil;
+    dispatch_async(_callbackQueue, ^{
+      callback(errors);
+    });
+  }
+}
+
+@end
+
 @implementation SCTKAuthorizationService
 
+#pragma mark - Callback Queue
+
++ (dispatch_queue_t)defaultCallbackQueue {
+  @synchronized([SCTKAuthorizationService class]) {
+    return gDefaultCallbackQueue ?: dispatch_get_main_queue();
+  }
+}
+
++ (void)setDefaultCallbackQueue:(nullable dispatch_queue_t)callbackQueue {
+  @synchronized([SCTKAuthorizationService class]) {
+    gDefaultCallbackQueue = callbackQueue;
+  }
+}
+
+#pragma mark - Discovery
+
 + (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
                                    completion:(SCTKDiscoveryCallback)completion {
   NSURL *fullDiscoveryURL =
@@ -325,15 +502,97 @@ NS_ASSUME_NONNULL_BEGIN
                                                  completion:completion];
 }
 
++ (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                callbackQueue:(dispatch_queue_t)callbackQueue
+                                   completion:(SCTKDiscoveryCallback)completion {
+  NSURL *fullDiscoveryURL =
+      [issuerURL URLByAppendingPathComponent:kOpenIDConfigurationWellKnownPath];
+
+  [[self class] discoverServiceConfigurationForDiscoveryURL:fullDiscoveryURL
+                                              callbackQueue:callbackQueue
+                                                 completion:completion];
+}
+
++ (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                         completion:(SCTKDiscoveryCallback)completion {
+  [[self class] discoverServiceConfigurationForDiscoveryURL:discoveryURL
+                                              callbackQueue:[self defaultCallbackQueue]
+                                                 completion:completion];
+}
+
 + (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
-    completion:(SCTKDiscoveryCallback)completion {
+                                      callbackQueue:(dispatch_queue_t)callbackQueue
+                                         completion:(SCTKDiscoveryCallback)completion {
+  SCTKServiceDiscoveryCache *cache = [SCTKServiceDiscoveryCache sharedCache];
+  SCTKServiceDiscoveryCacheEntry *cachedEntry = [cache entryForURL:discoveryURL];
+
+  // Returns a cached document without waiting for the network when it is fresh, or when a stale
+  // document may be revalidated in the background.
+  __block SCTKDiscoveryCallback pendingCompletion = completion;
+  if (cachedEntry && (cachedEntry.isFresh || cache.revalidatesInBackground)) {
+    SCTKServiceConfiguration *configuration =
+        [[SCTKServiceConfiguration alloc] initWithDiscoveryDocument:cachedEntry.discovery];
+    dispatch_async(callbackQueue, ^{
+      completion(configuration, nil);
+    });
+    if (cachedEntry.isFresh) {
+      return;
+    }
+    pendingCompletion = nil;
+  }
+
+  void (^deliver)(SCTKServiceConfiguration *_Nullable, NSError *_Nullable) =
+      ^(SCTKServiceConfiguration *_Nullable configuration, NSError *_Nullable error) {
+    SCTKDiscoveryCallback callback = pendingCompletion;
+    if (!callback) {
+      return;
+    }
+    dispatch_async(callbackQueue, ^{
+      callback(configuration, error);
+    });
+  };
+
+  NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:discoveryURL];
+  if (cachedEntry) {
+    // Revalidates with our own validators, so the 304 response reaches us rather than being
+    // answered from the URL cache of the session.
+    request.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    [cachedEntry addValidatorsToRequest:request];
+  }
+
+  id<SCTKHTTPTransport> transport =
+      [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileDiscovery];
+  id<SCTKHTTPTransportTask> task =
+      [SCTKResponseReader taskWithTransport:transport
+                                    request:request
+                                   endpoint:SCTKResponseReaderEndpointDiscovery
+                          completionHandler:^(NSData *_Nullable data,
+                                              NSURLResponse *_Nullable response,
+                                              NSError *_Nullable error) {
+    // An oversized document is reported as such, not as a connection error.
+    if ([SCTKResponseReader isResponseTooLargeError:error]) {
+      deliver(nil, error);
+      return;
+    }
+
+    // The cached document is still current. A 304 response has no body.
+    NSHTTPURLResponse *notModifiedResponse = (NSHTTPURLResponse *)response;
+    if (!error && cachedEntry && notModifiedResponse.statusCode == 304) {
+      SCTKServiceDiscoveryCacheEntry *renewedEntry =
+          [cache renewEntryWithNotModifiedResponse:notModifiedResponse forURL:discoveryURL];
+      SCTKServiceDiscovery *discovery = (renewedEntry ?: cachedEntry).discovery;
+      deliver([[SCTKServiceConfiguration alloc] initWithDiscoveryDocument:discovery], nil);
+      return;
+    }
 
-  NSURLSession *session = [SCTKURLSessionProvider session];
-  NSURLSessionDataTask *task =
-      [session dataTaskWithURL:discoveryURL
-             completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
-    // If we got any sort of error, just report it.
+    // If we got any sort of error, report it, unless there is a cached document to fall back on.
     if (error || !data) {
+      if (cachedEntry) {
+        deliver([[SCTKServiceConfiguration alloc]
+                    initWithDiscoveryDocument:cachedEntry.discovery],
+                nil);
+        return;
+      }
       NSString *errorDescription =
           [NSString stringWithFormat:@"Connection error fetching discovery document '%@': %@.",
                                      discoveryURL,
@@ -341,9 +600,7 @@ NS_ASSUME_NONNULL_BEGIN
       error = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
                                underlyingError:error
                                    description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
-        completion(nil, error);
-      });
+      deliver(nil, error);
       return;
     }
 
@@ -362,9 +619,7 @@ NS_ASSUME_NONNULL_BEGIN
       error = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
                                underlyingError:URLResponseError
                                    description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
-        completion(nil, error);
-      });
+      deliver(nil, error);
       return;
     }
 
@@ -379,18 +634,15 @@ NS_ASSUME_NONNULL_BEGIN
       error = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
                                underlyingError:error
                                    description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
-        completion(nil, error);
-      });
+      deliver(nil, error);
       return;
     }
+    [cache storeDiscovery:discovery response:urlResponse forURL:discoveryURL];
 
     // Create our service configuration with the discovery document and return it.
     SCTKServiceConfiguration *configuration =
         [[SCTKServiceConfiguration alloc] initWithDiscoveryDocument:discovery];
-    dispatch_async(dispatch_get_main_queue(), ^{
-      completion(configuration, nil);
-    });
+    deliver(configuration, nil);
   }];
   [task resume];
 }
@@ -429,240 +681,381 @@ NS_ASSUME_NONNULL_BEGIN
 + (void)performTokenRequest:(SCTKTokenRequest *)request
     originalAuthorizationResponse:(SCTKAuthorizationResponse *_Nullable)authorizationResponse
                          callback:(SCTKTokenCallback)callback {
+  [[self class] performTokenRequest:request
+      originalAuthorizationResponse:authorizationResponse
+                      callbackQueue:[self defaultCallbackQueue]
+                           callback:callback];
+}
+
++ (void)performTokenRequest:(SCTKTokenRequest *)request
+    originalAuthorizationResponse:(SCTKAuthorizationResponse *_Nullable)authorizationResponse
+                    callbackQueue:(dispatch_queue_t)callbackQueue
+                         callback:(SCTKTokenCallback)callback {
 
   NSURLRequest *URLRequest = [request URLRequest];
-  
+  id<SCTKHTTPTransport> transport =
+      [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileToken];
+
+  // joins an identical request in flight rather than sending this one
+  NSString *requestKey = [self keyForTokenURLRequest:URLRequest
+                               authorizationResponse:authorizationResponse];
+  NSMapTable *inFlightTokenRequests = SCTKInFlightTokenRequests();
+  NSMutableDictionary<NSString *, NSMutableArray<SCTKTokenCallback> *> *requestsInTransport;
+  @synchronized(inFlightTokenRequests) {
+    requestsInTransport = [inFlightTokenRequests objectForKey:transport];
+    if (!requestsInTransport) {
+      requestsInTransport = [NSMutableDictionary dictionary];
+      [inFlightTokenRequests setObject:requestsInTransport forKey:transport];
+    }
+    NSMutableArray<SCTKTokenCallback> *waitingCallbacks = requestsInTransport[requestKey];
+    if (waitingCallbacks) {
+      [waitingCallbacks addObject:^(SCTKTokenResponse *_Nullable tokenResponse,
+                                    NSError *_Nullable error) {
+        dispatch_async(callbackQueue, ^{
+          callback(tokenResponse, error);
+        });
+      }];
+      gCoalescedTokenRequestCount++;
+      AppAuthRequestTrace(@"Token Request: %@ joined an identical request in flight",
+                          URLRequest.URL);
+      return;
+    }
+    requestsInTransport[requestKey] = [NSMutableArray array];
+    gSentTokenRequestCount++;
+  }
+
   AppAuthRequestTrace(@"Token Request: %@\nHeaders:%@\nHTTPBody: %@",
                       URLRequest.URL,
                       URLRequest.allHTTPHeaderFields,
                       [[NSString alloc] initWithData:URLRequest.HTTPBody
                                             encoding:NSUTF8StringEncoding]);
 
-  NSURLSession *session = [SCTKURLSessionProvider session];
-  [[session dataTaskWithRequest:URLRequest
-              completionHandler:^(NSData *_Nullable data,
-                                  NSURLResponse *_Nullable response,
-                                  NSError *_Nullable error) {
-    if (error) {
-      // A network error or server error occurred.
-      NSString *errorDescription =
-          [NSString stringWithFormat:@"Connection error making token request to '%@': %@.",
-                                     URLRequest.URL,
-                                     error.localizedDescription];
-      NSError *returnedError =
-          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
-                           underlyingError:error
-                               description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
-        callback(nil, returnedError);
-      });
-      return;
-    }
+  NSDate *requestDate = [NSDate date];
+  [[SCTKResponseReader taskWithTransport:transport
+                                 request:URLRequest
+                                endpoint:SCTKResponseReaderEndpointToken
+                       completionHandler:^(NSData *_Nullable data,
+                                           NSURLResponse *_Nullable response,
+                                           NSError *_Nullable error) {
+    // the transport queue only receives the response, the rest is left to the pipeline
+    NSDate *responseDate = [NSDate date];
+    SCTKTokenResponsePipelineParseStage parse = ^id _Nullable(NSError **parseError) {
+      return [self tokenResponseForRequest:request
+                                URLRequest:URLRequest
+                               requestDate:requestDate
+                              responseDate:responseDate
+                                      data:data
+                                  response:response
+                           connectionError:error
+                                     error:parseError];
+    };
+    SCTKTokenResponsePipelineValidateStage validate = ^NSError *_Nullable(id tokenResponse) {
+      return [self validateIDTokenInTokenResponse:tokenResponse
+                            authorizationResponse:authorizationResponse];
+    };
+    SCTKTokenResponsePipelineDelivery delivery = ^(id _Nullable tokenResponse,
+                                                   NSError *_Nullable returnedError) {
+      NSArray<SCTKTokenCallback> *waitingCallbacks;
+      @synchronized(inFlightTokenRequests) {
+        waitingCallbacks = requestsInTransport[requestKey];
+        [requestsInTransport removeObjectForKey:requestKey];
+      }
+      callback(tokenResponse, returnedError);
+      for (SCTKTokenCallback waitingCallback in waitingCallbacks) {
+        waitingCallback(tokenResponse, returnedError);
+      }
+    };
+    [[SCTKTokenResponsePipeline sharedPipeline] processResponseForURL:URLRequest.URL
+                                                          requestDate:requestDate
+                                                                parse:parse
+                                                             validate:validate
+                                                        callbackQueue:callbackQueue
+                                                             delivery:delivery];
+  }] resume];
+}
 
-    NSHTTPURLResponse *HTTPURLResponse = (NSHTTPURLResponse *)response;
-    NSInteger statusCode = HTTPURLResponse.statusCode;
-    AppAuthRequestTrace(@"Token Response: HTTP Status %d\nHTTPBody: %@",
-                        (int)statusCode,
-                        [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]);
-    if (statusCode != 200) {
-      // A server error occurred.
-      NSError *serverError =
-          [SCTKErrorUtilities HTTPErrorWithHTTPResponse:HTTPURLResponse data:data];
++ (NSUInteger)sentTokenRequestCount {
+  NSMapTable *inFlightTokenRequests = SCTKInFlightTokenRequests();
+  @synchronized(inFlightTokenRequests) {
+    return gSentTokenRequestCount;
+  }
+}
 
-      // HTTP 4xx may indicate an RFC6749 Section 5.2 error response, attempts to parse as such.
-      if (statusCode >= 400 && statusCode < 500) {
-        NSError *jsonDeserializationError;
-        NSDictionary<NSString *, NSObject<NSCopying> *> *json =
-            [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonDeserializationError];
++ (NSUInteger)coalescedTokenRequestCount {
+  NSMapTable *inFlightTokenRequests = SCTKInFlightTokenRequests();
+  @synchronized(inFlightTokenRequests) {
+    return gCoalescedTokenRequestCount;
+  }
+}
 
-        // If the HTTP 4xx response parses as JSON and has an 'error' key, it's an OAuth error.
-        // These errors are special as they indicate a problem with the authorization grant.
-        if (json[SCTKOAuthErrorFieldError]) {
-          NSError *oauthError =
-            [SCTKErrorUtilities OAuthErrorWithDomain:SCTKOAuthTokenErrorDomain
-                                      OAuthResponse:json
-                                    underlyingError:serverError];
-          dispatch_async(dispatch_get_main_queue(), ^{
-            callback(nil, oauthError);
-          });
-          return;
-        }
-      }
+/*! @brief Returns the key identifying identical token requests: the token endpoint and a SHA-256
+        hash of the body parameters in canonical order, the client authentication, and the nonce
+        the ID Token is validated against.
+    @param URLRequest The URL request made for the token request.
+    @param authorizationResponse The original authorization response related to the token request.
+ */
++ (NSString *)keyForTokenURLRequest:(NSURLRequest *)URLRequest
+              authorizationResponse:(nullable SCTKAuthorizationResponse *)authorizationResponse {
+  NSString *body = [[NSString alloc] initWithData:URLRequest.HTTPBody ?: [NSData data]
+                                         encoding:NSUTF8StringEncoding];
+  NSArray<NSString *> *parameters =
+      [[body componentsSeparatedByString:@"&"] sortedArrayUsingSelector:@selector(compare:)];
+  NSString *canonicalRequest =
+      [NSString stringWithFormat:@"%@\n%@\n%@",
+                                 [parameters componentsJoinedByString:@"&"],
+                                 [URLRequest valueForHTTPHeaderField:@"Authorization"] ?: @"",
+                                 authorizationResponse.request.nonce ?: @""];
+  NSString *hash =
+      [SCTKTokenUtilities encodeBase64urlNoPadding:[SCTKTokenUtilities sha256:canonicalRequest]];
+  return [NSString stringWithFormat:@"%@ %@", URLRequest.URL.absoluteString, hash];
+}
 
-      // Status code indicates this is an error, but not an RFC6749 Section 5.2 error.
-      NSString *errorDescription =
-          [NSString stringWithFormat:@"Non-200 HTTP response (%d) making token request to '%@'.",
-                                     (int)statusCode,
-                                      URLRequest.URL];
-      NSError *returnedError =
-          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeServerError
-                           underlyingError:serverError
-                               description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
-        callback(nil, returnedError);
-      });
-      return;
-    }
+/*! @brief The parse stage of a token response: interprets the HTTP response and deserializes its
+        body into a token response.
+    @param request The token request.
+    @param URLRequest The URL request made for @c request.
+    @param requestDate When the request was sent.
+    @param responseDate When the response was received.
+    @param data The body of the HTTP response.
+    @param response The HTTP response.
+    @param connectionError The error of the URL session task, if any.
+    @param error Set if there is no token response.
+    @return The token response, or nil if @c error was set.
+ */
++ (nullable SCTKTokenResponse *)tokenResponseForRequest:(SCTKTokenRequest *)request
+                                             URLRequest:(NSURLRequest *)URLRequest
+                                            requestDate:(NSDate *)requestDate
+                                           responseDate:(NSDate *)responseDate
+                                                   data:(nullable NSData *)data
+                                               response:(nullable NSURLResponse *)response
+                                        connectionError:(nullable NSError *)connectionError
+                                                  error:(NSError **)error {
+  // identifies the server clock for skew estimation
+  NSURL *skewIssuer = request.configuration.issuer ?: request.configuration.tokenEndpoint;
+
+  if ([SCTKResponseReader isResponseTooLargeError:connectionError]) {
+    // An oversized response is reported as such, not as a connection error.
+    *error = connectionError;
+    return nil;
+  }
 
-    NSError *jsonDeserializationError;
-    NSDictionary<NSString *, NSObject<NSCopying> *> *json =
-        [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonDeserializationError];
-    if (jsonDeserializationError) {
-      // A problem occurred deserializing the response/JSON.
-      NSString *errorDescription =
-          [NSString stringWithFormat:@"JSON error parsing token response: %@",
-                                     jsonDeserializationError.localizedDescription];
-      NSError *returnedError =
-          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeJSONDeserializationError
-                           underlyingError:jsonDeserializationError
-                               description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
-        callback(nil, returnedError);
-      });
-      return;
-    }
+  if (connectionError) {
+    // A network error or server error occurred.
+    NSString *errorDescription =
+        [NSString stringWithFormat:@"Connection error making token request to '%@': %@.",
+                                   URLRequest.URL,
+                                   connectionError.localizedDescription];
+    NSError *returnedError =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
+                         underlyingError:connectionError
+                             description:errorDescription];
+    *error = returnedError;
+    return nil;
+  }
 
-    SCTKTokenResponse *tokenResponse =
-        [[SCTKTokenResponse alloc] initWithRequest:request parameters:json];
-    if (!tokenResponse) {
-      // A problem occurred constructing the token response from the JSON.
-      NSError *returnedError =
-          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeTokenResponseConstructionError
-                           underlyingError:jsonDeserializationError
-                               description:@"Token response invalid."];
-      dispatch_async(dispatch_get_main_queue(), ^{
-        callback(nil, returnedError);
-      });
-      return;
-    }
+  NSHTTPURLResponse *HTTPURLResponse = (NSHTTPURLResponse *)response;
+  NSString *dateHeader = HTTPURLResponse.allHeaderFields[@"Date"];
+  NSDate *serverDate =
+      dateHeader ? [SCTKClockSkewEstimator dateFromHTTPDateHeader:dateHeader] : nil;
+  if (serverDate && skewIssuer) {
+    [[SCTKClockSkewEstimator sharedEstimator] recordServerDate:serverDate
+                                                   requestDate:requestDate
+                                                  responseDate:responseDate
+                                                     forIssuer:skewIssuer];
+  }
 
-    // If an ID Token is included in the response, validates the ID Token following the rules
-    // in OpenID Connect Core Section 3.1.3.7 for features that AppAuth directly supports
-    // (which excludes rules #1, #4, #5, #7, #8, #12, and #13). Regarding rule #6, ID Tokens
-    // received by this class are received via direct communication between the Client and the Token
-    // Endpoint, thus we are exercising the option to rely only on the TLS validation. AppAuth
-    // has a zero dependencies policy, and verifying the JWT signature would add a dependency.
-    // Users of the library are welcome to perform the JWT signature verification themselves should
-    // they wish.
-    if (tokenResponse.idToken) {
-      SCTKIDToken *idToken = [[SCTKIDToken alloc] initWithIDTokenString:tokenResponse.idToken];
-      if (!idToken) {
-        NSError *invalidIDToken =
-          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenParsingError
-                           underlyingError:nil
-                               description:@"ID Token parsing failed"];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
+  NSInteger statusCode = HTTPURLResponse.statusCode;
+  AppAuthRequestTrace(@"Token Response: HTTP Status %d\nHTTPBody: %@",
+                      (int)statusCode,
+                      [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]);
+  if (statusCode != 200) {
+    // A server error occurred.
+    NSError *serverError =
+        [SCTKErrorUtilities HTTPErrorWithHTTPResponse:HTTPURLResponse data:data];
+
+    // HTTP 4xx may indicate an RFC6749 Section 5.2 error response, attempts to parse as such.
+    if (statusCode >= 400 && statusCode < 500) {
+      NSError *jsonDeserializationError;
+      NSDictionary<NSString *, NSObject<NSCopying> *> *json =
+          [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonDeserializationError];
+
+      // If the HTTP 4xx response parses as JSON and has an 'error' key, it's an OAuth error.
+      // These errors are special as they indicate a problem with the authorization grant.
+      if (json[SCTKOAuthErrorFieldError]) {
+        NSError *oauthError =
+          [SCTKErrorUtilities OAuthErrorWithDomain:SCTKOAuthTokenErrorDomain
+                                    OAuthResponse:json
+                                  underlyingError:serverError];
+        *error = oauthError;
+        return nil;
       }
-      
-      // OpenID Connect Core Section 3.1.3.7. rule #1
-      // Not supported: AppAuth does not support JWT encryption.
+    }
 
-      // OpenID Connect Core Section 3.1.3.7. rule #2
-      // Validates that the issuer in the ID Token matches that of the discovery document.
-      NSURL *issuer = tokenResponse.request.configuration.issuer;
-      if (issuer && ![idToken.issuer isEqual:issuer]) {
-        NSError *invalidIDToken =
-          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
-                           underlyingError:nil
-                               description:@"Issuer mismatch"];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
-      }
+    // Status code indicates this is an error, but not an RFC6749 Section 5.2 error.
+    NSString *errorDescription =
+        [NSString stringWithFormat:@"Non-200 HTTP response (%d) making token request to '%@'.",
+                                   (int)statusCode,
+                                    URLRequest.URL];
+    NSError *returnedError =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeServerError
+                         underlyingError:serverError
+                             description:errorDescription];
+    *error = returnedError;
+    return nil;
+  }
 
-      // OpenID Connect Core Section 3.1.3.7. rule #3 & Section 2 azp Claim
-      // Validates that the aud (audience) Claim contains the client ID, or that the azp
-      // (authorized party) Claim matches the client ID.
-      NSString *clientID = tokenResponse.request.clientID;
-      if (![idToken.audience containsObject:clientID] &&
-          ![idToken.claims[@"azp"] isEqualToString:clientID]) {
-        NSError *invalidIDToken =
-          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
-                           underlyingError:nil
-                               description:@"Audience mismatch"];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
-      }
-      
-      // OpenID Connect Core Section 3.1.3.7. rules #4 & #5
-      // Not supported.
-
-      // OpenID Connect Core Section 3.1.3.7. rule #6
-      // As noted above, AppAuth only supports the code flow which results in direct communication
-      // of the ID Token from the Token Endpoint to the Client, and we are exercising the option to
-      // use TSL server validation instead of checking the token signature. Users may additionally
-      // check the token signature should they wish.
-
-      // OpenID Connect Core Section 3.1.3.7. rules #7 & #8
-      // Not applicable. See rule #6.
-
-      // OpenID Connect Core Section 3.1.3.7. rule #9
-      // Validates that the current time is before the expiry time.
-      NSTimeInterval expiresAtDifference = [idToken.expiresAt timeIntervalSinceNow];
-      if (expiresAtDifference < 0) {
-        NSError *invalidIDToken =
-            [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
-                             underlyingError:nil
-                                 description:@"ID Token expired"];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
-      }
-      
-      // OpenID Connect Core Section 3.1.3.7. rule #10
-      // Validates that the issued at time is not more than +/- 10 minutes on the current time.
-      NSTimeInterval issuedAtDifference = [idToken.issuedAt timeIntervalSinceNow];
-      if (fabs(issuedAtDifference) > kOIDAuthorizationSessionIATMaxSkew) {
-        NSString *message =
-            [NSString stringWithFormat:@"Issued at time is more than %d seconds before or after "
-                                        "the current time",
-                                       kOIDAuthorizationSessionIATMaxSkew];
-        NSError *invalidIDToken =
-          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
-                           underlyingError:nil
-                               description:message];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
-      }
+  NSError *jsonDeserializationError;
+  NSDictionary<NSString *, NSObject<NSCopying> *> *json =
+      [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonDeserializationError];
+  if (jsonDeserializationError) {
+    // A problem occurred deserializing the response/JSON.
+    NSString *errorDescription =
+        [NSString stringWithFormat:@"JSON error parsing token response: %@",
+                                   jsonDeserializationError.localizedDescription];
+    NSError *returnedError =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeJSONDeserializationError
+                         underlyingError:jsonDeserializationError
+                             description:errorDescription];
+    *error = returnedError;
+    return nil;
+  }
+
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:request
+                                      parameters:json
+                                     requestDate:requestDate];
+  if (!tokenResponse) {
+    // A problem occurred constructing the token response from the JSON.
+    NSError *returnedError =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeTokenResponseConstructionError
+                         underlyingError:jsonDeserializationError
+                             description:@"Token response invalid."];
+    *error = returnedError;
+    return nil;
+  }
 
-      // Only relevant for the authorization_code response type
-      if ([tokenResponse.request.grantType isEqual:SCTKGrantTypeAuthorizationCode]) {
-        // OpenID Connect Core Section 3.1.3.7. rule #11
-        // Validates the nonce.
-        NSString *nonce = authorizationResponse.request.nonce;
-        if (nonce && ![idToken.nonce isEqual:nonce]) {
-          NSError *invalidIDToken =
+  return tokenResponse;
+}
+
+/*! @brief The validate stage of a token response.
+    @param tokenResponse The token response of the parse stage.
+    @param authorizationResponse The authorization response the tokens were requested for, if any.
+    @return An error if the ID Token of the response is invalid, otherwise nil.
+ */
++ (nullable NSError *)validateIDTokenInTokenResponse:(SCTKTokenResponse *)tokenResponse
+    authorizationResponse:(nullable SCTKAuthorizationResponse *)authorizationResponse {
+  // If an ID Token is included in the response, validates the ID Token following the rules
+  // in OpenID Connect Core Section 3.1.3.7 for features that AppAuth directly supports
+  // (which excludes rules #1, #4, #5, #7, #8, #12, and #13). Regarding rule #6, ID Tokens
+  // received by this class are received via direct communication between the Client and the Token
+  // Endpoint, thus we are exercising the option to rely only on the TLS validation. AppAuth
+  // has a zero dependencies policy, and verifying the JWT signature would add a dependency.
+  // Users of the library are welcome to perform the JWT signature verification themselves should
+  // they wish.
+  if (tokenResponse.idToken) {
+    SCTKIDToken *idToken = [[SCTKIDToken alloc] initWithIDTokenString:tokenResponse.idToken];
+    if (!idToken) {
+      NSError *invalidIDToken =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenParsingError
+                         underlyingError:nil
+                             description:@"ID Token parsing failed"];
+      return invalidIDToken;
+    }
+    
+    // OpenID Connect Core Section 3.1.3.7. rule #1
+    // Not supported: AppAuth does not support JWT encryption.
+
+    // OpenID Connect Core Section 3.1.3.7. rule #2
+    // Validates that the issuer in the ID Token matches that of the discovery document.
+    NSURL *issuer = tokenResponse.request.configuration.issuer;
+    if (issuer && ![idToken.issuer isEqual:issuer]) {
+      NSError *invalidIDToken =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
+                         underlyingError:nil
+                             description:@"Issuer mismatch"];
+      return invalidIDToken;
+    }
+
+    // OpenID Connect Core Section 3.1.3.7. rule #3 & Section 2 azp Claim
+    // Validates that the aud (audience) Claim contains the client ID, or that the azp
+    // (authorized party) Claim matches the client ID.
+    NSString *clientID = tokenResponse.request.clientID;
+    if (![idToken.audience containsObject:clientID] &&
+        ![idToken.claims[@"azp"] isEqualToString:clientID]) {
+      NSError *invalidIDToken =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
+                         underlyingError:nil
+                             description:@"Audience mismatch"];
+      return invalidIDToken;
+    }
+    
+    // OpenID Connect Core Section 3.1.3.7. rules #4 & #5
+    // Not supported.
+
+    // OpenID Connect Core Section 3.1.3.7. rule #6
+    // As noted above, AppAuth only supports the code flow which results in direct communication
+    // of the ID Token from the Token Endpoint to the Client, and we are exercising the option to
+    // use TSL server validation instead of checking the token signature. Users may additionally
+    // check the token signature should they wish.
+
+    // OpenID Connect Core Section 3.1.3.7. rules #7 & #8
+    // Not applicable. See rule #6.
+
+    // The ID Token times are set by the server clock, compares them with the current time by the
+    // server clock, as estimated from the Date headers of its responses.
+    SCTKServiceConfiguration *configuration = tokenResponse.request.configuration;
+    NSURL *skewIssuer = configuration.issuer ?: configuration.tokenEndpoint;
+    NSDate *serverNow =
+        [[SCTKClockSkewEstimator sharedEstimator] currentServerDateForIssuer:skewIssuer];
+
+    // OpenID Connect Core Section 3.1.3.7. rule #9
+    // Validates that the current time is before the expiry time.
+    NSTimeInterval expiresAtDifference = [idToken.expiresAt timeIntervalSinceDate:serverNow];
+    if (expiresAtDifference < 0) {
+      NSError *invalidIDToken =
           [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
                            underlyingError:nil
-                               description:@"Nonce mismatch"];
-          dispatch_async(dispatch_get_main_queue(), ^{
-            callback(nil, invalidIDToken);
-          });
-          return;
-        }
-      }
-      
-      // OpenID Connect Core Section 3.1.3.7. rules #12
-      // ACR is not directly supported by AppAuth.
+                               description:@"ID Token expired"];
+      return invalidIDToken;
+    }
+    
+    // OpenID Connect Core Section 3.1.3.7. rule #10
+    // Validates that the issued at time is not more than +/- 10 minutes on the current time.
+    NSTimeInterval issuedAtDifference = [idToken.issuedAt timeIntervalSinceDate:serverNow];
+    if (fabs(issuedAtDifference) > kOIDAuthorizationSessionIATMaxSkew) {
+      NSString *message =
+          [NSString stringWithFormat:@"Issued at time is more than %d seconds before or after "
+                                      "the current time",
+                                     kOIDAuthorizationSessionIATMaxSkew];
+      NSError *invalidIDToken =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
+                         underlyingError:nil
+                             description:message];
+      return invalidIDToken;
+    }
 
-      // OpenID Connect Core Section 3.1.3.7. rules #12
-      // max_age is not directly supported by AppAuth.
+    // Only relevant for the authorization_code response type
+    if ([tokenResponse.request.grantType isEqual:SCTKGrantTypeAuthorizationCode]) {
+      // OpenID Connect Core Section 3.1.3.7. rule #11
+      // Validates the nonce.
+      NSString *nonce = authorizationResponse.request.nonce;
+      if (nonce && ![idToken.nonce isEqual:nonce]) {
+        NSError *invalidIDToken =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
+                         underlyingError:nil
+                             description:@"Nonce mismatch"];
+        return invalidIDToken;
+      }
     }
+    
+    // OpenID Connect Core Section 3.1.3.7. rules #12
+    // ACR is not directly supported by AppAuth.
 
-    // Success
-    dispatch_async(dispatch_get_main_queue(), ^{
-      callback(tokenResponse, nil);
-    });
-  }] resume];
+    // OpenID Connect Core Section 3.1.3.7. rules #12
+    // max_age is not directly supported by AppAuth.
+  }
+
+  return nil;
 }
 
 
@@ -670,6 +1063,14 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (void)performRegistrationRequest:(SCTKRegistrationRequest *)request
                           completion:(SCTKRegistrationCompletion)completion {
+  [[self class] performRegistrationRequest:request
+                             callbackQueue:[self defaultCallbackQueue]
+                                completion:completion];
+}
+
++ (void)performRegistrationRequest:(SCTKRegistrationRequest *)request
+                     callbackQueue:(dispatch_queue_t)callbackQueue
+                        completion:(SCTKRegistrationCompletion)completion {
   NSURLRequest *URLRequest = [request URLRequest];
   if (!URLRequest) {
     // A problem occurred deserializing the response/JSON.
@@ -677,17 +1078,28 @@ NS_ASSUME_NONNULL_BEGIN
                                               underlyingError:nil
                                                   description:@"The registration request could not "
                                                                "be serialized as JSON."];
-    dispatch_async(dispatch_get_main_queue(), ^{
+    dispatch_async(callbackQueue, ^{
       completion(nil, returnedError);
     });
     return;
   }
 
-  NSURLSession *session = [SCTKURLSessionProvider session];
-  [[session dataTaskWithRequest:URLRequest
-              completionHandler:^(NSData *_Nullable data,
-                                  NSURLResponse *_Nullable response,
-                                  NSError *_Nullable error) {
+  id<SCTKHTTPTransport> transport =
+      [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileRegistration];
+  [[SCTKResponseReader taskWithTransport:transport
+                                 request:URLRequest
+                                endpoint:SCTKResponseReaderEndpointRegistration
+                       completionHandler:^(NSData *_Nullable data,
+                                           NSURLResponse *_Nullable response,
+                                           NSError *_Nullable error) {
+    // An oversized response is reported as such, not as a connection error.
+    if ([SCTKResponseReader isResponseTooLargeError:error]) {
+      dispatch_async(callbackQueue, ^{
+        completion(nil, error);
+      });
+      return;
+    }
+
     if (error) {
       // A network error or server error occurred.
       NSString *errorDescription =
@@ -697,7 +1109,7 @@ NS_ASSUME_NONNULL_BEGIN
       NSError *returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
                                                 underlyingError:error
                                                     description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         completion(nil, returnedError);
       });
       return;
@@ -724,7 +1136,7 @@ NS_ASSUME_NONNULL_BEGIN
               [SCTKErrorUtilities OAuthErrorWithDomain:SCTKOAuthRegistrationErrorDomain
                                         OAuthResponse:json
                                       underlyingError:serverError];
-          dispatch_async(dispatch_get_main_queue(), ^{
+          dispatch_async(callbackQueue, ^{
             completion(nil, oauthError);
           });
           return;
@@ -740,7 +1152,7 @@ NS_ASSUME_NONNULL_BEGIN
       NSError *returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeServerError
                                                 underlyingError:serverError
                                                     description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         completion(nil, returnedError);
       });
       return;
@@ -757,7 +1169,7 @@ NS_ASSUME_NONNULL_BEGIN
       NSError *returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeJSONDeserializationError
                                                 underlyingError:jsonDeserializationError
                                                     description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         completion(nil, returnedError);
       });
       return;
@@ -772,19 +1184,513 @@ NS_ASSUME_NONNULL_BEGIN
           [SCTKErrorUtilities errorWithCode:SCTKErrorCodeRegistrationResponseConstructionError
                            underlyingError:nil
                                description:@"Registration response invalid."];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         completion(nil, returnedError);
       });
       return;
     }
 
     // Success
-    dispatch_async(dispatch_get_main_queue(), ^{
+    dispatch_async(callbackQueue, ^{
       completion(registrationResponse, nil);
     });
   }] resume];
 }
 
+#pragma mark - UserInfo Endpoint
+
++ (void)performUserInfoRequestWithAuthState:(SCTKAuthState *)authState
+                                   callback:(SCTKUserInfoCallback)callback {
+  [[self class] performUserInfoRequestWithAuthState:authState
+                                      callbackQueue:[self defaultCallbackQueue]
+                                           callback:callback];
+}
+
++ (void)performUserInfoRequestWithAuthState:(SCTKAuthState *)authState
+                              callbackQueue:(dispatch_queue_t)callbackQueue
+                                   callback:(SCTKUserInfoCallback)callback {
+  SCTKServiceConfiguration *configuration =
+      authState.lastTokenResponse.request.configuration
+          ?: authState.lastAuthorizationResponse.request.configuration;
+  NSURL *userinfoEndpoint = configuration.discoveryDocument.userinfoEndpoint;
+  if (!userinfoEndpoint) {
+    NSError *error =
+        [SCTKErrorUtilities errorWithCode:SCTKErrorCodeEndpointNotConfiguredError
+                         underlyingError:nil
+                             description:@"The discovery document has no userinfo endpoint."];
+    dispatch_async(callbackQueue, ^{
+      callback(nil, error);
+    });
+    return;
+  }
+
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    if (error || !accessToken) {
+      callback(nil, error);
+      return;
+    }
+
+    SCTKIDToken *parsedIDToken =
+        idToken ? [[SCTKIDToken alloc] initWithIDTokenString:idToken] : nil;
+    NSString *subject = parsedIDToken.subject;
+    NSString *issuer = parsedIDToken.issuer.absoluteString;
+    NSString *clientID = authState.lastTokenResponse.request.clientID
+        ?: authState.lastAuthorizationResponse.request.clientID;
+    // the generation is only known if the snapshot still holds the token being sent; the token
+    // and the generation are read together from one snapshot
+    SCTKAuthStateTokenSnapshot *tokenSnapshot = authState.tokenSnapshot;
+    BOOL cacheable = subject && issuer && clientID
+        && [tokenSnapshot.accessToken isEqualToString:accessToken];
+    uint64_t generation = tokenSnapshot.generation;
+    SCTKUserInfoCache *cache = [SCTKUserInfoCache sharedCache];
+    SCTKUserInfoResponse *cachedUserInfo = cacheable ? [cache userInfoForIssuer:issuer
+                                                                       clientID:clientID
+                                                                        subject:subject
+                                                                    accessToken:accessToken
+                                                                     generation:generation]
+                                                     : nil;
+    if (cachedUserInfo) {
+      callback(cachedUserInfo, nil);
+      return;
+    }
+
+    [[self class] performUserInfoRequestToEndpoint:userinfoEndpoint
+                                       accessToken:accessToken
+                                     callbackQueue:callbackQueue
+                                          callback:^(SCTKUserInfoResponse *_Nullable userInfo,
+                                                     NSError *_Nullable userInfoError) {
+      if (!userInfo) {
+        // a rejected access token puts the auth state into an error state
+        if ([userInfoError.domain isEqualToString:SCTKResourceServerAuthorizationErrorDomain]) {
+          [authState updateWithAuthorizationError:userInfoError];
+        }
+        callback(nil, userInfoError);
+        return;
+      }
+
+      // https://openid.net/specs/openid-connect-core-1_0.html#UserInfoResponse
+      // "The sub Claim in the UserInfo Response MUST be verified to exactly match the sub Claim in
+      // the ID Token; if they do not match, the UserInfo Response values MUST NOT be used."
+      if (subject && ![userInfo.subject isEqualToString:subject]) {
+        NSString *errorDescription =
+            [NSString stringWithFormat:@"Userinfo subject \"%@\" does not match the ID Token "
+                                       "subject \"%@\".",
+                                       userInfo.subject,
+                                       subject];
+        callback(nil,
+                 [SCTKErrorUtilities errorWithCode:SCTKErrorCodeUserInfoSubjectMismatchError
+                                  underlyingError:nil
+                                      description:errorDescription]);
+        return;
+      }
+
+      if (cacheable) {
+        [cache storeUserInfo:userInfo
+                   forIssuer:issuer
+                    clientID:clientID
+                 accessToken:accessToken
+                  generation:generation];
+      }
+      callback(userInfo, nil);
+    }];
+  }
+      additionalRefreshParameters:nil
+                    dispatchQueue:callbackQueue];
+}
+
++ (void)performUserInfoRequestToEndpoint:(NSURL *)userinfoEndpoint
+                             accessToken:(NSString *)accessToken
+                           callbackQueue:(dispatch_queue_t)callbackQueue
+                                callback:(SCTKUserInfoCallback)callback {
+  NSMutableURLRequest *URLRequest = [NSMutableURLRequest requestWithURL:userinfoEndpoint];
+  NSString *authorizationHeaderValue = [NSString stringWithFormat:@"Bearer %@", accessToken];
+  [URLRequest setValue:authorizationHeaderValue forHTTPHeaderField:@"Authorization"];
+  [URLRequest setValue:@"application/json" forHTTPHeaderField:@"Accept"];
+
+  AppAuthRequestTrace(@"Userinfo Request: %@", userinfoEndpoint);
+
+  id<SCTKHTTPTransport> transport =
+      [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileToken];
+  [[SCTKResponseReader taskWithTransport:transport
+                                 request:URLRequest
+                                endpoint:SCTKResponseReaderEndpointUserInfo
+                       completionHandler:^(NSData *_Nullable data,
+                                           NSURLResponse *_Nullable response,
+                                           NSError *_Nullable error) {
+    if ([SCTKResponseReader isResponseTooLargeError:error]) {
+      dispatch_async(callbackQueue, ^{
+        callback(nil, error);
+      });
+      return;
+    }
+
+    if (error || !data) {
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Connection error making userinfo request to '%@': %@.",
+                                     userinfoEndpoint,
+                                     error.localizedDescription];
+      NSError *returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
+                                                underlyingError:error
+                                                    description:errorDescription];
+      dispatch_async(callbackQueue, ^{
+        callback(nil, returnedError);
+      });
+      return;
+    }
+
+    NSHTTPURLResponse *HTTPURLResponse = (NSHTTPURLResponse *)response;
+    AppAuthRequestTrace(@"Userinfo Response: HTTP Status %d", (int)HTTPURLResponse.statusCode);
+
+    if (HTTPURLResponse.statusCode != 200) {
+      NSError *serverError = [SCTKErrorUtilities HTTPErrorWithHTTPResponse:HTTPURLResponse
+                                                                     data:data];
+      NSError *returnedError;
+      // https://openid.net/specs/openid-connect-core-1_0.html#UserInfoError
+      if (HTTPURLResponse.statusCode == 401 || HTTPURLResponse.statusCode == 403) {
+        id json = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+        NSDictionary *errorResponse = [json isKindOfClass:[NSDictionary class]] ? json : nil;
+        returnedError =
+            [SCTKErrorUtilities resourceServerAuthorizationErrorWithCode:0
+                                                          errorResponse:errorResponse
+                                                        underlyingError:serverError];
+      } else {
+        NSString *errorDescription =
+            [NSString stringWithFormat:@"Non-200 HTTP response (%d) making userinfo request to "
+                                       "'%@'.",
+                                       (int)HTTPURLResponse.statusCode,
+                                       userinfoEndpoint];
+        returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeServerError
+                                         underlyingError:serverError
+                                             description:errorDescription];
+      }
+      dispatch_async(callbackQueue, ^{
+        callback(nil, returnedError);
+      });
+      return;
+    }
+
+    NSError *jsonDeserializationError;
+    id json = [NSJSONSerialization JSONObjectWithData:data
+                                              options:0
+                                                error:&jsonDeserializationError];
+    SCTKUserInfoResponse *userInfo = [json isKindOfClass:[NSDictionary class]]
+        ? [[SCTKUserInfoResponse alloc] initWithClaims:json]
+        : nil;
+    if (!userInfo) {
+      // Signed or encrypted (application/jwt) responses are not supported.
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Userinfo response is not a JSON object with a subject: %@",
+                                     jsonDeserializationError.localizedDescription];
+      NSError *returnedError =
+          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeJSONDeserializationError
+                           underlyingError:jsonDeserializationError
+                               description:errorDescription];
+      dispatch_async(callbackQueue, ^{
+        callback(nil, returnedError);
+      });
+      return;
+    }
+
+    dispatch_async(callbackQueue, ^{
+      callback(userInfo, nil);
+    });
+  }] resume];
+}
+
+#pragma mark - Revocation Endpoint
+
++ (void)performRevocationRequest:(SCTKRevocationRequest *)request
+                        callback:(SCTKRevocationCallback)callback {
+  [[self class] performRevocationRequest:request
+                           callbackQueue:[self defaultCallbackQueue]
+                                callback:callback];
+}
+
++ (void)performRevocationRequest:(SCTKRevocationRequest *)request
+                   callbackQueue:(dispatch_queue_t)callbackQueue
+                        callback:(SCTKRevocationCallback)callback {
+  NSURLRequest *URLRequest = [request URLRequest];
+  AppAuthRequestTrace(@"Revocation Request: %@\nHeaders:%@\nHTTPBody: %@",
+                      URLRequest.URL,
+                      URLRequest.allHTTPHeaderFields,
+                      [[NSString alloc] initWithData:URLRequest.HTTPBody
+                                            encoding:NSUTF8StringEncoding]);
+
+  id<SCTKHTTPTransport> transport =
+      [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileToken];
+  [[SCTKResponseReader taskWithTransport:transport
+                                 request:URLRequest
+                                endpoint:SCTKResponseReaderEndpointRevocation
+                       completionHandler:^(NSData *_Nullable data,
+                                           NSURLResponse *_Nullable response,
+                                           NSError *_Nullable error) {
+    if ([SCTKResponseReader isResponseTooLargeError:error]) {
+      dispatch_async(callbackQueue, ^{
+        callback(error);
+      });
+      return;
+    }
+
+    if (error) {
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Connection error making revocation request to '%@': %@.",
+                                     URLRequest.URL,
+                                     error.localizedDescription];
+      NSError *returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
+                                                underlyingError:error
+                                                    description:errorDescription];
+      dispatch_async(callbackQueue, ^{
+        callback(returnedError);
+      });
+      return;
+    }
+
+    NSHTTPURLResponse *HTTPURLResponse = (NSHTTPURLResponse *)response;
+    AppAuthRequestTrace(@"Revocation Response: HTTP Status %d", (int)HTTPURLResponse.statusCode);
+
+    // https://tools.ietf.org/html/rfc7009#section-2.2
+    // "The content of the response body is ignored by the client as all necessary information is
+    // conveyed in the response code."
+    if (HTTPURLResponse.statusCode == 200) {
+      dispatch_async(callbackQueue, ^{
+        callback(nil);
+      });
+      return;
+    }
+
+    NSError *serverError = [SCTKErrorUtilities HTTPErrorWithHTTPResponse:HTTPURLResponse
+                                                                   data:data];
+
+    // https://tools.ietf.org/html/rfc7009#section-2.2.1
+    if (HTTPURLResponse.statusCode == 400 && data) {
+      id json = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+      if ([json isKindOfClass:[NSDictionary class]] && json[SCTKOAuthErrorFieldError]) {
+        NSError *oauthError =
+            [SCTKErrorUtilities OAuthErrorWithDomain:SCTKOAuthRevocationErrorDomain
+                                      OAuthResponse:json
+                                    underlyingError:serverError];
+        dispatch_async(callbackQueue, ^{
+          callback(oauthError);
+        });
+        return;
+      }
+    }
+
+    NSString *errorDescription =
+        [NSString stringWithFormat:@"Non-200 HTTP response (%d) making revocation request to "
+                                   "'%@'.",
+                                   (int)HTTPURLResponse.statusCode,
+                                   URLRequest.URL];
+    NSError *returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeServerError
+                                              underlyingError:serverError
+                                                  description:errorDescription];
+    dispatch_async(callbackQueue, ^{
+      callback(returnedError);
+    });
+  }] resume];
+}
+
++ (void)performRevocationRequests:(NSArray<SCTKRevocationRequest *> *)requests
+                         callback:(SCTKRevocationBatchCallback)callback {
+  NSUInteger maximumConcurrentRequests =
+      SCTKAuthorizationServiceDefaultMaximumConcurrentRevocations;
+  [[self class] performRevocationRequests:requests
+                maximumConcurrentRequests:maximumConcurrentRequests
+                            callbackQueue:[self defaultCallbackQueue]
+                                 callback:callback];
+}
+
++ (void)performRevocationRequests:(NSArray<SCTKRevocationRequest *> *)requests
+        maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+                    callbackQueue:(dispatch_queue_t)callbackQueue
+                         callback:(SCTKRevocationBatchCallback)callback {
+  SCTKRevocationBatch *batch =
+      [[SCTKRevocationBatch alloc] initWithRequests:requests
+                                             errors:@{}
+                          maximumConcurrentRequests:maximumConcurrentRequests
+                                      callbackQueue:callbackQueue
+                                           callback:callback];
+  [batch start];
+}
+
++ (void)revokeTokensOfAuthStates:(NSArray<SCTKAuthState *> *)authStates
+                        callback:(SCTKRevocationBatchCallback)callback {
+  NSUInteger maximumConcurrentRequests =
+      SCTKAuthorizationServiceDefaultMaximumConcurrentRevocations;
+  [[self class] revokeTokensOfAuthStates:authStates
+               maximumConcurrentRequests:maximumConcurrentRequests
+                           callbackQueue:[self defaultCallbackQueue]
+                                callback:callback];
+}
+
++ (void)revokeTokensOfAuthStates:(NSArray<SCTKAuthState *> *)authStates
+       maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+                   callbackQueue:(dispatch_queue_t)callbackQueue
+                        callback:(SCTKRevocationBatchCallback)callback {
+  NSMutableArray<SCTKRevocationRequest *> *requests = [NSMutableArray array];
+  NSMutableDictionary<NSString *, NSError *> *errors = [NSMutableDictionary dictionary];
+  for (SCTKAuthState *authState in authStates) {
+    SCTKTokenRequest *tokenRequest = authState.lastTokenResponse.request;
+    SCTKAuthorizationRequest *authorizationRequest = authState.lastAuthorizationResponse.request;
+    SCTKServiceConfiguration *configuration =
+        tokenRequest.configuration ?: authorizationRequest.configuration;
+    NSURL *revocationEndpoint = configuration.discoveryDocument.revocationEndpoint;
+    NSString *clientID = tokenRequest.clientID ?: authorizationRequest.clientID;
+    NSString *clientSecret = tokenRequest.clientSecret ?: authorizationRequest.clientSecret;
+
+    // the refresh token goes first, as revoking it may also revoke the access tokens it issued
+    NSMutableArray<NSString *> *tokens = [NSMutableArray array];
+    NSMutableArray<NSString *> *tokenTypeHints = [NSMutableArray array];
+    if (authState.refreshToken) {
+      [tokens addObject:authState.refreshToken];
+      [tokenTypeHints addObject:SCTKTokenTypeHintRefreshToken];
+    }
+    NSString *accessToken = authState.tokenSnapshot.accessToken;
+    if (accessToken) {
+      [tokens addObject:accessToken];
+      [tokenTypeHints addObject:SCTKTokenTypeHintAccessToken];
+    }
+
+    NSString *configurationErrorDescription;
+    if (!revocationEndpoint) {
+      configurationErrorDescription = @"The discovery document has no revocation endpoint.";
+    } else if (!clientID) {
+      configurationErrorDescription = @"The auth state has no client ID to revoke tokens with.";
+    }
+    for (NSUInteger i = 0; i < tokens.count; i++) {
+      if (configurationErrorDescription) {
+        errors[tokens[i]] =
+            [SCTKErrorUtilities errorWithCode:SCTKErrorCodeEndpointNotConfiguredError
+                             underlyingError:nil
+                                 description:configurationErrorDescription];
+        continue;
+      }
+      SCTKRevocationRequest *request =
+          [[SCTKRevocationRequest alloc] initWithRevocationEndpoint:revocationEndpoint
+                                                              token:tokens[i]
+                                                      tokenTypeHint:tokenTypeHints[i]
+                                                           clientID:clientID
+                                                       clientSecret:clientSecret
+                                               additionalParameters:nil];
+      [requests addObject:request];
+    }
+  }
+
+  SCTKRevocationBatch *batch =
+      [[SCTKRevocationBatch alloc] initWithRequests:requests
+                                             errors:errors
+                          maximumConcurrentRequests:maximumConcurrentRequests
+                                      callbackQueue:callbackQueue
+                                           callback:callback];
+  [batch start];
+}
+
+#pragma mark - Introspection Endpoint
+
++ (void)performIntrospectionRequest:(SCTKIntrospectionRequest *)request
+                           callback:(SCTKIntrospectionCallback)callback {
+  [[self class] performIntrospectionRequest:request
+                              callbackQueue:[self defaultCallbackQueue]
+                                   callback:callback];
+}
+
++ (void)performIntrospectionRequest:(SCTKIntrospectionRequest *)request
+                      callbackQueue:(dispatch_queue_t)callbackQueue
+                           callback:(SCTKIntrospectionCallback)callback {
+  SCTKIntrospectionCache *cache = [SCTKIntrospectionCache sharedCache];
+  SCTKIntrospectionResponse *cachedResponse = [cache responseForToken:request.token];
+  if (cachedResponse) {
+    dispatch_async(callbackQueue, ^{
+      callback(cachedResponse, nil);
+    });
+    return;
+  }
+
+  NSURLRequest *URLRequest = [request URLRequest];
+  AppAuthRequestTrace(@"Introspection Request: %@", URLRequest.URL);
+
+  id<SCTKHTTPTransport> transport =
+      [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileToken];
+  [[SCTKResponseReader taskWithTransport:transport
+                                 request:URLRequest
+                                endpoint:SCTKResponseReaderEndpointIntrospection
+                       completionHandler:^(NSData *_Nullable data,
+                                           NSURLResponse *_Nullable response,
+                                           NSError *_Nullable error) {
+    if ([SCTKResponseReader isResponseTooLargeError:error]) {
+      dispatch_async(callbackQueue, ^{
+        callback(nil, error);
+      });
+      return;
+    }
+
+    if (error || !data) {
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Connection error making introspection request to '%@': "
+                                     "%@.",
+                                     URLRequest.URL,
+                                     error.localizedDescription];
+      NSError *returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
+                                                underlyingError:error
+                                                    description:errorDescription];
+      dispatch_async(callbackQueue, ^{
+        callback(nil, returnedError);
+      });
+      return;
+    }
+
+    NSHTTPURLResponse *HTTPURLResponse = (NSHTTPURLResponse *)response;
+    AppAuthRequestTrace(@"Introspection Response: HTTP Status %d",
+                        (int)HTTPURLResponse.statusCode);
+
+    if (HTTPURLResponse.statusCode != 200) {
+      NSError *serverError = [SCTKErrorUtilities HTTPErrorWithHTTPResponse:HTTPURLResponse
+                                                                     data:data];
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Non-200 HTTP response (%d) making introspection request "
+                                     "to '%@'.",
+                                     (int)HTTPURLResponse.statusCode,
+                                     URLRequest.URL];
+      NSError *returnedError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeServerError
+                                                underlyingError:serverError
+                                                    description:errorDescription];
+      dispatch_async(callbackQueue, ^{
+        callback(nil, returnedError);
+      });
+      return;
+    }
+
+    NSError *jsonDeserializationError;
+    id json = [NSJSONSerialization JSONObjectWithData:data
+                                              options:0
+                                                error:&jsonDeserializationError];
+    SCTKIntrospectionResponse *introspectionResponse = [json isKindOfClass:[NSDictionary class]]
+        ? [[SCTKIntrospectionResponse alloc] initWithParameters:json]
+        : nil;
+    if (!introspectionResponse) {
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Introspection response is not a JSON object with an "
+                                     "active member: %@",
+                                     jsonDeserializationError.localizedDescription];
+      NSError *returnedError =
+          [SCTKErrorUtilities errorWithCode:SCTKErrorCodeJSONDeserializationError
+                           underlyingError:jsonDeserializationError
+                               description:errorDescription];
+      dispatch_async(callbackQueue, ^{
+        callback(nil, returnedError);
+      });
+      return;
+    }
+
+    [cache storeResponse:introspectionResponse forToken:request.token];
+    dispatch_async(callbackQueue, ^{
+      callback(introspectionResponse, nil);
+    });
+  }] resume];
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
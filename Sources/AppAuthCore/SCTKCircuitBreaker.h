@@ -0,0 +1,81 @@
+/*! @file SCTKCircuitBreaker.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Fails requests to an endpoint fast while it is known to be down, instead of adding to
+        its load.
+    @discussion Each endpoint has its own circuit. A circuit opens after @c failureThreshold
+        consecutive transient failures, and requests to an open circuit are refused without being
+        sent. Once @c resetTimeout has passed, a single trial request is let through: the circuit
+        closes if it succeeds, and opens again for another @c resetTimeout if it fails.
+
+        Share one circuit breaker between the auth states that use the same endpoints, so that they
+        all learn of an outage from the first failures.
+ */
+@interface SCTKCircuitBreaker : NSObject
+
+/*! @brief The number of consecutive failures that opens the circuit of an endpoint.
+ */
+@property(nonatomic, readonly) NSUInteger failureThreshold;
+
+/*! @brief How long a circuit stays open before a trial request is let through.
+ */
+@property(nonatomic, readonly) NSTimeInterval resetTimeout;
+
+/*! @brief Creates a circuit breaker that opens after five consecutive failures, for thirty
+        seconds.
+ */
+- (instancetype)init;
+
+/*! @brief Designated initializer.
+    @param failureThreshold The number of consecutive failures that opens the circuit of an
+        endpoint. Must be at least one.
+    @param resetTimeout How long a circuit stays open before a trial request is let through.
+ */
+- (instancetype)initWithFailureThreshold:(NSUInteger)failureThreshold
+                            resetTimeout:(NSTimeInterval)resetTimeout NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Determines whether a request to an endpoint may be sent. Call
+        @c SCTKCircuitBreaker.recordSuccessForEndpoint: or
+        @c SCTKCircuitBreaker.recordFailureForEndpoint: with its outcome if it is.
+    @param endpoint The endpoint of the request.
+    @return NO if the circuit of the endpoint is open, or a trial request is already in progress.
+ */
+- (BOOL)shouldAllowRequestToEndpoint:(NSURL *)endpoint;
+
+/*! @brief Records that an endpoint answered a request, which closes its circuit.
+    @param endpoint The endpoint of the request.
+ */
+- (void)recordSuccessForEndpoint:(NSURL *)endpoint;
+
+/*! @brief Records that a request to an endpoint failed with a transient error.
+    @param endpoint The endpoint of the request.
+ */
+- (void)recordFailureForEndpoint:(NSURL *)endpoint;
+
+/*! @brief Determines whether the circuit of an endpoint is open.
+    @param endpoint The endpoint.
+ */
+- (BOOL)isOpenForEndpoint:(NSURL *)endpoint;
+
+@end
+
+NS_ASSUME_NONNULL_END
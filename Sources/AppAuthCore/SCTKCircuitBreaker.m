@@ -0,0 +1,133 @@
+/*! @file SCTKCircuitBreaker.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKCircuitBreaker.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The default number of consecutive failures that opens a circuit.
+ */
+static const NSUInteger kDefaultFailureThreshold = 5;
+
+/*! @brief The default number of seconds a circuit stays open.
+ */
+static const NSTimeInterval kDefaultResetTimeout = 30;
+
+/*! @brief The circuit of one endpoint.
+ */
+@interface SCTKCircuitBreakerCircuit : NSObject
+
+/*! @brief The number of failures since the endpoint last answered.
+ */
+@property(nonatomic) NSUInteger consecutiveFailureCount;
+
+/*! @brief When the circuit last opened, or nil if it is closed.
+ */
+@property(nonatomic, nullable) NSDate *openedDate;
+
+/*! @brief YES while the trial request of an open circuit is in progress.
+ */
+@property(nonatomic) BOOL trialInProgress;
+
+@end
+
+@implementation SCTKCircuitBreakerCircuit
+@end
+
+@implementation SCTKCircuitBreaker {
+  /*! @brief The circuits of the endpoints that failed since they last answered, by URL. Guarded by
+          @c self.
+   */
+  NSMutableDictionary<NSString *, SCTKCircuitBreakerCircuit *> *_circuits;
+}
+
+- (instancetype)init {
+  return [self initWithFailureThreshold:kDefaultFailureThreshold
+                           resetTimeout:kDefaultResetTimeout];
+}
+
+- (instancetype)initWithFailureThreshold:(NSUInteger)failureThreshold
+                            resetTimeout:(NSTimeInterval)resetTimeout {
+  self = [super init];
+  if (self) {
+    NSAssert(failureThreshold > 0, @"The failure threshold must be at least one.");
+    _failureThreshold = MAX(failureThreshold, (NSUInteger)1);
+    _resetTimeout = resetTimeout;
+    _circuits = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, failureThreshold: %lu, resetTimeout: %.3f>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    (unsigned long)_failureThreshold,
+                                    _resetTimeout];
+}
+
+#pragma mark - Circuits
+
+- (BOOL)shouldAllowRequestToEndpoint:(NSURL *)endpoint {
+  @synchronized(self) {
+    SCTKCircuitBreakerCircuit *circuit = _circuits[endpoint.absoluteString];
+    if (!circuit.openedDate) {
+      return YES;
+    }
+    if (circuit.trialInProgress || -[circuit.openedDate timeIntervalSinceNow] < _resetTimeout) {
+      return NO;
+    }
+    // half-open: lets one request find out whether the endpoint is back
+    circuit.trialInProgress = YES;
+    return YES;
+  }
+}
+
+- (void)recordSuccessForEndpoint:(NSURL *)endpoint {
+  @synchronized(self) {
+    [_circuits removeObjectForKey:endpoint.absoluteString];
+  }
+}
+
+- (void)recordFailureForEndpoint:(NSURL *)endpoint {
+  @synchronized(self) {
+    NSString *key = endpoint.absoluteString;
+    SCTKCircuitBreakerCircuit *circuit = _circuits[key];
+    if (!circuit) {
+      circuit = [[SCTKCircuitBreakerCircuit alloc] init];
+      _circuits[key] = circuit;
+    }
+    circuit.consecutiveFailureCount++;
+    if (circuit.trialInProgress || circuit.consecutiveFailureCount >= _failureThreshold) {
+      circuit.openedDate = [NSDate date];
+      circuit.trialInProgress = NO;
+    }
+  }
+}
+
+- (BOOL)isOpenForEndpoint:(NSURL *)endpoint {
+  @synchronized(self) {
+    return !!_circuits[endpoint.absoluteString].openedDate;
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,71 @@
+/*! @file SCTKClockSkewEstimator.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Learns how far the device clock is off from the clocks of the authorization servers it
+        talks to, from the HTTP @c Date header of their responses.
+    @discussion Each sample compares the server's date with the midpoint of the request's round
+        trip, and is blended into a per-issuer moving average. Samples from slow round trips carry
+        too much uncertainty and are ignored.
+ */
+@interface SCTKClockSkewEstimator : NSObject
+
+/*! @brief The estimator used by @c SCTKAuthorizationService.
+ */
++ (SCTKClockSkewEstimator *)sharedEstimator;
+
+/*! @brief Parses the value of an HTTP @c Date header.
+    @param dateHeader The header value, in the IMF-fixdate format of RFC 7231.
+    @return The date, or nil if @c dateHeader could not be parsed.
+    @see https://tools.ietf.org/html/rfc7231#section-7.1.1.1
+ */
++ (nullable NSDate *)dateFromHTTPDateHeader:(NSString *)dateHeader;
+
+/*! @brief Adds a sample to the estimate for an issuer.
+    @param serverDate The date reported by the server.
+    @param requestDate When the request was sent, by the device clock.
+    @param responseDate When the response was received, by the device clock.
+    @param issuer The issuer, or other URL identifying the server's clock.
+ */
+- (void)recordServerDate:(NSDate *)serverDate
+             requestDate:(NSDate *)requestDate
+            responseDate:(NSDate *)responseDate
+               forIssuer:(NSURL *)issuer;
+
+/*! @brief Returns how far the issuer's clock is ahead of the device clock.
+    @param issuer The issuer, or nil.
+    @return The estimated skew in seconds, positive if the server clock is ahead, or zero if there
+        is no estimate for @c issuer.
+ */
+- (NSTimeInterval)clockSkewForIssuer:(nullable NSURL *)issuer;
+
+/*! @brief Returns the current time by the issuer's clock, as estimated.
+    @param issuer The issuer, or nil.
+ */
+- (NSDate *)currentServerDateForIssuer:(nullable NSURL *)issuer;
+
+/*! @brief Discards all estimates.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,113 @@
+/*! @file SCTKClockSkewEstimator.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKClockSkewEstimator.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Samples whose round trip took longer than this many seconds are ignored.
+ */
+static const NSTimeInterval kMaximumRoundTripTime = 10;
+
+/*! @brief The weight of a new sample in the moving average.
+ */
+static const double kSampleWeight = 0.25;
+
+/*! @brief The HTTP @c Date header only has a resolution of one second, and servers truncate it.
+        Adding half a second centers the error.
+ */
+static const NSTimeInterval kDateHeaderResolutionCorrection = 0.5;
+
+@implementation SCTKClockSkewEstimator {
+  /*! @brief The skew estimates keyed by issuer. Guarded by @c self.
+   */
+  NSMutableDictionary<NSURL *, NSNumber *> *_skews;
+}
+
++ (SCTKClockSkewEstimator *)sharedEstimator {
+  static SCTKClockSkewEstimator *sharedEstimator;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sharedEstimator = [[SCTKClockSkewEstimator alloc] init];
+  });
+  return sharedEstimator;
+}
+
++ (nullable NSDate *)dateFromHTTPDateHeader:(NSString *)dateHeader {
+  static NSDateFormatter *dateFormatter;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    dateFormatter = [[NSDateFormatter alloc] init];
+    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    dateFormatter.dateFormat = @"EEE',' dd MMM yyyy HH':'mm':'ss 'GMT'";
+  });
+  // NSDateFormatter is thread safe since iOS 7 and macOS 10.9
+  return [dateFormatter dateFromString:dateHeader];
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _skews = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (void)recordServerDate:(NSDate *)serverDate
+             requestDate:(NSDate *)requestDate
+            responseDate:(NSDate *)responseDate
+               forIssuer:(NSURL *)issuer {
+  NSTimeInterval roundTripTime = [responseDate timeIntervalSinceDate:requestDate];
+  if (roundTripTime < 0 || roundTripTime > kMaximumRoundTripTime) {
+    return;
+  }
+  NSDate *midpoint = [requestDate dateByAddingTimeInterval:roundTripTime / 2];
+  NSTimeInterval sample =
+      [serverDate timeIntervalSinceDate:midpoint] + kDateHeaderResolutionCorrection;
+
+  @synchronized(self) {
+    NSNumber *estimate = _skews[issuer];
+    _skews[issuer] = estimate
+        ? @(estimate.doubleValue + kSampleWeight * (sample - estimate.doubleValue))
+        : @(sample);
+  }
+}
+
+- (NSTimeInterval)clockSkewForIssuer:(nullable NSURL *)issuer {
+  if (!issuer) {
+    return 0;
+  }
+  @synchronized(self) {
+    return _skews[issuer].doubleValue;
+  }
+}
+
+- (NSDate *)currentServerDateForIssuer:(nullable NSURL *)issuer {
+  return [NSDate dateWithTimeIntervalSinceNow:[self clockSkewForIssuer:issuer]];
+}
+
+- (void)reset {
+  @synchronized(self) {
+    [_skews removeAllObjects];
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,160 @@
+/*! @file SCTKConnectionPrewarmer.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class SCTKServiceConfiguration;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The default interval at which a @c SCTKConnectionPrewarmer repeats its requests.
+ */
+extern const NSTimeInterval SCTKConnectionPrewarmerDefaultKeepAliveInterval;
+
+/*! @brief The connection setup times of a request.
+ */
+@interface SCTKConnectionMetrics : NSObject
+
+/*! @brief The URL of the request.
+ */
+@property(nonatomic, readonly, nullable) NSURL *URL;
+
+/*! @brief Whether the request was sent by a @c SCTKConnectionPrewarmer.
+ */
+@property(nonatomic, readonly, getter=isPrewarming) BOOL prewarming;
+
+/*! @brief Whether the request was sent on a connection that was already open.
+ */
+@property(nonatomic, readonly, getter=isReusedConnection) BOOL reusedConnection;
+
+/*! @brief The time spent resolving the host name, zero if none was needed.
+ */
+@property(nonatomic, readonly) NSTimeInterval domainLookupDuration;
+
+/*! @brief The time spent establishing the connection, including the TLS handshake, zero if an
+        open connection was used.
+ */
+@property(nonatomic, readonly) NSTimeInterval connectDuration;
+
+/*! @brief The time spent in the TLS handshake, zero if an open connection was used.
+ */
+@property(nonatomic, readonly) NSTimeInterval secureConnectionDuration;
+
+/*! @brief The time from the start of the fetch until the end of the response.
+ */
+@property(nonatomic, readonly) NSTimeInterval totalDuration;
+
+/*! @internal
+    @brief Unavailable. Metrics are created by @c SCTKConnectionPrewarmer.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/*! @brief Receives the connection setup times of requests.
+    @param metrics The metrics of a request.
+ */
+typedef void (^SCTKConnectionMetricsHandler)(SCTKConnectionMetrics *metrics);
+
+/*! @brief Opens connections to the token, userinfo and JWKS endpoints ahead of use, and keeps
+        them open, so that the first request after the user returns from the external user agent
+        does not wait for DNS, TCP and TLS setup.
+    @discussion Each endpoint origin is sent a @c HEAD request through the transport of
+        @c SCTKURLSessionProvider, which keeps the connection in its pool for later requests. The
+        requests repeat at @c keepAliveInterval until the prewarmer is stopped. The JWKS endpoint
+        is requested on the session of @c ::SCTKURLSessionProfileDiscovery, the others on that of
+        @c ::SCTKURLSessionProfileToken.
+
+        Set @c SCTKConnectionPrewarmer.prewarmsDuringAuthorization to prewarm while each
+        authorization request is presented.
+ */
+@interface SCTKConnectionPrewarmer : NSObject
+
+/*! @brief The endpoints requested, one per origin and session.
+ */
+@property(nonatomic, readonly) NSArray<NSURL *> *URLs;
+
+/*! @brief The interval at which the requests repeat while the prewarmer runs. Defaults to
+        @c SCTKConnectionPrewarmerDefaultKeepAliveInterval.
+ */
+@property(atomic) NSTimeInterval keepAliveInterval;
+
+/*! @brief Whether authorization requests prewarm connections while they are presented. Defaults
+        to NO.
+ */
++ (BOOL)prewarmsDuringAuthorization;
+
+/*! @brief Sets whether authorization requests prewarm connections while they are presented.
+    @param prewarmsDuringAuthorization Whether to prewarm.
+ */
++ (void)setPrewarmsDuringAuthorization:(BOOL)prewarmsDuringAuthorization;
+
+/*! @brief Returns the handler receiving connection metrics, nil by default.
+ */
++ (nullable SCTKConnectionMetricsHandler)connectionMetricsHandler;
+
+/*! @brief Sets the handler receiving the connection metrics of prewarming requests and of
+        discovery, token and registration requests, so that the handshake time saved can be
+        measured.
+    @param handler The handler, called on the delegate queue of the session, or nil.
+    @discussion Metrics are collected by @c SCTKURLSessionTransport where per-task delegates are
+        available (iOS 15, macOS 12, tvOS 15, watchOS 8), not by other transports.
+ */
++ (void)setConnectionMetricsHandler:(nullable SCTKConnectionMetricsHandler)handler;
+
+/*! @brief Passes the metrics of a task to the connection metrics handler, if one is set.
+    @param taskMetrics The metrics of the task.
+    @param prewarming Whether the task was sent by a prewarmer.
+ */
++ (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics prewarming:(BOOL)prewarming;
+
+/*! @brief Whether a request was sent by a prewarmer.
+    @param request The request.
+ */
++ (BOOL)isPrewarmingRequest:(nullable NSURLRequest *)request;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithConfiguration: or @c initWithURLs:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Creates a prewarmer for the token endpoint of a configuration, and the userinfo and
+        JWKS endpoints of its discovery document, if any.
+    @param configuration The service configuration.
+ */
+- (instancetype)initWithConfiguration:(SCTKServiceConfiguration *)configuration;
+
+/*! @brief Designated initializer.
+    @param URLs The endpoints to open connections to, on the session of
+        @c ::SCTKURLSessionProfileToken. Only the first of each origin is requested.
+ */
+- (instancetype)initWithURLs:(NSArray<NSURL *> *)URLs NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Sends the requests, and repeats them at @c keepAliveInterval until stopped. Has no
+        effect if already running.
+ */
+- (void)start;
+
+/*! @brief Stops repeating the requests. Connections already open stay in the pool of the
+        transport.
+ */
+- (void)stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
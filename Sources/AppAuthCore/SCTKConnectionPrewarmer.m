@@ -0,0 +1,281 @@
+/*! @file SCTKConnectionPrewarmer.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKConnectionPrewarmer.h"
+
+#import "SCTKDefines.h"
+#import "SCTKHTTPTransport.h"
+#import "SCTKServiceConfiguration.h"
+#import "SCTKServiceDiscovery.h"
+#import "SCTKURLSessionProvider.h"
+
+const NSTimeInterval SCTKConnectionPrewarmerDefaultKeepAliveInterval = 30;
+
+/*! @brief The timeout of prewarming requests, in seconds.
+ */
+static const NSTimeInterval kPrewarmingRequestTimeout = 10;
+
+/*! @brief The @c NSURLProtocol property marking prewarming requests.
+ */
+static NSString *const kPrewarmingRequestPropertyKey = @"SCTKConnectionPrewarmerRequest";
+
+/*! @brief Whether authorization requests prewarm connections. Guarded by
+        @c SCTKConnectionPrewarmer.
+ */
+static BOOL gPrewarmsDuringAuthorization;
+
+/*! @brief The handler receiving connection metrics. Guarded by @c SCTKConnectionPrewarmer.
+ */
+static SCTKConnectionMetricsHandler _Nullable gConnectionMetricsHandler;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Returns the time between two dates, or zero if either is missing.
+    @param startDate The start date.
+    @param endDate The end date.
+ */
+static NSTimeInterval SCTKDurationBetweenDates(NSDate *_Nullable startDate,
+                                               NSDate *_Nullable endDate) {
+  if (!startDate || !endDate) {
+    return 0;
+  }
+  return [endDate timeIntervalSinceDate:startDate];
+}
+
+@interface SCTKConnectionMetrics ()
+
+/*! @brief Creates the metrics of a task.
+    @param taskMetrics The metrics collected by the session.
+    @param prewarming Whether the task was sent by a prewarmer.
+ */
+- (instancetype)initWithTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics
+                         prewarming:(BOOL)prewarming NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation SCTKConnectionMetrics
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithTaskMetrics:prewarming:))
+
+- (instancetype)initWithTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics
+                         prewarming:(BOOL)prewarming {
+  self = [super init];
+  if (self) {
+    // the last transaction is the one that loaded the response, after any redirects
+    NSURLSessionTaskTransactionMetrics *transaction = taskMetrics.transactionMetrics.lastObject;
+    _URL = transaction.request.URL;
+    _prewarming = prewarming;
+    _reusedConnection = transaction.isReusedConnection;
+    _domainLookupDuration = SCTKDurationBetweenDates(transaction.domainLookupStartDate,
+                                                     transaction.domainLookupEndDate);
+    _connectDuration = SCTKDurationBetweenDates(transaction.connectStartDate,
+                                                transaction.connectEndDate);
+    _secureConnectionDuration = SCTKDurationBetweenDates(transaction.secureConnectionStartDate,
+                                                         transaction.secureConnectionEndDate);
+    _totalDuration = taskMetrics.taskInterval.duration;
+  }
+  return self;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, URL: %@, prewarming: %@, reusedConnection: %@, "
+                                     "domainLookupDuration: %.3f, connectDuration: %.3f, "
+                                     "secureConnectionDuration: %.3f, totalDuration: %.3f>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _URL,
+                                    _prewarming ? @"YES" : @"NO",
+                                    _reusedConnection ? @"YES" : @"NO",
+                                    _domainLookupDuration,
+                                    _connectDuration,
+                                    _secureConnectionDuration,
+                                    _totalDuration];
+}
+
+@end
+
+@implementation SCTKConnectionPrewarmer {
+  /*! @brief The URLs requested on the session of a profile other than
+        @c ::SCTKURLSessionProfileToken, by URL.
+   */
+  NSDictionary<NSURL *, NSNumber *> *_profiles;
+
+  /*! @brief The timer repeating the requests while running. Guarded by @c self.
+   */
+  dispatch_source_t _Nullable _timer;
+}
+
++ (BOOL)prewarmsDuringAuthorization {
+  @synchronized([SCTKConnectionPrewarmer class]) {
+    return gPrewarmsDuringAuthorization;
+  }
+}
+
++ (void)setPrewarmsDuringAuthorization:(BOOL)prewarmsDuringAuthorization {
+  @synchronized([SCTKConnectionPrewarmer class]) {
+    gPrewarmsDuringAuthorization = prewarmsDuringAuthorization;
+  }
+}
+
++ (nullable SCTKConnectionMetricsHandler)connectionMetricsHandler {
+  @synchronized([SCTKConnectionPrewarmer class]) {
+    return gConnectionMetricsHandler;
+  }
+}
+
++ (void)setConnectionMetricsHandler:(nullable SCTKConnectionMetricsHandler)handler {
+  @synchronized([SCTKConnectionPrewarmer class]) {
+    gConnectionMetricsHandler = [handler copy];
+  }
+}
+
++ (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics prewarming:(BOOL)prewarming {
+  SCTKConnectionMetricsHandler handler = [self connectionMetricsHandler];
+  if (!handler) {
+    return;
+  }
+  handler([[SCTKConnectionMetrics alloc] initWithTaskMetrics:taskMetrics prewarming:prewarming]);
+}
+
++ (BOOL)isPrewarmingRequest:(nullable NSURLRequest *)request {
+  if (!request) {
+    return NO;
+  }
+  return [[NSURLProtocol propertyForKey:kPrewarmingRequestPropertyKey inRequest:request] boolValue];
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithURLs:))
+
+- (instancetype)initWithConfiguration:(SCTKServiceConfiguration *)configuration {
+  NSMutableArray<NSURL *> *URLs = [NSMutableArray arrayWithObject:configuration.tokenEndpoint];
+  SCTKServiceDiscovery *discovery = configuration.discoveryDocument;
+  if (discovery.userinfoEndpoint) {
+    [URLs addObject:discovery.userinfoEndpoint];
+  }
+  if (discovery.jwksURL) {
+    [URLs addObject:discovery.jwksURL];
+  }
+  self = [self initWithURLs:URLs];
+  if (self && discovery.jwksURL) {
+    // keys are fetched with the discovery traffic, which has a connection pool of its own, so the
+    // JWKS endpoint is kept even when it shares an origin with the token endpoint
+    _profiles = @{discovery.jwksURL : @(SCTKURLSessionProfileDiscovery)};
+    _URLs = [[self class] URLs:URLs dedupedPerPoolWithProfiles:_profiles];
+  }
+  return self;
+}
+
+- (instancetype)initWithURLs:(NSArray<NSURL *> *)URLs {
+  self = [super init];
+  if (self) {
+    _URLs = [[self class] URLs:URLs dedupedPerPoolWithProfiles:nil];
+    _keepAliveInterval = SCTKConnectionPrewarmerDefaultKeepAliveInterval;
+  }
+  return self;
+}
+
+/*! @brief Returns the first URL of each connection pool, which is one per origin and profile.
+    @param URLs The endpoints.
+    @param profiles The profile of each URL not requested on the session of
+        @c ::SCTKURLSessionProfileToken.
+ */
++ (NSArray<NSURL *> *)URLs:(NSArray<NSURL *> *)URLs
+    dedupedPerPoolWithProfiles:(nullable NSDictionary<NSURL *, NSNumber *> *)profiles {
+  // connections are pooled per origin by each session, so one request to each is enough
+  NSMutableSet<NSString *> *pools = [NSMutableSet set];
+  NSMutableArray<NSURL *> *poolURLs = [NSMutableArray array];
+  for (NSURL *URL in URLs) {
+    NSNumber *profile = profiles[URL] ?: @(SCTKURLSessionProfileToken);
+    NSString *pool = [NSString stringWithFormat:@"%@://%@:%@ %@",
+                                                URL.scheme.lowercaseString,
+                                                URL.host.lowercaseString,
+                                                URL.port,
+                                                profile];
+    if (URL.host && ![pools containsObject:pool]) {
+      [pools addObject:pool];
+      [poolURLs addObject:URL];
+    }
+  }
+  return [poolURLs copy];
+}
+
+- (void)dealloc {
+  if (_timer) {
+    dispatch_source_cancel(_timer);
+  }
+}
+
+- (void)start {
+  @synchronized(self) {
+    if (_timer) {
+      return;
+    }
+    uint64_t interval = (uint64_t)(self.keepAliveInterval * NSEC_PER_SEC);
+    _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER,
+                                    0,
+                                    0,
+                                    dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+    dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, 0), interval, interval / 10);
+    __weak SCTKConnectionPrewarmer *weakSelf = self;
+    dispatch_source_set_event_handler(_timer, ^{
+      [weakSelf sendRequests];
+    });
+    dispatch_resume(_timer);
+  }
+}
+
+- (void)stop {
+  @synchronized(self) {
+    if (_timer) {
+      dispatch_source_cancel(_timer);
+      _timer = nil;
+    }
+  }
+}
+
+/*! @brief Sends a @c HEAD request to each endpoint through the transport of its profile, leaving
+        the connection in its pool.
+ */
+- (void)sendRequests {
+  for (NSURL *URL in _URLs) {
+    NSNumber *profile = _profiles[URL] ?: @(SCTKURLSessionProfileToken);
+    id<SCTKHTTPTransport> transport =
+        [SCTKURLSessionProvider transportForProfile:profile.integerValue];
+    NSMutableURLRequest *request =
+        [NSMutableURLRequest requestWithURL:URL
+                                cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+                            timeoutInterval:kPrewarmingRequestTimeout];
+    request.HTTPMethod = @"HEAD";
+    [NSURLProtocol setProperty:@YES forKey:kPrewarmingRequestPropertyKey inRequest:request];
+    // only the connection matters, not the response
+    id<SCTKHTTPTransportTask> task =
+        [transport taskWithRequest:request
+                   responseHandler:^BOOL(NSURLResponse *response) { return YES; }
+                       dataHandler:^BOOL(NSData *data) { return YES; }
+                 completionHandler:^(NSError *_Nullable error) {}];
+    [task resume];
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -61,6 +61,16 @@ extern NSString *const SCTKOAuthTokenErrorDomain;
  */
 extern NSString *const SCTKOAuthRegistrationErrorDomain;
 
+/*! @brief The error domain for token revocation errors.
+    @discussion This error domain is used when the server responds to a revocation request with
+        HTTP 400 and an OAuth error, as defined in RFC7009 Section 2.2.1. The entire OAuth error
+        response dictionary is available in the \NSError_userInfo dictionary using the
+        @c ::SCTKOAuthErrorResponseErrorKey key. Errors in this domain do not invalidate the
+        authentication state.
+    @see https://tools.ietf.org/html/rfc7009#section-2.2.1
+ */
+extern NSString *const SCTKOAuthRevocationErrorDomain;
+
 /*! @brief The error domain for authorization errors encountered out of band on the resource server.
  */
 extern NSString *const SCTKResourceServerAuthorizationErrorDomain;
@@ -151,6 +161,44 @@ typedef NS_ENUM(NSInteger, SCTKErrorCode) {
   /*! @brief The ID Token did not pass validation (e.g. issuer, audience checks).
    */
   SCTKErrorCodeIDTokenFailedValidationError = -15,
+
+  /*! @brief An action gave up waiting for a token refresh after its timeout.
+   */
+  SCTKErrorCodeTokenRefreshTimeoutError = -16,
+
+  /*! @brief An action was cancelled while waiting for a token refresh.
+   */
+  SCTKErrorCodeTokenRefreshCancelledError = -17,
+
+  /*! @brief Indicates a problem occurred serializing or deserializing an object graph with
+          @c SCTKAuthStateCodec.
+   */
+  SCTKErrorCodeArchiveError = -18,
+
+  /*! @brief A request was not sent because its endpoint is known to be down, as reported by
+          @c SCTKCircuitBreaker.
+   */
+  SCTKErrorCodeEndpointUnavailableError = -19,
+
+  /*! @brief A @c SCTKPromise was cancelled before it was resolved.
+   */
+  SCTKErrorCodePromiseCancelledError = -20,
+
+  /*! @brief A response body exceeded the maximum size set with @c SCTKResponseReader, and was
+          not read further.
+   */
+  SCTKErrorCodeResponseTooLargeError = -21,
+
+  /*! @brief A request was not sent because the service configuration has no endpoint for it, or
+          there is no client ID to send it with.
+   */
+  SCTKErrorCodeEndpointNotConfiguredError = -22,
+
+  /*! @brief The subject of a userinfo response did not match the subject of the ID Token, so the
+          response must not be used.
+      @see https://openid.net/specs/openid-connect-core-1_0.html#UserInfoResponse
+   */
+  SCTKErrorCodeUserInfoSubjectMismatchError = -23,
 };
 
 /*! @brief Enum of all possible OAuth error codes as defined by RFC6749
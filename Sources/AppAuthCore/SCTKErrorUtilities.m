@@ -39,6 +39,7 @@
 
 + (BOOL)isOAuthErrorDomain:(NSString *)errorDomain {
   return errorDomain == SCTKOAuthRegistrationErrorDomain
+      || errorDomain == SCTKOAuthRevocationErrorDomain
       || errorDomain == SCTKOAuthAuthorizationErrorDomain
       || errorDomain == SCTKOAuthTokenErrorDomain;
 }
@@ -0,0 +1,82 @@
+/*! @file SCTKHTTPTransport.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Called once the status and headers of a response are received.
+    @param response The response.
+    @return NO to cancel the request.
+ */
+typedef BOOL (^SCTKHTTPTransportResponseHandler)(NSURLResponse *response);
+
+/*! @brief Called with each part of the body of a response, in order, as it arrives.
+    @param data The part of the body.
+    @return NO to cancel the request.
+ */
+typedef BOOL (^SCTKHTTPTransportDataHandler)(NSData *data);
+
+/*! @brief Called once a request has completed.
+    @param error The error of the request, or an error of code @c NSURLErrorCancelled in the
+        @c NSURLErrorDomain if it was cancelled, by a handler or with
+        @c SCTKHTTPTransportTask.cancel.
+ */
+typedef void (^SCTKHTTPTransportCompletionHandler)(NSError *_Nullable error);
+
+/*! @protocol SCTKHTTPTransportTask
+    @brief A request sent through a @c SCTKHTTPTransport.
+ */
+@protocol SCTKHTTPTransportTask<NSObject>
+
+/*! @brief Sends the request. Has no effect if already sent.
+ */
+- (void)resume;
+
+/*! @brief Cancels the request. The completion handler is called with @c NSURLErrorCancelled,
+        unless the request has already completed.
+ */
+- (void)cancel;
+
+@end
+
+/*! @protocol SCTKHTTPTransport
+    @brief Sends the HTTP requests of AppAuth. Clients may provide their own implementation, such
+        as a pooled client, with @c SCTKURLSessionProvider.setTransport:.
+    @discussion Responses are streamed to the handlers of each request, which are called serially,
+        in the order response, data, completion, on a queue of the transport's choosing. A
+        transport never calls them from within @c SCTKHTTPTransportTask.resume. AppAuth reads the
+        responses of its requests with @c SCTKResponseReader, which buffers the body within the
+        size limit of the endpoint.
+ */
+@protocol SCTKHTTPTransport<NSObject>
+
+/*! @brief Creates a task sending a request, to be resumed by the caller.
+    @param request The request.
+    @param responseHandler Called once the response is received, unless the request fails first.
+    @param dataHandler Called with each part of the body.
+    @param completionHandler Called once the request has completed, successfully or not.
+ */
+- (id<SCTKHTTPTransportTask>)taskWithRequest:(NSURLRequest *)request
+                             responseHandler:(SCTKHTTPTransportResponseHandler)responseHandler
+                                 dataHandler:(SCTKHTTPTransportDataHandler)dataHandler
+                           completionHandler:(SCTKHTTPTransportCompletionHandler)completionHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,137 @@
+/*! @file SCTKIntrospectionCache.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class SCTKIntrospectionResponse;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The default number of tokens a @c SCTKIntrospectionCache keeps results for.
+ */
+extern const NSUInteger SCTKIntrospectionCacheDefaultCountLimit;
+
+/*! @brief The default longest time for which a @c SCTKIntrospectionCache keeps the result of an
+        active token.
+ */
+extern const NSTimeInterval SCTKIntrospectionCacheDefaultMaximumTimeToLive;
+
+/*! @brief The default time for which a @c SCTKIntrospectionCache keeps the result of an inactive
+        token.
+ */
+extern const NSTimeInterval SCTKIntrospectionCacheDefaultNegativeTimeToLive;
+
+/*! @brief A snapshot of the lookups of a @c SCTKIntrospectionCache.
+ */
+@interface SCTKIntrospectionCacheStatistics : NSObject
+
+/*! @brief The number of lookups answered with a kept result, active or not.
+ */
+@property(nonatomic, readonly) NSUInteger hitCount;
+
+/*! @brief The number of lookups answered with the kept result of an inactive token.
+ */
+@property(nonatomic, readonly) NSUInteger negativeHitCount;
+
+/*! @brief The number of lookups without a kept result.
+ */
+@property(nonatomic, readonly) NSUInteger missCount;
+
+/*! @brief The number of results dropped to stay within @c SCTKIntrospectionCache.countLimit.
+ */
+@property(nonatomic, readonly) NSUInteger evictionCount;
+
+/*! @brief The number of results kept.
+ */
+@property(nonatomic, readonly) NSUInteger entryCount;
+
+/*! @brief The share of lookups that were hits, from 0 to 1, or 0 if there were no lookups.
+ */
+@property(nonatomic, readonly) double hitRate;
+
+/*! @internal
+    @brief Unavailable. Statistics are returned by @c SCTKIntrospectionCache.statistics.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/*! @brief Keeps introspection results in memory, by the SHA-256 hash of their token, so that a
+        protected resource does not introspect the same token on every request.
+    @discussion The result of an active token is kept until the token's @c exp, and for no longer
+        than @c maximumTimeToLive, so a revoked token is noticed within that time. The result of
+        an inactive token is kept for @c negativeTimeToLive. Once @c countLimit results are kept,
+        the least recently used one is dropped for a new one.
+ */
+@interface SCTKIntrospectionCache : NSObject
+
+/*! @brief The maximum number of results kept. Defaults to
+        @c ::SCTKIntrospectionCacheDefaultCountLimit; zero disables the cache.
+ */
+@property(atomic) NSUInteger countLimit;
+
+/*! @brief The longest time for which the result of an active token is kept. Defaults to
+        @c ::SCTKIntrospectionCacheDefaultMaximumTimeToLive.
+ */
+@property(atomic) NSTimeInterval maximumTimeToLive;
+
+/*! @brief The time for which the result of an inactive token is kept. Defaults to
+        @c ::SCTKIntrospectionCacheDefaultNegativeTimeToLive; zero or less keeps none.
+ */
+@property(atomic) NSTimeInterval negativeTimeToLive;
+
+/*! @brief Returns the cache used by @c SCTKAuthorizationService for introspection requests.
+ */
++ (SCTKIntrospectionCache *)sharedCache;
+
+/*! @brief Sets the cache used by @c SCTKAuthorizationService for introspection requests.
+    @param cache The cache, or nil to restore a default one.
+ */
++ (void)setSharedCache:(nullable SCTKIntrospectionCache *)cache;
+
+/*! @brief Returns the unexpired result for a token, if any, and counts the lookup.
+    @param token The introspected token.
+ */
+- (nullable SCTKIntrospectionResponse *)responseForToken:(NSString *)token;
+
+/*! @brief Keeps the result for a token, unless it has already expired.
+    @param response The result of introspecting the token.
+    @param token The introspected token.
+ */
+- (void)storeResponse:(SCTKIntrospectionResponse *)response forToken:(NSString *)token;
+
+/*! @brief Drops the result for a token, such as after revoking it.
+    @param token The introspected token.
+ */
+- (void)removeResponseForToken:(NSString *)token;
+
+/*! @brief Drops all results. The statistics are kept.
+ */
+- (void)removeAllResponses;
+
+/*! @brief Returns a snapshot of the lookups since the cache was created or the statistics reset.
+ */
+- (SCTKIntrospectionCacheStatistics *)statistics;
+
+/*! @brief Sets the lookup and eviction counts back to zero.
+ */
+- (void)resetStatistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,281 @@
+/*! @file SCTKIntrospectionCache.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKIntrospectionCache.h"
+
+#import "SCTKIntrospectionResponse.h"
+#import "SCTKTokenUtilities.h"
+
+const NSUInteger SCTKIntrospectionCacheDefaultCountLimit = 1000;
+
+const NSTimeInterval SCTKIntrospectionCacheDefaultMaximumTimeToLive = 300;
+
+const NSTimeInterval SCTKIntrospectionCacheDefaultNegativeTimeToLive = 10;
+
+/*! @brief The cache used for introspection requests, created on first use.
+ */
+static SCTKIntrospectionCache *_Nullable gSharedCache;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface SCTKIntrospectionCacheStatistics ()
+
+- (instancetype)initWithHitCount:(NSUInteger)hitCount
+                negativeHitCount:(NSUInteger)negativeHitCount
+                       missCount:(NSUInteger)missCount
+                   evictionCount:(NSUInteger)evictionCount
+                      entryCount:(NSUInteger)entryCount NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation SCTKIntrospectionCacheStatistics
+
+- (instancetype)initWithHitCount:(NSUInteger)hitCount
+                negativeHitCount:(NSUInteger)negativeHitCount
+                       missCount:(NSUInteger)missCount
+                   evictionCount:(NSUInteger)evictionCount
+                      entryCount:(NSUInteger)entryCount {
+  self = [super init];
+  if (self) {
+    _hitCount = hitCount;
+    _negativeHitCount = negativeHitCount;
+    _missCount = missCount;
+    _evictionCount = evictionCount;
+    _entryCount = entryCount;
+  }
+  return self;
+}
+
+- (double)hitRate {
+  NSUInteger lookupCount = _hitCount + _missCount;
+  return lookupCount > 0 ? (double)_hitCount / lookupCount : 0;
+}
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, hitCount: %lu, negativeHitCount: %lu, "
+                                     "missCount: %lu, evictionCount: %lu, entryCount: %lu>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    (unsigned long)_hitCount,
+                                    (unsigned long)_negativeHitCount,
+                                    (unsigned long)_missCount,
+                                    (unsigned long)_evictionCount,
+                                    (unsigned long)_entryCount];
+}
+
+@end
+
+/*! @brief A kept result with its expiry.
+ */
+@interface SCTKIntrospectionCacheEntry : NSObject
+
+/*! @brief The result.
+ */
+@property(nonatomic, readonly) SCTKIntrospectionResponse *response;
+
+/*! @brief The time after which the result is not returned, in system uptime.
+ */
+@property(nonatomic, readonly) NSTimeInterval expirationTime;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithResponse:(SCTKIntrospectionResponse *)response
+                  expirationTime:(NSTimeInterval)expirationTime NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation SCTKIntrospectionCacheEntry
+
+- (instancetype)initWithResponse:(SCTKIntrospectionResponse *)response
+                  expirationTime:(NSTimeInterval)expirationTime {
+  self = [super init];
+  if (self) {
+    _response = response;
+    _expirationTime = expirationTime;
+  }
+  return self;
+}
+
+@end
+
+@implementation SCTKIntrospectionCache {
+  /*! @brief The kept results, by hash of their token. Guarded by @c self.
+   */
+  NSMutableDictionary<NSString *, SCTKIntrospectionCacheEntry *> *_entries;
+
+  /*! @brief The keys of @c _entries, least recently used first. Guarded by @c self.
+   */
+  NSMutableOrderedSet<NSString *> *_keysByUse;
+
+  /*! @brief The lookup and eviction counts. Guarded by @c self.
+   */
+  NSUInteger _hitCount;
+  NSUInteger _negativeHitCount;
+  NSUInteger _missCount;
+  NSUInteger _evictionCount;
+}
+
++ (SCTKIntrospectionCache *)sharedCache {
+  @synchronized([SCTKIntrospectionCache class]) {
+    if (!gSharedCache) {
+      gSharedCache = [[SCTKIntrospectionCache alloc] init];
+    }
+    return gSharedCache;
+  }
+}
+
++ (void)setSharedCache:(nullable SCTKIntrospectionCache *)cache {
+  @synchronized([SCTKIntrospectionCache class]) {
+    gSharedCache = cache;
+  }
+}
+
+/*! @brief Returns the key of a token, so that tokens are not kept in memory in the clear.
+    @param token The token.
+ */
++ (NSString *)keyForToken:(NSString *)token {
+  return [SCTKTokenUtilities encodeBase64urlNoPadding:[SCTKTokenUtilities sha256:token]];
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _countLimit = SCTKIntrospectionCacheDefaultCountLimit;
+    _maximumTimeToLive = SCTKIntrospectionCacheDefaultMaximumTimeToLive;
+    _negativeTimeToLive = SCTKIntrospectionCacheDefaultNegativeTimeToLive;
+    _entries = [NSMutableDictionary dictionary];
+    _keysByUse = [NSMutableOrderedSet orderedSet];
+  }
+  return self;
+}
+
+- (nullable SCTKIntrospectionResponse *)responseForToken:(NSString *)token {
+  NSString *key = [[self class] keyForToken:token];
+  NSTimeInterval now = [NSProcessInfo processInfo].systemUptime;
+  @synchronized(self) {
+    SCTKIntrospectionCacheEntry *entry = _entries[key];
+    if (entry && entry.expirationTime <= now) {
+      [self removeEntryForKey:key];
+      entry = nil;
+    }
+    if (!entry) {
+      _missCount++;
+      return nil;
+    }
+    _hitCount++;
+    if (!entry.response.active) {
+      _negativeHitCount++;
+    }
+    [_keysByUse removeObject:key];
+    [_keysByUse addObject:key];
+    return entry.response;
+  }
+}
+
+- (void)storeResponse:(SCTKIntrospectionResponse *)response forToken:(NSString *)token {
+  NSTimeInterval timeToLive;
+  if (response.active) {
+    timeToLive = self.maximumTimeToLive;
+    if (response.expirationDate) {
+      timeToLive = MIN(timeToLive, [response.expirationDate timeIntervalSinceNow]);
+    }
+  } else {
+    timeToLive = self.negativeTimeToLive;
+  }
+  NSUInteger countLimit = self.countLimit;
+  if (timeToLive <= 0 || countLimit == 0) {
+    return;
+  }
+
+  NSString *key = [[self class] keyForToken:token];
+  NSTimeInterval now = [NSProcessInfo processInfo].systemUptime;
+  SCTKIntrospectionCacheEntry *entry =
+      [[SCTKIntrospectionCacheEntry alloc] initWithResponse:response
+                                             expirationTime:now + timeToLive];
+  @synchronized(self) {
+    [_keysByUse removeObject:key];
+    _entries[key] = entry;
+    [_keysByUse addObject:key];
+    if (_entries.count > countLimit) {
+      [self removeExpiredEntriesAtTime:now];
+    }
+    while (_entries.count > countLimit) {
+      [self removeEntryForKey:_keysByUse.firstObject];
+      _evictionCount++;
+    }
+  }
+}
+
+- (void)removeResponseForToken:(NSString *)token {
+  NSString *key = [[self class] keyForToken:token];
+  @synchronized(self) {
+    [self removeEntryForKey:key];
+  }
+}
+
+- (void)removeAllResponses {
+  @synchronized(self) {
+    [_entries removeAllObjects];
+    [_keysByUse removeAllObjects];
+  }
+}
+
+- (SCTKIntrospectionCacheStatistics *)statistics {
+  @synchronized(self) {
+    return [[SCTKIntrospectionCacheStatistics alloc] initWithHitCount:_hitCount
+                                                     negativeHitCount:_negativeHitCount
+                                                            missCount:_missCount
+                                                        evictionCount:_evictionCount
+                                                           entryCount:_entries.count];
+  }
+}
+
+- (void)resetStatistics {
+  @synchronized(self) {
+    _hitCount = 0;
+    _negativeHitCount = 0;
+    _missCount = 0;
+    _evictionCount = 0;
+  }
+}
+
+#pragma mark - Private
+
+/*! @brief Drops an entry. Must be called while synchronized on @c self.
+    @param key The key of the entry.
+ */
+- (void)removeEntryForKey:(NSString *)key {
+  [_entries removeObjectForKey:key];
+  [_keysByUse removeObject:key];
+}
+
+/*! @brief Drops the expired entries, which do not count as evictions. Must be called while
+        synchronized on @c self.
+    @param now The current system uptime.
+ */
+- (void)removeExpiredEntriesAtTime:(NSTimeInterval)now {
+  for (NSString *key in [_entries allKeys]) {
+    if (_entries[key].expirationTime <= now) {
+      [self removeEntryForKey:key];
+    }
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
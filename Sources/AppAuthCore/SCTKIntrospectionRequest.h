@@ -0,0 +1,86 @@
+/*! @file SCTKIntrospectionRequest.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "SCTKRevocationRequest.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Represents a token introspection request.
+    @see https://tools.ietf.org/html/rfc7662#section-2.1
+ */
+@interface SCTKIntrospectionRequest : NSObject <NSCopying>
+
+/*! @brief The introspection endpoint of the authorization server.
+ */
+@property(nonatomic, readonly) NSURL *introspectionEndpoint;
+
+/*! @brief The token to introspect.
+    @remarks token
+ */
+@property(nonatomic, readonly) NSString *token;
+
+/*! @brief The type of @c token, such as @c ::SCTKTokenTypeHintAccessToken, if known.
+    @remarks token_type_hint
+ */
+@property(nonatomic, readonly, nullable) NSString *tokenTypeHint;
+
+/*! @brief The identifier with which the protected resource authenticates.
+    @remarks client_id
+ */
+@property(nonatomic, readonly) NSString *clientID;
+
+/*! @brief The client secret, sent with HTTP Basic authentication if present.
+ */
+@property(nonatomic, readonly, nullable) NSString *clientSecret;
+
+/*! @brief The client's additional introspection request parameters.
+ */
+@property(nonatomic, readonly, nullable) NSDictionary<NSString *, NSString *> *additionalParameters;
+
+/*! @internal
+    @brief Unavailable. Please use
+        @c initWithIntrospectionEndpoint:token:tokenTypeHint:clientID:clientSecret:
+        additionalParameters:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param introspectionEndpoint The introspection endpoint of the authorization server.
+    @param token The token to introspect.
+    @param tokenTypeHint The type of the token, if known.
+    @param clientID The client identifier.
+    @param clientSecret The client secret.
+    @param additionalParameters The client's additional introspection request parameters.
+ */
+- (instancetype)initWithIntrospectionEndpoint:(NSURL *)introspectionEndpoint
+                                        token:(NSString *)token
+                                tokenTypeHint:(nullable NSString *)tokenTypeHint
+                                     clientID:(NSString *)clientID
+                                 clientSecret:(nullable NSString *)clientSecret
+                         additionalParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Constructs the request to send to the introspection endpoint.
+ */
+- (NSURLRequest *)URLRequest;
+
+@end
+
+NS_ASSUME_NONNULL_END
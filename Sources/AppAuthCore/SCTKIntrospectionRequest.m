@@ -0,0 +1,132 @@
+/*! @file SCTKIntrospectionRequest.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKIntrospectionRequest.h"
+
+#import "SCTKDefines.h"
+#import "SCTKTokenUtilities.h"
+#import "SCTKURLQueryComponent.h"
+
+/*! @brief The key for the @c token property in the outgoing parameters.
+ */
+static NSString *const kTokenKey = @"token";
+
+/*! @brief The key for the @c tokenTypeHint property in the outgoing parameters.
+ */
+static NSString *const kTokenTypeHintKey = @"token_type_hint";
+
+/*! @brief The key for the @c clientID property in the outgoing parameters.
+ */
+static NSString *const kClientIDKey = @"client_id";
+
+@implementation SCTKIntrospectionRequest
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(
+        @selector(initWithIntrospectionEndpoint:
+                                          token:
+                                  tokenTypeHint:
+                                       clientID:
+                                   clientSecret:
+                           additionalParameters:)
+    )
+
+- (instancetype)initWithIntrospectionEndpoint:(NSURL *)introspectionEndpoint
+                                        token:(NSString *)token
+                                tokenTypeHint:(nullable NSString *)tokenTypeHint
+                                     clientID:(NSString *)clientID
+                                 clientSecret:(nullable NSString *)clientSecret
+                         additionalParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters {
+  self = [super init];
+  if (self) {
+    _introspectionEndpoint = [introspectionEndpoint copy];
+    _token = [token copy];
+    _tokenTypeHint = [tokenTypeHint copy];
+    _clientID = [clientID copy];
+    _clientSecret = [clientSecret copy];
+    _additionalParameters =
+        [[NSDictionary alloc] initWithDictionary:additionalParameters copyItems:YES];
+  }
+  return self;
+}
+
+#pragma mark - NSCopying
+
+- (instancetype)copyWithZone:(nullable NSZone *)zone {
+  // The documentation for NSCopying specifically advises us to return a reference to the original
+  // instance in the case where instances are immutable (as ours is):
+  // "Implement NSCopying by retaining the original instead of creating a new copy when the class
+  // and its contents are immutable."
+  return self;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, introspectionEndpoint: %@, token: \"%@\", "
+                                     "tokenTypeHint: %@, clientID: %@>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _introspectionEndpoint,
+                                    [SCTKTokenUtilities redact:_token],
+                                    _tokenTypeHint,
+                                    _clientID];
+}
+
+#pragma mark -
+
+- (NSURLRequest *)URLRequest {
+  static NSString *const kHTTPPost = @"POST";
+  static NSString *const kHTTPContentTypeHeaderKey = @"Content-Type";
+  static NSString *const kHTTPContentTypeHeaderValue =
+      @"application/x-www-form-urlencoded; charset=UTF-8";
+
+  NSMutableURLRequest *URLRequest = [NSMutableURLRequest requestWithURL:_introspectionEndpoint];
+  URLRequest.HTTPMethod = kHTTPPost;
+  [URLRequest setValue:kHTTPContentTypeHeaderValue forHTTPHeaderField:kHTTPContentTypeHeaderKey];
+
+  SCTKURLQueryComponent *bodyParameters = [[SCTKURLQueryComponent alloc] init];
+  [bodyParameters addParameter:kTokenKey value:_token];
+  if (_tokenTypeHint) {
+    [bodyParameters addParameter:kTokenTypeHintKey value:_tokenTypeHint];
+  }
+  [bodyParameters addParameters:_additionalParameters];
+
+  // https://tools.ietf.org/html/rfc7662#section-2.1
+  // The protected resource authenticates as a client would at the token endpoint; without a
+  // secret it identifies itself with its client_id, for servers that allow it.
+  if (_clientSecret) {
+    NSString *encodedClientID = [SCTKTokenUtilities formUrlEncode:_clientID];
+    NSString *encodedClientSecret = [SCTKTokenUtilities formUrlEncode:_clientSecret];
+    NSString *credentials =
+        [NSString stringWithFormat:@"%@:%@", encodedClientID, encodedClientSecret];
+    NSData *plainData = [credentials dataUsingEncoding:NSUTF8StringEncoding];
+    NSString *basicAuth = [plainData base64EncodedStringWithOptions:kNilOptions];
+    [URLRequest setValue:[NSString stringWithFormat:@"Basic %@", basicAuth]
+        forHTTPHeaderField:@"Authorization"];
+  } else {
+    [bodyParameters addParameter:kClientIDKey value:_clientID];
+  }
+
+  NSString *bodyString = [bodyParameters URLEncodedParameters];
+  URLRequest.HTTPBody = [bodyString dataUsingEncoding:NSUTF8StringEncoding];
+  return URLRequest;
+}
+
+@end
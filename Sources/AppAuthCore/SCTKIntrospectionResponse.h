@@ -0,0 +1,108 @@
+/*! @file SCTKIntrospectionResponse.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Represents the response of a token introspection endpoint.
+    @see https://tools.ietf.org/html/rfc7662#section-2.2
+ */
+@interface SCTKIntrospectionResponse : NSObject <NSCopying>
+
+/*! @brief REQUIRED. Whether the token is currently active. An inactive response usually has no
+        other members.
+    @remarks active
+ */
+@property(nonatomic, readonly, getter=isActive) BOOL active;
+
+/*! @brief The space-separated scopes associated with the token.
+    @remarks scope
+ */
+@property(nonatomic, readonly, nullable) NSString *scope;
+
+/*! @brief The identifier of the client the token was issued to.
+    @remarks client_id
+ */
+@property(nonatomic, readonly, nullable) NSString *clientID;
+
+/*! @brief A human-readable identifier of the resource owner who authorized the token.
+    @remarks username
+ */
+@property(nonatomic, readonly, nullable) NSString *username;
+
+/*! @brief The type of the token.
+    @remarks token_type
+ */
+@property(nonatomic, readonly, nullable) NSString *tokenType;
+
+/*! @brief When the token expires.
+    @remarks exp
+ */
+@property(nonatomic, readonly, nullable) NSDate *expirationDate;
+
+/*! @brief When the token was issued.
+    @remarks iat
+ */
+@property(nonatomic, readonly, nullable) NSDate *issuedAt;
+
+/*! @brief The time before which the token must not be used.
+    @remarks nbf
+ */
+@property(nonatomic, readonly, nullable) NSDate *notBefore;
+
+/*! @brief The subject of the token, usually the resource owner.
+    @remarks sub
+ */
+@property(nonatomic, readonly, nullable) NSString *subject;
+
+/*! @brief The intended audiences of the token. A single audience is returned as one element.
+    @remarks aud
+ */
+@property(nonatomic, readonly, nullable) NSArray<NSString *> *audience;
+
+/*! @brief The issuer of the token.
+    @remarks iss
+ */
+@property(nonatomic, readonly, nullable) NSString *issuer;
+
+/*! @brief The identifier of the token.
+    @remarks jti
+ */
+@property(nonatomic, readonly, nullable) NSString *tokenID;
+
+/*! @brief Members without a property above, including those of a type other than specified.
+ */
+@property(nonatomic, readonly)
+    NSDictionary<NSString *, NSObject<NSCopying> *> *additionalParameters;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithParameters:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param parameters The decoded JSON object returned by the introspection endpoint.
+    @return The response, or nil if @c parameters has no boolean @c active member.
+ */
+- (nullable instancetype)initWithParameters:
+    (NSDictionary<NSString *, NSObject<NSCopying> *> *)parameters NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,141 @@
+/*! @file SCTKIntrospectionResponse.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKIntrospectionResponse.h"
+
+#import "SCTKDefines.h"
+#import "SCTKFieldMapping.h"
+
+/*! @brief The key for the @c active property in the incoming parameters.
+ */
+static NSString *const kActiveKey = @"active";
+
+/*! @brief The key for the @c audience property in the incoming parameters.
+ */
+static NSString *const kAudienceKey = @"aud";
+
+@implementation SCTKIntrospectionResponse
+
+/*! @brief Returns a mapping of incoming parameters to instance variables.
+    @return A mapping of incoming parameters to instance variables.
+    @discussion @c active and @c aud are mapped separately, as their JSON types vary.
+ */
++ (NSDictionary<NSString *, SCTKFieldMapping *> *)fieldMap {
+  static NSMutableDictionary<NSString *, SCTKFieldMapping *> *fieldMap;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    fieldMap = [NSMutableDictionary dictionary];
+    Class stringClass = [NSString class];
+    NSDictionary<NSString *, NSString *> *stringParameters = @{
+      @"scope" : @"_scope",
+      @"client_id" : @"_clientID",
+      @"username" : @"_username",
+      @"token_type" : @"_tokenType",
+      @"sub" : @"_subject",
+      @"iss" : @"_issuer",
+      @"jti" : @"_tokenID",
+    };
+    for (NSString *parameter in stringParameters) {
+      fieldMap[parameter] = [[SCTKFieldMapping alloc] initWithName:stringParameters[parameter]
+                                                              type:stringClass];
+    }
+    NSDictionary<NSString *, NSString *> *dateParameters = @{
+      @"exp" : @"_expirationDate",
+      @"iat" : @"_issuedAt",
+      @"nbf" : @"_notBefore",
+    };
+    for (NSString *parameter in dateParameters) {
+      fieldMap[parameter] =
+          [[SCTKFieldMapping alloc] initWithName:dateParameters[parameter]
+                                            type:[NSDate class]
+                                      conversion:[SCTKFieldMapping dateEpochConversion]];
+    }
+  });
+  return fieldMap;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithParameters:))
+
+- (nullable instancetype)initWithParameters:
+    (NSDictionary<NSString *, NSObject<NSCopying> *> *)parameters {
+  self = [super init];
+  if (self) {
+    NSMutableDictionary<NSString *, NSObject<NSCopying> *> *additionalParameters =
+        [[SCTKFieldMapping remainingParametersWithMap:[[self class] fieldMap]
+                                           parameters:parameters
+                                             instance:self] mutableCopy];
+
+    // https://tools.ietf.org/html/rfc7662#section-2.2
+    // "active REQUIRED. Boolean indicator of whether or not the presented token is currently
+    // active."
+    NSObject *active = additionalParameters[kActiveKey];
+    if (![active isKindOfClass:[NSNumber class]]) {
+      return nil;
+    }
+    _active = [(NSNumber *)active boolValue];
+    [additionalParameters removeObjectForKey:kActiveKey];
+
+    NSObject *audience = additionalParameters[kAudienceKey];
+    if ([audience isKindOfClass:[NSString class]]) {
+      _audience = @[ (NSString *)audience ];
+      [additionalParameters removeObjectForKey:kAudienceKey];
+    } else if ([audience isKindOfClass:[NSArray class]]) {
+      NSPredicate *isString = [NSPredicate predicateWithBlock:^BOOL(id element, id bindings) {
+        return [element isKindOfClass:[NSString class]];
+      }];
+      NSArray *audiences = (NSArray *)audience;
+      if ([audiences filteredArrayUsingPredicate:isString].count == audiences.count) {
+        _audience = audiences;
+        [additionalParameters removeObjectForKey:kAudienceKey];
+      }
+    }
+    _additionalParameters = [additionalParameters copy];
+  }
+  return self;
+}
+
+#pragma mark - NSCopying
+
+- (instancetype)copyWithZone:(nullable NSZone *)zone {
+  // The documentation for NSCopying specifically advises us to return a reference to the original
+  // instance in the case where instances are immutable (as ours is):
+  // "Implement NSCopying by retaining the original instead of creating a new copy when the class
+  // and its contents are immutable."
+  return self;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, active: %@, scope: \"%@\", clientID: %@, "
+                                     "expirationDate: %@, subject: \"%@\", "
+                                     "additionalParameters: %@>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _active ? @"YES" : @"NO",
+                                    _scope,
+                                    _clientID,
+                                    _expirationDate,
+                                    _subject,
+                                    _additionalParameters.allKeys];
+}
+
+@end
@@ -0,0 +1,82 @@
+/*! @file SCTKLoopbackTransport.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "SCTKHTTPTransport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Answers a request of a @c SCTKLoopbackTransport. Only the first call has an effect.
+    @param response The response, if the request succeeded.
+    @param data The body of the response, if any.
+    @param error The error of the request, if it failed.
+ */
+typedef void (^SCTKLoopbackTransportResponder)(NSURLResponse *_Nullable response,
+                                               NSData *_Nullable data,
+                                               NSError *_Nullable error);
+
+/*! @brief Answers the requests of a @c SCTKLoopbackTransport.
+    @param request The request.
+    @param respond Called with the answer, at once or later. A request that is never answered
+        stays in flight until it is cancelled.
+ */
+typedef void (^SCTKLoopbackTransportHandler)(NSURLRequest *request,
+                                             SCTKLoopbackTransportResponder respond);
+
+/*! @brief Answers requests in memory, without a network, such as for benchmarks of the token
+        pipeline or tests of code making requests.
+    @discussion Each request is passed to the handler on the queue of the transport once resumed.
+        The handlers of the request are called, with the whole body as one part, from within the
+        responder.
+ */
+@interface SCTKLoopbackTransport : NSObject <SCTKHTTPTransport>
+
+/*! @brief The number of requests resumed so far.
+ */
+@property(atomic, readonly) NSUInteger requestCount;
+
+/*! @brief Creates a transport answering every request with the same response.
+    @param statusCode The HTTP status code.
+    @param headers The HTTP response headers.
+    @param body The body.
+ */
++ (instancetype)transportWithStatusCode:(NSInteger)statusCode
+                                headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                   body:(nullable NSData *)body;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithHandler:queue:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Creates a transport passing requests to its handler on a global concurrent queue.
+    @param handler Answers the requests.
+ */
+- (instancetype)initWithHandler:(SCTKLoopbackTransportHandler)handler;
+
+/*! @brief Designated initializer.
+    @param handler Answers the requests.
+    @param queue The queue on which the handler is called.
+ */
+- (instancetype)initWithHandler:(SCTKLoopbackTransportHandler)handler
+                          queue:(dispatch_queue_t)queue NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,222 @@
+/*! @file SCTKLoopbackTransport.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKLoopbackTransport.h"
+
+#import "SCTKDefines.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief A request of a @c SCTKLoopbackTransport.
+ */
+@interface SCTKLoopbackTransportTask : NSObject <SCTKHTTPTransportTask>
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithRequest:(NSURLRequest *)request
+                      transport:(SCTKLoopbackTransport *)transport
+                        handler:(SCTKLoopbackTransportHandler)handler
+                          queue:(dispatch_queue_t)queue
+                responseHandler:(SCTKHTTPTransportResponseHandler)responseHandler
+                    dataHandler:(SCTKHTTPTransportDataHandler)dataHandler
+              completionHandler:(SCTKHTTPTransportCompletionHandler)completionHandler
+    NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@interface SCTKLoopbackTransport ()
+
+/*! @brief Counts a resumed request.
+ */
+- (void)didResumeTask;
+
+@end
+
+@implementation SCTKLoopbackTransportTask {
+  NSURLRequest *_request;
+  SCTKLoopbackTransport *_transport;
+  SCTKLoopbackTransportHandler _handler;
+  dispatch_queue_t _queue;
+  SCTKHTTPTransportResponseHandler _responseHandler;
+  SCTKHTTPTransportDataHandler _dataHandler;
+
+  /*! @brief Called once the request completes, nil once it has been called. Guarded by @c self.
+   */
+  SCTKHTTPTransportCompletionHandler _Nullable _completionHandler;
+
+  /*! @brief Whether the task has been resumed. Guarded by @c self.
+   */
+  BOOL _resumed;
+}
+
+- (instancetype)initWithRequest:(NSURLRequest *)request
+                      transport:(SCTKLoopbackTransport *)transport
+                        handler:(SCTKLoopbackTransportHandler)handler
+                          queue:(dispatch_queue_t)queue
+                responseHandler:(SCTKHTTPTransportResponseHandler)responseHandler
+                    dataHandler:(SCTKHTTPTransportDataHandler)dataHandler
+              completionHandler:(SCTKHTTPTransportCompletionHandler)completionHandler {
+  self = [super init];
+  if (self) {
+    _request = [request copy];
+    _transport = transport;
+    _handler = handler;
+    _queue = queue;
+    _responseHandler = [responseHandler copy];
+    _dataHandler = [dataHandler copy];
+    _completionHandler = [completionHandler copy];
+  }
+  return self;
+}
+
+/*! @brief Returns the completion handler if the request has not completed yet, marking it
+        completed.
+ */
+- (nullable SCTKHTTPTransportCompletionHandler)takeCompletionHandler {
+  @synchronized(self) {
+    SCTKHTTPTransportCompletionHandler completionHandler = _completionHandler;
+    _completionHandler = nil;
+    return completionHandler;
+  }
+}
+
+- (void)resume {
+  @synchronized(self) {
+    if (_resumed || !_completionHandler) {
+      return;
+    }
+    _resumed = YES;
+  }
+  [_transport didResumeTask];
+  dispatch_async(_queue, ^{
+    self->_handler(self->_request, ^(NSURLResponse *_Nullable response,
+                                     NSData *_Nullable data,
+                                     NSError *_Nullable error) {
+      [self finishWithResponse:response data:data error:error];
+    });
+  });
+}
+
+- (void)cancel {
+  SCTKHTTPTransportCompletionHandler completionHandler = [self takeCompletionHandler];
+  if (!completionHandler) {
+    return;
+  }
+  dispatch_async(_queue, ^{
+    completionHandler([NSError errorWithDomain:NSURLErrorDomain
+                                          code:NSURLErrorCancelled
+                                      userInfo:nil]);
+  });
+}
+
+/*! @brief Passes an answer to the handlers of the request, unless it has already completed.
+    @param response The response, if the request succeeded.
+    @param data The body of the response, if any.
+    @param error The error of the request, if it failed.
+ */
+- (void)finishWithResponse:(nullable NSURLResponse *)response
+                      data:(nullable NSData *)data
+                     error:(nullable NSError *)error {
+  SCTKHTTPTransportCompletionHandler completionHandler = [self takeCompletionHandler];
+  if (!completionHandler) {
+    return;
+  }
+  if (error || !response) {
+    completionHandler(error);
+    return;
+  }
+  if (!_responseHandler(response) || (data.length > 0 && !_dataHandler(data))) {
+    completionHandler([NSError errorWithDomain:NSURLErrorDomain
+                                          code:NSURLErrorCancelled
+                                      userInfo:nil]);
+    return;
+  }
+  completionHandler(nil);
+}
+
+@end
+
+@implementation SCTKLoopbackTransport {
+  SCTKLoopbackTransportHandler _handler;
+  dispatch_queue_t _queue;
+}
+
+@synthesize requestCount = _requestCount;
+
++ (instancetype)transportWithStatusCode:(NSInteger)statusCode
+                                headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                   body:(nullable NSData *)body {
+  NSData *responseBody = [body copy];
+  return [[self alloc] initWithHandler:^(NSURLRequest *request,
+                                         SCTKLoopbackTransportResponder respond) {
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL
+                                                              statusCode:statusCode
+                                                             HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:headers];
+    respond(response, responseBody, nil);
+  }];
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithHandler:queue:))
+
+- (instancetype)initWithHandler:(SCTKLoopbackTransportHandler)handler {
+  return [self initWithHandler:handler
+                         queue:dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0)];
+}
+
+- (instancetype)initWithHandler:(SCTKLoopbackTransportHandler)handler
+                          queue:(dispatch_queue_t)queue {
+  self = [super init];
+  if (self) {
+    _handler = [handler copy];
+    _queue = queue;
+  }
+  return self;
+}
+
+- (NSUInteger)requestCount {
+  @synchronized(self) {
+    return _requestCount;
+  }
+}
+
+- (void)didResumeTask {
+  @synchronized(self) {
+    _requestCount++;
+  }
+}
+
+#pragma mark - SCTKHTTPTransport
+
+- (id<SCTKHTTPTransportTask>)taskWithRequest:(NSURLRequest *)request
+                             responseHandler:(SCTKHTTPTransportResponseHandler)responseHandler
+                                 dataHandler:(SCTKHTTPTransportDataHandler)dataHandler
+                           completionHandler:(SCTKHTTPTransportCompletionHandler)completionHandler {
+  return [[SCTKLoopbackTransportTask alloc] initWithRequest:request
+                                                  transport:self
+                                                    handler:_handler
+                                                      queue:_queue
+                                            responseHandler:responseHandler
+                                                dataHandler:dataHandler
+                                          completionHandler:completionHandler];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
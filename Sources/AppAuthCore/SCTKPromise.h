@@ -0,0 +1,158 @@
+/*! @file SCTKPromise.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The eventual result of an asynchronous operation: a value, or an error.
+    @discussion A promise starts pending and is resolved exactly once, by @c fulfill:, @c reject:
+        or @c cancel. Later attempts to resolve it are ignored.
+
+        Blocks passed to @c then: and @c recover: are called on a dispatch queue, by default
+        @c SCTKPromise.defaultDispatchQueue, and derive a new promise from their return value:
+        a @c SCTKPromise is adopted, an @c NSError rejects the derived promise, and any other
+        value, including nil, fulfills it.
+
+        Cancelling a promise rejects it with an error of code
+        @c ::SCTKErrorCodePromiseCancelledError and calls its cancellation handlers. The
+        cancellation propagates to each promise it was derived from that is still pending, once
+        no other promise derived from that one waits for it. Work shared by several chains thus
+        keeps running until none of them needs it.
+ */
+@interface SCTKPromise<__covariant ValueType> : NSObject
+
+/*! @brief Whether the promise is yet to be resolved.
+ */
+@property(nonatomic, readonly) BOOL isPending;
+
+/*! @brief The value the promise was fulfilled with, or nil.
+ */
+@property(nonatomic, readonly, nullable) ValueType value;
+
+/*! @brief The error the promise was rejected with, or nil.
+ */
+@property(nonatomic, readonly, nullable) NSError *error;
+
+/*! @brief The queue @c then: and @c recover: call their blocks on, by default the main queue.
+ */
++ (dispatch_queue_t)defaultDispatchQueue;
+
+/*! @brief Sets the queue @c then: and @c recover: call their blocks on.
+    @param dispatchQueue The new default queue, or nil to restore the main queue.
+ */
++ (void)setDefaultDispatchQueue:(nullable dispatch_queue_t)dispatchQueue;
+
+/*! @brief Creates a pending promise, to be resolved with @c fulfill: or @c reject:.
+ */
++ (instancetype)pendingPromise;
+
+/*! @brief Creates a promise fulfilled with the given value.
+    @param value The value.
+ */
++ (instancetype)promiseWithValue:(nullable ValueType)value;
+
+/*! @brief Creates a promise rejected with the given error.
+    @param error The error.
+ */
++ (instancetype)promiseWithError:(NSError *)error;
+
+/*! @brief Creates a promise fulfilled with the values of all the given promises, in order, once
+        they are all fulfilled, with @c NSNull standing in for nil values.
+    @param promises The promises to combine.
+    @discussion Rejected with the first error of the given promises, at which point the promises
+        still pending are cancelled.
+ */
++ (SCTKPromise<NSArray *> *)all:(NSArray<SCTKPromise *> *)promises;
+
+/*! @brief Creates a promise fulfilled with the value of the first of the given promises to be
+        fulfilled, at which point the others are cancelled.
+    @param promises The promises to combine, at least one.
+    @discussion Rejected with the error of the last of the given promises to be rejected, if they
+        are all rejected.
+ */
++ (SCTKPromise *)any:(NSArray<SCTKPromise *> *)promises;
+
+/*! @brief Creates a promise resolved like the first of the given promises to be resolved, at
+        which point the others are cancelled.
+    @param promises The promises to combine, at least one.
+ */
++ (SCTKPromise *)race:(NSArray<SCTKPromise *> *)promises;
+
+/*! @internal
+    @brief Unavailable. Please use @c pendingPromise, @c promiseWithValue: or
+        @c promiseWithError:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Fulfills the promise, if it is pending.
+    @param value The value.
+ */
+- (void)fulfill:(nullable ValueType)value;
+
+/*! @brief Rejects the promise, if it is pending.
+    @param error The error.
+ */
+- (void)reject:(NSError *)error;
+
+/*! @brief Rejects the promise with an error of code @c ::SCTKErrorCodePromiseCancelledError, if
+        it is pending, and propagates the cancellation.
+ */
+- (void)cancel;
+
+/*! @brief Adds a block called when the promise is cancelled, to stop the work that would resolve
+        it. Called immediately if the promise was already cancelled.
+    @param cancellationHandler The block, called on the thread that cancels the promise.
+ */
+- (void)onCancel:(dispatch_block_t)cancellationHandler;
+
+/*! @brief Derives a promise from the value of this one, on the default queue.
+    @param block Called with the value if this promise is fulfilled. Returns a promise to adopt,
+        an error to reject with, or a value to fulfill with.
+    @return A promise rejected with the error of this one if this one is rejected, otherwise
+        resolved from the return value of @c block.
+ */
+- (SCTKPromise *)then:(id _Nullable (^)(ValueType _Nullable value))block;
+
+/*! @brief Derives a promise from the value of this one.
+    @param dispatchQueue The queue to call @c block on.
+    @param block Called with the value if this promise is fulfilled. Returns a promise to adopt,
+        an error to reject with, or a value to fulfill with.
+ */
+- (SCTKPromise *)onQueue:(dispatch_queue_t)dispatchQueue
+                    then:(id _Nullable (^)(ValueType _Nullable value))block;
+
+/*! @brief Derives a promise from the error of this one, on the default queue.
+    @param block Called with the error if this promise is rejected. Returns a promise to adopt,
+        an error to reject with, or a value to fulfill with.
+    @return A promise fulfilled with the value of this one if this one is fulfilled, otherwise
+        resolved from the return value of @c block.
+ */
+- (SCTKPromise *)recover:(id _Nullable (^)(NSError *error))block;
+
+/*! @brief Derives a promise from the error of this one.
+    @param dispatchQueue The queue to call @c block on.
+    @param block Called with the error if this promise is rejected. Returns a promise to adopt,
+        an error to reject with, or a value to fulfill with.
+ */
+- (SCTKPromise *)onQueue:(dispatch_queue_t)dispatchQueue
+                 recover:(id _Nullable (^)(NSError *error))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
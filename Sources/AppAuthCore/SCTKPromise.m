@@ -0,0 +1,414 @@
+/*! @file SCTKPromise.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKPromise.h"
+
+#import "SCTKDefines.h"
+#import "SCTKErrorUtilities.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Called synchronously when a promise is resolved.
+    @param value The value of the promise, if fulfilled.
+    @param error The error of the promise, if rejected.
+ */
+typedef void (^SCTKPromiseObserver)(id _Nullable value, NSError *_Nullable error);
+
+/*! @brief The queue @c then: and @c recover: call their blocks on, or nil for the main queue.
+        Guarded by @c SCTKPromise.
+ */
+static dispatch_queue_t _Nullable gDefaultDispatchQueue;
+
+@implementation SCTKPromise {
+  /*! @brief Whether the promise is yet to be resolved.
+   */
+  BOOL _pending;
+
+  /*! @brief Whether the promise was resolved by @c cancel.
+   */
+  BOOL _cancelled;
+
+  /*! @brief The value the promise was fulfilled with.
+   */
+  id _Nullable _value;
+
+  /*! @brief The error the promise was rejected with.
+   */
+  NSError *_Nullable _error;
+
+  /*! @brief Called when the promise is resolved. Nil once it is.
+   */
+  NSMutableArray<SCTKPromiseObserver> *_Nullable _observers;
+
+  /*! @brief Called when the promise is cancelled. Nil once it is resolved.
+   */
+  NSMutableArray<dispatch_block_t> *_Nullable _cancellationHandlers;
+
+  /*! @brief The promises this one waits for. Nil once it is resolved.
+   */
+  NSMutableArray<SCTKPromise *> *_Nullable _upstreams;
+
+  /*! @brief The number of promises that waited for this one.
+   */
+  NSUInteger _consumerCount;
+
+  /*! @brief The number of promises that no longer wait for this one.
+   */
+  NSUInteger _releasedConsumerCount;
+}
+
++ (dispatch_queue_t)defaultDispatchQueue {
+  @synchronized([SCTKPromise class]) {
+    return gDefaultDispatchQueue ?: dispatch_get_main_queue();
+  }
+}
+
++ (void)setDefaultDispatchQueue:(nullable dispatch_queue_t)dispatchQueue {
+  @synchronized([SCTKPromise class]) {
+    gDefaultDispatchQueue = dispatchQueue;
+  }
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(pendingPromise))
+
+/*! @brief Creates a pending promise.
+ */
+- (instancetype)initPending {
+  self = [super init];
+  if (self) {
+    _pending = YES;
+    _observers = [NSMutableArray array];
+    _cancellationHandlers = [NSMutableArray array];
+    _upstreams = [NSMutableArray array];
+  }
+  return self;
+}
+
++ (instancetype)pendingPromise {
+  return [[self alloc] initPending];
+}
+
++ (instancetype)promiseWithValue:(nullable id)value {
+  SCTKPromise *promise = [self pendingPromise];
+  [promise fulfill:value];
+  return promise;
+}
+
++ (instancetype)promiseWithError:(NSError *)error {
+  SCTKPromise *promise = [self pendingPromise];
+  [promise reject:error];
+  return promise;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  @synchronized(self) {
+    return [NSString stringWithFormat:@"<%@: %p, pending: %@, value: %@, error: %@>",
+                                      NSStringFromClass([self class]),
+                                      (void *)self,
+                                      _pending ? @"YES" : @"NO",
+                                      _value,
+                                      _error];
+  }
+}
+
+#pragma mark - State
+
+- (BOOL)isPending {
+  @synchronized(self) {
+    return _pending;
+  }
+}
+
+- (nullable id)value {
+  @synchronized(self) {
+    return _value;
+  }
+}
+
+- (nullable NSError *)error {
+  @synchronized(self) {
+    return _error;
+  }
+}
+
+#pragma mark - Resolution
+
+- (void)fulfill:(nullable id)value {
+  [self resolveWithValue:value error:nil cancelled:NO];
+}
+
+- (void)reject:(NSError *)error {
+  NSAssert(error, @"Parameter: |error| must be non-nil.");
+  [self resolveWithValue:nil error:error cancelled:NO];
+}
+
+- (void)cancel {
+  NSError *error = [SCTKErrorUtilities errorWithCode:SCTKErrorCodePromiseCancelledError
+                                     underlyingError:nil
+                                         description:@"The promise was cancelled."];
+  [self resolveWithValue:nil error:error cancelled:YES];
+}
+
+- (void)onCancel:(dispatch_block_t)cancellationHandler {
+  BOOL cancelled;
+  @synchronized(self) {
+    if (_pending) {
+      [_cancellationHandlers addObject:[cancellationHandler copy]];
+      return;
+    }
+    cancelled = _cancelled;
+  }
+  if (cancelled) {
+    cancellationHandler();
+  }
+}
+
+/*! @brief Resolves the promise if it is pending, then notifies its observers and releases the
+        promises it waited for.
+    @param value The value to fulfill the promise with.
+    @param error The error to reject the promise with, takes precedence over @c value.
+    @param cancelled Whether to call the cancellation handlers.
+ */
+- (void)resolveWithValue:(nullable id)value
+                   error:(nullable NSError *)error
+               cancelled:(BOOL)cancelled {
+  NSArray<SCTKPromiseObserver> *observers;
+  NSArray<dispatch_block_t> *cancellationHandlers;
+  NSArray<SCTKPromise *> *upstreams;
+  @synchronized(self) {
+    if (!_pending) {
+      return;
+    }
+    _pending = NO;
+    _cancelled = cancelled;
+    _value = error ? nil : value;
+    _error = error;
+    observers = _observers;
+    cancellationHandlers = cancelled ? _cancellationHandlers : nil;
+    upstreams = _upstreams;
+    _observers = nil;
+    _cancellationHandlers = nil;
+    _upstreams = nil;
+  }
+
+  for (dispatch_block_t cancellationHandler in cancellationHandlers) {
+    cancellationHandler();
+  }
+  for (SCTKPromise *upstream in upstreams) {
+    [upstream consumerDidRelease];
+  }
+  for (SCTKPromiseObserver observer in observers) {
+    observer(error ? nil : value, error);
+  }
+}
+
+/*! @brief Resolves the promise from the return value of a @c then: or @c recover: block.
+    @param result A promise to adopt, an error to reject with, or a value to fulfill with.
+ */
+- (void)resolveWithResult:(nullable id)result {
+  if ([result isKindOfClass:[SCTKPromise class]]) {
+    SCTKPromise *adoptedPromise = result;
+    [self addUpstream:adoptedPromise];
+    [adoptedPromise addObserver:^(id _Nullable value, NSError *_Nullable error) {
+      [self resolveWithValue:value error:error cancelled:NO];
+    }];
+  } else if ([result isKindOfClass:[NSError class]]) {
+    [self reject:result];
+  } else {
+    [self fulfill:result];
+  }
+}
+
+/*! @brief Calls the observer when the promise is resolved, immediately if it already is.
+    @param observer The observer, called on the thread that resolves the promise.
+ */
+- (void)addObserver:(SCTKPromiseObserver)observer {
+  id value;
+  NSError *error;
+  @synchronized(self) {
+    if (_pending) {
+      [_observers addObject:[observer copy]];
+      return;
+    }
+    value = _value;
+    error = _error;
+  }
+  observer(value, error);
+}
+
+#pragma mark - Cancellation propagation
+
+/*! @brief Makes this promise wait for another, which is then only cancelled by this one once no
+        other promise waits for it.
+    @param upstream The promise this one waits for.
+ */
+- (void)addUpstream:(SCTKPromise *)upstream {
+  [upstream addConsumer];
+  @synchronized(self) {
+    if (_pending) {
+      [_upstreams addObject:upstream];
+      return;
+    }
+  }
+  [upstream consumerDidRelease];
+}
+
+/*! @brief Records that another promise waits for this one.
+ */
+- (void)addConsumer {
+  @synchronized(self) {
+    _consumerCount++;
+  }
+}
+
+/*! @brief Records that a promise no longer waits for this one, and cancels this one if no promise
+        does.
+ */
+- (void)consumerDidRelease {
+  BOOL unused;
+  @synchronized(self) {
+    _releasedConsumerCount++;
+    unused = _pending && _releasedConsumerCount == _consumerCount;
+  }
+  if (unused) {
+    [self cancel];
+  }
+}
+
+#pragma mark - Chaining
+
+- (SCTKPromise *)then:(id _Nullable (^)(id _Nullable value))block {
+  return [self onQueue:[[self class] defaultDispatchQueue] then:block];
+}
+
+- (SCTKPromise *)onQueue:(dispatch_queue_t)dispatchQueue
+                    then:(id _Nullable (^)(id _Nullable value))block {
+  SCTKPromise *derivedPromise = [SCTKPromise pendingPromise];
+  [derivedPromise addUpstream:self];
+  [self addObserver:^(id _Nullable value, NSError *_Nullable error) {
+    if (error) {
+      [derivedPromise reject:error];
+      return;
+    }
+    dispatch_async(dispatchQueue, ^{
+      // the derived promise may have been cancelled while the block was queued
+      if (derivedPromise.isPending) {
+        [derivedPromise resolveWithResult:block(value)];
+      }
+    });
+  }];
+  return derivedPromise;
+}
+
+- (SCTKPromise *)recover:(id _Nullable (^)(NSError *error))block {
+  return [self onQueue:[[self class] defaultDispatchQueue] recover:block];
+}
+
+- (SCTKPromise *)onQueue:(dispatch_queue_t)dispatchQueue
+                 recover:(id _Nullable (^)(NSError *error))block {
+  SCTKPromise *derivedPromise = [SCTKPromise pendingPromise];
+  [derivedPromise addUpstream:self];
+  [self addObserver:^(id _Nullable value, NSError *_Nullable error) {
+    if (!error) {
+      [derivedPromise fulfill:value];
+      return;
+    }
+    dispatch_async(dispatchQueue, ^{
+      if (derivedPromise.isPending) {
+        [derivedPromise resolveWithResult:block(error)];
+      }
+    });
+  }];
+  return derivedPromise;
+}
+
+#pragma mark - Combinators
+
++ (SCTKPromise<NSArray *> *)all:(NSArray<SCTKPromise *> *)promises {
+  SCTKPromise<NSArray *> *combinedPromise = [SCTKPromise pendingPromise];
+  if (promises.count == 0) {
+    [combinedPromise fulfill:@[]];
+    return combinedPromise;
+  }
+
+  NSMutableArray *values = [NSMutableArray arrayWithCapacity:promises.count];
+  for (NSUInteger i = 0; i < promises.count; i++) {
+    [values addObject:[NSNull null]];
+  }
+  __block NSUInteger remainingCount = promises.count;
+  [promises enumerateObjectsUsingBlock:^(SCTKPromise *promise, NSUInteger index, BOOL *stop) {
+    [combinedPromise addUpstream:promise];
+    [promise addObserver:^(id _Nullable value, NSError *_Nullable error) {
+      if (error) {
+        [combinedPromise reject:error];
+        return;
+      }
+      BOOL fulfilled;
+      @synchronized(values) {
+        values[index] = value ?: [NSNull null];
+        fulfilled = (--remainingCount == 0);
+      }
+      if (fulfilled) {
+        [combinedPromise fulfill:[values copy]];
+      }
+    }];
+  }];
+  return combinedPromise;
+}
+
++ (SCTKPromise *)any:(NSArray<SCTKPromise *> *)promises {
+  NSAssert(promises.count > 0, @"Parameter: |promises| must not be empty.");
+  SCTKPromise *combinedPromise = [SCTKPromise pendingPromise];
+  __block NSUInteger remainingCount = promises.count;
+  for (SCTKPromise *promise in promises) {
+    [combinedPromise addUpstream:promise];
+    [promise addObserver:^(id _Nullable value, NSError *_Nullable error) {
+      if (!error) {
+        [combinedPromise fulfill:value];
+        return;
+      }
+      BOOL rejected;
+      @synchronized(combinedPromise) {
+        rejected = (--remainingCount == 0);
+      }
+      if (rejected) {
+        [combinedPromise reject:error];
+      }
+    }];
+  }
+  return combinedPromise;
+}
+
++ (SCTKPromise *)race:(NSArray<SCTKPromise *> *)promises {
+  NSAssert(promises.count > 0, @"Parameter: |promises| must not be empty.");
+  SCTKPromise *combinedPromise = [SCTKPromise pendingPromise];
+  for (SCTKPromise *promise in promises) {
+    [combinedPromise addUpstream:promise];
+    [promise addObserver:^(id _Nullable value, NSError *_Nullable error) {
+      [combinedPromise resolveWithValue:value error:error cancelled:NO];
+    }];
+  }
+  return combinedPromise;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
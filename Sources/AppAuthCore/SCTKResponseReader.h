@@ -0,0 +1,105 @@
+/*! @file SCTKResponseReader.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "SCTKHTTPTransport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The kinds of endpoint whose responses are read with a size limit.
+ */
+typedef NS_ENUM(NSInteger, SCTKResponseReaderEndpoint) {
+  /*! @brief The OpenID Connect discovery document. The default limit is 1 MiB.
+   */
+  SCTKResponseReaderEndpointDiscovery = 0,
+
+  /*! @brief The token endpoint. The default limit is 256 KiB.
+   */
+  SCTKResponseReaderEndpointToken = 1,
+
+  /*! @brief The dynamic client registration endpoint. The default limit is 256 KiB.
+   */
+  SCTKResponseReaderEndpointRegistration = 2,
+
+  /*! @brief The OpenID Connect userinfo endpoint. The default limit is 256 KiB.
+   */
+  SCTKResponseReaderEndpointUserInfo = 3,
+
+  /*! @brief The token revocation endpoint. The default limit is 64 KiB.
+   */
+  SCTKResponseReaderEndpointRevocation = 4,
+
+  /*! @brief The token introspection endpoint. The default limit is 64 KiB.
+   */
+  SCTKResponseReaderEndpointIntrospection = 5,
+};
+
+/*! @brief Called when a response has been read.
+    @param data The body of the response, or nil if there was an error.
+    @param response The response, if one was received.
+    @param error The error of the request, or an error of code
+        @c ::SCTKErrorCodeResponseTooLargeError if the body exceeded the maximum size.
+ */
+typedef void (^SCTKResponseReaderCompletion)(NSData *_Nullable data,
+                                             NSURLResponse *_Nullable response,
+                                             NSError *_Nullable error);
+
+/*! @brief Reads response bodies with a maximum size per kind of endpoint.
+    @discussion The body is streamed from the transport into a single buffer, sized from the
+        Content-Length of the response when given, and the request is cancelled as soon as the
+        body is known to exceed the maximum.
+ */
+@interface SCTKResponseReader : NSObject
+
+/*! @brief Returns the maximum body size of responses from the given kind of endpoint, in bytes.
+    @param endpoint The kind of endpoint.
+ */
++ (NSUInteger)maximumBodySizeForEndpoint:(SCTKResponseReaderEndpoint)endpoint;
+
+/*! @brief Sets the maximum body size of responses from the given kind of endpoint.
+    @param maximumBodySize The maximum size, in bytes.
+    @param endpoint The kind of endpoint.
+ */
++ (void)setMaximumBodySize:(NSUInteger)maximumBodySize
+               forEndpoint:(SCTKResponseReaderEndpoint)endpoint;
+
+/*! @brief Creates a task reading the response to a request, to be resumed by the caller.
+    @param transport The transport to send the request through.
+    @param request The request.
+    @param endpoint The kind of endpoint the request is sent to.
+    @param completionHandler Called on the queue of the transport when the response has been read.
+ */
++ (id<SCTKHTTPTransportTask>)taskWithTransport:(id<SCTKHTTPTransport>)transport
+                                       request:(NSURLRequest *)request
+                                      endpoint:(SCTKResponseReaderEndpoint)endpoint
+                             completionHandler:(SCTKResponseReaderCompletion)completionHandler;
+
+/*! @brief Determines whether an error reports a response body that exceeded the maximum size.
+    @param error The error.
+ */
++ (BOOL)isResponseTooLargeError:(nullable NSError *)error;
+
+/*! @internal
+    @brief Unavailable. Please use @c taskWithTransport:request:endpoint:completionHandler:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,200 @@
+/*! @file SCTKResponseReader.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKResponseReader.h"
+
+#import "SCTKDefines.h"
+#import "SCTKErrorUtilities.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The number of kinds of endpoint in @c SCTKResponseReaderEndpoint.
+ */
+static const NSInteger kEndpointCount = SCTKResponseReaderEndpointIntrospection + 1;
+
+/*! @brief The maximum body sizes per kind of endpoint. Guarded by @c SCTKResponseReader.
+ */
+static NSUInteger gMaximumBodySizes[kEndpointCount] = {
+  [SCTKResponseReaderEndpointDiscovery] = 1024 * 1024,
+  [SCTKResponseReaderEndpointToken] = 256 * 1024,
+  [SCTKResponseReaderEndpointRegistration] = 256 * 1024,
+  [SCTKResponseReaderEndpointUserInfo] = 256 * 1024,
+  [SCTKResponseReaderEndpointRevocation] = 64 * 1024,
+  [SCTKResponseReaderEndpointIntrospection] = 64 * 1024,
+};
+
+@implementation SCTKResponseReader {
+  /*! @brief The URL of the request.
+   */
+  NSURL *_Nullable _URL;
+
+  /*! @brief The maximum size of the body, in bytes.
+   */
+  NSUInteger _maximumBodySize;
+
+  /*! @brief Called when the response has been read, nil once it has been called.
+   */
+  SCTKResponseReaderCompletion _Nullable _completionHandler;
+
+  /*! @brief The response, once received.
+   */
+  NSURLResponse *_Nullable _response;
+
+  /*! @brief The body read so far.
+   */
+  NSMutableData *_Nullable _body;
+
+  /*! @brief Set when the body exceeded the maximum size.
+   */
+  NSError *_Nullable _overflowError;
+}
+
++ (NSUInteger)maximumBodySizeForEndpoint:(SCTKResponseReaderEndpoint)endpoint {
+  NSAssert(endpoint >= 0 && endpoint < kEndpointCount, @"Unknown endpoint %ld.", (long)endpoint);
+  @synchronized([SCTKResponseReader class]) {
+    return gMaximumBodySizes[endpoint];
+  }
+}
+
++ (void)setMaximumBodySize:(NSUInteger)maximumBodySize
+               forEndpoint:(SCTKResponseReaderEndpoint)endpoint {
+  NSAssert(endpoint >= 0 && endpoint < kEndpointCount, @"Unknown endpoint %ld.", (long)endpoint);
+  @synchronized([SCTKResponseReader class]) {
+    gMaximumBodySizes[endpoint] = maximumBodySize;
+  }
+}
+
+/*! @brief Returns the error reported when a body exceeds the maximum size.
+    @param URL The URL of the request.
+    @param maximumBodySize The maximum size, in bytes.
+ */
++ (NSError *)overflowErrorForURL:(nullable NSURL *)URL maximumBodySize:(NSUInteger)maximumBodySize {
+  NSString *description =
+      [NSString stringWithFormat:@"The response from '%@' exceeded the maximum size of %lu bytes.",
+                                 URL,
+                                 (unsigned long)maximumBodySize];
+  return [SCTKErrorUtilities errorWithCode:SCTKErrorCodeResponseTooLargeError
+                           underlyingError:nil
+                               description:description];
+}
+
++ (BOOL)isResponseTooLargeError:(nullable NSError *)error {
+  return [error.domain isEqualToString:SCTKGeneralErrorDomain]
+      && error.code == SCTKErrorCodeResponseTooLargeError;
+}
+
++ (id<SCTKHTTPTransportTask>)taskWithTransport:(id<SCTKHTTPTransport>)transport
+                                       request:(NSURLRequest *)request
+                                      endpoint:(SCTKResponseReaderEndpoint)endpoint
+                             completionHandler:(SCTKResponseReaderCompletion)completionHandler {
+  SCTKResponseReader *reader =
+      [[SCTKResponseReader alloc] initWithURL:request.URL
+                              maximumBodySize:[self maximumBodySizeForEndpoint:endpoint]
+                            completionHandler:completionHandler];
+  // the transport holds on to the handlers, and so the reader, until the request completes
+  return [transport taskWithRequest:request
+                    responseHandler:^BOOL(NSURLResponse *response) {
+    return [reader didReceiveResponse:response];
+  }
+                        dataHandler:^BOOL(NSData *data) {
+    return [reader didReceiveData:data];
+  }
+                  completionHandler:^(NSError *_Nullable error) {
+    [reader didCompleteWithError:error];
+  }];
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(
+        @selector(taskWithTransport:request:endpoint:completionHandler:))
+
+/*! @brief Creates a reader for a single request.
+    @param URL The URL of the request.
+    @param maximumBodySize The maximum size of the body, in bytes.
+    @param completionHandler Called when the response has been read.
+ */
+- (instancetype)initWithURL:(nullable NSURL *)URL
+            maximumBodySize:(NSUInteger)maximumBodySize
+          completionHandler:(SCTKResponseReaderCompletion)completionHandler {
+  self = [super init];
+  if (self) {
+    _URL = URL;
+    _maximumBodySize = maximumBodySize;
+    _completionHandler = [completionHandler copy];
+  }
+  return self;
+}
+
+/*! @brief Sizes the buffer for the body of a response.
+    @param response The response.
+    @return NO if the response is known to exceed the maximum size.
+ */
+- (BOOL)didReceiveResponse:(NSURLResponse *)response {
+  _response = response;
+  long long expectedContentLength = response.expectedContentLength;
+  if (expectedContentLength > (long long)_maximumBodySize) {
+    _overflowError = [[self class] overflowErrorForURL:_URL maximumBodySize:_maximumBodySize];
+    return NO;
+  }
+  // sized up front when the length is known, so that the buffer never has to grow
+  NSUInteger capacity = expectedContentLength > 0 ? (NSUInteger)expectedContentLength : 0;
+  _body = [NSMutableData dataWithCapacity:capacity];
+  return YES;
+}
+
+/*! @brief Appends a part of the body.
+    @param data The part of the body.
+    @return NO if the body exceeds the maximum size.
+ */
+- (BOOL)didReceiveData:(NSData *)data {
+  if (_overflowError) {
+    return NO;
+  }
+  if (_body.length + data.length > _maximumBodySize) {
+    _overflowError = [[self class] overflowErrorForURL:_URL maximumBodySize:_maximumBodySize];
+    return NO;
+  }
+  // appends each region of the possibly discontiguous data, rather than flattening it first
+  NSMutableData *body = _body;
+  [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+    [body appendBytes:bytes length:byteRange.length];
+  }];
+  return YES;
+}
+
+/*! @brief Calls the completion handler, once.
+    @param error The error of the request, if any.
+ */
+- (void)didCompleteWithError:(nullable NSError *)error {
+  SCTKResponseReaderCompletion completionHandler = _completionHandler;
+  _completionHandler = nil;
+  if (!completionHandler) {
+    return;
+  }
+  if (_overflowError) {
+    completionHandler(nil, _response, _overflowError);
+  } else if (error) {
+    completionHandler(nil, _response, error);
+  } else {
+    completionHandler(_body ?: [NSData data], _response, nil);
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
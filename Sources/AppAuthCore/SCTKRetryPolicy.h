@@ -0,0 +1,71 @@
+/*! @file SCTKRetryPolicy.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Decides whether and when a failed request is retried.
+    @discussion Only transient failures are retried: network errors, and HTTP 429 and 5xx
+        responses that do not carry an OAuth error. The delay before each retry follows
+        exponential backoff with full jitter: a random duration between zero and
+        @c initialDelay doubled once per previous retry, capped at @c maximumDelay. Spreading
+        retries this way keeps clients that failed together from retrying together.
+ */
+@interface SCTKRetryPolicy : NSObject
+
+/*! @brief The maximum number of retries after the first attempt.
+ */
+@property(nonatomic, readonly) NSUInteger maximumRetryCount;
+
+/*! @brief The upper bound of the delay before the first retry.
+ */
+@property(nonatomic, readonly) NSTimeInterval initialDelay;
+
+/*! @brief The upper bound of the delay before any retry.
+ */
+@property(nonatomic, readonly) NSTimeInterval maximumDelay;
+
+/*! @brief Creates a policy of at most three retries, with an initial delay of one second and a
+        maximum delay of thirty seconds.
+ */
+- (instancetype)init;
+
+/*! @brief Designated initializer.
+    @param maximumRetryCount The maximum number of retries after the first attempt.
+    @param initialDelay The upper bound of the delay before the first retry.
+    @param maximumDelay The upper bound of the delay before any retry.
+ */
+- (instancetype)initWithMaximumRetryCount:(NSUInteger)maximumRetryCount
+                             initialDelay:(NSTimeInterval)initialDelay
+                             maximumDelay:(NSTimeInterval)maximumDelay
+    NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Returns a random delay to wait before a retry.
+    @param retry The number of retries already made, starting at zero.
+ */
+- (NSTimeInterval)delayBeforeRetry:(NSUInteger)retry;
+
+/*! @brief Determines whether a request that failed with an error may succeed if retried.
+    @param error The error returned by @c SCTKAuthorizationService.
+ */
++ (BOOL)isTransientError:(nullable NSError *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,100 @@
+/*! @file SCTKRetryPolicy.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKRetryPolicy.h"
+
+#import "SCTKError.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The default maximum number of retries.
+ */
+static const NSUInteger kDefaultMaximumRetryCount = 3;
+
+/*! @brief The default upper bound of the delay before the first retry, in seconds.
+ */
+static const NSTimeInterval kDefaultInitialDelay = 1;
+
+/*! @brief The default upper bound of the delay before any retry, in seconds.
+ */
+static const NSTimeInterval kDefaultMaximumDelay = 30;
+
+/*! @brief The HTTP status code of a rate-limited request.
+ */
+static const NSInteger kHTTPStatusCodeTooManyRequests = 429;
+
+@implementation SCTKRetryPolicy
+
+- (instancetype)init {
+  return [self initWithMaximumRetryCount:kDefaultMaximumRetryCount
+                            initialDelay:kDefaultInitialDelay
+                            maximumDelay:kDefaultMaximumDelay];
+}
+
+- (instancetype)initWithMaximumRetryCount:(NSUInteger)maximumRetryCount
+                             initialDelay:(NSTimeInterval)initialDelay
+                             maximumDelay:(NSTimeInterval)maximumDelay {
+  self = [super init];
+  if (self) {
+    _maximumRetryCount = maximumRetryCount;
+    _initialDelay = initialDelay;
+    _maximumDelay = maximumDelay;
+  }
+  return self;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, maximumRetryCount: %lu, initialDelay: %.3f, "
+                                     "maximumDelay: %.3f>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    (unsigned long)_maximumRetryCount,
+                                    _initialDelay,
+                                    _maximumDelay];
+}
+
+#pragma mark - Retries
+
+- (NSTimeInterval)delayBeforeRetry:(NSUInteger)retry {
+  // caps the exponent too, so that the backoff cannot overflow
+  NSTimeInterval backoff = MIN(_maximumDelay, _initialDelay * pow(2, MIN(retry, (NSUInteger)32)));
+  return backoff * ((double)arc4random() / UINT32_MAX);
+}
+
++ (BOOL)isTransientError:(nullable NSError *)error {
+  if (![error.domain isEqualToString:SCTKGeneralErrorDomain]) {
+    // OAuth errors are answers from a working server
+    return NO;
+  }
+  if (error.code == SCTKErrorCodeNetworkError) {
+    return YES;
+  }
+  if (error.code == SCTKErrorCodeServerError) {
+    NSError *HTTPError = error.userInfo[NSUnderlyingErrorKey];
+    if ([HTTPError.domain isEqualToString:SCTKHTTPErrorDomain]) {
+      return HTTPError.code >= 500 || HTTPError.code == kHTTPStatusCodeTooManyRequests;
+    }
+  }
+  return NO;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
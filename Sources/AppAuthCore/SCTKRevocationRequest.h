@@ -0,0 +1,94 @@
+/*! @file SCTKRevocationRequest.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The token type hint for an access token.
+    @see https://tools.ietf.org/html/rfc7009#section-2.1
+ */
+extern NSString *const SCTKTokenTypeHintAccessToken;
+
+/*! @brief The token type hint for a refresh token.
+    @see https://tools.ietf.org/html/rfc7009#section-2.1
+ */
+extern NSString *const SCTKTokenTypeHintRefreshToken;
+
+/*! @brief Represents a token revocation request.
+    @see https://tools.ietf.org/html/rfc7009#section-2.1
+ */
+@interface SCTKRevocationRequest : NSObject <NSCopying>
+
+/*! @brief The revocation endpoint of the authorization server.
+ */
+@property(nonatomic, readonly) NSURL *revocationEndpoint;
+
+/*! @brief The token to revoke.
+    @remarks token
+ */
+@property(nonatomic, readonly) NSString *token;
+
+/*! @brief The type of @c token, such as @c ::SCTKTokenTypeHintRefreshToken, if known.
+    @remarks token_type_hint
+ */
+@property(nonatomic, readonly, nullable) NSString *tokenTypeHint;
+
+/*! @brief The client identifier.
+    @remarks client_id
+ */
+@property(nonatomic, readonly) NSString *clientID;
+
+/*! @brief The client secret, sent with HTTP Basic authentication if present.
+ */
+@property(nonatomic, readonly, nullable) NSString *clientSecret;
+
+/*! @brief The client's additional revocation request parameters.
+ */
+@property(nonatomic, readonly, nullable) NSDictionary<NSString *, NSString *> *additionalParameters;
+
+/*! @internal
+    @brief Unavailable. Please use
+        @c initWithRevocationEndpoint:token:tokenTypeHint:clientID:clientSecret:
+        additionalParameters:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param revocationEndpoint The revocation endpoint of the authorization server.
+    @param token The token to revoke.
+    @param tokenTypeHint The type of the token, if known.
+    @param clientID The client identifier.
+    @param clientSecret The client secret.
+    @param additionalParameters The client's additional revocation request parameters.
+ */
+- (instancetype)initWithRevocationEndpoint:(NSURL *)revocationEndpoint
+                                     token:(NSString *)token
+                             tokenTypeHint:(nullable NSString *)tokenTypeHint
+                                  clientID:(NSString *)clientID
+                              clientSecret:(nullable NSString *)clientSecret
+                      additionalParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Constructs the request to send to the revocation endpoint.
+ */
+- (NSURLRequest *)URLRequest;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -90,6 +90,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property(nonatomic, readonly, nullable) NSURL *endSessionEndpoint;
 
+/*! @brief OPTIONAL. URL of the authorization server's OAuth 2.0 revocation endpoint.
+    @remarks revocation_endpoint
+    @see https://tools.ietf.org/html/rfc8414#section-2
+    @see https://tools.ietf.org/html/rfc7009
+ */
+@property(nonatomic, readonly, nullable) NSURL *revocationEndpoint;
+
+/*! @brief OPTIONAL. URL of the authorization server's OAuth 2.0 introspection endpoint.
+    @remarks introspection_endpoint
+    @see https://tools.ietf.org/html/rfc8414#section-2
+    @see https://tools.ietf.org/html/rfc7662
+ */
+@property(nonatomic, readonly, nullable) NSURL *introspectionEndpoint;
+
 /*! @brief RECOMMENDED. JSON array containing a list of the OAuth 2.0 [RFC6749] scope values that
         this server supports. The server MUST support the openid scope value. Servers MAY choose not
         to advertise some supported scope values even when this parameter is used, although those
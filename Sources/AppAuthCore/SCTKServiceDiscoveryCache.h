@@ -0,0 +1,156 @@
+/*! @file SCTKServiceDiscoveryCache.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class SCTKServiceDiscovery;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief A discovery document held by a @c SCTKServiceDiscoveryCache, with the HTTP caching
+        metadata of the response it came from.
+ */
+@interface SCTKServiceDiscoveryCacheEntry : NSObject <NSSecureCoding>
+
+/*! @brief The discovery document.
+ */
+@property(nonatomic, readonly) SCTKServiceDiscovery *discovery;
+
+/*! @brief The date after which the document must be revalidated before it is relied on.
+ */
+@property(nonatomic, readonly) NSDate *expirationDate;
+
+/*! @brief The @c ETag of the response, if one was given.
+ */
+@property(nonatomic, readonly, nullable) NSString *entityTag;
+
+/*! @brief The @c Last-Modified header of the response, if one was given.
+ */
+@property(nonatomic, readonly, nullable) NSString *lastModified;
+
+/*! @brief Whether the document can be used without revalidation.
+ */
+@property(nonatomic, readonly, getter=isFresh) BOOL fresh;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithDiscovery:expirationDate:entityTag:lastModified:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param discovery The discovery document.
+    @param expirationDate The date after which the document must be revalidated.
+    @param entityTag The @c ETag of the response.
+    @param lastModified The @c Last-Modified header of the response.
+ */
+- (instancetype)initWithDiscovery:(SCTKServiceDiscovery *)discovery
+                   expirationDate:(NSDate *)expirationDate
+                        entityTag:(nullable NSString *)entityTag
+                     lastModified:(nullable NSString *)lastModified NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Adds the @c If-None-Match and @c If-Modified-Since headers that revalidate this entry.
+    @param request The request for the discovery document.
+ */
+- (void)addValidatorsToRequest:(NSMutableURLRequest *)request;
+
+@end
+
+/*! @brief Caches discovery documents according to the HTTP caching headers of their responses.
+    @discussion Freshness comes from the @c max-age directive of @c Cache-Control, less any
+        @c Age, or failing that from @c Expires. Responses marked @c no-store are not cached, and
+        responses marked @c no-cache, or without freshness information, are revalidated on each
+        use. Entries are kept in memory and, when the cache has a directory, written there so
+        they outlive the process.
+
+        While a cache is set with @c SCTKServiceDiscoveryCache.setSharedCache:, discovery returns a
+        fresh cached document without a request. A stale document is returned immediately and
+        revalidated in the background if @c revalidatesInBackground is set, otherwise it is
+        revalidated first, with the document returned on a 304 response or a connection error.
+ */
+@interface SCTKServiceDiscoveryCache : NSObject
+
+/*! @brief The directory the entries are written to, or nil if they are kept in memory only.
+ */
+@property(nonatomic, readonly, nullable) NSURL *directoryURL;
+
+/*! @brief Whether discovery returns stale documents immediately and revalidates them
+        afterwards, rather than waiting for the revalidation. Defaults to YES.
+ */
+@property(atomic) BOOL revalidatesInBackground;
+
+/*! @brief Returns the cache used by discovery, nil by default.
+ */
++ (nullable SCTKServiceDiscoveryCache *)sharedCache;
+
+/*! @brief Sets the cache used by discovery.
+    @param cache The cache to use, or nil to fetch every document from the network.
+ */
++ (void)setSharedCache:(nullable SCTKServiceDiscoveryCache *)cache;
+
+/*! @brief Creates a cache that keeps entries in memory only.
+ */
+- (instancetype)init;
+
+/*! @brief Designated initializer.
+    @param directoryURL The directory to write entries to, which is created if needed, or nil to
+        keep entries in memory only.
+ */
+- (instancetype)initWithDirectoryURL:(nullable NSURL *)directoryURL NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Returns the entry for a discovery URL, reading it from the directory if needed.
+    @param URL The URL of the discovery document.
+ */
+- (nullable SCTKServiceDiscoveryCacheEntry *)entryForURL:(NSURL *)URL;
+
+/*! @brief Caches a document received in a 200 response, unless the response forbids it.
+    @param discovery The discovery document.
+    @param response The response the document was received in.
+    @param URL The URL of the discovery document.
+    @return The new entry, or nil if the response was not cacheable.
+ */
+- (nullable SCTKServiceDiscoveryCacheEntry *)storeDiscovery:(SCTKServiceDiscovery *)discovery
+                                                   response:(NSHTTPURLResponse *)response
+                                                     forURL:(NSURL *)URL;
+
+/*! @brief Renews the entry for a discovery URL from a 304 response.
+    @param response The 304 response, whose caching headers replace those of the entry.
+    @param URL The URL of the discovery document.
+    @return The renewed entry, or nil if there was no entry or the response was not cacheable.
+ */
+- (nullable SCTKServiceDiscoveryCacheEntry *)
+    renewEntryWithNotModifiedResponse:(NSHTTPURLResponse *)response
+                               forURL:(NSURL *)URL;
+
+/*! @brief Removes the entry for a discovery URL.
+    @param URL The URL of the discovery document.
+ */
+- (void)removeEntryForURL:(NSURL *)URL;
+
+/*! @brief Removes all entries, including those written to the directory.
+ */
+- (void)removeAllEntries;
+
+/*! @brief Returns the date after which a response must be revalidated.
+    @param response The response.
+    @param storable Set to NO if the response must not be cached.
+ */
++ (NSDate *)expirationDateForResponse:(NSHTTPURLResponse *)response storable:(BOOL *)storable;
+
+@end
+
+NS_ASSUME_NONNULL_END
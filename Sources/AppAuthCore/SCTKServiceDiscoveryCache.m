@@ -0,0 +1,386 @@
+/*! @file SCTKServiceDiscoveryCache.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKServiceDiscoveryCache.h"
+
+#import "SCTKClockSkewEstimator.h"
+#import "SCTKDefines.h"
+#import "SCTKServiceDiscovery.h"
+#import "SCTKTokenUtilities.h"
+
+/*! @brief Key used to encode the @c discovery property for @c NSSecureCoding.
+ */
+static NSString *const kDiscoveryKey = @"discovery";
+
+/*! @brief Key used to encode the @c expirationDate property for @c NSSecureCoding.
+ */
+static NSString *const kExpirationDateKey = @"expirationDate";
+
+/*! @brief Key used to encode the @c entityTag property for @c NSSecureCoding.
+ */
+static NSString *const kEntityTagKey = @"entityTag";
+
+/*! @brief Key used to encode the @c lastModified property for @c NSSecureCoding.
+ */
+static NSString *const kLastModifiedKey = @"lastModified";
+
+/*! @brief The extension of the files entries are written to.
+ */
+static NSString *const kEntryFileExtension = @"discovery";
+
+/*! @brief The cache used by discovery, if any.
+ */
+static SCTKServiceDiscoveryCache *_Nullable gSharedCache;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@implementation SCTKServiceDiscoveryCacheEntry
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(
+        @selector(initWithDiscovery:expirationDate:entityTag:lastModified:))
+
+- (instancetype)initWithDiscovery:(SCTKServiceDiscovery *)discovery
+                   expirationDate:(NSDate *)expirationDate
+                        entityTag:(nullable NSString *)entityTag
+                     lastModified:(nullable NSString *)lastModified {
+  self = [super init];
+  if (self) {
+    _discovery = discovery;
+    _expirationDate = expirationDate;
+    _entityTag = [entityTag copy];
+    _lastModified = [lastModified copy];
+  }
+  return self;
+}
+
+- (BOOL)isFresh {
+  return [_expirationDate timeIntervalSinceNow] > 0;
+}
+
+- (void)addValidatorsToRequest:(NSMutableURLRequest *)request {
+  if (_entityTag) {
+    [request setValue:_entityTag forHTTPHeaderField:@"If-None-Match"];
+  }
+  if (_lastModified) {
+    [request setValue:_lastModified forHTTPHeaderField:@"If-Modified-Since"];
+  }
+}
+
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding {
+  return YES;
+}
+
+- (nullable instancetype)initWithCoder:(NSCoder *)aDecoder {
+  SCTKServiceDiscovery *discovery = [aDecoder decodeObjectOfClass:[SCTKServiceDiscovery class]
+                                                           forKey:kDiscoveryKey];
+  NSDate *expirationDate = [aDecoder decodeObjectOfClass:[NSDate class]
+                                                  forKey:kExpirationDateKey];
+  if (!discovery || !expirationDate) {
+    return nil;
+  }
+  return [self initWithDiscovery:discovery
+                  expirationDate:expirationDate
+                       entityTag:[aDecoder decodeObjectOfClass:[NSString class]
+                                                        forKey:kEntityTagKey]
+                    lastModified:[aDecoder decodeObjectOfClass:[NSString class]
+                                                        forKey:kLastModifiedKey]];
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+  [aCoder encodeObject:_discovery forKey:kDiscoveryKey];
+  [aCoder encodeObject:_expirationDate forKey:kExpirationDateKey];
+  [aCoder encodeObject:_entityTag forKey:kEntityTagKey];
+  [aCoder encodeObject:_lastModified forKey:kLastModifiedKey];
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, expirationDate: %@, entityTag: %@, "
+                                     "lastModified: %@, discovery: %@>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _expirationDate,
+                                    _entityTag,
+                                    _lastModified,
+                                    _discovery];
+}
+
+@end
+
+@implementation SCTKServiceDiscoveryCache {
+  /*! @brief The entries read or stored so far, by the absolute string of their URL.
+   */
+  NSMutableDictionary<NSString *, SCTKServiceDiscoveryCacheEntry *> *_entries;
+}
+
++ (nullable SCTKServiceDiscoveryCache *)sharedCache {
+  @synchronized([SCTKServiceDiscoveryCache class]) {
+    return gSharedCache;
+  }
+}
+
++ (void)setSharedCache:(nullable SCTKServiceDiscoveryCache *)cache {
+  @synchronized([SCTKServiceDiscoveryCache class]) {
+    gSharedCache = cache;
+  }
+}
+
+- (instancetype)init {
+  return [self initWithDirectoryURL:nil];
+}
+
+- (instancetype)initWithDirectoryURL:(nullable NSURL *)directoryURL {
+  self = [super init];
+  if (self) {
+    _directoryURL = [directoryURL copy];
+    _revalidatesInBackground = YES;
+    _entries = [NSMutableDictionary dictionary];
+    if (_directoryURL) {
+      NSError *error;
+      if (![[NSFileManager defaultManager] createDirectoryAtURL:_directoryURL
+                                    withIntermediateDirectories:YES
+                                                     attributes:nil
+                                                          error:&error]) {
+        NSLog(@"SCTKServiceDiscoveryCache: unable to create %@ (%@), entries will be kept in "
+               "memory only", _directoryURL, error);
+        _directoryURL = nil;
+      }
+    }
+  }
+  return self;
+}
+
+- (nullable SCTKServiceDiscoveryCacheEntry *)entryForURL:(NSURL *)URL {
+  @synchronized(self) {
+    SCTKServiceDiscoveryCacheEntry *entry = _entries[URL.absoluteString];
+    if (!entry && _directoryURL) {
+      entry = [self readEntryForURL:URL];
+      if (entry) {
+        _entries[URL.absoluteString] = entry;
+      }
+    }
+    return entry;
+  }
+}
+
+- (nullable SCTKServiceDiscoveryCacheEntry *)storeDiscovery:(SCTKServiceDiscovery *)discovery
+                                                   response:(NSHTTPURLResponse *)response
+                                                     forURL:(NSURL *)URL {
+  BOOL storable;
+  NSDate *expirationDate = [[self class] expirationDateForResponse:response storable:&storable];
+  if (!storable) {
+    [self removeEntryForURL:URL];
+    return nil;
+  }
+  SCTKServiceDiscoveryCacheEntry *entry =
+      [[SCTKServiceDiscoveryCacheEntry alloc]
+          initWithDiscovery:discovery
+             expirationDate:expirationDate
+                  entityTag:[response valueForHTTPHeaderField:@"ETag"]
+               lastModified:[response valueForHTTPHeaderField:@"Last-Modified"]];
+  [self setEntry:entry forURL:URL];
+  return entry;
+}
+
+- (nullable SCTKServiceDiscoveryCacheEntry *)
+    renewEntryWithNotModifiedResponse:(NSHTTPURLResponse *)response
+                               forURL:(NSURL *)URL {
+  @synchronized(self) {
+    SCTKServiceDiscoveryCacheEntry *entry = [self entryForURL:URL];
+    if (!entry) {
+      return nil;
+    }
+    BOOL storable;
+    NSDate *expirationDate = [[self class] expirationDateForResponse:response storable:&storable];
+    if (!storable) {
+      [self removeEntryForURL:URL];
+      return nil;
+    }
+    // A 304 response may update the validators; those it leaves out still apply.
+    NSString *entityTag = [response valueForHTTPHeaderField:@"ETag"] ?: entry.entityTag;
+    NSString *lastModified =
+        [response valueForHTTPHeaderField:@"Last-Modified"] ?: entry.lastModified;
+    SCTKServiceDiscoveryCacheEntry *renewedEntry =
+        [[SCTKServiceDiscoveryCacheEntry alloc] initWithDiscovery:entry.discovery
+                                                   expirationDate:expirationDate
+                                                        entityTag:entityTag
+                                                     lastModified:lastModified];
+    [self setEntry:renewedEntry forURL:URL];
+    return renewedEntry;
+  }
+}
+
+- (void)removeEntryForURL:(NSURL *)URL {
+  @synchronized(self) {
+    [_entries removeObjectForKey:URL.absoluteString];
+    if (_directoryURL) {
+      [[NSFileManager defaultManager] removeItemAtURL:[self fileURLForURL:URL] error:nil];
+    }
+  }
+}
+
+- (void)removeAllEntries {
+  @synchronized(self) {
+    [_entries removeAllObjects];
+    if (!_directoryURL) {
+      return;
+    }
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSArray<NSURL *> *fileURLs = [fileManager contentsOfDirectoryAtURL:_directoryURL
+                                            includingPropertiesForKeys:nil
+                                                               options:0
+                                                                 error:nil];
+    for (NSURL *fileURL in fileURLs) {
+      if ([fileURL.pathExtension isEqualToString:kEntryFileExtension]) {
+        [fileManager removeItemAtURL:fileURL error:nil];
+      }
+    }
+  }
+}
+
++ (NSDate *)expirationDateForResponse:(NSHTTPURLResponse *)response storable:(BOOL *)storable {
+  *storable = YES;
+  NSDate *now = [NSDate date];
+
+  // https://www.rfc-editor.org/rfc/rfc9111#section-5.2.2
+  NSString *cacheControl = [response valueForHTTPHeaderField:@"Cache-Control"].lowercaseString;
+  NSCharacterSet *whitespace = [NSCharacterSet whitespaceCharacterSet];
+  BOOL noCache = NO;
+  NSTimeInterval maxAge = -1;
+  for (NSString *component in [cacheControl componentsSeparatedByString:@","]) {
+    NSString *directive = [component stringByTrimmingCharactersInSet:whitespace];
+    if ([directive isEqualToString:@"no-store"]) {
+      *storable = NO;
+      return now;
+    } else if ([directive isEqualToString:@"no-cache"]) {
+      noCache = YES;
+    } else if ([directive hasPrefix:@"max-age="]) {
+      NSString *value = [directive substringFromIndex:@"max-age=".length];
+      maxAge = [[value stringByTrimmingCharactersInSet:
+          [NSCharacterSet characterSetWithCharactersInString:@"\""]] doubleValue];
+    }
+  }
+  if (noCache) {
+    return now;
+  }
+  if (maxAge >= 0) {
+    NSTimeInterval age = [[response valueForHTTPHeaderField:@"Age"] doubleValue];
+    return [now dateByAddingTimeInterval:MAX(maxAge - age, 0)];
+  }
+
+  // https://www.rfc-editor.org/rfc/rfc9111#section-5.3
+  NSString *expires = [response valueForHTTPHeaderField:@"Expires"];
+  if (expires) {
+    NSDate *expiresDate = [SCTKClockSkewEstimator dateFromHTTPDateHeader:expires];
+    if (!expiresDate) {
+      // An invalid date, such as "0", means the response has already expired.
+      return now;
+    }
+    // Measured against the server's own clock where possible, so that a device clock which is
+    // off does not lengthen or shorten the lifetime.
+    NSString *dateHeader = [response valueForHTTPHeaderField:@"Date"];
+    NSDate *serverDate = dateHeader ? [SCTKClockSkewEstimator dateFromHTTPDateHeader:dateHeader]
+                                    : nil;
+    NSTimeInterval lifetime = [expiresDate timeIntervalSinceDate:serverDate ?: now];
+    return [now dateByAddingTimeInterval:MAX(lifetime, 0)];
+  }
+
+  // Without freshness information the document is kept, but revalidated on each use.
+  return now;
+}
+
+#pragma mark - Persistence
+
+/*! @brief Stores an entry in memory and, if the cache has a directory, on disk.
+    @param entry The entry.
+    @param URL The URL of the discovery document.
+ */
+- (void)setEntry:(SCTKServiceDiscoveryCacheEntry *)entry forURL:(NSURL *)URL {
+  @synchronized(self) {
+    _entries[URL.absoluteString] = entry;
+    if (_directoryURL) {
+      [self writeEntry:entry forURL:URL];
+    }
+  }
+}
+
+/*! @brief Returns the file an entry is written to.
+    @param URL The URL of the discovery document.
+ */
+- (NSURL *)fileURLForURL:(NSURL *)URL {
+  NSString *fileName =
+      [SCTKTokenUtilities encodeBase64urlNoPadding:[SCTKTokenUtilities sha256:URL.absoluteString]];
+  return [[_directoryURL URLByAppendingPathComponent:fileName]
+      URLByAppendingPathExtension:kEntryFileExtension];
+}
+
+/*! @brief Reads an entry from the directory.
+    @param URL The URL of the discovery document.
+    @return The entry, or nil if there was none or it could not be read.
+ */
+- (nullable SCTKServiceDiscoveryCacheEntry *)readEntryForURL:(NSURL *)URL {
+  NSData *archivedEntry = [NSData dataWithContentsOfURL:[self fileURLForURL:URL]];
+  if (!archivedEntry) {
+    return nil;
+  }
+  SCTKServiceDiscoveryCacheEntry *entry;
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    entry = [NSKeyedUnarchiver unarchivedObjectOfClass:[SCTKServiceDiscoveryCacheEntry class]
+                                              fromData:archivedEntry
+                                                 error:nil];
+  } else {
+#if !TARGET_OS_IOS
+    entry = [NSKeyedUnarchiver unarchiveObjectWithData:archivedEntry];
+#endif
+  }
+  if (![entry isKindOfClass:[SCTKServiceDiscoveryCacheEntry class]]) {
+    return nil;
+  }
+  return entry;
+}
+
+/*! @brief Writes an entry to the directory, replacing any previous one.
+    @param entry The entry.
+    @param URL The URL of the discovery document.
+ */
+- (void)writeEntry:(SCTKServiceDiscoveryCacheEntry *)entry forURL:(NSURL *)URL {
+  NSData *archivedEntry;
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    archivedEntry = [NSKeyedArchiver archivedDataWithRootObject:entry
+                                          requiringSecureCoding:YES
+                                                          error:nil];
+  } else {
+#if !TARGET_OS_IOS
+    archivedEntry = [NSKeyedArchiver archivedDataWithRootObject:entry];
+#endif
+  }
+  NSError *error;
+  if (!archivedEntry || ![archivedEntry writeToURL:[self fileURLForURL:URL]
+                                           options:NSDataWritingAtomic
+                                             error:&error]) {
+    NSLog(@"SCTKServiceDiscoveryCache: unable to write the entry for %@ (%@)", URL, error);
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
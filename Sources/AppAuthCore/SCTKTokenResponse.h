@@ -105,6 +105,19 @@ NS_ASSUME_NONNULL_BEGIN
                      parameters:(NSDictionary<NSString *, NSObject<NSCopying> *> *)parameters
                      NS_DESIGNATED_INITIALIZER;
 
+/*! @brief Creates a token response whose access token expiry is counted from when the request was
+        sent.
+    @param request The serviced request.
+    @param parameters The decoded parameters returned from the Authorization Server.
+    @param requestDate When the request was sent.
+    @discussion The server starts counting @c expires_in no later than when it received the
+        request, so anchoring it to the send date errs on the safe side, whereas anchoring it to
+        the parse date overstates the lifetime by the round trip time.
+ */
+- (instancetype)initWithRequest:(SCTKTokenRequest *)request
+                     parameters:(NSDictionary<NSString *, NSObject<NSCopying> *> *)parameters
+                    requestDate:(NSDate *)requestDate;
+
 @end
 
 NS_ASSUME_NONNULL_END
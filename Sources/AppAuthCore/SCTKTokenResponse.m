@@ -106,6 +106,20 @@ static NSString *const kAdditionalParametersKey = @"additionalParameters";
   return self;
 }
 
+- (instancetype)initWithRequest:(SCTKTokenRequest *)request
+                     parameters:(NSDictionary<NSString *, NSObject<NSCopying> *> *)parameters
+                    requestDate:(NSDate *)requestDate {
+  self = [self initWithRequest:request parameters:parameters];
+  if (self) {
+    NSObject *expiresIn = parameters[kExpiresInKey];
+    if ([expiresIn isKindOfClass:[NSNumber class]]) {
+      _accessTokenExpirationDate =
+          [requestDate dateByAddingTimeInterval:[(NSNumber *)expiresIn longLongValue]];
+    }
+  }
+  return self;
+}
+
 #pragma mark - NSCopying
 
 - (instancetype)copyWithZone:(nullable NSZone *)zone {
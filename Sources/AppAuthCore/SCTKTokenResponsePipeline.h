@@ -0,0 +1,151 @@
+/*! @file SCTKTokenResponsePipeline.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The default maximum number of responses a pipeline processes at once.
+ */
+extern const NSUInteger SCTKTokenResponsePipelineDefaultMaximumConcurrentResponses;
+
+/*! @brief The time a token response spent in each stage of a @c SCTKTokenResponsePipeline.
+ */
+@interface SCTKTokenResponsePipelineMetrics : NSObject
+
+/*! @brief The URL of the request.
+ */
+@property(nonatomic, readonly, nullable) NSURL *URL;
+
+/*! @brief The time from sending the request to receiving the response.
+ */
+@property(nonatomic, readonly) NSTimeInterval receiveDuration;
+
+/*! @brief The time the response waited for a processing slot and a thread.
+ */
+@property(nonatomic, readonly) NSTimeInterval queueDuration;
+
+/*! @brief The time spent deserializing the response and constructing the result.
+ */
+@property(nonatomic, readonly) NSTimeInterval parseDuration;
+
+/*! @brief The time spent validating the result, zero if parsing failed.
+ */
+@property(nonatomic, readonly) NSTimeInterval validateDuration;
+
+/*! @brief The time from the end of validation until the callback started on its queue.
+ */
+@property(nonatomic, readonly) NSTimeInterval deliverDuration;
+
+/*! @brief Whether the response was delivered with an error.
+ */
+@property(nonatomic, readonly) BOOL failed;
+
+/*! @internal
+    @brief Unavailable. Metrics are created by @c SCTKTokenResponsePipeline.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/*! @brief Receives the metrics of each processed response.
+    @param metrics The stage timings of the response.
+ */
+typedef void (^SCTKTokenResponsePipelineMetricsHandler)(SCTKTokenResponsePipelineMetrics *metrics);
+
+/*! @brief The parse stage: turns the received response into a result.
+    @param error Set if no result could be constructed.
+    @return The result, or nil if @c error was set.
+ */
+typedef id _Nullable (^SCTKTokenResponsePipelineParseStage)(NSError **error);
+
+/*! @brief The validate stage: checks the result of the parse stage.
+    @param result The result of the parse stage.
+    @return An error if the result is invalid, otherwise nil.
+ */
+typedef NSError *_Nullable (^SCTKTokenResponsePipelineValidateStage)(id result);
+
+/*! @brief The deliver stage: hands the finished result to the caller.
+    @param result The validated result, or nil if there was an error.
+    @param error The error of the parse or validate stage, or nil if there was a result.
+ */
+typedef void (^SCTKTokenResponsePipelineDelivery)(id _Nullable result, NSError *_Nullable error);
+
+/*! @brief Processes received token responses off the main thread.
+    @discussion Each response goes through four stages: receive, parse, validate and deliver. The
+        parse and validate stages run on a private concurrent queue, and only the finished result
+        is dispatched to the caller's queue, so that JSON deserialization and ID Token validation
+        never occupy that queue.
+
+        At most @c maximumConcurrentResponses responses are processed at once. When the pipeline
+        is full, submitting a response blocks the submitting thread, typically the delegate queue
+        of the URL session, until a slot frees up. This back-pressure holds further responses in
+        the session rather than queueing unbounded work. Do not submit from the queue responses
+        are delivered to.
+ */
+@interface SCTKTokenResponsePipeline : NSObject
+
+/*! @brief The maximum number of responses processed at once.
+ */
+@property(nonatomic, readonly) NSUInteger maximumConcurrentResponses;
+
+/*! @brief Called on the callback queue with the stage timings of each response, after its result
+        has been delivered.
+ */
+@property(atomic, copy, nullable) SCTKTokenResponsePipelineMetricsHandler metricsHandler;
+
+/*! @brief The pipeline @c SCTKAuthorizationService processes token responses with.
+ */
++ (SCTKTokenResponsePipeline *)sharedPipeline;
+
+/*! @brief Replaces the pipeline @c SCTKAuthorizationService processes token responses with.
+    @param pipeline The new shared pipeline.
+ */
++ (void)setSharedPipeline:(SCTKTokenResponsePipeline *)pipeline;
+
+/*! @brief Creates a pipeline that processes at most
+        @c SCTKTokenResponsePipelineDefaultMaximumConcurrentResponses responses at once.
+ */
+- (instancetype)init;
+
+/*! @brief Designated initializer.
+    @param maximumConcurrentResponses The maximum number of responses processed at once. Zero is
+        treated as one.
+ */
+- (instancetype)initWithMaximumConcurrentResponses:(NSUInteger)maximumConcurrentResponses
+    NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Processes a received response and delivers the result.
+    @param URL The URL of the request, reported in the metrics.
+    @param requestDate When the request was sent.
+    @param parse The parse stage.
+    @param validate The validate stage, run only if parsing produced a result.
+    @param callbackQueue The queue @c delivery is called on.
+    @param delivery The deliver stage.
+    @discussion Blocks the calling thread while the pipeline is full.
+ */
+- (void)processResponseForURL:(nullable NSURL *)URL
+                  requestDate:(NSDate *)requestDate
+                        parse:(SCTKTokenResponsePipelineParseStage)parse
+                     validate:(nullable SCTKTokenResponsePipelineValidateStage)validate
+                callbackQueue:(dispatch_queue_t)callbackQueue
+                     delivery:(SCTKTokenResponsePipelineDelivery)delivery;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,178 @@
+/*! @file SCTKTokenResponsePipeline.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKTokenResponsePipeline.h"
+
+#import "SCTKDefines.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+const NSUInteger SCTKTokenResponsePipelineDefaultMaximumConcurrentResponses = 4;
+
+/*! @brief The pipeline used by @c SCTKAuthorizationService, created on first use. Guarded by
+        @c SCTKTokenResponsePipeline.
+ */
+static SCTKTokenResponsePipeline *_Nullable gSharedPipeline;
+
+@interface SCTKTokenResponsePipelineMetrics ()
+
+@property(nonatomic, readwrite, nullable) NSURL *URL;
+@property(nonatomic, readwrite) NSTimeInterval receiveDuration;
+@property(nonatomic, readwrite) NSTimeInterval queueDuration;
+@property(nonatomic, readwrite) NSTimeInterval parseDuration;
+@property(nonatomic, readwrite) NSTimeInterval validateDuration;
+@property(nonatomic, readwrite) NSTimeInterval deliverDuration;
+@property(nonatomic, readwrite) BOOL failed;
+
+/*! @brief Creates empty metrics, filled in by the pipeline as the response progresses.
+ */
+- (instancetype)initPrivate NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation SCTKTokenResponsePipelineMetrics
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initPrivate))
+
+- (instancetype)initPrivate {
+  return [super init];
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, URL: %@, receive: %.3f, queue: %.3f, parse: %.3f, "
+                                     "validate: %.3f, deliver: %.3f, failed: %@>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _URL,
+                                    _receiveDuration,
+                                    _queueDuration,
+                                    _parseDuration,
+                                    _validateDuration,
+                                    _deliverDuration,
+                                    _failed ? @"YES" : @"NO"];
+}
+
+@end
+
+@implementation SCTKTokenResponsePipeline {
+  /*! @brief The concurrent queue the parse and validate stages run on.
+   */
+  dispatch_queue_t _processingQueue;
+
+  /*! @brief Counts the free processing slots.
+   */
+  dispatch_semaphore_t _processingSlots;
+}
+
++ (SCTKTokenResponsePipeline *)sharedPipeline {
+  @synchronized([SCTKTokenResponsePipeline class]) {
+    if (!gSharedPipeline) {
+      gSharedPipeline = [[SCTKTokenResponsePipeline alloc] init];
+    }
+    return gSharedPipeline;
+  }
+}
+
++ (void)setSharedPipeline:(SCTKTokenResponsePipeline *)pipeline {
+  NSAssert(pipeline, @"Parameter: |pipeline| must be non-nil.");
+  @synchronized([SCTKTokenResponsePipeline class]) {
+    gSharedPipeline = pipeline;
+  }
+}
+
+- (instancetype)init {
+  return [self initWithMaximumConcurrentResponses:
+      SCTKTokenResponsePipelineDefaultMaximumConcurrentResponses];
+}
+
+- (instancetype)initWithMaximumConcurrentResponses:(NSUInteger)maximumConcurrentResponses {
+  self = [super init];
+  if (self) {
+    _maximumConcurrentResponses = MAX(maximumConcurrentResponses, (NSUInteger)1);
+    _processingQueue = dispatch_queue_create("org.openid.appauth.tokenresponsepipeline",
+                                             DISPATCH_QUEUE_CONCURRENT);
+    _processingSlots = dispatch_semaphore_create((long)_maximumConcurrentResponses);
+  }
+  return self;
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, maximumConcurrentResponses: %lu>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    (unsigned long)_maximumConcurrentResponses];
+}
+
+#pragma mark - Processing
+
+- (void)processResponseForURL:(nullable NSURL *)URL
+                  requestDate:(NSDate *)requestDate
+                        parse:(SCTKTokenResponsePipelineParseStage)parse
+                     validate:(nullable SCTKTokenResponsePipelineValidateStage)validate
+                callbackQueue:(dispatch_queue_t)callbackQueue
+                     delivery:(SCTKTokenResponsePipelineDelivery)delivery {
+  // receive
+  SCTKTokenResponsePipelineMetrics *metrics =
+      [[SCTKTokenResponsePipelineMetrics alloc] initPrivate];
+  metrics.URL = URL;
+  metrics.receiveDuration = MAX(-[requestDate timeIntervalSinceNow], 0);
+  NSProcessInfo *processInfo = [NSProcessInfo processInfo];
+  NSTimeInterval receivedTime = processInfo.systemUptime;
+
+  dispatch_semaphore_wait(_processingSlots, DISPATCH_TIME_FOREVER);
+  dispatch_async(_processingQueue, ^{
+    // parse
+    NSTimeInterval parseStartTime = processInfo.systemUptime;
+    metrics.queueDuration = parseStartTime - receivedTime;
+    NSError *error;
+    id result = parse(&error);
+    NSTimeInterval validateStartTime = processInfo.systemUptime;
+    metrics.parseDuration = validateStartTime - parseStartTime;
+
+    // validate
+    if (result && validate) {
+      error = validate(result);
+      if (error) {
+        result = nil;
+      }
+    }
+    NSTimeInterval validateEndTime = processInfo.systemUptime;
+    metrics.validateDuration = validateEndTime - validateStartTime;
+    metrics.failed = (result == nil);
+    dispatch_semaphore_signal(self->_processingSlots);
+
+    // deliver
+    dispatch_async(callbackQueue, ^{
+      metrics.deliverDuration = processInfo.systemUptime - validateEndTime;
+      delivery(result, error);
+      SCTKTokenResponsePipelineMetricsHandler metricsHandler = self.metricsHandler;
+      if (metricsHandler) {
+        metricsHandler(metrics);
+      }
+    });
+  });
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
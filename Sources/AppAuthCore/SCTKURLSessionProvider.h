@@ -18,23 +18,89 @@
 
 #import <Foundation/Foundation.h>
 
+@protocol SCTKHTTPTransport;
+
 NS_ASSUME_NONNULL_BEGIN
 
+/*! @brief The kinds of traffic sent on separate sessions, so that each has its own connection
+        pool, timeouts, cache and cookie policy.
+ */
+typedef NS_ENUM(NSInteger, SCTKURLSessionProfile) {
+  /*! @brief Token, userinfo, revocation and introspection requests. Never cached, never sends or
+          stores cookies, up to 4 connections per host, 30 second request timeout.
+   */
+  SCTKURLSessionProfileToken = 0,
+
+  /*! @brief Discovery document and JWKS requests. Uses the shared URL cache, never sends or
+          stores cookies, up to 2 connections per host, 60 second request timeout.
+   */
+  SCTKURLSessionProfileDiscovery = 1,
+
+  /*! @brief Dynamic client registration requests. Never cached, never sends or stores cookies, up
+          to 2 connections per host, 60 second request timeout.
+   */
+  SCTKURLSessionProfileRegistration = 2,
+};
+
 /*! @brief A NSURLSession provider that allows clients to provide custom implementation
         for NSURLSession
+    @discussion By default each @c SCTKURLSessionProfile has a session of its own, so that token
+        requests never queue behind large discovery or JWKS downloads, and token responses are
+        never written to the URL cache. A session set with @c setSession: is used for every
+        profile instead, and a transport set with @c setTransport: for every request.
  */
 @interface SCTKURLSessionProvider : NSObject
 
-/*! @brief Obtains the current @c NSURLSession; using the +[NSURLSession sharedSession] if
-        no custom implementation is provided.
+/*! @brief Obtains the @c NSURLSession set with @c setSession:; using the
+        +[NSURLSession sharedSession] if no custom implementation is provided.
     @return NSURLSession object to be used for making network requests.
  */
 + (NSURLSession *)session;
 
 /*! @brief Allows library consumers to change the @c NSURLSession instance used to make
-        network requests.
-    @param session The @c NSURLSession instance that should be used for making network requests.
+        network requests, for every profile.
+    @param session The @c NSURLSession instance that should be used for making network requests,
+        or nil to use the session of each profile again.
+ */
++ (void)setSession:(nullable NSURLSession *)session;
+
+/*! @brief Returns the configuration of the sessions of a profile, if not changed with
+        @c setConfiguration:forProfile:.
+    @param profile The profile.
+ */
++ (NSURLSessionConfiguration *)defaultConfigurationForProfile:(SCTKURLSessionProfile)profile;
+
+/*! @brief Changes the configuration of the session of a profile. Requests in flight on the
+        previous session are completed before it is invalidated.
+    @param configuration The configuration, or nil to use the default configuration again.
+    @param profile The profile.
+ */
++ (void)setConfiguration:(nullable NSURLSessionConfiguration *)configuration
+              forProfile:(SCTKURLSessionProfile)profile;
+
+/*! @brief Obtains the session of a profile; the session set with @c setSession: if any.
+    @param profile The profile.
+ */
++ (NSURLSession *)sessionForProfile:(SCTKURLSessionProfile)profile;
+
+/*! @brief Obtains the transport through which the requests of a profile are sent; a
+        @c SCTKURLSessionTransport on @c sessionForProfile: if no custom implementation is
+        provided.
+    @param profile The profile.
+ */
++ (id<SCTKHTTPTransport>)transportForProfile:(SCTKURLSessionProfile)profile;
+
+/*! @brief Obtains the transport of token requests; the same as @c transportForProfile: with
+        @c ::SCTKURLSessionProfileToken.
+    @return The transport to be used for making network requests.
+ */
++ (id<SCTKHTTPTransport>)transport;
+
+/*! @brief Allows library consumers to send requests through their own transport, such as a pooled
+        client or a @c SCTKLoopbackTransport in tests and benchmarks.
+    @param transport The transport that should be used for making network requests of every
+        profile, or nil to use the session of each profile again.
  */
-+ (void)setSession:(NSURLSession *)session;
++ (void)setTransport:(nullable id<SCTKHTTPTransport>)transport;
 @end
 NS_ASSUME_NONNULL_END
@@ -18,22 +18,162 @@
 
 #import "SCTKURLSessionProvider.h"
 
+#import "SCTKHTTPTransport.h"
+#import "SCTKURLSessionTransport.h"
+
 NS_ASSUME_NONNULL_BEGIN
 
+/*! @brief The number of profiles in @c SCTKURLSessionProfile.
+ */
+static const NSInteger kProfileCount = SCTKURLSessionProfileRegistration + 1;
+
+/*! @brief The maximum number of connections per host of token traffic, enough for a refresh to
+        proceed alongside userinfo and revocation requests.
+ */
+static const NSInteger kTokenMaximumConnectionsPerHost = 4;
+
+/*! @brief The maximum number of connections per host of discovery and registration traffic.
+ */
+static const NSInteger kDiscoveryMaximumConnectionsPerHost = 2;
+
+/*! @brief The request timeout of token traffic, in seconds.
+ */
+static const NSTimeInterval kTokenRequestTimeout = 30;
+
+/*! @brief The request timeout of discovery and registration traffic, in seconds.
+ */
+static const NSTimeInterval kDiscoveryRequestTimeout = 60;
+
+/*! @brief The session set by the client, if any. Guarded by @c SCTKURLSessionProvider.
+ */
 static NSURLSession *__nullable gURLSession;
 
+/*! @brief The transport set by the client, if any. Guarded by @c SCTKURLSessionProvider.
+ */
+static id<SCTKHTTPTransport> __nullable gTransport;
+
+/*! @brief The configurations set by the client, by profile. Guarded by
+        @c SCTKURLSessionProvider.
+ */
+static NSMutableDictionary<NSNumber *, NSURLSessionConfiguration *> *__nullable gConfigurations;
+
+/*! @brief The sessions of the profiles, created on first use, by profile. Guarded by
+        @c SCTKURLSessionProvider.
+ */
+static NSMutableDictionary<NSNumber *, NSURLSession *> *__nullable gProfileSessions;
+
+/*! @brief The transports on the session of each profile, recreated when the session changes, by
+        profile. Guarded by @c SCTKURLSessionProvider.
+ */
+static NSMutableDictionary<NSNumber *, SCTKURLSessionTransport *> *__nullable gSessionTransports;
+
 @implementation SCTKURLSessionProvider
 
 + (NSURLSession *)session {
-    if (!gURLSession) {
-        gURLSession = [NSURLSession sharedSession];
+    @synchronized(self) {
+        return gURLSession ?: [NSURLSession sharedSession];
+    }
+}
+
++ (void)setSession:(nullable NSURLSession *)session {
+    @synchronized(self) {
+        gURLSession = session;
+    }
+}
+
++ (NSURLSessionConfiguration *)defaultConfigurationForProfile:(SCTKURLSessionProfile)profile {
+    NSAssert(profile >= 0 && profile < kProfileCount, @"Unknown profile %ld.", (long)profile);
+    NSURLSessionConfiguration *configuration =
+        [NSURLSessionConfiguration defaultSessionConfiguration];
+    // AppAuth requests carry their credentials explicitly, never in cookies
+    configuration.HTTPCookieStorage = nil;
+    configuration.HTTPShouldSetCookies = NO;
+    configuration.HTTPCookieAcceptPolicy = NSHTTPCookieAcceptPolicyNever;
+    switch (profile) {
+        case SCTKURLSessionProfileToken:
+            // token responses must never be written to the disk cache
+            configuration.URLCache = nil;
+            configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+            configuration.HTTPMaximumConnectionsPerHost = kTokenMaximumConnectionsPerHost;
+            configuration.timeoutIntervalForRequest = kTokenRequestTimeout;
+            break;
+        case SCTKURLSessionProfileDiscovery:
+            configuration.URLCache = [NSURLCache sharedURLCache];
+            configuration.requestCachePolicy = NSURLRequestUseProtocolCachePolicy;
+            configuration.HTTPMaximumConnectionsPerHost = kDiscoveryMaximumConnectionsPerHost;
+            configuration.timeoutIntervalForRequest = kDiscoveryRequestTimeout;
+            break;
+        case SCTKURLSessionProfileRegistration:
+            configuration.URLCache = nil;
+            configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+            configuration.HTTPMaximumConnectionsPerHost = kDiscoveryMaximumConnectionsPerHost;
+            configuration.timeoutIntervalForRequest = kDiscoveryRequestTimeout;
+            break;
+    }
+    return configuration;
+}
+
++ (void)setConfiguration:(nullable NSURLSessionConfiguration *)configuration
+              forProfile:(SCTKURLSessionProfile)profile {
+    NSAssert(profile >= 0 && profile < kProfileCount, @"Unknown profile %ld.", (long)profile);
+    NSURLSession *previousSession;
+    @synchronized(self) {
+        if (!gConfigurations) {
+            gConfigurations = [NSMutableDictionary dictionary];
+        }
+        gConfigurations[@(profile)] = [configuration copy];
+        previousSession = gProfileSessions[@(profile)];
+        [gProfileSessions removeObjectForKey:@(profile)];
     }
-    return gURLSession;
+    [previousSession finishTasksAndInvalidate];
 }
 
-+ (void)setSession:(NSURLSession *)session {
-    NSAssert(session, @"Parameter: |session| must be non-nil.");
-    gURLSession = session;
++ (NSURLSession *)sessionForProfile:(SCTKURLSessionProfile)profile {
+    NSAssert(profile >= 0 && profile < kProfileCount, @"Unknown profile %ld.", (long)profile);
+    @synchronized(self) {
+        if (gURLSession) {
+            return gURLSession;
+        }
+        NSURLSession *session = gProfileSessions[@(profile)];
+        if (!session) {
+            NSURLSessionConfiguration *configuration =
+                gConfigurations[@(profile)] ?: [self defaultConfigurationForProfile:profile];
+            session = [NSURLSession sessionWithConfiguration:configuration];
+            if (!gProfileSessions) {
+                gProfileSessions = [NSMutableDictionary dictionary];
+            }
+            gProfileSessions[@(profile)] = session;
+        }
+        return session;
+    }
+}
+
++ (id<SCTKHTTPTransport>)transportForProfile:(SCTKURLSessionProfile)profile {
+    @synchronized(self) {
+        if (gTransport) {
+            return gTransport;
+        }
+        NSURLSession *session = [self sessionForProfile:profile];
+        SCTKURLSessionTransport *transport = gSessionTransports[@(profile)];
+        if (transport.session != session) {
+            transport = [[SCTKURLSessionTransport alloc] initWithSession:session];
+            if (!gSessionTransports) {
+                gSessionTransports = [NSMutableDictionary dictionary];
+            }
+            gSessionTransports[@(profile)] = transport;
+        }
+        return transport;
+    }
+}
+
++ (id<SCTKHTTPTransport>)transport {
+    return [self transportForProfile:SCTKURLSessionProfileToken];
+}
+
++ (void)setTransport:(nullable id<SCTKHTTPTransport>)transport {
+    @synchronized(self) {
+        gTransport = transport;
+    }
 }
 @end
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,51 @@
+/*! @file SCTKURLSessionTransport.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "SCTKHTTPTransport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Sends requests with an @c NSURLSession. The default transport of
+        @c SCTKURLSessionProvider, on its session.
+    @discussion Where per-task delegates are available (iOS 15, macOS 12, tvOS 15, watchOS 8), the
+        body is streamed to the data handler as it arrives, and the connection metrics of each
+        request are passed to @c SCTKConnectionPrewarmer.recordTaskMetrics:prewarming:. Elsewhere
+        the session buffers the body, which is passed to the data handler in one part. Handlers
+        are called on the delegate queue of the session.
+ */
+@interface SCTKURLSessionTransport : NSObject <SCTKHTTPTransport>
+
+/*! @brief The session requests are sent with.
+ */
+@property(nonatomic, readonly) NSURLSession *session;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithSession:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param session The session to send requests with.
+ */
+- (instancetype)initWithSession:(NSURLSession *)session NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
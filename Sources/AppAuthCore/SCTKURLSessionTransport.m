@@ -0,0 +1,164 @@
+/*! @file SCTKURLSessionTransport.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKURLSessionTransport.h"
+
+#import "SCTKConnectionPrewarmer.h"
+#import "SCTKDefines.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Session tasks already respond to @c resume and @c cancel.
+ */
+@interface NSURLSessionTask (SCTKHTTPTransportTask) <SCTKHTTPTransportTask>
+@end
+
+@implementation NSURLSessionTask (SCTKHTTPTransportTask)
+@end
+
+/*! @brief Returns the error with which a request cancelled by a handler completes.
+ */
+static NSError *SCTKCancelledError(void) {
+  return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+}
+
+/*! @brief Forwards the events of a single task to the handlers of its request.
+ */
+@interface SCTKURLSessionTransportTaskDelegate : NSObject <NSURLSessionDataDelegate>
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithResponseHandler:(SCTKHTTPTransportResponseHandler)responseHandler
+                            dataHandler:(SCTKHTTPTransportDataHandler)dataHandler
+                      completionHandler:(SCTKHTTPTransportCompletionHandler)completionHandler
+    NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation SCTKURLSessionTransportTaskDelegate {
+  SCTKHTTPTransportResponseHandler _responseHandler;
+  SCTKHTTPTransportDataHandler _dataHandler;
+  SCTKHTTPTransportCompletionHandler _completionHandler;
+
+  /*! @brief Set once a handler has cancelled the request, after which no more data is passed on.
+   */
+  BOOL _cancelled;
+}
+
+- (instancetype)initWithResponseHandler:(SCTKHTTPTransportResponseHandler)responseHandler
+                            dataHandler:(SCTKHTTPTransportDataHandler)dataHandler
+                      completionHandler:(SCTKHTTPTransportCompletionHandler)completionHandler {
+  self = [super init];
+  if (self) {
+    _responseHandler = [responseHandler copy];
+    _dataHandler = [dataHandler copy];
+    _completionHandler = [completionHandler copy];
+  }
+  return self;
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session
+              dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveResponse:(NSURLResponse *)response
+     completionHandler:(void (^)(NSURLSessionResponseDisposition disposition))completionHandler {
+  if (!_responseHandler(response)) {
+    _cancelled = YES;
+    completionHandler(NSURLSessionResponseCancel);
+    return;
+  }
+  completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveData:(NSData *)data {
+  if (_cancelled) {
+    return;
+  }
+  if (!_dataHandler(data)) {
+    _cancelled = YES;
+    [dataTask cancel];
+  }
+}
+
+- (void)URLSession:(NSURLSession *)session
+                          task:(NSURLSessionTask *)task
+    didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics {
+  BOOL prewarming = [SCTKConnectionPrewarmer isPrewarmingRequest:task.originalRequest];
+  [SCTKConnectionPrewarmer recordTaskMetrics:metrics prewarming:prewarming];
+}
+
+- (void)URLSession:(NSURLSession *)session
+                    task:(NSURLSessionTask *)task
+    didCompleteWithError:(nullable NSError *)error {
+  _completionHandler(_cancelled ? SCTKCancelledError() : error);
+}
+
+@end
+
+@implementation SCTKURLSessionTransport
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithSession:))
+
+- (instancetype)initWithSession:(NSURLSession *)session {
+  self = [super init];
+  if (self) {
+    _session = session;
+  }
+  return self;
+}
+
+#pragma mark - SCTKHTTPTransport
+
+- (id<SCTKHTTPTransportTask>)taskWithRequest:(NSURLRequest *)request
+                             responseHandler:(SCTKHTTPTransportResponseHandler)responseHandler
+                                 dataHandler:(SCTKHTTPTransportDataHandler)dataHandler
+                           completionHandler:(SCTKHTTPTransportCompletionHandler)completionHandler {
+  if (@available(iOS 15.0, macOS 12.0, tvOS 15.0, watchOS 8.0, *)) {
+    SCTKURLSessionTransportTaskDelegate *delegate =
+        [[SCTKURLSessionTransportTaskDelegate alloc] initWithResponseHandler:responseHandler
+                                                                 dataHandler:dataHandler
+                                                           completionHandler:completionHandler];
+    NSURLSessionDataTask *task = [_session dataTaskWithRequest:request];
+    // the task holds on to its delegate until it completes
+    task.delegate = delegate;
+    return task;
+  }
+
+  return [_session dataTaskWithRequest:request
+                     completionHandler:^(NSData *_Nullable data,
+                                         NSURLResponse *_Nullable response,
+                                         NSError *_Nullable error) {
+    if (error || !response) {
+      completionHandler(error);
+      return;
+    }
+    if (!responseHandler(response) || (data.length > 0 && !dataHandler(data))) {
+      completionHandler(SCTKCancelledError());
+      return;
+    }
+    completionHandler(nil);
+  }];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
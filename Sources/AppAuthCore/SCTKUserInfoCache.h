@@ -0,0 +1,93 @@
+/*! @file SCTKUserInfoCache.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class SCTKUserInfoResponse;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The default time for which a @c SCTKUserInfoCache keeps a response.
+ */
+extern const NSTimeInterval SCTKUserInfoCacheDefaultTimeToLive;
+
+/*! @brief Keeps userinfo responses in memory for a limited time, by account and by the access
+        token they were fetched with.
+    @discussion An account is the issuer, client ID and subject of the end-user, as a subject is
+        only unique per issuer. A response is returned only for the access token it was fetched
+        with, so it is not reused once the tokens of the auth state change, such as after a
+        refresh that may have changed the granted scopes. Only a SHA-256 hash of the token is
+        kept. Storing a response for an account drops the one kept for its previous token.
+ */
+@interface SCTKUserInfoCache : NSObject
+
+/*! @brief The time for which responses are kept. Defaults to
+        @c SCTKUserInfoCacheDefaultTimeToLive; zero or less disables the cache.
+ */
+@property(atomic) NSTimeInterval timeToLive;
+
+/*! @brief Returns the cache used by @c SCTKAuthorizationService for userinfo requests.
+ */
++ (SCTKUserInfoCache *)sharedCache;
+
+/*! @brief Sets the cache used by @c SCTKAuthorizationService for userinfo requests.
+    @param cache The cache, or nil to restore a default one.
+ */
++ (void)setSharedCache:(nullable SCTKUserInfoCache *)cache;
+
+/*! @brief Returns the unexpired response for an account and access token, if any.
+    @param issuer The issuer of the ID Token of the end-user.
+    @param clientID The client identifier the tokens were issued to.
+    @param subject The subject of the end-user.
+    @param accessToken The access token the response is requested with.
+    @param generation The generation of the token snapshot holding @c accessToken. A response
+        stored with another generation is not returned.
+ */
+- (nullable SCTKUserInfoResponse *)userInfoForIssuer:(NSString *)issuer
+                                            clientID:(NSString *)clientID
+                                             subject:(NSString *)subject
+                                         accessToken:(NSString *)accessToken
+                                          generation:(uint64_t)generation;
+
+/*! @brief Keeps a response for the account of its subject and the access token it was fetched
+        with.
+    @param userInfo The response.
+    @param issuer The issuer of the ID Token of the end-user.
+    @param clientID The client identifier the tokens were issued to.
+    @param accessToken The access token the response was fetched with.
+    @param generation The generation of the token snapshot holding @c accessToken.
+ */
+- (void)storeUserInfo:(SCTKUserInfoResponse *)userInfo
+            forIssuer:(NSString *)issuer
+             clientID:(NSString *)clientID
+          accessToken:(NSString *)accessToken
+           generation:(uint64_t)generation;
+
+/*! @brief Drops the responses for a subject of any issuer, such as after the end-user edited
+        their profile.
+    @param subject The subject of the end-user.
+ */
+- (void)removeUserInfoForSubject:(NSString *)subject;
+
+/*! @brief Drops all responses.
+ */
+- (void)removeAllUserInfo;
+
+@end
+
+NS_ASSUME_NONNULL_END
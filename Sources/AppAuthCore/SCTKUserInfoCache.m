@@ -0,0 +1,173 @@
+/*! @file SCTKUserInfoCache.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKUserInfoCache.h"
+
+#import "SCTKTokenUtilities.h"
+#import "SCTKUserInfoResponse.h"
+
+const NSTimeInterval SCTKUserInfoCacheDefaultTimeToLive = 300;
+
+/*! @brief The cache used for userinfo requests, created on first use.
+ */
+static SCTKUserInfoCache *_Nullable gSharedCache;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief A cached response with the access token and generation it belongs to and its expiry.
+ */
+@interface SCTKUserInfoCacheEntry : NSObject
+
+/*! @brief The response.
+ */
+@property(nonatomic, readonly) SCTKUserInfoResponse *userInfo;
+
+/*! @brief The SHA-256 hash of the access token the response was fetched with.
+ */
+@property(nonatomic, readonly) NSData *accessTokenHash;
+
+/*! @brief The generation of the token snapshot holding the access token.
+ */
+@property(nonatomic, readonly) uint64_t generation;
+
+/*! @brief The time after which the response is not returned, in system uptime.
+ */
+@property(nonatomic, readonly) NSTimeInterval expirationTime;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithUserInfo:(SCTKUserInfoResponse *)userInfo
+                 accessTokenHash:(NSData *)accessTokenHash
+                      generation:(uint64_t)generation
+                  expirationTime:(NSTimeInterval)expirationTime NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation SCTKUserInfoCacheEntry
+
+- (instancetype)initWithUserInfo:(SCTKUserInfoResponse *)userInfo
+                 accessTokenHash:(NSData *)accessTokenHash
+                      generation:(uint64_t)generation
+                  expirationTime:(NSTimeInterval)expirationTime {
+  self = [super init];
+  if (self) {
+    _userInfo = userInfo;
+    _accessTokenHash = accessTokenHash;
+    _generation = generation;
+    _expirationTime = expirationTime;
+  }
+  return self;
+}
+
+@end
+
+@implementation SCTKUserInfoCache {
+  /*! @brief The newest entry of each account, keyed by its issuer, client ID and subject. Guarded
+          by @c self.
+   */
+  NSMutableDictionary<NSArray<NSString *> *, SCTKUserInfoCacheEntry *> *_entries;
+}
+
++ (SCTKUserInfoCache *)sharedCache {
+  @synchronized([SCTKUserInfoCache class]) {
+    if (!gSharedCache) {
+      gSharedCache = [[SCTKUserInfoCache alloc] init];
+    }
+    return gSharedCache;
+  }
+}
+
++ (void)setSharedCache:(nullable SCTKUserInfoCache *)cache {
+  @synchronized([SCTKUserInfoCache class]) {
+    gSharedCache = cache;
+  }
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _timeToLive = SCTKUserInfoCacheDefaultTimeToLive;
+    _entries = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (nullable SCTKUserInfoResponse *)userInfoForIssuer:(NSString *)issuer
+                                            clientID:(NSString *)clientID
+                                             subject:(NSString *)subject
+                                         accessToken:(NSString *)accessToken
+                                          generation:(uint64_t)generation {
+  NSArray<NSString *> *account = @[ issuer, clientID, subject ];
+  NSData *accessTokenHash = [SCTKTokenUtilities sha256:accessToken];
+  NSTimeInterval now = [NSProcessInfo processInfo].systemUptime;
+  @synchronized(self) {
+    SCTKUserInfoCacheEntry *entry = _entries[account];
+    if (!entry || ![entry.accessTokenHash isEqualToData:accessTokenHash]
+        || entry.generation != generation) {
+      return nil;
+    }
+    if (entry.expirationTime <= now) {
+      [_entries removeObjectForKey:account];
+      return nil;
+    }
+    return entry.userInfo;
+  }
+}
+
+- (void)storeUserInfo:(SCTKUserInfoResponse *)userInfo
+            forIssuer:(NSString *)issuer
+             clientID:(NSString *)clientID
+          accessToken:(NSString *)accessToken
+           generation:(uint64_t)generation {
+  NSTimeInterval timeToLive = self.timeToLive;
+  if (timeToLive <= 0) {
+    return;
+  }
+  NSArray<NSString *> *account = @[ issuer, clientID, userInfo.subject ];
+  NSTimeInterval expirationTime = [NSProcessInfo processInfo].systemUptime + timeToLive;
+  SCTKUserInfoCacheEntry *entry =
+      [[SCTKUserInfoCacheEntry alloc] initWithUserInfo:userInfo
+                                       accessTokenHash:[SCTKTokenUtilities sha256:accessToken]
+                                            generation:generation
+                                        expirationTime:expirationTime];
+  @synchronized(self) {
+    _entries[account] = entry;
+  }
+}
+
+- (void)removeUserInfoForSubject:(NSString *)subject {
+  @synchronized(self) {
+    NSMutableArray<NSArray<NSString *> *> *accounts = [NSMutableArray array];
+    for (NSArray<NSString *> *account in _entries) {
+      if ([account[2] isEqualToString:subject]) {
+        [accounts addObject:account];
+      }
+    }
+    [_entries removeObjectsForKeys:accounts];
+  }
+}
+
+- (void)removeAllUserInfo {
+  @synchronized(self) {
+    [_entries removeAllObjects];
+  }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
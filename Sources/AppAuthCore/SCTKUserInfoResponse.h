@@ -0,0 +1,146 @@
+/*! @file SCTKUserInfoResponse.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Represents the claims returned by an OpenID Connect userinfo endpoint.
+    @see https://openid.net/specs/openid-connect-core-1_0.html#UserInfoResponse
+ */
+@interface SCTKUserInfoResponse : NSObject <NSCopying, NSSecureCoding>
+
+/*! @brief REQUIRED. Subject, the identifier of the end-user at the issuer.
+    @remarks sub
+ */
+@property(nonatomic, readonly) NSString *subject;
+
+/*! @brief The full name of the end-user.
+    @remarks name
+ */
+@property(nonatomic, readonly, nullable) NSString *name;
+
+/*! @brief Given name(s) or first name(s) of the end-user.
+    @remarks given_name
+ */
+@property(nonatomic, readonly, nullable) NSString *givenName;
+
+/*! @brief Surname(s) or last name(s) of the end-user.
+    @remarks family_name
+ */
+@property(nonatomic, readonly, nullable) NSString *familyName;
+
+/*! @brief Middle name(s) of the end-user.
+    @remarks middle_name
+ */
+@property(nonatomic, readonly, nullable) NSString *middleName;
+
+/*! @brief Casual name of the end-user.
+    @remarks nickname
+ */
+@property(nonatomic, readonly, nullable) NSString *nickname;
+
+/*! @brief Shorthand name by which the end-user wishes to be referred to.
+    @remarks preferred_username
+ */
+@property(nonatomic, readonly, nullable) NSString *preferredUsername;
+
+/*! @brief URL of the end-user's profile page.
+    @remarks profile
+ */
+@property(nonatomic, readonly, nullable) NSURL *profile;
+
+/*! @brief URL of the end-user's profile picture.
+    @remarks picture
+ */
+@property(nonatomic, readonly, nullable) NSURL *picture;
+
+/*! @brief URL of the end-user's web page or blog.
+    @remarks website
+ */
+@property(nonatomic, readonly, nullable) NSURL *website;
+
+/*! @brief The end-user's preferred e-mail address.
+    @remarks email
+ */
+@property(nonatomic, readonly, nullable) NSString *email;
+
+/*! @brief Whether the issuer has verified @c email, as a boolean, if stated.
+    @remarks email_verified
+ */
+@property(nonatomic, readonly, nullable) NSNumber *emailVerified;
+
+/*! @brief The end-user's gender.
+    @remarks gender
+ */
+@property(nonatomic, readonly, nullable) NSString *gender;
+
+/*! @brief The end-user's birthday, in the ISO 8601 YYYY-MM-DD or YYYY format.
+    @remarks birthdate
+ */
+@property(nonatomic, readonly, nullable) NSString *birthdate;
+
+/*! @brief The end-user's time zone, from the IANA time zone database.
+    @remarks zoneinfo
+ */
+@property(nonatomic, readonly, nullable) NSString *zoneinfo;
+
+/*! @brief The end-user's locale, as a BCP47 language tag.
+    @remarks locale
+ */
+@property(nonatomic, readonly, nullable) NSString *locale;
+
+/*! @brief The end-user's preferred telephone number.
+    @remarks phone_number
+ */
+@property(nonatomic, readonly, nullable) NSString *phoneNumber;
+
+/*! @brief Whether the issuer has verified @c phoneNumber, as a boolean, if stated.
+    @remarks phone_number_verified
+ */
+@property(nonatomic, readonly, nullable) NSNumber *phoneNumberVerified;
+
+/*! @brief The end-user's preferred postal address, as a JSON object.
+    @remarks address
+ */
+@property(nonatomic, readonly, nullable) NSDictionary<NSString *, id> *address;
+
+/*! @brief When the end-user's information was last updated.
+    @remarks updated_at
+ */
+@property(nonatomic, readonly, nullable) NSDate *updatedAt;
+
+/*! @brief Claims without a property above, including those of a type other than specified.
+ */
+@property(nonatomic, readonly) NSDictionary<NSString *, NSObject<NSCopying> *> *additionalClaims;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithClaims:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param claims The decoded JSON object returned by the userinfo endpoint.
+    @return The response, or nil if @c claims has no @c sub string.
+ */
+- (nullable instancetype)initWithClaims:(NSDictionary<NSString *, NSObject<NSCopying> *> *)claims
+    NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,164 @@
+/*! @file SCTKUserInfoResponse.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKUserInfoResponse.h"
+
+#import "SCTKDefines.h"
+#import "SCTKFieldMapping.h"
+#import "SCTKTokenUtilities.h"
+
+/*! @brief The key for the @c subject property in the incoming claims and for @c NSSecureCoding.
+ */
+static NSString *const kSubjectKey = @"sub";
+
+/*! @brief The key for the @c address property in the incoming claims and for @c NSSecureCoding.
+ */
+static NSString *const kAddressKey = @"address";
+
+/*! @brief Key used to encode the @c additionalClaims property for @c NSSecureCoding.
+ */
+static NSString *const kAdditionalClaimsKey = @"additionalClaims";
+
+@implementation SCTKUserInfoResponse
+
+/*! @brief Returns a mapping of incoming claims to instance variables.
+    @return A mapping of incoming claims to instance variables.
+    @discussion @c address is mapped separately, as a JSON object needs the JSON types to decode.
+ */
++ (NSDictionary<NSString *, SCTKFieldMapping *> *)fieldMap {
+  static NSMutableDictionary<NSString *, SCTKFieldMapping *> *fieldMap;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    fieldMap = [NSMutableDictionary dictionary];
+    Class stringClass = [NSString class];
+    NSDictionary<NSString *, NSString *> *stringClaims = @{
+      kSubjectKey : @"_subject",
+      @"name" : @"_name",
+      @"given_name" : @"_givenName",
+      @"family_name" : @"_familyName",
+      @"middle_name" : @"_middleName",
+      @"nickname" : @"_nickname",
+      @"preferred_username" : @"_preferredUsername",
+      @"email" : @"_email",
+      @"gender" : @"_gender",
+      @"birthdate" : @"_birthdate",
+      @"zoneinfo" : @"_zoneinfo",
+      @"locale" : @"_locale",
+      @"phone_number" : @"_phoneNumber",
+    };
+    for (NSString *claim in stringClaims) {
+      fieldMap[claim] = [[SCTKFieldMapping alloc] initWithName:stringClaims[claim]
+                                                          type:stringClass];
+    }
+    for (NSString *claim in @[ @"profile", @"picture", @"website" ]) {
+      fieldMap[claim] =
+          [[SCTKFieldMapping alloc] initWithName:[@"_" stringByAppendingString:claim]
+                                            type:[NSURL class]
+                                      conversion:[SCTKFieldMapping URLConversion]];
+    }
+    fieldMap[@"email_verified"] =
+        [[SCTKFieldMapping alloc] initWithName:@"_emailVerified" type:[NSNumber class]];
+    fieldMap[@"phone_number_verified"] =
+        [[SCTKFieldMapping alloc] initWithName:@"_phoneNumberVerified" type:[NSNumber class]];
+    fieldMap[@"updated_at"] =
+        [[SCTKFieldMapping alloc] initWithName:@"_updatedAt"
+                                          type:[NSDate class]
+                                    conversion:[SCTKFieldMapping dateEpochConversion]];
+  });
+  return fieldMap;
+}
+
+#pragma mark - Initializers
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithClaims:))
+
+- (nullable instancetype)initWithClaims:
+    (NSDictionary<NSString *, NSObject<NSCopying> *> *)claims {
+  self = [super init];
+  if (self) {
+    NSMutableDictionary<NSString *, NSObject<NSCopying> *> *additionalClaims =
+        [[SCTKFieldMapping remainingParametersWithMap:[[self class] fieldMap]
+                                           parameters:claims
+                                             instance:self] mutableCopy];
+    NSObject *address = additionalClaims[kAddressKey];
+    if ([address isKindOfClass:[NSDictionary class]]) {
+      _address = (NSDictionary *)address;
+      [additionalClaims removeObjectForKey:kAddressKey];
+    }
+    _additionalClaims = [additionalClaims copy];
+    // https://openid.net/specs/openid-connect-core-1_0.html#UserInfoResponse
+    // "The sub (subject) Claim MUST always be returned in the UserInfo Response."
+    if (!_subject) {
+      return nil;
+    }
+  }
+  return self;
+}
+
+#pragma mark - NSCopying
+
+- (instancetype)copyWithZone:(nullable NSZone *)zone {
+  // The documentation for NSCopying specifically advises us to return a reference to the original
+  // instance in the case where instances are immutable (as ours is):
+  // "Implement NSCopying by retaining the original instead of creating a new copy when the class
+  // and its contents are immutable."
+  return self;
+}
+
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding {
+  return YES;
+}
+
+- (nullable instancetype)initWithCoder:(NSCoder *)aDecoder {
+  NSString *subject = [aDecoder decodeObjectOfClass:[NSString class] forKey:kSubjectKey];
+  if (!subject) {
+    return nil;
+  }
+  self = [self initWithClaims:@{ kSubjectKey : subject }];
+  if (self) {
+    [SCTKFieldMapping decodeWithCoder:aDecoder map:[[self class] fieldMap] instance:self];
+    _address = [aDecoder decodeObjectOfClasses:[SCTKFieldMapping JSONTypes] forKey:kAddressKey];
+    _additionalClaims = [aDecoder decodeObjectOfClasses:[SCTKFieldMapping JSONTypes]
+                                                 forKey:kAdditionalClaimsKey] ?: @{};
+  }
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+  [SCTKFieldMapping encodeWithCoder:aCoder map:[[self class] fieldMap] instance:self];
+  [aCoder encodeObject:_address forKey:kAddressKey];
+  [aCoder encodeObject:_additionalClaims forKey:kAdditionalClaimsKey];
+}
+
+#pragma mark - NSObject overrides
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, subject: \"%@\", name: \"%@\", email: \"%@\", "
+                                     "additionalClaims: %@>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _subject,
+                                    [SCTKTokenUtilities redact:_name],
+                                    [SCTKTokenUtilities redact:_email],
+                                    _additionalClaims.allKeys];
+}
+
+@end
@@ -77,16 +77,44 @@ typedef void (^OIDTVAuthorizationCancelBlock)(void);
 + (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
                                    completion:(OIDTVDiscoveryCallback)completion;
 
+/*! @brief Convenience method for creating a TV authorization service configuration from an OpenID
+        Connect compliant issuer URL. This method validates the presence of a device authorization
+        endpoint in the retrieved discovery document and instantiates an
+        @c OIDTVServiceConfiguration.
+    @param issuerURL The service provider's OpenID Connect issuer.
+    @param callbackQueue The queue on which to call the completion.
+    @param completion A block which will be invoked when the authorization service configuration has
+        been created, or when an error has occurred.
+    @see https://openid.net/specs/openid-connect-discovery-1_0.html
+ */
++ (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                callbackQueue:(dispatch_queue_t)callbackQueue
+                                   completion:(OIDTVDiscoveryCallback)completion;
+
+/*! @brief Convenience method for creating a TV authorization service configuration from an OpenID
+        Connect compliant identity provider's discovery document. This method validates the presence
+        of a device authorization endpoint in the retrieved discovery document and instantiates an
+        @c OIDTVServiceConfiguration.
+    @param discoveryURL The URL of the service provider's OpenID Connect discovery document.
+    @param completion A block which will be invoked when the authorization service configuration has
+        been created, or when an error has occurred.
+    @see https://openid.net/specs/openid-connect-discovery-1_0.html
+ */
++ (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                         completion:(OIDTVDiscoveryCallback)completion;
+
 /*! @brief Convenience method for creating a TV authorization service configuration from an OpenID
         Connect compliant identity provider's discovery document. This method validates the presence
         of a device authorization endpoint in the retrieved discovery document and instantiates an
         @c OIDTVServiceConfiguration.
     @param discoveryURL The URL of the service provider's OpenID Connect discovery document.
+    @param callbackQueue The queue on which to call the completion.
     @param completion A block which will be invoked when the authorization service configuration has
         been created, or when an error has occurred.
     @see https://openid.net/specs/openid-connect-discovery-1_0.html
  */
 + (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                      callbackQueue:(dispatch_queue_t)callbackQueue
                                          completion:(OIDTVDiscoveryCallback)completion;
 
 /*! @brief Starts a TV authorization flow with the given request and polls for a response.
@@ -106,6 +134,20 @@ typedef void (^OIDTVAuthorizationCancelBlock)(void);
                                      initialization:(OIDTVAuthorizationInitialization)initialization
                                          completion:(OIDTVAuthorizationCompletion)completion;
 
+/*! @brief Starts a TV authorization flow with the given request and polls for a response.
+    @param request The TV authorization request to initiate.
+    @param callbackQueue The queue on which to call @c initialization and @c completion.
+    @param initialization Block that is called with the initial authorization response.
+    @param completion Block that is called on the success or failure of the authorization.
+    @return A block which you can execute if you need to cancel the ongoing authorization. Has no
+        effect if called twice, or called after the authorization concludes.
+    @see https://tools.ietf.org/html/rfc8628
+ */
++ (OIDTVAuthorizationCancelBlock)authorizeTVRequest:(OIDTVAuthorizationRequest *)request
+                                      callbackQueue:(dispatch_queue_t)callbackQueue
+                                     initialization:(OIDTVAuthorizationInitialization)initialization
+                                         completion:(OIDTVAuthorizationCompletion)completion;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -22,6 +22,7 @@
 #import "SCTKAuthState.h"
 #import "SCTKDefines.h"
 #import "SCTKErrorUtilities.h"
+#import "SCTKResponseReader.h"
 #import "SCTKServiceDiscovery.h"
 #import "SCTKURLQueryComponent.h"
 #import "SCTKURLSessionProvider.h"
@@ -59,10 +60,31 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
                                                  completion:completion];
 }
 
++ (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                callbackQueue:(dispatch_queue_t)callbackQueue
+                                   completion:(OIDTVDiscoveryCallback)completion {
+  NSURL *fullDiscoveryURL =
+      [issuerURL URLByAppendingPathComponent:kOpenIDConfigurationWellKnownPath];
+
+  [[self class] discoverServiceConfigurationForDiscoveryURL:fullDiscoveryURL
+                                              callbackQueue:callbackQueue
+                                                 completion:completion];
+}
+
++ (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                         completion:(OIDTVDiscoveryCallback)completion {
+  dispatch_queue_t callbackQueue = [SCTKAuthorizationService defaultCallbackQueue];
+  [[self class] discoverServiceConfigurationForDiscoveryURL:discoveryURL
+                                              callbackQueue:callbackQueue
+                                                 completion:completion];
+}
+
 + (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                      callbackQueue:(dispatch_queue_t)callbackQueue
                                          completion:(OIDTVDiscoveryCallback)completion {
   // Call the corresponding discovery method in SCTKAuthorizationService
   [SCTKAuthorizationService discoverServiceConfigurationForDiscoveryURL:discoveryURL
+                                                          callbackQueue:callbackQueue
       completion:^(SCTKServiceConfiguration * _Nullable configuration, NSError * _Nullable error) {
     if (configuration == nil) {
       completion(nil, error);
@@ -92,13 +114,27 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
 + (OIDTVAuthorizationCancelBlock)authorizeTVRequest:(OIDTVAuthorizationRequest *)request
                                      initialization:(OIDTVAuthorizationInitialization)initialization
                                          completion:(OIDTVAuthorizationCompletion)completion {
+  return [[self class] authorizeTVRequest:request
+                            callbackQueue:[SCTKAuthorizationService defaultCallbackQueue]
+                           initialization:initialization
+                               completion:completion];
+}
+
++ (OIDTVAuthorizationCancelBlock)authorizeTVRequest:(OIDTVAuthorizationRequest *)request
+                                      callbackQueue:(dispatch_queue_t)callbackQueue
+                                     initialization:(OIDTVAuthorizationInitialization)initialization
+                                         completion:(OIDTVAuthorizationCompletion)completion {
+  // Serializes the handling of the poll responses.
+  dispatch_queue_t pollQueue =
+      dispatch_queue_create("org.openid.appauth.tvpoll", DISPATCH_QUEUE_SERIAL);
+
   // Block level variable that can be used to cancel the polling.
   __block BOOL pollRunning = YES;
 
   // Block that will be returned allowign the caller to cancel the polling.
   OIDTVAuthorizationCancelBlock cancelBlock = ^{
     if (pollRunning) {
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         NSError *cancelError =
             [SCTKErrorUtilities errorWithCode:OIDErrorCodeProgramCanceledAuthorizationFlow
                              underlyingError:nil
@@ -111,18 +147,28 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
 
   // Performs the initial authorization reqeust.
   NSURLRequest *URLRequest = [request URLRequest];
-  NSURLSession *session = [NSURLSession sharedSession];
-  [[session dataTaskWithRequest:URLRequest
-              completionHandler:^(NSData *_Nullable data,
-                                  NSURLResponse *_Nullable response,
-                                  NSError *_Nullable error) {
+  id<SCTKHTTPTransport> transport =
+      [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileToken];
+  [[SCTKResponseReader taskWithTransport:transport
+                                 request:URLRequest
+                                endpoint:SCTKResponseReaderEndpointToken
+                       completionHandler:^(NSData *_Nullable data,
+                                           NSURLResponse *_Nullable response,
+                                           NSError *_Nullable error) {
+    // An oversized response is reported as such, not as a connection error.
+    if ([SCTKResponseReader isResponseTooLargeError:error]) {
+      dispatch_async(callbackQueue, ^{
+        initialization(nil, error);
+      });
+      return;
+    }
     if (error) {
       // A network error or server error occurred.
       NSError *returnedError =
           [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
                            underlyingError:error
                                description:nil];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         initialization(nil, returnedError);
       });
       return;
@@ -150,7 +196,7 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
             [SCTKErrorUtilities OAuthErrorWithDomain:SCTKOAuthTokenErrorDomain
                                       OAuthResponse:json
                                     underlyingError:serverError];
-          dispatch_async(dispatch_get_main_queue(), ^{
+          dispatch_async(callbackQueue, ^{
             initialization(nil, oauthError);
           });
           return;
@@ -162,7 +208,7 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
           [SCTKErrorUtilities errorWithCode:SCTKErrorCodeServerError
                            underlyingError:serverError
                                description:nil];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         initialization(nil, returnedError);
       });
       return;
@@ -179,7 +225,7 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
           [SCTKErrorUtilities errorWithCode:SCTKErrorCodeJSONDeserializationError
                            underlyingError:jsonDeserializationError
                                description:nil];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         initialization(nil, returnedError);
       });
       return;
@@ -194,14 +240,14 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
           [SCTKErrorUtilities errorWithCode:SCTKErrorCodeTokenResponseConstructionError
                            underlyingError:jsonDeserializationError
                                description:nil];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      dispatch_async(callbackQueue, ^{
         initialization(nil, returnedError);
       });
       return;
     }
 
     // Calls the initialization block to signal that we received a TV authorization response.
-    dispatch_async(dispatch_get_main_queue(), ^() {
+    dispatch_async(callbackQueue, ^() {
       initialization(TVAuthorizationResponse, nil);
     });
 
@@ -231,49 +277,49 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
 
         // Polls token endpoint.
         [SCTKAuthorizationService performTokenRequest:pollRequest
-                                            callback:^(SCTKTokenResponse *_Nullable tokenResponse,
-                                                       NSError *_Nullable tokenError) {
+                        originalAuthorizationResponse:nil
+                                        callbackQueue:pollQueue
+                                             callback:^(SCTKTokenResponse *_Nullable tokenResponse,
+                                                        NSError *_Nullable tokenError) {
           if (!pollRunning) {
             return;
           }
-          dispatch_async(dispatch_get_main_queue(), ^() {
-            if (tokenResponse) {
-              // Success response.
-              pollRunning = NO;
-              dispatch_async(dispatch_get_main_queue(), ^{
-                SCTKAuthState *authState =
-                    [[SCTKAuthState alloc] initWithAuthorizationResponse:TVAuthorizationResponse
-                                                          tokenResponse:tokenResponse];
-                completion(authState, nil);
-              });
-            } else {
-              if (tokenError.domain == SCTKOAuthTokenErrorDomain) {
-                // OAuth token errors inspected for device flow specific errors.
-                NSString *errorCode =
-                    tokenError.userInfo[SCTKOAuthErrorResponseErrorKey][SCTKOAuthErrorFieldError];
-                if ([errorCode isEqual:kErrorCodeAuthorizationPending]) {
-                  // authorization_pending is an expected response.
-                  return;
-                } else if ([errorCode isEqual:kErrorCodeSlowDown]) {
-                  // Increase interval by 20%, enforce a lower bound of 5s.
-                  interval *= 1.20;
-                  interval = MAX(5.0, interval);
-                } else {
-                  // Unhandled token error, considered fatal.
-                  pollRunning = NO;
-                  dispatch_async(dispatch_get_main_queue(), ^{
-                    completion(nil, tokenError);
-                  });
-                }
+          if (tokenResponse) {
+            // Success response.
+            pollRunning = NO;
+            dispatch_async(callbackQueue, ^{
+              SCTKAuthState *authState =
+                  [[SCTKAuthState alloc] initWithAuthorizationResponse:TVAuthorizationResponse
+                                                        tokenResponse:tokenResponse];
+              completion(authState, nil);
+            });
+          } else {
+            if (tokenError.domain == SCTKOAuthTokenErrorDomain) {
+              // OAuth token errors inspected for device flow specific errors.
+              NSString *errorCode =
+                  tokenError.userInfo[SCTKOAuthErrorResponseErrorKey][SCTKOAuthErrorFieldError];
+              if ([errorCode isEqual:kErrorCodeAuthorizationPending]) {
+                // authorization_pending is an expected response.
+                return;
+              } else if ([errorCode isEqual:kErrorCodeSlowDown]) {
+                // Increase interval by 20%, enforce a lower bound of 5s.
+                interval *= 1.20;
+                interval = MAX(5.0, interval);
               } else {
-                // All other errors considered fatal.
+                // Unhandled token error, considered fatal.
                 pollRunning = NO;
-                dispatch_async(dispatch_get_main_queue(), ^{
+                dispatch_async(callbackQueue, ^{
                   completion(nil, tokenError);
                 });
               }
+            } else {
+              // All other errors considered fatal.
+              pollRunning = NO;
+              dispatch_async(callbackQueue, ^{
+                completion(nil, tokenError);
+              });
             }
-          });
+          }
         }];
       } while ([TVAuthorizationResponse.expirationDate timeIntervalSinceNow] > 0 && pollRunning);
     });
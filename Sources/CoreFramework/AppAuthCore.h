@@ -50,4 +50,30 @@ FOUNDATION_EXPORT const unsigned char AppAuthCoreVersionString[];
 #import <AppAuthCore/SCTKURLSessionProvider.h>
 #import <AppAuthCore/SCTKEndSessionRequest.h>
 #import <AppAuthCore/SCTKEndSessionResponse.h>
+#import <AppAuthCore/SCTKAuthStateStore.h>
+#import <AppAuthCore/SCTKAuthStateRefreshScheduler.h>
+#import <AppAuthCore/SCTKAuthStateTokenSnapshot.h>
+#import <AppAuthCore/SCTKAuthStateRefreshCoordinator.h>
+#import <AppAuthCore/SCTKClockSkewEstimator.h>
+#import <AppAuthCore/SCTKAuthStateActionHandle.h>
+#import <AppAuthCore/SCTKAuthStateCodec.h>
+#import <AppAuthCore/SCTKAuthStateJournalStore.h>
+#import <AppAuthCore/SCTKAuthStateBatchRefresher.h>
+#import <AppAuthCore/SCTKRetryPolicy.h>
+#import <AppAuthCore/SCTKCircuitBreaker.h>
+#import <AppAuthCore/SCTKTokenResponsePipeline.h>
+#import <AppAuthCore/SCTKPromise.h>
+#import <AppAuthCore/SCTKAuthorizationService+Promises.h>
+#import <AppAuthCore/SCTKResponseReader.h>
+#import <AppAuthCore/SCTKServiceDiscoveryCache.h>
+#import <AppAuthCore/SCTKConnectionPrewarmer.h>
+#import <AppAuthCore/SCTKUserInfoResponse.h>
+#import <AppAuthCore/SCTKUserInfoCache.h>
+#import <AppAuthCore/SCTKRevocationRequest.h>
+#import <AppAuthCore/SCTKIntrospectionRequest.h>
+#import <AppAuthCore/SCTKIntrospectionResponse.h>
+#import <AppAuthCore/SCTKIntrospectionCache.h>
+#import <AppAuthCore/SCTKHTTPTransport.h>
+#import <AppAuthCore/SCTKURLSessionTransport.h>
+#import <AppAuthCore/SCTKLoopbackTransport.h>
 
@@ -20,16 +20,23 @@
 
 #import "OIDAuthorizationResponseTests.h"
 #import "OIDRegistrationResponseTests.h"
+#import "SCTKTestURLProtocol.h"
 #import "SCTKTokenResponseTests.h"
 
 #if SWIFT_PACKAGE
 @import AppAuthCore;
 #else
 #import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthStateActionHandle.h"
+#import "Sources/AppAuthCore/SCTKAuthorizationService.h"
+#import "Sources/AppAuthCore/SCTKCircuitBreaker.h"
 #import "Sources/AppAuthCore/OIDAuthorizationResponse.h"
+#import "Sources/AppAuthCore/SCTKError.h"
 #import "Sources/AppAuthCore/SCTKErrorUtilities.h"
 #import "Sources/AppAuthCore/SCTKRegistrationResponse.h"
+#import "Sources/AppAuthCore/SCTKRetryPolicy.h"
 #import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
 #endif
 
 #import "OIDTokenRequestTests.h"
@@ -73,6 +80,19 @@
   return authstate;
 }
 
+/*! @brief Creates an auth state with a fresh access token and no refresh token.
+ */
++ (SCTKAuthState *)freshInstance {
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:[OIDTokenRequestTests testInstance]
+                                     parameters:@{@"access_token": @"abc123",
+                                                  @"expires_in": @(3600)
+                                                 }];
+  return [[SCTKAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]
+                      tokenResponse:tokenResponse];
+}
+
 /*! @brief NSError for an invalid_request on the authorization endpoint.
  */
 + (NSError *)OAuthAuthorizationError {
@@ -271,6 +291,7 @@
   XCTAssertNil(authState.refreshToken);
   XCTAssertNil(authState.scope);
   XCTAssertNil(authState.lastAuthorizationResponse);
+  XCTAssertNil(authState.lastTokenResponseDate);
   XCTAssertNil(authState.authorizationError);
   XCTAssertFalse(authState.isAuthorized);
 }
@@ -282,6 +303,7 @@
   SCTKTokenResponse *tokenResponse = [SCTKTokenResponseTests testInstanceRefresh];
   [authState updateWithTokenResponse:tokenResponse error:nil];
   XCTAssertEqual(authState.lastTokenResponse, tokenResponse, @"");
+  XCTAssertNotNil(authState.lastTokenResponseDate, @"");
   XCTAssertNotNil(authState.refreshToken, @"");
   XCTAssertTrue(authState.isAuthorized, @"");
   XCTAssertNil(authState.authorizationError, @"");
@@ -392,6 +414,7 @@
                         authState.lastAuthorizationResponse.authorizationCode, @"");
   XCTAssertEqualObjects(authStateCopy.lastTokenResponse.refreshToken,
                         authState.lastTokenResponse.refreshToken, @"");
+  XCTAssertEqualObjects(authStateCopy.lastTokenResponseDate, authState.lastTokenResponseDate, @"");
   XCTAssertEqualObjects(authStateCopy.authorizationError.domain,
                         authState.authorizationError.domain, @"");
   XCTAssertEqual(authStateCopy.authorizationError.code, authState.authorizationError.code, @"");
@@ -477,6 +500,565 @@
   XCTAssertEqual([authState isTokenFresh], YES, @"");
 }
 
+- (void)testPerformActionWithFreshTokensInlineRunsSynchronously {
+  SCTKAuthState *authState = [[self class] freshInstance];
+  __block BOOL called = NO;
+  BOOL inlined = [authState performActionWithFreshTokensInline:^(NSString *_Nullable accessToken,
+                                                                 NSString *_Nullable idToken,
+                                                                 NSError *_Nullable error) {
+    XCTAssertEqualObjects(accessToken, @"abc123", @"");
+    XCTAssertNil(error, @"");
+    called = YES;
+  }
+                                   additionalRefreshParameters:nil
+                                                 dispatchQueue:dispatch_get_main_queue()];
+  XCTAssertTrue(inlined, @"");
+  XCTAssertTrue(called, @"");
+}
+
+- (void)testPerformActionWithFreshTokensInlineFallsBackWithoutRefreshToken {
+  SCTKAuthState *authState = [[self class] freshInstance];
+  [authState setNeedsTokenRefresh];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"action called"];
+  BOOL inlined = [authState performActionWithFreshTokensInline:^(NSString *_Nullable accessToken,
+                                                                 NSString *_Nullable idToken,
+                                                                 NSError *_Nullable error) {
+    XCTAssertEqual(error.code, SCTKErrorCodeTokenRefreshError, @"");
+    [expectation fulfill];
+  }
+                                   additionalRefreshParameters:nil
+                                                 dispatchQueue:dispatch_get_main_queue()];
+  XCTAssertFalse(inlined, @"");
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+- (void)testPerformActionWithFreshTokensDispatchedPerformance {
+  SCTKAuthState *authState = [[self class] freshInstance];
+  dispatch_queue_t queue = dispatch_queue_create("SCTKAuthStateTests", DISPATCH_QUEUE_SERIAL);
+  [self measureBlock:^{
+    dispatch_group_t group = dispatch_group_create();
+    for (NSUInteger i = 0; i < 10000; i++) {
+      dispatch_group_enter(group);
+      [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                                NSString *_Nullable idToken,
+                                                NSError *_Nullable error) {
+        dispatch_group_leave(group);
+      }
+                  additionalRefreshParameters:nil
+                                dispatchQueue:queue];
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+  }];
+}
+
+- (void)testPerformActionWithFreshTokensInlinePerformance {
+  SCTKAuthState *authState = [[self class] freshInstance];
+  dispatch_queue_t queue = dispatch_queue_create("SCTKAuthStateTests", DISPATCH_QUEUE_SERIAL);
+  [self measureBlock:^{
+    dispatch_group_t group = dispatch_group_create();
+    for (NSUInteger i = 0; i < 10000; i++) {
+      dispatch_group_enter(group);
+      [authState performActionWithFreshTokensInline:^(NSString *_Nullable accessToken,
+                                                      NSString *_Nullable idToken,
+                                                      NSError *_Nullable error) {
+        dispatch_group_leave(group);
+      }
+                        additionalRefreshParameters:nil
+                                      dispatchQueue:queue];
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+  }];
+}
+
+/*! @brief Tests that an action waiting on a refresh that never completes fails once its timeout
+        elapses.
+ */
+- (void)testPerformActionWithFreshTokensTimeout {
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] testInstance];
+  [authState setNeedsTokenRefresh];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"action timed out"];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertNil(accessToken);
+    XCTAssertEqualObjects(error.domain, SCTKGeneralErrorDomain);
+    XCTAssertEqual(error.code, SCTKErrorCodeTokenRefreshTimeoutError);
+    [expectation fulfill];
+  }
+              additionalRefreshParameters:nil
+                            dispatchQueue:dispatch_get_main_queue()
+                                  timeout:0.1];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that cancelling the handle of a waiting action fails only that action.
+ */
+- (void)testPerformActionWithFreshTokensHandleCancel {
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] testInstance];
+  [authState setNeedsTokenRefresh];
+
+  XCTestExpectation *cancelled = [self expectationWithDescription:@"action cancelled"];
+  SCTKAuthStateActionHandle *handle =
+      [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                                NSString *_Nullable idToken,
+                                                NSError *_Nullable error) {
+        XCTAssertEqual(error.code, SCTKErrorCodeTokenRefreshCancelledError);
+        [cancelled fulfill];
+      }
+                  additionalRefreshParameters:nil
+                                dispatchQueue:dispatch_get_main_queue()
+                                      timeout:0];
+  XCTestExpectation *timedOut = [self expectationWithDescription:@"other action timed out"];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertEqual(error.code, SCTKErrorCodeTokenRefreshTimeoutError);
+    [timedOut fulfill];
+  }
+              additionalRefreshParameters:nil
+                            dispatchQueue:dispatch_get_main_queue()
+                                  timeout:0.5];
+  [handle cancel];
+  XCTAssertTrue(handle.isCancelled);
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that @c SCTKAuthState.cancelTokenRefresh fails every waiting action, without
+        letting later actions start a second refresh.
+ */
+- (void)testCancelTokenRefresh {
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] testInstance];
+  [authState setNeedsTokenRefresh];
+
+  for (NSUInteger i = 0; i < 3; i++) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"action cancelled"];
+    [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                              NSString *_Nullable idToken,
+                                              NSError *_Nullable error) {
+      XCTAssertEqual(error.code, SCTKErrorCodeTokenRefreshCancelledError);
+      [expectation fulfill];
+    }
+                additionalRefreshParameters:nil
+                              dispatchQueue:dispatch_get_main_queue()
+                                    timeout:0];
+  }
+  [authState cancelTokenRefresh];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  // an action asking after the cancellation waits for the request already sent
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+  }
+              additionalRefreshParameters:nil
+                            dispatchQueue:dispatch_get_main_queue()
+                                  timeout:0];
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Creates an auth state with a refresh token, whose access token expires after the given
+        number of seconds.
+ */
++ (SCTKAuthState *)instanceExpiringIn:(NSInteger)expiresIn {
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:[OIDTokenRequestTests testInstance]
+                                     parameters:@{@"access_token": @"abc123",
+                                                  @"expires_in": @(expiresIn),
+                                                  @"refresh_token": @"refresh123"
+                                                 }];
+  return [[SCTKAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]
+                      tokenResponse:tokenResponse];
+}
+
+/*! @brief Tests that with the stale-while-revalidate policy, a token within the refresh tolerance
+        is handed to actions straight away while a single background refresh is started.
+ */
+- (void)testStaleWhileRevalidateServesStaleToken {
+  XCTestExpectation *refreshStarted = [self expectationWithDescription:@"refresh started"];
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    [refreshStarted fulfill];
+    return nil;
+  }];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] instanceExpiringIn:30];
+  authState.refreshPolicy = SCTKAuthStateRefreshPolicyStaleWhileRevalidate;
+
+  for (NSUInteger i = 0; i < 2; i++) {
+    XCTestExpectation *performed = [self expectationWithDescription:@"action performed"];
+    [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                              NSString *_Nullable idToken,
+                                              NSError *_Nullable error) {
+      XCTAssertEqualObjects(accessToken, @"abc123");
+      XCTAssertNil(error);
+      [performed fulfill];
+    }];
+  }
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+  [authState cancelTokenRefresh];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that with the stale-while-revalidate policy, actions still wait for the refresh
+        once the token has expired.
+ */
+- (void)testStaleWhileRevalidateWaitsForExpiredToken {
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] instanceExpiringIn:-10];
+  authState.refreshPolicy = SCTKAuthStateRefreshPolicyStaleWhileRevalidate;
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"action timed out"];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertNil(accessToken);
+    XCTAssertEqual(error.code, SCTKErrorCodeTokenRefreshTimeoutError);
+    [expectation fulfill];
+  }
+              additionalRefreshParameters:nil
+                            dispatchQueue:dispatch_get_main_queue()
+                                  timeout:0.1];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Performs an action with the scoped token for the given scopes and resource, and waits
+        for it.
+    @return The access token the action was called with.
+ */
+- (nullable NSString *)accessTokenFromAuthState:(SCTKAuthState *)authState
+                                      forScopes:(NSArray<NSString *> *)scopes
+                                       resource:(nullable NSString *)resource {
+  __block NSString *scopedAccessToken;
+  XCTestExpectation *expectation = [self expectationWithDescription:@"action performed"];
+  [authState performActionWithFreshTokensForScopes:scopes
+                                          resource:resource
+                                            action:^(NSString *_Nullable accessToken,
+                                                     NSString *_Nullable idToken,
+                                                     NSError *_Nullable error) {
+    XCTAssertNil(error);
+    scopedAccessToken = accessToken;
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  return scopedAccessToken;
+}
+
+/*! @brief Tests that each combination of scopes and resource gets its own cached access token,
+        alongside the main one, and that the auth state adopts a rotated refresh token.
+ */
+- (void)testScopedTokensAreCachedPerScopesAndResource {
+  __block NSUInteger tokensIssued = 0;
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    NSString *accessToken;
+    @synchronized(self) {
+      accessToken = [NSString stringWithFormat:@"scoped%lu", (unsigned long)++tokensIssued];
+    }
+    return [SCTKTestURLResponse
+        responseWithStatusCode:200
+                       headers:nil
+                          JSON:@{@"access_token": accessToken,
+                                 @"token_type": @"Bearer",
+                                 @"expires_in": @3600,
+                                 @"refresh_token": @"rotated123"}];
+  }];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] instanceExpiringIn:3600];
+
+  XCTAssertEqualObjects([self accessTokenFromAuthState:authState
+                                             forScopes:@[@"read", @"write"]
+                                              resource:@"https://api.example.com"],
+                        @"scoped1");
+  XCTAssertEqualObjects([self accessTokenFromAuthState:authState
+                                             forScopes:@[@"read"]
+                                              resource:@"https://api.example.com"],
+                        @"scoped2");
+  XCTAssertEqualObjects([self accessTokenFromAuthState:authState
+                                             forScopes:@[@"read"]
+                                              resource:@"https://other.example.com"],
+                        @"scoped3");
+  // switching back does not cost a round trip, whatever the order of the scopes
+  XCTAssertEqualObjects([self accessTokenFromAuthState:authState
+                                             forScopes:@[@"write", @"read"]
+                                              resource:@"https://api.example.com"],
+                        @"scoped1");
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 3u);
+
+  XCTAssertEqualObjects(authState.refreshToken, @"rotated123");
+  XCTAssertTrue([authState performActionWithFreshTokensInline:^(NSString *_Nullable accessToken,
+                                                                NSString *_Nullable idToken,
+                                                                NSError *_Nullable error) {
+    XCTAssertEqualObjects(accessToken, @"abc123");
+  }
+                                  additionalRefreshParameters:nil
+                                                dispatchQueue:dispatch_get_main_queue()]);
+
+  // a forced refresh discards the scoped tokens too
+  [authState setNeedsTokenRefresh];
+  XCTAssertEqualObjects([self accessTokenFromAuthState:authState
+                                             forScopes:@[@"read"]
+                                              resource:@"https://other.example.com"],
+                        @"scoped4");
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that actions asking for the same scoped token while it is being obtained share
+        one request, and are cancelled by @c SCTKAuthState.cancelTokenRefresh.
+ */
+- (void)testScopedTokenRequestsAreCoalesced {
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] instanceExpiringIn:3600];
+
+  for (NSUInteger i = 0; i < 3; i++) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"action cancelled"];
+    [authState performActionWithFreshTokensForScopes:@[@"read"]
+                                            resource:nil
+                                              action:^(NSString *_Nullable accessToken,
+                                                       NSString *_Nullable idToken,
+                                                       NSError *_Nullable error) {
+      XCTAssertNil(accessToken);
+      XCTAssertEqual(error.code, SCTKErrorCodeTokenRefreshCancelledError);
+      [expectation fulfill];
+    }];
+  }
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.1 * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+    [authState cancelTokenRefresh];
+  });
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that a scoped token request waits for the token refresh in progress, and sends the
+        refresh token it rotated.
+ */
+- (void)testScopedTokenRequestWaitsForTokenRefresh {
+  __block NSUInteger requestsInFlight = 0;
+  __block NSUInteger maximumRequestsInFlight = 0;
+  __block NSUInteger tokensIssued = 0;
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    NSUInteger tokenNumber;
+    @synchronized(self) {
+      maximumRequestsInFlight = MAX(maximumRequestsInFlight, ++requestsInFlight);
+      tokenNumber = ++tokensIssued;
+    }
+    // leaves time for a concurrent request to start, which it must not
+    [NSThread sleepForTimeInterval:0.1];
+    @synchronized(self) {
+      requestsInFlight--;
+    }
+    NSString *accessToken = [NSString stringWithFormat:@"new%lu", (unsigned long)tokenNumber];
+    NSString *refreshToken = [NSString stringWithFormat:@"rotated%lu", (unsigned long)tokenNumber];
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"access_token" : accessToken,
+                                                         @"token_type" : @"Bearer",
+                                                         @"expires_in" : @3600,
+                                                         @"refresh_token" : refreshToken}];
+  }];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] instanceExpiringIn:-10];
+
+  XCTestExpectation *refreshExpectation = [self expectationWithDescription:@"refreshed"];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertEqualObjects(accessToken, @"new1");
+    [refreshExpectation fulfill];
+  }];
+  XCTestExpectation *scopedExpectation = [self expectationWithDescription:@"scoped"];
+  [authState performActionWithFreshTokensForScopes:@[@"read"]
+                                          resource:nil
+                                            action:^(NSString *_Nullable accessToken,
+                                                     NSString *_Nullable idToken,
+                                                     NSError *_Nullable error) {
+    XCTAssertEqualObjects(accessToken, @"new2");
+    [scopedExpectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertEqual(maximumRequestsInFlight, 1u);
+  XCTAssertEqualObjects(authState.refreshToken, @"rotated2");
+  XCTAssertEqualObjects(authState.lastTokenResponse.accessToken, @"new1");
+  XCTAssertEqualObjects(authState.lastTokenResponse.refreshToken, @"rotated2");
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that two auth states refreshing the same refresh token at once share one token
+        request.
+ */
+- (void)testIdenticalTokenRefreshesShareOneRequest {
+  dispatch_semaphore_t responseRelease = dispatch_semaphore_create(0);
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    // holds the response back until both refreshes have been requested
+    dispatch_semaphore_wait(responseRelease,
+                            dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5 * NSEC_PER_SEC)));
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"access_token" : @"new123",
+                                                         @"token_type" : @"Bearer",
+                                                         @"expires_in" : @3600,
+                                                         @"refresh_token" : @"rotated123"}];
+  }];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  NSUInteger sentCount = [SCTKAuthorizationService sentTokenRequestCount];
+  NSUInteger coalescedCount = [SCTKAuthorizationService coalescedTokenRequestCount];
+  NSArray<SCTKAuthState *> *authStates =
+      @[ [[self class] instanceExpiringIn:-10], [[self class] instanceExpiringIn:-10] ];
+
+  for (SCTKAuthState *authState in authStates) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"action performed"];
+    [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                              NSString *_Nullable idToken,
+                                              NSError *_Nullable error) {
+      XCTAssertEqualObjects(accessToken, @"new123");
+      XCTAssertNil(error);
+      [expectation fulfill];
+    }];
+  }
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+    dispatch_semaphore_signal(responseRelease);
+  });
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+  XCTAssertEqual([SCTKAuthorizationService sentTokenRequestCount] - sentCount, 1u);
+  XCTAssertEqual([SCTKAuthorizationService coalescedTokenRequestCount] - coalescedCount, 1u);
+  for (SCTKAuthState *authState in authStates) {
+    XCTAssertEqualObjects(authState.refreshToken, @"rotated123");
+  }
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that concurrent token refreshes update the auth state one at a time even when the
+        default callback queue is concurrent.
+ */
+- (void)testTokenRefreshWithConcurrentCallbackQueue {
+  __block NSUInteger tokensIssued = 0;
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    NSString *accessToken;
+    @synchronized(self) {
+      accessToken = [NSString stringWithFormat:@"new%lu", (unsigned long)++tokensIssued];
+    }
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"access_token" : accessToken,
+                                                         @"token_type" : @"Bearer",
+                                                         @"expires_in" : @3600,
+                                                         @"refresh_token" : @"rotated123"}];
+  }];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  [SCTKAuthorizationService
+      setDefaultCallbackQueue:dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0)];
+  SCTKAuthState *authState = [[self class] instanceExpiringIn:-10];
+
+  XCTestExpectation *refreshExpectation = [self expectationWithDescription:@"refreshed"];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertEqualObjects(accessToken, @"new1");
+    [refreshExpectation fulfill];
+  }];
+  for (NSString *scope in @[ @"read", @"write" ]) {
+    XCTestExpectation *scopedExpectation = [self expectationWithDescription:scope];
+    [authState performActionWithFreshTokensForScopes:@[ scope ]
+                                            resource:nil
+                                              action:^(NSString *_Nullable accessToken,
+                                                       NSString *_Nullable idToken,
+                                                       NSError *_Nullable error) {
+      XCTAssertNotNil(accessToken);
+      [scopedExpectation fulfill];
+    }];
+  }
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertEqualObjects(authState.refreshToken, @"rotated123");
+  XCTAssertEqualObjects(authState.lastTokenResponse.accessToken, @"new1");
+  [SCTKAuthorizationService setDefaultCallbackQueue:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that a refresh failing with server errors is retried as the retry policy allows.
+ */
+- (void)testTokenRefreshRetriesTransientErrors {
+  __block NSUInteger requestNumber = 0;
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    @synchronized(self) {
+      if (++requestNumber < 3) {
+        return [SCTKTestURLResponse responseWithStatusCode:503 headers:nil data:nil];
+      }
+    }
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"access_token" : @"new123",
+                                                         @"token_type" : @"Bearer",
+                                                         @"expires_in" : @3600}];
+  }];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] instanceExpiringIn:-10];
+  authState.retryPolicy = [[SCTKRetryPolicy alloc] initWithMaximumRetryCount:2
+                                                                initialDelay:0.01
+                                                                maximumDelay:0.01];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"action performed"];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertEqualObjects(accessToken, @"new123");
+    XCTAssertNil(error);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 3u);
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that refreshes fail fast without a request while the circuit breaker of the token
+        endpoint is open.
+ */
+- (void)testTokenRefreshFailsFastWhenCircuitIsOpen {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:500 headers:nil data:nil];
+  }];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKCircuitBreaker *circuitBreaker =
+      [[SCTKCircuitBreaker alloc] initWithFailureThreshold:1 resetTimeout:60];
+  SCTKAuthState *authState = [[self class] instanceExpiringIn:-10];
+  authState.circuitBreaker = circuitBreaker;
+
+  NSArray<NSNumber *> *expectedErrorCodes =
+      @[@(SCTKErrorCodeServerError), @(SCTKErrorCodeEndpointUnavailableError)];
+  for (NSNumber *expectedErrorCode in expectedErrorCodes) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"action failed"];
+    [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                              NSString *_Nullable idToken,
+                                              NSError *_Nullable error) {
+      XCTAssertNil(accessToken);
+      XCTAssertEqual(error.code, expectedErrorCode.integerValue);
+      [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+  }
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
 - (void)testThatRefreshTokenExceptionWillBeRaisedForTokenRequestWithAdditionalParameters {
   SCTKAuthState *authState = [[SCTKAuthState alloc] initWithAuthorizationResponse:nil tokenResponse:nil registrationResponse:nil];
   XCTAssertThrowsSpecificNamed([authState tokenRefreshRequestWithAdditionalParameters:nil],
@@ -27,6 +27,7 @@
 #else
 #import "Sources/AppAuthCore/SCTKAuthorizationService.h"
 #import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKResponseReader.h"
 #import "Sources/AppAuthCore/SCTKServiceConfiguration.h"
 #import "Sources/AppAuthCore/SCTKServiceDiscovery.h"
 #endif
@@ -36,20 +37,24 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wgnu"
 
-/*! @brief The callback signature for @c NSURLSession 's @c dataTaskWithURL:completionHandler:
-        method, which we swizzle in @c testFetcher to fake the network response with an OpenID
-        Connect Discovery document.
+/*! @brief The callback signature for @c SCTKResponseReader 's
+        @c taskWithTransport:request:endpoint:completionHandler: method, which we swizzle in
+        @c testFetcher to fake the network response with an OpenID Connect Discovery document.
  */
 typedef void(^DataTaskWithURLCompletionHandler)(NSData *_Nullable data,
                                                 NSURLResponse *_Nullable response,
                                                 NSError *_Nullable error);
 
-/*! @brief The function signature for a @c dataTaskWithURL:completionHandler: implementation. Used
-        in @c testFetcher for implementing a swizzled version of @c NSURLSession 's
-        @c dataTaskWithURL:completionHandler:
+/*! @brief The function signature for a @c taskWithTransport:request:endpoint:completionHandler:
+        implementation. Used in @c testFetcher for implementing a swizzled version of
+        @c SCTKResponseReader 's @c taskWithTransport:request:endpoint:completionHandler:
  */
-typedef NSURLSessionDataTask *(^DataTaskWithURLCompletionImplementation)
-    (id _self, NSURL *url, DataTaskWithURLCompletionHandler completionHandler);
+typedef id<SCTKHTTPTransportTask> (^DataTaskWithURLCompletionImplementation)
+    (id _self,
+     id<SCTKHTTPTransport> transport,
+     NSURLRequest *request,
+     SCTKResponseReaderEndpoint endpoint,
+     DataTaskWithURLCompletionHandler completionHandler);
 
 /*! @brief A block to be called during teardown.
  */
@@ -204,8 +209,12 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
  */
 - (void)testFetcher {
   DataTaskWithURLCompletionImplementation successfulResponse =
-      ^NSURLSessionDataTask *(
-          id _self, NSURL *url, DataTaskWithURLCompletionHandler completionHandler) {
+      ^id<SCTKHTTPTransportTask>(
+          id _self,
+          id<SCTKHTTPTransport> transport,
+          NSURLRequest *request,
+          SCTKResponseReaderEndpoint endpoint,
+          DataTaskWithURLCompletionHandler completionHandler) {
         NSError *error;
         NSDictionary *jsonObject =
             [OIDServiceDiscoveryTests completeServiceDiscoveryDictionary];
@@ -213,7 +222,7 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
                                                            options:NSJSONWritingPrettyPrinted
                                                              error:&error];
         NSHTTPURLResponse *jsonResponse =
-            [[NSHTTPURLResponse alloc] initWithURL:url
+            [[NSHTTPURLResponse alloc] initWithURL:request.URL
                                         statusCode:200
                                        HTTPVersion:@"1.1"
                                       headerFields:nil];
@@ -221,9 +230,9 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
         return nil;
       };
 
-  [self replaceInstanceMethodForClass:[NSURLSession class]
-                             selector:@selector(dataTaskWithURL:completionHandler:)
-                            withBlock:successfulResponse];
+  [self replaceClassMethodForClass:[SCTKResponseReader class]
+       selector:@selector(taskWithTransport:request:endpoint:completionHandler:)
+      withBlock:successfulResponse];
 
 
   NSURL *url = [NSURL URLWithString:kInitializerTestDiscoveryEndpoint];
@@ -250,21 +259,73 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
   [self waitForExpectationsWithTimeout:2 handler:nil];
 }
 
+/*! @brief Tests that discovery completions are called on the given callback queue, or on the
+        default callback queue if none is given.
+ */
+- (void)testFetcherCallbackQueue {
+  DataTaskWithURLCompletionImplementation failedResponse =
+      ^id<SCTKHTTPTransportTask>(
+          id _self,
+          id<SCTKHTTPTransport> transport,
+          NSURLRequest *request,
+          SCTKResponseReaderEndpoint endpoint,
+          DataTaskWithURLCompletionHandler completionHandler) {
+        NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:500 userInfo:nil];
+        completionHandler(nil, nil, error);
+        return nil;
+      };
+  [self replaceClassMethodForClass:[SCTKResponseReader class]
+       selector:@selector(taskWithTransport:request:endpoint:completionHandler:)
+      withBlock:failedResponse];
+
+  static void *kCallbackQueueKey = &kCallbackQueueKey;
+  dispatch_queue_t callbackQueue =
+      dispatch_queue_create("org.openid.appauth.tests.callback", DISPATCH_QUEUE_SERIAL);
+  dispatch_queue_set_specific(callbackQueue, kCallbackQueueKey, kCallbackQueueKey, NULL);
+  NSURL *url = [NSURL URLWithString:kInitializerTestDiscoveryEndpoint];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback should be fired."];
+  [SCTKAuthorizationService discoverServiceConfigurationForDiscoveryURL:url
+                                                          callbackQueue:callbackQueue
+      completion:^(SCTKServiceConfiguration *_Nullable configuration, NSError *_Nullable error) {
+    XCTAssertTrue(dispatch_get_specific(kCallbackQueueKey) == kCallbackQueueKey);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+
+  XCTAssertEqual([SCTKAuthorizationService defaultCallbackQueue], dispatch_get_main_queue());
+  [SCTKAuthorizationService setDefaultCallbackQueue:callbackQueue];
+  XCTestExpectation *defaultExpectation =
+      [self expectationWithDescription:@"Callback should be fired on the default queue."];
+  [SCTKAuthorizationService discoverServiceConfigurationForDiscoveryURL:url
+      completion:^(SCTKServiceConfiguration *_Nullable configuration, NSError *_Nullable error) {
+    XCTAssertTrue(dispatch_get_specific(kCallbackQueueKey) == kCallbackQueueKey);
+    [defaultExpectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  [SCTKAuthorizationService setDefaultCallbackQueue:nil];
+  XCTAssertEqual([SCTKAuthorizationService defaultCallbackQueue], dispatch_get_main_queue());
+}
+
 /*! @brief Tests the OpenID Connect Discovery Document fetching and initialization in the face of
         a network error.
  */
 - (void)testFetcherWithNetworkError {
   DataTaskWithURLCompletionImplementation successfulResponse =
-      ^NSURLSessionDataTask *(
-          id _self, NSURL *url, DataTaskWithURLCompletionHandler completionHandler) {
+      ^id<SCTKHTTPTransportTask>(
+          id _self,
+          id<SCTKHTTPTransport> transport,
+          NSURLRequest *request,
+          SCTKResponseReaderEndpoint endpoint,
+          DataTaskWithURLCompletionHandler completionHandler) {
         NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:500 userInfo:nil];
         completionHandler(nil, nil, error);
         return nil;
       };
 
-  [self replaceInstanceMethodForClass:[NSURLSession class]
-                             selector:@selector(dataTaskWithURL:completionHandler:)
-                            withBlock:successfulResponse];
+  [self replaceClassMethodForClass:[SCTKResponseReader class]
+       selector:@selector(taskWithTransport:request:endpoint:completionHandler:)
+      withBlock:successfulResponse];
 
   NSURL *url = [NSURL URLWithString:kInitializerTestDiscoveryEndpoint];
 
@@ -286,15 +347,19 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
  */
 - (void)testFetcherWithErrorCode {
   DataTaskWithURLCompletionImplementation successfulResponse =
-      ^NSURLSessionDataTask *(
-          id _self, NSURL *url, DataTaskWithURLCompletionHandler completionHandler) {
+      ^id<SCTKHTTPTransportTask>(
+          id _self,
+          id<SCTKHTTPTransport> transport,
+          NSURLRequest *request,
+          SCTKResponseReaderEndpoint endpoint,
+          DataTaskWithURLCompletionHandler completionHandler) {
         NSError *error;
         NSDictionary *jsonObject = [OIDServiceDiscoveryTests completeServiceDiscoveryDictionary];
         NSData *jsonData = [NSJSONSerialization dataWithJSONObject:jsonObject
                                                            options:NSJSONWritingPrettyPrinted
                                                              error:&error];
         NSHTTPURLResponse *jsonResponse =
-            [[NSHTTPURLResponse alloc] initWithURL:url
+            [[NSHTTPURLResponse alloc] initWithURL:request.URL
                                         statusCode:500
                                        HTTPVersion:@"1.1"
                                       headerFields:nil];
@@ -302,9 +367,9 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
         return nil;
       };
 
-  [self replaceInstanceMethodForClass:[NSURLSession class]
-                             selector:@selector(dataTaskWithURL:completionHandler:)
-                            withBlock:successfulResponse];
+  [self replaceClassMethodForClass:[SCTKResponseReader class]
+       selector:@selector(taskWithTransport:request:endpoint:completionHandler:)
+      withBlock:successfulResponse];
 
 
   NSURL *url = [NSURL URLWithString:kInitializerTestDiscoveryEndpoint];
@@ -327,11 +392,15 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
  */
 - (void)testFetcherWithBadJSON {
   DataTaskWithURLCompletionImplementation successfulResponse =
-      ^NSURLSessionDataTask *(
-          id _self, NSURL *url, DataTaskWithURLCompletionHandler completionHandler) {
+      ^id<SCTKHTTPTransportTask>(
+          id _self,
+          id<SCTKHTTPTransport> transport,
+          NSURLRequest *request,
+          SCTKResponseReaderEndpoint endpoint,
+          DataTaskWithURLCompletionHandler completionHandler) {
         NSData *jsonData = [@"JUNK" dataUsingEncoding:NSUTF8StringEncoding];
         NSHTTPURLResponse *jsonResponse =
-            [[NSHTTPURLResponse alloc] initWithURL:url
+            [[NSHTTPURLResponse alloc] initWithURL:request.URL
                                         statusCode:200
                                        HTTPVersion:@"1.1"
                                       headerFields:nil];
@@ -339,9 +408,9 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
         return nil;
       };
 
-  [self replaceInstanceMethodForClass:[NSURLSession class]
-                             selector:@selector(dataTaskWithURL:completionHandler:)
-                            withBlock:successfulResponse];
+  [self replaceClassMethodForClass:[SCTKResponseReader class]
+       selector:@selector(taskWithTransport:request:endpoint:completionHandler:)
+      withBlock:successfulResponse];
 
   NSURL *url = [NSURL URLWithString:kInitializerTestDiscoveryEndpoint];
 
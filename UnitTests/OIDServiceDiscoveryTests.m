@@ -81,6 +81,8 @@ static NSString *const kUserinfoEndpointKey = @"userinfo_endpoint";
 static NSString *const kJWKSURLKey = @"jwks_uri";
 static NSString *const kRegistrationEndpointKey = @"registration_endpoint";
 static NSString *const kEndSessionEndpointKey = @"end_session_endpoint";
+static NSString *const kRevocationEndpointKey = @"revocation_endpoint";
+static NSString *const kIntrospectionEndpointKey = @"introspection_endpoint";
 static NSString *const kScopesSupportedKey = @"scopes_supported";
 static NSString *const kResponseTypesSupportedKey = @"response_types_supported";
 static NSString *const kResponseModesSupportedKey = @"response_modes_supported";
@@ -643,6 +645,8 @@ TestURLFieldBackedBy(userinfoEndpoint, kUserinfoEndpointKey, kTestURL)
 TestURLFieldBackedBy(jwksURL, kJWKSURLKey, kTestURL)
 TestURLFieldBackedBy(registrationEndpoint, kRegistrationEndpointKey, kTestURL)
 TestURLFieldBackedBy(endSessionEndpoint, kEndSessionEndpointKey, kTestURL)
+TestURLFieldBackedBy(revocationEndpoint, kRevocationEndpointKey, kTestURL)
+TestURLFieldBackedBy(introspectionEndpoint, kIntrospectionEndpointKey, kTestURL)
 TestFieldBackedBy(scopesSupported, kScopesSupportedKey, @"Scopes Supported")
 TestFieldBackedBy(responseTypesSupported, kResponseTypesSupportedKey, @"Response Types Supported")
 TestFieldBackedBy(responseModesSupported, kResponseModesSupportedKey, @"Response Modes Supported")
@@ -208,6 +208,19 @@ static NSString *const kTestAdditionalParameterValue = @"example_value";
                         kTestAdditionalParameterValue, @"");
 }
 
+/*! @brief Tests that the access token expiry is counted from the request date when one is given.
+ */
+- (void)testExpirationDateAnchoredToRequestDate {
+  NSDate *requestDate = [NSDate dateWithTimeIntervalSinceNow:-30];
+  SCTKTokenResponse *response =
+      [[SCTKTokenResponse alloc] initWithRequest:[OIDTokenRequestTests testInstance]
+                                      parameters:@{ @"access_token" : @"abc123",
+                                                    @"expires_in" : @(3600) }
+                                     requestDate:requestDate];
+  XCTAssertEqualObjects(response.accessTokenExpirationDate,
+                        [requestDate dateByAddingTimeInterval:3600], @"");
+}
+
 @end
 
 #pragma GCC diagnostic pop
@@ -18,6 +18,7 @@
 
 #import <XCTest/XCTest.h>
 #import "SCTKURLSessionProvider.h"
+#import "SCTKURLSessionTransport.h"
 
 @interface OIDURLSessionProviderTests : XCTestCase
 
@@ -30,6 +31,7 @@
 - (void)tearDown {
     // Setting the session back to default sharedSession for future test cases
     [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+    [SCTKURLSessionProvider setConfiguration:nil forProfile:SCTKURLSessionProfileToken];
 }
 
 - (void)testCustomSession {
@@ -40,4 +42,65 @@
     XCTAssertEqualObjects(session, customSession);
 }
 
+- (void)testCustomSessionIsUsedForEveryProfile {
+    NSURLSessionConfiguration *config = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    NSURLSession *customSession = [NSURLSession sessionWithConfiguration:config];
+    [SCTKURLSessionProvider setSession:customSession];
+    XCTAssertEqual([SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileToken],
+                   customSession);
+    XCTAssertEqual([SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileDiscovery],
+                   customSession);
+    XCTAssertEqual([SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileRegistration],
+                   customSession);
+}
+
+- (void)testProfilesHaveSeparateSessions {
+    [SCTKURLSessionProvider setSession:nil];
+    XCTAssertEqual([SCTKURLSessionProvider session], [NSURLSession sharedSession]);
+    NSURLSession *tokenSession =
+        [SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileToken];
+    NSURLSession *discoverySession =
+        [SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileDiscovery];
+    XCTAssertNotEqual(tokenSession, discoverySession);
+    XCTAssertNotEqual(tokenSession, [NSURLSession sharedSession]);
+    XCTAssertEqual([SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileToken],
+                   tokenSession);
+
+    NSURLSessionConfiguration *tokenConfiguration = tokenSession.configuration;
+    XCTAssertNil(tokenConfiguration.URLCache);
+    XCTAssertFalse(tokenConfiguration.HTTPShouldSetCookies);
+    XCTAssertEqual(tokenConfiguration.HTTPCookieAcceptPolicy, NSHTTPCookieAcceptPolicyNever);
+    XCTAssertEqual(tokenConfiguration.HTTPMaximumConnectionsPerHost, 4);
+    XCTAssertNotNil(discoverySession.configuration.URLCache);
+    XCTAssertEqual(discoverySession.configuration.HTTPMaximumConnectionsPerHost, 2);
+}
+
+- (void)testSetConfiguration {
+    [SCTKURLSessionProvider setSession:nil];
+    NSURLSession *defaultSession =
+        [SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileToken];
+    NSURLSessionConfiguration *configuration =
+        [SCTKURLSessionProvider defaultConfigurationForProfile:SCTKURLSessionProfileToken];
+    configuration.HTTPMaximumConnectionsPerHost = 8;
+    [SCTKURLSessionProvider setConfiguration:configuration forProfile:SCTKURLSessionProfileToken];
+
+    NSURLSession *session = [SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileToken];
+    XCTAssertNotEqual(session, defaultSession);
+    XCTAssertEqual(session.configuration.HTTPMaximumConnectionsPerHost, 8);
+
+    [SCTKURLSessionProvider setConfiguration:nil forProfile:SCTKURLSessionProfileToken];
+    session = [SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileToken];
+    XCTAssertEqual(session.configuration.HTTPMaximumConnectionsPerHost, 4);
+}
+
+- (void)testTransportForProfile {
+    [SCTKURLSessionProvider setSession:nil];
+    SCTKURLSessionTransport *transport = (SCTKURLSessionTransport *)
+        [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileDiscovery];
+    XCTAssertEqual(transport.session,
+                   [SCTKURLSessionProvider sessionForProfile:SCTKURLSessionProfileDiscovery]);
+    XCTAssertEqual([SCTKURLSessionProvider transport],
+                   [SCTKURLSessionProvider transportForProfile:SCTKURLSessionProfileToken]);
+}
+
 @end
@@ -0,0 +1,182 @@
+/*! @file SCTKAuthStateBatchRefresherTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDAuthorizationResponseTests.h"
+#import "OIDTokenRequestTests.h"
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthStateBatchRefresher.h"
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKAuthStateBatchRefresher.
+ */
+@interface SCTKAuthStateBatchRefresherTests : XCTestCase
+@end
+
+@implementation SCTKAuthStateBatchRefresherTests
+
+- (void)setUp {
+  [super setUp];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+}
+
+- (void)tearDown {
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+  [super tearDown];
+}
+
+/*! @brief Returns an auth state whose access token expires after the given number of seconds.
+ */
++ (SCTKAuthState *)authStateExpiringIn:(NSInteger)expiresIn {
+  return [self authStateExpiringIn:expiresIn refreshToken:@"refresh123"];
+}
+
+/*! @brief Returns an auth state with the given refresh token, whose access token expires after
+        the given number of seconds.
+ */
++ (SCTKAuthState *)authStateExpiringIn:(NSInteger)expiresIn refreshToken:(NSString *)refreshToken {
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:[OIDTokenRequestTests testInstance]
+                                      parameters:@{
+                                        @"access_token" : @"abc123",
+                                        @"expires_in" : @(expiresIn),
+                                        @"refresh_token" : refreshToken,
+                                      }];
+  return [[SCTKAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]
+                      tokenResponse:tokenResponse];
+}
+
+/*! @brief Makes the token endpoint issue a new access token for every request.
+ */
++ (void)respondWithNewTokens {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"access_token" : @"new123",
+                                                         @"token_type" : @"Bearer",
+                                                         @"expires_in" : @3600}];
+  }];
+}
+
+/*! @brief Tests that an empty batch completes straight away.
+ */
+- (void)testEmptyBatch {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"batch completed"];
+  SCTKAuthStateBatchRefresher *refresher = [[SCTKAuthStateBatchRefresher alloc] init];
+  [refresher refreshAuthStates:@[]
+                      progress:^(NSUInteger completedCount, NSUInteger totalCount) {
+    XCTFail(@"An empty batch has no progress to report.");
+  }
+                    completion:^(NSDictionary<NSNumber *, NSError *> *errors) {
+    XCTAssertEqual(errors.count, 0u);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/*! @brief Tests that only the auth states that need it are refreshed, and that progress is
+        reported for each of them.
+ */
+- (void)testRefreshesExpiredAuthStates {
+  [[self class] respondWithNewTokens];
+  NSArray<SCTKAuthState *> *authStates = @[
+    [[self class] authStateExpiringIn:3600],
+    [[self class] authStateExpiringIn:-10],
+    [[self class] authStateExpiringIn:3600],
+  ];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"batch completed"];
+  NSMutableArray<NSNumber *> *progressReports = [NSMutableArray array];
+  SCTKAuthStateBatchRefresher *refresher = [[SCTKAuthStateBatchRefresher alloc] init];
+  [refresher refreshAuthStates:authStates
+                      progress:^(NSUInteger completedCount, NSUInteger totalCount) {
+    XCTAssertEqual(totalCount, 3u);
+    [progressReports addObject:@(completedCount)];
+  }
+                    completion:^(NSDictionary<NSNumber *, NSError *> *errors) {
+    XCTAssertEqual(errors.count, 0u);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertEqualObjects(progressReports, (@[@1, @2, @3]));
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+  XCTAssertEqualObjects(authStates[1].tokenSnapshot.accessToken, @"new123");
+}
+
+/*! @brief Tests that no more than the maximum number of refreshes run at once against a token
+        endpoint, and that the queued auth states are refreshed as the running ones complete.
+ */
+- (void)testLimitsConcurrentRefreshesPerEndpoint {
+  // the token endpoint never responds, so the first refreshes stay in progress
+  [SCTKTestURLProtocol setHandler:nil];
+  NSMutableArray<SCTKAuthState *> *authStates = [NSMutableArray array];
+  // distinct refresh tokens, as identical token requests in flight would share one request
+  for (NSUInteger i = 0; i < 6; i++) {
+    NSString *refreshToken = [NSString stringWithFormat:@"refresh%lu", (unsigned long)i];
+    [authStates addObject:[[self class] authStateExpiringIn:-10 refreshToken:refreshToken]];
+  }
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"batch completed"];
+  SCTKAuthStateBatchRefresher *refresher =
+      [[SCTKAuthStateBatchRefresher alloc] initWithMaximumConcurrentRefreshes:2];
+  [refresher refreshAuthStates:authStates
+                      progress:nil
+                    completion:^(NSDictionary<NSNumber *, NSError *> *errors) {
+    XCTAssertEqual(errors.count, 2u);
+    for (NSError *error in errors.allValues) {
+      XCTAssertEqual(error.code, SCTKErrorCodeTokenRefreshCancelledError);
+    }
+    [expectation fulfill];
+  }];
+
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+    XCTAssertEqual([SCTKTestURLProtocol requestCount], 2u);
+    // lets the queued auth states through, and gives up on the two stuck ones
+    NSPredicate *refreshing = [NSPredicate predicateWithFormat:@"pendingActionCount > 0"];
+    NSArray<SCTKAuthState *> *stuckAuthStates =
+        [authStates filteredArrayUsingPredicate:refreshing];
+    XCTAssertEqual(stuckAuthStates.count, 2u);
+    [[self class] respondWithNewTokens];
+    for (SCTKAuthState *authState in stuckAuthStates) {
+      [authState cancelTokenRefresh];
+    }
+  });
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 4u);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,297 @@
+/*! @file SCTKAuthStateCodecTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDAuthorizationResponseTests.h"
+#import "SCTKAuthStateTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthorizationResponse.h"
+#import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthStateCodec.h"
+#import "Sources/AppAuthCore/SCTKAuthorizationRequest.h"
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKServiceConfiguration.h"
+#import "Sources/AppAuthCore/SCTKTokenRequest.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Number of auth states encoded or decoded by each iteration of the benchmarks.
+ */
+static const NSUInteger kBenchmarkAuthStateCount = 500;
+
+/*! @brief Unit tests and benchmarks for @c SCTKAuthStateCodec.
+ */
+@interface SCTKAuthStateCodecTests : XCTestCase
+@end
+
+@implementation SCTKAuthStateCodecTests
+
+/*! @brief Returns an auth state whose token response was exchanged from its authorization
+        response, so that both share a single @c SCTKServiceConfiguration.
+ */
++ (SCTKAuthState *)sharedConfigurationInstance {
+  SCTKAuthorizationResponse *authorizationResponse =
+      [OIDAuthorizationResponseTests testInstanceCodeFlow];
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:[authorizationResponse tokenExchangeRequest]
+                                      parameters:@{
+                                        @"access_token" : @"abc123",
+                                        @"expires_in" : @(3600),
+                                        @"refresh_token" : @"refresh123",
+                                      }];
+  return [[SCTKAuthState alloc] initWithAuthorizationResponse:authorizationResponse
+                                                tokenResponse:tokenResponse];
+}
+
+/*! @brief Archives an object with @c NSKeyedArchiver.
+ */
++ (NSData *)keyedArchiveWithRootObject:(id<NSSecureCoding>)rootObject {
+  NSData *data;
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    data = [NSKeyedArchiver archivedDataWithRootObject:rootObject
+                                 requiringSecureCoding:YES
+                                                 error:nil];
+  } else {
+#if !TARGET_OS_IOS
+    data = [NSKeyedArchiver archivedDataWithRootObject:rootObject];
+#endif
+  }
+  return data;
+}
+
+/*! @brief Tests that an auth state survives a round trip through the codec.
+ */
+- (void)testRoundTrip {
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  NSError *error;
+  NSData *data = [SCTKAuthStateCodec dataWithRootObject:authState error:&error];
+  XCTAssertNotNil(data);
+  XCTAssertNil(error);
+  XCTAssertTrue([SCTKAuthStateCodec isCodecData:data]);
+
+  SCTKAuthState *authStateCopy = [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                                          fromData:data
+                                                             error:&error];
+  XCTAssertNotNil(authStateCopy);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(authStateCopy.refreshToken, authState.refreshToken);
+  XCTAssertEqualObjects(authStateCopy.scope, authState.scope);
+  XCTAssertEqual(authStateCopy.isAuthorized, authState.isAuthorized);
+  XCTAssertEqualObjects(authStateCopy.lastAuthorizationResponse.authorizationCode,
+                        authState.lastAuthorizationResponse.authorizationCode);
+  XCTAssertEqualObjects(authStateCopy.lastTokenResponse.accessToken,
+                        authState.lastTokenResponse.accessToken);
+  XCTAssertEqualObjects(authStateCopy.lastTokenResponse.accessTokenExpirationDate,
+                        authState.lastTokenResponse.accessTokenExpirationDate);
+  XCTAssertEqualObjects(authStateCopy.lastTokenResponse.request.configuration.tokenEndpoint,
+                        authState.lastTokenResponse.request.configuration.tokenEndpoint);
+}
+
+/*! @brief Tests that the access token expiration date survives a round trip through the codec,
+        and that the values encoded after it are still read.
+ */
+- (void)testRoundTripExpirationDate {
+  SCTKAuthState *authState = [[self class] sharedConfigurationInstance];
+  NSDate *expirationDate = authState.lastTokenResponse.accessTokenExpirationDate;
+  XCTAssertNotNil(expirationDate);
+
+  NSError *error;
+  NSData *data = [SCTKAuthStateCodec dataWithRootObject:authState error:&error];
+  XCTAssertNotNil(data);
+  SCTKAuthState *authStateCopy = [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                                          fromData:data
+                                                             error:&error];
+  XCTAssertNotNil(authStateCopy);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(authStateCopy.lastTokenResponse.accessTokenExpirationDate, expirationDate);
+  XCTAssertEqualObjects(authStateCopy.lastTokenResponse.accessToken, @"abc123");
+  XCTAssertEqualObjects(authStateCopy.refreshToken, @"refresh123");
+}
+
+/*! @brief Tests that the error of an auth state survives a round trip through the codec.
+ */
+- (void)testRoundTripAuthorizationError {
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  NSError *oauthError = [NSError errorWithDomain:SCTKOAuthTokenErrorDomain
+                                            code:SCTKErrorCodeOAuthInvalidGrant
+                                        userInfo:nil];
+  [authState updateWithTokenResponse:nil error:oauthError];
+
+  NSData *data = [SCTKAuthStateCodec dataWithRootObject:authState error:nil];
+  SCTKAuthState *authStateCopy = [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                                          fromData:data
+                                                             error:nil];
+  XCTAssertEqualObjects(authStateCopy.authorizationError.domain, SCTKOAuthTokenErrorDomain);
+  XCTAssertEqual(authStateCopy.authorizationError.code, SCTKErrorCodeOAuthInvalidGrant);
+  XCTAssertFalse(authStateCopy.isAuthorized);
+}
+
+/*! @brief Tests that an object referenced twice in the graph is written once and decoded as a
+        single instance.
+ */
+- (void)testSharedObjectsDecodeAsOneInstance {
+  SCTKAuthState *authState = [[self class] sharedConfigurationInstance];
+  XCTAssertEqual(authState.lastAuthorizationResponse.request.configuration,
+                 authState.lastTokenResponse.request.configuration);
+
+  NSData *data = [SCTKAuthStateCodec dataWithRootObject:authState error:nil];
+  SCTKAuthState *authStateCopy = [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                                          fromData:data
+                                                             error:nil];
+  XCTAssertNotNil(authStateCopy.lastAuthorizationResponse.request.configuration);
+  XCTAssertEqual(authStateCopy.lastAuthorizationResponse.request.configuration,
+                 authStateCopy.lastTokenResponse.request.configuration);
+}
+
+/*! @brief Tests that the codec output is smaller than the equivalent keyed archive.
+ */
+- (void)testSmallerThanKeyedArchive {
+  SCTKAuthState *authState = [[self class] sharedConfigurationInstance];
+  NSData *keyedArchive = [[self class] keyedArchiveWithRootObject:authState];
+  NSData *data = [SCTKAuthStateCodec dataWithRootObject:authState error:nil];
+  XCTAssertLessThan(data.length, keyedArchive.length);
+}
+
+/*! @brief Tests that a keyed archive can be read directly, and migrated to the codec's format.
+ */
+- (void)testMigratesKeyedArchive {
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  NSData *keyedArchive = [[self class] keyedArchiveWithRootObject:authState];
+  XCTAssertTrue([SCTKAuthStateCodec isKeyedArchiveData:keyedArchive]);
+  XCTAssertFalse([SCTKAuthStateCodec isCodecData:keyedArchive]);
+
+  SCTKAuthState *unarchived = [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                                       fromData:keyedArchive
+                                                          error:nil];
+  XCTAssertEqualObjects(unarchived.refreshToken, authState.refreshToken);
+
+  NSError *error;
+  NSData *migrated = [SCTKAuthStateCodec migratedDataWithData:keyedArchive
+                                                      ofClass:[SCTKAuthState class]
+                                                        error:&error];
+  XCTAssertNil(error);
+  XCTAssertTrue([SCTKAuthStateCodec isCodecData:migrated]);
+  SCTKAuthState *decoded = [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                                    fromData:migrated
+                                                       error:nil];
+  XCTAssertEqualObjects(decoded.refreshToken, authState.refreshToken);
+
+  // data already in the codec's format is returned as is
+  XCTAssertEqual([SCTKAuthStateCodec migratedDataWithData:migrated
+                                                  ofClass:[SCTKAuthState class]
+                                                    error:nil],
+                 migrated);
+}
+
+/*! @brief Tests that decoding fails when the root object is not of the expected class.
+ */
+- (void)testRejectsUnexpectedClass {
+  NSData *data = [SCTKAuthStateCodec dataWithRootObject:[SCTKAuthStateTests testInstance]
+                                                  error:nil];
+  NSError *error;
+  id object = [SCTKAuthStateCodec objectOfClass:[SCTKTokenResponse class]
+                                       fromData:data
+                                          error:&error];
+  XCTAssertNil(object);
+  XCTAssertEqualObjects(error.domain, SCTKGeneralErrorDomain);
+  XCTAssertEqual(error.code, SCTKErrorCodeArchiveError);
+}
+
+/*! @brief Tests that truncated data, and data from a newer format version, fail to decode.
+ */
+- (void)testRejectsInvalidData {
+  NSData *data = [SCTKAuthStateCodec dataWithRootObject:[SCTKAuthStateTests testInstance]
+                                                  error:nil];
+  for (NSUInteger length = 0; length < data.length; length += 7) {
+    NSError *error;
+    id object = [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                         fromData:[data subdataWithRange:NSMakeRange(0, length)]
+                                            error:&error];
+    XCTAssertNil(object);
+    XCTAssertEqual(error.code, SCTKErrorCodeArchiveError);
+  }
+
+  NSMutableData *futureData = [data mutableCopy];
+  ((uint8_t *)futureData.mutableBytes)[4] = SCTKAuthStateCodecFormatVersion + 1;
+  NSError *error;
+  XCTAssertNil([SCTKAuthStateCodec objectOfClass:[SCTKAuthState class]
+                                        fromData:futureData
+                                           error:&error]);
+  XCTAssertEqual(error.code, SCTKErrorCodeArchiveError);
+}
+
+#pragma mark - Benchmarks
+
+/*! @brief Measures encoding auth states with the codec.
+ */
+- (void)testEncodePerformance {
+  SCTKAuthState *authState = [[self class] sharedConfigurationInstance];
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < kBenchmarkAuthStateCount; i++) {
+      [SCTKAuthStateCodec dataWithRootObject:authState error:nil];
+    }
+  }];
+}
+
+/*! @brief Measures encoding auth states with @c NSKeyedArchiver, for comparison.
+ */
+- (void)testKeyedArchiverEncodePerformance {
+  SCTKAuthState *authState = [[self class] sharedConfigurationInstance];
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < kBenchmarkAuthStateCount; i++) {
+      [[self class] keyedArchiveWithRootObject:authState];
+    }
+  }];
+}
+
+/*! @brief Measures decoding auth states with the codec.
+ */
+- (void)testDecodePerformance {
+  NSData *data = [SCTKAuthStateCodec dataWithRootObject:[[self class] sharedConfigurationInstance]
+                                                  error:nil];
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < kBenchmarkAuthStateCount; i++) {
+      [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class] fromData:data error:nil];
+    }
+  }];
+}
+
+/*! @brief Measures decoding auth states with @c NSKeyedUnarchiver, for comparison.
+ */
+- (void)testKeyedUnarchiverDecodePerformance {
+  SCTKAuthState *authState = [[self class] sharedConfigurationInstance];
+  NSData *data = [[self class] keyedArchiveWithRootObject:authState];
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < kBenchmarkAuthStateCount; i++) {
+      [SCTKAuthStateCodec objectOfClass:[SCTKAuthState class] fromData:data error:nil];
+    }
+  }];
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,217 @@
+/*! @file SCTKAuthStateJournalStoreTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "SCTKAuthStateTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthStateJournalStore.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKAuthStateJournalStore.
+ */
+@interface SCTKAuthStateJournalStoreTests : XCTestCase
+@end
+
+@implementation SCTKAuthStateJournalStoreTests {
+  /*! @brief The journal file used by the test.
+   */
+  NSURL *_fileURL;
+}
+
+- (void)setUp {
+  [super setUp];
+  NSString *fileName = [NSString stringWithFormat:@"journal-%@", [NSUUID UUID].UUIDString];
+  NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:fileName];
+  _fileURL = [NSURL fileURLWithPath:path];
+}
+
+- (void)tearDown {
+  [[NSFileManager defaultManager] removeItemAtURL:_fileURL error:nil];
+  [super tearDown];
+}
+
+/*! @brief Opens the test's journal.
+ */
+- (SCTKAuthStateJournalStore *)openStore {
+  NSError *error;
+  SCTKAuthStateJournalStore *store = [[SCTKAuthStateJournalStore alloc] initWithFileURL:_fileURL
+                                                                                  error:&error];
+  XCTAssertNotNil(store);
+  XCTAssertNil(error);
+  return store;
+}
+
+/*! @brief Refreshes an auth state's tokens as a token endpoint would, rotating its refresh token.
+ */
++ (void)refreshAuthState:(SCTKAuthState *)authState
+             accessToken:(NSString *)accessToken
+            refreshToken:(NSString *)refreshToken {
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:[authState tokenRefreshRequest]
+                                      parameters:@{
+                                        @"access_token" : accessToken,
+                                        @"expires_in" : @(3600),
+                                        @"refresh_token" : refreshToken,
+                                      }];
+  [authState updateWithTokenResponse:tokenResponse error:nil];
+}
+
+/*! @brief Tests that stored and removed accounts are recovered when the journal is reopened.
+ */
+- (void)testStoreRemoveAndReopen {
+  SCTKAuthStateJournalStore *store = [self openStore];
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  [store storeAuthState:authState forAccountID:@"alice"];
+  [store storeAuthState:[SCTKAuthStateTests testInstance] forAccountID:@"bob"];
+  [store removeAuthStateForAccountID:@"bob"];
+  [store synchronize];
+  store = nil;
+
+  store = [self openStore];
+  XCTAssertEqualObjects(store.accountIDs, @[ @"alice" ]);
+  SCTKAuthState *recovered = [store authStateForAccountID:@"alice"];
+  XCTAssertEqualObjects(recovered.refreshToken, authState.refreshToken);
+  XCTAssertEqualObjects(recovered.lastTokenResponse.accessToken,
+                        authState.lastTokenResponse.accessToken);
+  XCTAssertNil([store authStateForAccountID:@"bob"]);
+}
+
+/*! @brief Tests that a token refresh appends a record much smaller than the full state, which is
+        replayed when the journal is reopened.
+ */
+- (void)testTokenUpdateAppendsSmallRecord {
+  SCTKAuthStateJournalStore *store = [self openStore];
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  unsigned long long emptyLength = store.fileLength;
+  [store storeAuthState:authState forAccountID:@"alice"];
+  unsigned long long stateRecordLength = store.fileLength - emptyLength;
+
+  [[self class] refreshAuthState:authState accessToken:@"access2" refreshToken:@"refresh2"];
+  [store recordTokenUpdateForAuthState:authState accountID:@"alice"];
+  unsigned long long tokenUpdateLength = store.fileLength - emptyLength - stateRecordLength;
+  XCTAssertGreaterThan(tokenUpdateLength, 0u);
+  XCTAssertLessThan(tokenUpdateLength * 2, stateRecordLength);
+
+  // unchanged tokens are not recorded again
+  [store recordTokenUpdateForAuthState:authState accountID:@"alice"];
+  XCTAssertEqual(store.fileLength, emptyLength + stateRecordLength + tokenUpdateLength);
+  store = nil;
+
+  store = [self openStore];
+  SCTKAuthState *recovered = [store authStateForAccountID:@"alice"];
+  XCTAssertEqualObjects(recovered.lastTokenResponse.accessToken, @"access2");
+  XCTAssertEqualObjects(recovered.refreshToken, @"refresh2");
+  XCTAssertEqualWithAccuracy(
+      recovered.lastTokenResponse.accessTokenExpirationDate.timeIntervalSinceReferenceDate,
+      authState.lastTokenResponse.accessTokenExpirationDate.timeIntervalSinceReferenceDate,
+      0.001);
+}
+
+/*! @brief Tests that a record torn by a crash is discarded, keeping the records before it.
+ */
+- (void)testRecoversFromTornRecord {
+  SCTKAuthStateJournalStore *store = [self openStore];
+  [store storeAuthState:[SCTKAuthStateTests testInstance] forAccountID:@"alice"];
+  [store synchronize];
+  unsigned long long validLength = store.fileLength;
+  store = nil;
+
+  NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingToURL:_fileURL error:nil];
+  [fileHandle seekToEndOfFile];
+  const uint8_t tornRecord[] = {0x40, 0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78, 0x53, 0x43};
+  [fileHandle writeData:[NSData dataWithBytes:tornRecord length:sizeof(tornRecord)]];
+  [fileHandle closeFile];
+
+  store = [self openStore];
+  XCTAssertEqual(store.fileLength, validLength);
+  XCTAssertNotNil([store authStateForAccountID:@"alice"]);
+
+  // new records are appended after the last valid one
+  [store storeAuthState:[SCTKAuthStateTests testInstance] forAccountID:@"bob"];
+  store = nil;
+  store = [self openStore];
+  XCTAssertEqual(store.accountIDs.count, 2u);
+}
+
+/*! @brief Tests that a complete record that cannot be decoded fails recovery, leaving the
+        journal as it is rather than truncating the records after it.
+ */
+- (void)testUndecodableRecordFailsRecovery {
+  SCTKAuthStateJournalStore *store = [self openStore];
+  [store storeAuthState:[SCTKAuthStateTests testInstance] forAccountID:@"alice"];
+  [store synchronize];
+  store = nil;
+
+  // a two byte payload "ab" with its valid CRC-32, which is not an encoded record
+  NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingToURL:_fileURL error:nil];
+  [fileHandle seekToEndOfFile];
+  const uint8_t record[] = {0x02, 0x00, 0x00, 0x00, 0x6d, 0x48, 0x83, 0x9e, 'a', 'b'};
+  [fileHandle writeData:[NSData dataWithBytes:record length:sizeof(record)]];
+  [fileHandle closeFile];
+  NSData *contents = [NSData dataWithContentsOfURL:_fileURL];
+
+  NSError *error;
+  store = [[SCTKAuthStateJournalStore alloc] initWithFileURL:_fileURL error:&error];
+  XCTAssertNil(store);
+  XCTAssertNotNil(error);
+  XCTAssertEqualObjects([NSData dataWithContentsOfURL:_fileURL], contents);
+}
+
+/*! @brief Tests that compaction drops superseded records and keeps the latest state.
+ */
+- (void)testCompaction {
+  SCTKAuthStateJournalStore *store = [self openStore];
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  [store storeAuthState:authState forAccountID:@"alice"];
+  for (NSUInteger i = 0; i < 20; i++) {
+    NSString *accessToken = [NSString stringWithFormat:@"access%lu", (unsigned long)i];
+    NSString *refreshToken = [NSString stringWithFormat:@"refresh%lu", (unsigned long)i];
+    [[self class] refreshAuthState:authState accessToken:accessToken refreshToken:refreshToken];
+    [store recordTokenUpdateForAuthState:authState accountID:@"alice"];
+  }
+  unsigned long long uncompactedLength = store.fileLength;
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"compacted"];
+  [store compactWithCompletion:^(BOOL succeeded) {
+    XCTAssertTrue(succeeded);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertLessThan(store.fileLength, uncompactedLength);
+  store = nil;
+
+  store = [self openStore];
+  SCTKAuthState *recovered = [store authStateForAccountID:@"alice"];
+  XCTAssertEqualObjects(recovered.lastTokenResponse.accessToken, @"access19");
+  XCTAssertEqualObjects(recovered.refreshToken, @"refresh19");
+}
+
+@end
+
+#pragma GCC diagnostic pop
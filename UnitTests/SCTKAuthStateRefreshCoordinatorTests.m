@@ -0,0 +1,214 @@
+/*! @file SCTKAuthStateRefreshCoordinatorTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDTokenRequestTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthStateRefreshCoordinator.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKAuthStateRefreshCoordinator.
+    @discussion Two coordinators on the same file stand in for two processes, as each opens the
+        file separately and so holds its own @c flock(2) lock.
+ */
+@interface SCTKAuthStateRefreshCoordinatorTests : XCTestCase
+@end
+
+@implementation SCTKAuthStateRefreshCoordinatorTests {
+  /*! @brief The record file used by the test.
+   */
+  NSURL *_fileURL;
+}
+
+- (void)setUp {
+  [super setUp];
+  NSString *fileName = [NSString stringWithFormat:@"%@.record", [NSUUID UUID].UUIDString];
+  NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:fileName];
+  _fileURL = [NSURL fileURLWithPath:path];
+}
+
+- (void)tearDown {
+  [[NSFileManager defaultManager] removeItemAtURL:_fileURL error:nil];
+  [super tearDown];
+}
+
+/*! @brief Returns a token response to share.
+ */
++ (SCTKTokenResponse *)tokenResponse {
+  return [[SCTKTokenResponse alloc] initWithRequest:[OIDTokenRequestTests testInstance]
+                                         parameters:@{
+                                           @"access_token" : @"shared123",
+                                           @"expires_in" : @(3600),
+                                           @"refresh_token" : @"rotated123",
+                                         }];
+}
+
+/*! @brief Tests that a token response released by one process is seen by the next.
+ */
+- (void)testSharesReleasedTokenResponse {
+  SCTKAuthStateRefreshCoordinator *first =
+      [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:_fileURL];
+  SCTKAuthStateRefreshCoordinator *second =
+      [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:_fileURL];
+
+  NSDate *obtainedDate = [NSDate dateWithTimeIntervalSinceReferenceDate:1000];
+  XCTestExpectation *firstExpectation = [self expectationWithDescription:@"first"];
+  [first performExclusivelyForAuthorizationKey:@"key"
+                                       onQueue:dispatch_get_main_queue()
+                                         block:^(SCTKTokenResponse *_Nullable sharedTokenResponse,
+                                                 NSDate *_Nullable sharedDate,
+                                                 SCTKAuthStateRefreshCoordinatorRelease release) {
+    XCTAssertNil(sharedTokenResponse);
+    XCTAssertNil(sharedDate);
+    release([[self class] tokenResponse], obtainedDate);
+    [firstExpectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+
+  XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second"];
+  [second performExclusivelyForAuthorizationKey:@"key"
+                                        onQueue:dispatch_get_main_queue()
+                                          block:^(SCTKTokenResponse *_Nullable sharedTokenResponse,
+                                                  NSDate *_Nullable sharedDate,
+                                                  SCTKAuthStateRefreshCoordinatorRelease release) {
+    XCTAssertEqualObjects(sharedTokenResponse.accessToken, @"shared123");
+    XCTAssertEqualObjects(sharedTokenResponse.refreshToken, @"rotated123");
+    XCTAssertEqualObjects(sharedDate, obtainedDate);
+    release(nil, nil);
+    [secondExpectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+/*! @brief Tests that a process waits while another is in the exclusive section.
+ */
+- (void)testWaitsForOtherProcess {
+  SCTKAuthStateRefreshCoordinator *first =
+      [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:_fileURL];
+  SCTKAuthStateRefreshCoordinator *second =
+      [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:_fileURL];
+
+  __block SCTKAuthStateRefreshCoordinatorRelease firstRelease;
+  XCTestExpectation *firstEntered = [self expectationWithDescription:@"first entered"];
+  [first performExclusivelyForAuthorizationKey:@"key"
+                                       onQueue:dispatch_get_main_queue()
+                                         block:^(SCTKTokenResponse *_Nullable sharedTokenResponse,
+                                                 NSDate *_Nullable sharedDate,
+                                                 SCTKAuthStateRefreshCoordinatorRelease release) {
+    firstRelease = release;
+    [firstEntered fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+
+  __block BOOL secondEntered = NO;
+  XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second entered"];
+  [second performExclusivelyForAuthorizationKey:@"key"
+                                        onQueue:dispatch_get_main_queue()
+                                          block:^(SCTKTokenResponse *_Nullable sharedTokenResponse,
+                                                  NSDate *_Nullable sharedDate,
+                                                  SCTKAuthStateRefreshCoordinatorRelease release) {
+    secondEntered = YES;
+    XCTAssertEqualObjects(sharedTokenResponse.accessToken, @"shared123");
+    release(nil, nil);
+    [secondExpectation fulfill];
+  }];
+
+  // gives the second coordinator time to enter, which it must not while the first holds the lock
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+  XCTAssertFalse(secondEntered);
+
+  firstRelease([[self class] tokenResponse], [NSDate date]);
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+/*! @brief Shares a token response under an authorization key and waits until it is written.
+ */
+- (void)shareTokenResponseWithCoordinator:(SCTKAuthStateRefreshCoordinator *)coordinator
+                         authorizationKey:(NSString *)authorizationKey {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"shared"];
+  SCTKAuthStateRefreshCoordinatorBlock block = ^(SCTKTokenResponse *_Nullable sharedTokenResponse,
+                                                 NSDate *_Nullable sharedDate,
+                                                 SCTKAuthStateRefreshCoordinatorRelease release) {
+    release([[self class] tokenResponse], [NSDate date]);
+    [expectation fulfill];
+  };
+  [coordinator performExclusivelyForAuthorizationKey:authorizationKey
+                                             onQueue:dispatch_get_main_queue()
+                                               block:block];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+/*! @brief Asserts that a coordinator sees no shared token response for an authorization key.
+ */
+- (void)assertNoSharedTokenResponseWithCoordinator:(SCTKAuthStateRefreshCoordinator *)coordinator
+                                  authorizationKey:(NSString *)authorizationKey {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"not shared"];
+  SCTKAuthStateRefreshCoordinatorBlock block = ^(SCTKTokenResponse *_Nullable sharedTokenResponse,
+                                                 NSDate *_Nullable sharedDate,
+                                                 SCTKAuthStateRefreshCoordinatorRelease release) {
+    XCTAssertNil(sharedTokenResponse);
+    XCTAssertNil(sharedDate);
+    release(nil, nil);
+    [expectation fulfill];
+  };
+  [coordinator performExclusivelyForAuthorizationKey:authorizationKey
+                                             onQueue:dispatch_get_main_queue()
+                                               block:block];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+/*! @brief Tests that a token response shared for one authorization is not seen by another.
+ */
+- (void)testIgnoresOtherAuthorization {
+  SCTKAuthStateRefreshCoordinator *first =
+      [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:_fileURL];
+  SCTKAuthStateRefreshCoordinator *second =
+      [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:_fileURL];
+
+  [self shareTokenResponseWithCoordinator:first authorizationKey:@"key"];
+  [self assertNoSharedTokenResponseWithCoordinator:second authorizationKey:@"other"];
+}
+
+/*! @brief Tests that a reset record no longer shares its token response.
+ */
+- (void)testResetRecord {
+  SCTKAuthStateRefreshCoordinator *first =
+      [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:_fileURL];
+  SCTKAuthStateRefreshCoordinator *second =
+      [[SCTKAuthStateRefreshCoordinator alloc] initWithFileURL:_fileURL];
+
+  [self shareTokenResponseWithCoordinator:first authorizationKey:@"key"];
+  [first resetRecord];
+  // the reset is queued on the first coordinator, so waiting on it orders the read after it
+  [self assertNoSharedTokenResponseWithCoordinator:first authorizationKey:@"key"];
+  [self assertNoSharedTokenResponseWithCoordinator:second authorizationKey:@"key"];
+}
+
+@end
+
+#pragma GCC diagnostic pop
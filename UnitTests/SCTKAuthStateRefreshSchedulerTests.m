@@ -0,0 +1,194 @@
+/*! @file SCTKAuthStateRefreshSchedulerTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDAuthorizationResponseTests.h"
+#import "OIDTokenRequestTests.h"
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthStateRefreshScheduler.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKAuthStateRefreshScheduler.
+ */
+@interface SCTKAuthStateRefreshSchedulerTests : XCTestCase
+@end
+
+@implementation SCTKAuthStateRefreshSchedulerTests
+
+/*! @brief Returns a token response whose access token expires after the given number of seconds.
+ */
++ (SCTKTokenResponse *)tokenResponseExpiringIn:(NSTimeInterval)expiresIn {
+  return [[SCTKTokenResponse alloc] initWithRequest:[OIDTokenRequestTests testInstance]
+                                         parameters:@{
+                                           @"access_token" : @"abc123",
+                                           @"expires_in" : @(expiresIn),
+                                           @"refresh_token" : @"refresh123",
+                                         }];
+}
+
+/*! @brief Returns an auth state whose access token expires in an hour.
+ */
++ (SCTKAuthState *)authStateExpiringInOneHour {
+  return [[SCTKAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]
+                      tokenResponse:[self tokenResponseExpiringIn:3600]];
+}
+
+/*! @brief Tests that a new scheduler is paused and has nothing registered.
+ */
+- (void)testPausedWhenEmpty {
+  SCTKAuthStateRefreshScheduler *scheduler = [[SCTKAuthStateRefreshScheduler alloc] init];
+  XCTAssertTrue(scheduler.isPaused);
+  XCTAssertEqual(scheduler.registeredCount, 0u);
+}
+
+/*! @brief Tests that the refresh is scheduled the lead time plus some jitter before expiry.
+ */
+- (void)testSchedulesWithinJitterWindow {
+  SCTKAuthStateRefreshScheduler *scheduler =
+      [[SCTKAuthStateRefreshScheduler alloc] initWithLeadTime:60 maximumJitter:30];
+  SCTKAuthState *authState = [[self class] authStateExpiringInOneHour];
+  NSDate *start = [NSDate date];
+  [scheduler registerAuthState:authState];
+
+  XCTAssertFalse(scheduler.isPaused);
+  XCTAssertEqual(scheduler.registeredCount, 1u);
+  NSDate *fireDate = [scheduler scheduledRefreshDateForAuthState:authState];
+  XCTAssertNotNil(fireDate);
+  NSTimeInterval delay = [fireDate timeIntervalSinceDate:start];
+  XCTAssertGreaterThanOrEqual(delay, 3600 - 60 - 30 - 1);
+  XCTAssertLessThanOrEqual(delay, 3600 - 60 + 1);
+}
+
+/*! @brief Tests that unregistering the last auth state pauses the scheduler.
+ */
+- (void)testUnregisterPauses {
+  SCTKAuthStateRefreshScheduler *scheduler = [[SCTKAuthStateRefreshScheduler alloc] init];
+  SCTKAuthState *authState = [[self class] authStateExpiringInOneHour];
+  [scheduler registerAuthState:authState];
+  XCTAssertFalse(scheduler.isPaused);
+
+  [scheduler unregisterAuthState:authState];
+  XCTAssertTrue(scheduler.isPaused);
+  XCTAssertEqual(scheduler.registeredCount, 0u);
+  XCTAssertNil([scheduler scheduledRefreshDateForAuthState:authState]);
+}
+
+/*! @brief Tests that an auth state refreshed by other means since it was scheduled is moved to its
+        new expiry when its old date comes, rather than refreshed again.
+ */
+- (void)testPostponesAuthStateRefreshedElsewhere {
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthStateRefreshScheduler *scheduler =
+      [[SCTKAuthStateRefreshScheduler alloc] initWithLeadTime:3599.8 maximumJitter:0];
+  SCTKAuthState *authState = [[self class] authStateExpiringInOneHour];
+  [scheduler registerAuthState:authState];
+
+  [authState updateWithTokenResponse:[[self class] tokenResponseExpiringIn:7200] error:nil];
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1]];
+
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 0u);
+  NSTimeInterval delay =
+      [[scheduler scheduledRefreshDateForAuthState:authState] timeIntervalSinceNow];
+  XCTAssertGreaterThan(delay, 3590);
+  XCTAssertLessThan(delay, 3601);
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that a proactive refresh keeps the scoped access tokens of the auth state.
+ */
+- (void)testRefreshKeepsScopedTokens {
+  __block NSUInteger tokensIssued = 0;
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    NSString *accessToken;
+    @synchronized(self) {
+      accessToken = [NSString stringWithFormat:@"token%lu", (unsigned long)++tokensIssued];
+    }
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"access_token" : accessToken,
+                                                         @"token_type" : @"Bearer",
+                                                         @"expires_in" : @3600}];
+  }];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  SCTKAuthState *authState = [[self class] authStateExpiringInOneHour];
+  NSMutableArray<NSString *> *scopedAccessTokens = [NSMutableArray array];
+  SCTKAuthStateAction action = ^(NSString *_Nullable accessToken,
+                                 NSString *_Nullable idToken,
+                                 NSError *_Nullable error) {
+    [scopedAccessTokens addObject:accessToken ?: @""];
+  };
+  [authState performActionWithFreshTokensForScopes:@[ @"read" ] resource:nil action:action];
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+  SCTKAuthStateRefreshScheduler *scheduler =
+      [[SCTKAuthStateRefreshScheduler alloc] initWithLeadTime:3599.8 maximumJitter:0];
+  [scheduler registerAuthState:authState];
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1]];
+  XCTAssertEqualObjects(authState.accessToken, @"token2");
+
+  [authState performActionWithFreshTokensForScopes:@[ @"read" ] resource:nil action:action];
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+  XCTAssertEqualObjects(scopedAccessTokens, (@[ @"token1", @"token1" ]));
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 2u);
+  [scheduler unregisterAuthState:authState];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests that the entries of deallocated auth states are dropped from the schedule when the
+        timer fires.
+ */
+- (void)testPrunesDeallocatedAuthStates {
+  SCTKAuthStateRefreshScheduler *scheduler =
+      [[SCTKAuthStateRefreshScheduler alloc] initWithLeadTime:3599.8 maximumJitter:0];
+  @autoreleasepool {
+    [scheduler registerAuthState:[[self class] authStateExpiringInOneHour]];
+  }
+  XCTAssertEqual(scheduler.registeredCount, 0u);
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1]];
+  XCTAssertTrue(scheduler.isPaused);
+
+  // an auth state without a refresh token is registered but never scheduled
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:[OIDTokenRequestTests testInstance]
+                                      parameters:@{@"access_token" : @"abc123"}];
+  SCTKAuthState *authState = [[SCTKAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]
+                      tokenResponse:tokenResponse];
+  [scheduler registerAuthState:authState];
+  XCTAssertEqual(scheduler.registeredCount, 1u);
+  XCTAssertTrue(scheduler.isPaused);
+}
+
+@end
+
+#pragma GCC diagnostic pop
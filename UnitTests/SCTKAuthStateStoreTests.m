@@ -0,0 +1,191 @@
+/*! @file SCTKAuthStateStoreTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "SCTKAuthStateTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthStateStore.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief An in-memory @c SCTKAuthStateBackingStore that records what it was given.
+ */
+@interface SCTKAuthStateStoreTestsBackingStore : NSObject <SCTKAuthStateBackingStore>
+
+/*! @brief The stored auth states, keyed by account identifier.
+ */
+@property(nonatomic, readonly) NSMutableDictionary<NSString *, SCTKAuthState *> *storedAuthStates;
+
+@end
+
+@implementation SCTKAuthStateStoreTestsBackingStore
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _storedAuthStates = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (nullable SCTKAuthState *)authStateForAccountID:(NSString *)accountID {
+  return _storedAuthStates[accountID];
+}
+
+- (void)storeAuthState:(SCTKAuthState *)authState forAccountID:(NSString *)accountID {
+  _storedAuthStates[accountID] = authState;
+}
+
+- (void)removeAuthStateForAccountID:(NSString *)accountID {
+  [_storedAuthStates removeObjectForKey:accountID];
+}
+
+@end
+
+/*! @brief Unit tests for @c SCTKAuthStateStore.
+ */
+@interface SCTKAuthStateStoreTests : XCTestCase
+@end
+
+@implementation SCTKAuthStateStoreTests
+
+/*! @brief Tests that a stored auth state can be looked up again.
+ */
+- (void)testSetAndLookup {
+  SCTKAuthStateStore *store = [[SCTKAuthStateStore alloc] initWithCapacity:10 backingStore:nil];
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  [store setAuthState:authState forAccountID:@"alice"];
+
+  XCTAssertEqual([store authStateForAccountID:@"alice"], authState);
+  XCTAssertNil([store authStateForAccountID:@"bob"]);
+  XCTAssertEqual(store.residentCount, 1u);
+}
+
+/*! @brief Tests that the least recently used auth state is evicted to the backing store, and
+        loaded back when it is next requested.
+ */
+- (void)testEvictsLeastRecentlyUsed {
+  SCTKAuthStateStoreTestsBackingStore *backingStore =
+      [[SCTKAuthStateStoreTestsBackingStore alloc] init];
+  SCTKAuthStateStore *store = [[SCTKAuthStateStore alloc] initWithCapacity:2
+                                                             backingStore:backingStore
+                                                          lockStripeCount:1];
+  SCTKAuthState *alice = [SCTKAuthStateTests testInstance];
+  SCTKAuthState *bob = [SCTKAuthStateTests testInstance];
+  SCTKAuthState *carol = [SCTKAuthStateTests testInstance];
+
+  [store setAuthState:alice forAccountID:@"alice"];
+  [store setAuthState:bob forAccountID:@"bob"];
+  // touches alice so that bob becomes the least recently used entry
+  XCTAssertEqual([store authStateForAccountID:@"alice"], alice);
+  [store setAuthState:carol forAccountID:@"carol"];
+
+  XCTAssertEqual(store.residentCount, 2u);
+  XCTAssertEqual(backingStore.storedAuthStates.count, 3u);
+  XCTAssertEqual(backingStore.storedAuthStates[@"bob"], bob);
+
+  // bob is loaded back from the backing store, evicting alice
+  XCTAssertEqual([store authStateForAccountID:@"bob"], bob);
+  XCTAssertEqual(store.residentCount, 2u);
+  XCTAssertEqual(backingStore.storedAuthStates[@"alice"], alice);
+}
+
+/*! @brief Tests that setting an auth state writes it through to the backing store.
+ */
+- (void)testSetWritesThrough {
+  SCTKAuthStateStoreTestsBackingStore *backingStore =
+      [[SCTKAuthStateStoreTestsBackingStore alloc] init];
+  SCTKAuthStateStore *store = [[SCTKAuthStateStore alloc] initWithCapacity:10
+                                                             backingStore:backingStore];
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  [store setAuthState:authState forAccountID:@"alice"];
+
+  XCTAssertEqual(backingStore.storedAuthStates[@"alice"], authState);
+}
+
+/*! @brief Tests that an evicted auth state still in use is made resident again instead of being
+        loaded from the backing store as a second instance.
+ */
+- (void)testReloadReturnsLiveInstance {
+  SCTKAuthStateStoreTestsBackingStore *backingStore =
+      [[SCTKAuthStateStoreTestsBackingStore alloc] init];
+  SCTKAuthStateStore *store = [[SCTKAuthStateStore alloc] initWithCapacity:1
+                                                             backingStore:backingStore
+                                                          lockStripeCount:1];
+  SCTKAuthState *alice = [SCTKAuthStateTests testInstance];
+  [store setAuthState:alice forAccountID:@"alice"];
+  [store setAuthState:[SCTKAuthStateTests testInstance] forAccountID:@"bob"];
+  // a real backing store would decode a new instance
+  backingStore.storedAuthStates[@"alice"] = [SCTKAuthStateTests testInstance];
+
+  XCTAssertEqual([store authStateForAccountID:@"alice"], alice);
+  XCTAssertEqual(store.residentCount, 1u);
+}
+
+/*! @brief Tests that bulk lookups return resident and backed accounts and omit unknown ones.
+ */
+- (void)testBulkLookup {
+  SCTKAuthStateStoreTestsBackingStore *backingStore =
+      [[SCTKAuthStateStoreTestsBackingStore alloc] init];
+  SCTKAuthState *backed = [SCTKAuthStateTests testInstance];
+  [backingStore storeAuthState:backed forAccountID:@"backed"];
+
+  SCTKAuthStateStore *store = [[SCTKAuthStateStore alloc] initWithCapacity:10
+                                                             backingStore:backingStore];
+  SCTKAuthState *resident = [SCTKAuthStateTests testInstance];
+  [store setAuthState:resident forAccountID:@"resident"];
+
+  NSDictionary<NSString *, SCTKAuthState *> *authStates =
+      [store authStatesForAccountIDs:@[ @"resident", @"backed", @"unknown" ]];
+  XCTAssertEqual(authStates.count, 2u);
+  XCTAssertEqual(authStates[@"resident"], resident);
+  XCTAssertEqual(authStates[@"backed"], backed);
+  XCTAssertNil(authStates[@"unknown"]);
+}
+
+/*! @brief Tests that removing an account removes it from memory and from the backing store, and
+        that flushing writes resident states through.
+ */
+- (void)testRemoveAndFlush {
+  SCTKAuthStateStoreTestsBackingStore *backingStore =
+      [[SCTKAuthStateStoreTestsBackingStore alloc] init];
+  SCTKAuthStateStore *store = [[SCTKAuthStateStore alloc] initWithCapacity:10
+                                                             backingStore:backingStore];
+  [store setAuthState:[SCTKAuthStateTests testInstance] forAccountID:@"alice"];
+  [store setAuthState:[SCTKAuthStateTests testInstance] forAccountID:@"bob"];
+  [store flush];
+  XCTAssertEqual(backingStore.storedAuthStates.count, 2u);
+
+  [store removeAuthStateForAccountID:@"alice"];
+  XCTAssertNil([store authStateForAccountID:@"alice"]);
+  XCTAssertNil(backingStore.storedAuthStates[@"alice"]);
+  XCTAssertEqual(store.residentCount, 1u);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,158 @@
+/*! @file SCTKAuthStateTokenSnapshotTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "SCTKAuthStateTests.h"
+#import "OIDTokenRequestTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthStateTokenSnapshot.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Number of token responses applied by the concurrent writer.
+ */
+static const NSUInteger kTokenResponseCount = 200;
+
+/*! @brief Number of snapshot reads performed by each concurrent reader.
+ */
+static const NSUInteger kReadsPerReader = 10000;
+
+/*! @brief Number of concurrent readers.
+ */
+static const size_t kReaderCount = 8;
+
+/*! @brief Unit tests for @c SCTKAuthStateTokenSnapshot.
+ */
+@interface SCTKAuthStateTokenSnapshotTests : XCTestCase
+@end
+
+@implementation SCTKAuthStateTokenSnapshotTests
+
+/*! @brief Returns token responses with distinct access tokens and expiration dates.
+ */
++ (NSArray<SCTKTokenResponse *> *)tokenResponses {
+  NSMutableArray<SCTKTokenResponse *> *tokenResponses =
+      [NSMutableArray arrayWithCapacity:kTokenResponseCount];
+  for (NSUInteger i = 0; i < kTokenResponseCount; i++) {
+    [tokenResponses addObject:[[SCTKTokenResponse alloc]
+        initWithRequest:[OIDTokenRequestTests testInstance]
+             parameters:@{
+               @"access_token" : [NSString stringWithFormat:@"token%lu", (unsigned long)i],
+               @"expires_in" : @(3600 + i * 60),
+             }]];
+  }
+  return tokenResponses;
+}
+
+/*! @brief Tests that the snapshot follows the token response and its generation increases.
+ */
+- (void)testSnapshotFollowsTokenResponse {
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  SCTKAuthStateTokenSnapshot *before = authState.tokenSnapshot;
+  XCTAssertNotNil(before);
+  NSString *originalAccessToken = authState.lastTokenResponse.accessToken;
+  XCTAssertEqualObjects(before.accessToken, originalAccessToken);
+
+  SCTKTokenResponse *tokenResponse = [[self class] tokenResponses].firstObject;
+  [authState updateWithTokenResponse:tokenResponse error:nil];
+
+  SCTKAuthStateTokenSnapshot *after = authState.tokenSnapshot;
+  XCTAssertNotEqual(before, after);
+  XCTAssertGreaterThan(after.generation, before.generation);
+  XCTAssertEqualObjects(after.accessToken, tokenResponse.accessToken);
+  XCTAssertEqualObjects(after.accessTokenExpirationDate, tokenResponse.accessTokenExpirationDate);
+  // the previous snapshot is unchanged
+  XCTAssertEqualObjects(before.accessToken, originalAccessToken);
+}
+
+/*! @brief Tests that readers never see an access token paired with another token's expiry while
+        the tokens are being replaced concurrently.
+ */
+- (void)testConcurrentReadsAreConsistent {
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  NSArray<SCTKTokenResponse *> *tokenResponses = [[self class] tokenResponses];
+  NSMutableDictionary<NSString *, NSDate *> *expirationDates = [NSMutableDictionary dictionary];
+  for (SCTKTokenResponse *tokenResponse in tokenResponses) {
+    expirationDates[tokenResponse.accessToken] = tokenResponse.accessTokenExpirationDate;
+  }
+
+  dispatch_group_t writer = dispatch_group_create();
+  dispatch_group_async(writer, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+    for (SCTKTokenResponse *tokenResponse in tokenResponses) {
+      [authState updateWithTokenResponse:tokenResponse error:nil];
+    }
+  });
+
+  __block BOOL consistent = YES;
+  dispatch_apply(kReaderCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+                 ^(size_t reader) {
+    uint64_t lastGeneration = 0;
+    for (NSUInteger i = 0; i < kReadsPerReader; i++) {
+      SCTKAuthStateTokenSnapshot *snapshot = authState.tokenSnapshot;
+      NSDate *expectedExpirationDate = expirationDates[snapshot.accessToken];
+      if ((expectedExpirationDate
+           && ![expectedExpirationDate isEqual:snapshot.accessTokenExpirationDate])
+          || snapshot.generation < lastGeneration) {
+        consistent = NO;
+      }
+      lastGeneration = snapshot.generation;
+    }
+  });
+  dispatch_group_wait(writer, DISPATCH_TIME_FOREVER);
+
+  XCTAssertTrue(consistent);
+  XCTAssertEqualObjects(authState.tokenSnapshot.accessToken, tokenResponses.lastObject.accessToken);
+}
+
+/*! @brief Measures snapshot read throughput of concurrent readers while the tokens are being
+        replaced.
+ */
+- (void)testConcurrentReadPerformance {
+  SCTKAuthState *authState = [SCTKAuthStateTests testInstance];
+  NSArray<SCTKTokenResponse *> *tokenResponses = [[self class] tokenResponses];
+
+  [self measureBlock:^{
+    dispatch_group_t writer = dispatch_group_create();
+    dispatch_group_async(writer, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+      for (SCTKTokenResponse *tokenResponse in tokenResponses) {
+        [authState updateWithTokenResponse:tokenResponse error:nil];
+      }
+    });
+    dispatch_apply(kReaderCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+                   ^(size_t reader) {
+      for (NSUInteger i = 0; i < kReadsPerReader; i++) {
+        (void)authState.tokenSnapshot.accessToken;
+      }
+    });
+    dispatch_group_wait(writer, DISPATCH_TIME_FOREVER);
+  }];
+}
+
+@end
+
+#pragma GCC diagnostic pop
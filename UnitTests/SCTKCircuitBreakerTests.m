@@ -0,0 +1,103 @@
+/*! @file SCTKCircuitBreakerTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKCircuitBreaker.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Test endpoint.
+ */
+static NSString *const kTestEndpoint = @"https://www.example.com/token";
+
+/*! @brief Another test endpoint.
+ */
+static NSString *const kOtherTestEndpoint = @"https://www.example.net/token";
+
+/*! @brief Unit tests for @c SCTKCircuitBreaker.
+ */
+@interface SCTKCircuitBreakerTests : XCTestCase
+@end
+
+@implementation SCTKCircuitBreakerTests
+
+/*! @brief Tests that a circuit opens after the failure threshold, for its endpoint only.
+ */
+- (void)testOpensAfterConsecutiveFailures {
+  NSURL *endpoint = [NSURL URLWithString:kTestEndpoint];
+  NSURL *otherEndpoint = [NSURL URLWithString:kOtherTestEndpoint];
+  SCTKCircuitBreaker *circuitBreaker =
+      [[SCTKCircuitBreaker alloc] initWithFailureThreshold:3 resetTimeout:60];
+
+  [circuitBreaker recordFailureForEndpoint:endpoint];
+  [circuitBreaker recordFailureForEndpoint:endpoint];
+  XCTAssertTrue([circuitBreaker shouldAllowRequestToEndpoint:endpoint]);
+  [circuitBreaker recordFailureForEndpoint:endpoint];
+
+  XCTAssertTrue([circuitBreaker isOpenForEndpoint:endpoint]);
+  XCTAssertFalse([circuitBreaker shouldAllowRequestToEndpoint:endpoint]);
+  XCTAssertFalse([circuitBreaker isOpenForEndpoint:otherEndpoint]);
+  XCTAssertTrue([circuitBreaker shouldAllowRequestToEndpoint:otherEndpoint]);
+}
+
+/*! @brief Tests that a success resets the count of consecutive failures.
+ */
+- (void)testSuccessResetsFailures {
+  NSURL *endpoint = [NSURL URLWithString:kTestEndpoint];
+  SCTKCircuitBreaker *circuitBreaker =
+      [[SCTKCircuitBreaker alloc] initWithFailureThreshold:2 resetTimeout:60];
+
+  [circuitBreaker recordFailureForEndpoint:endpoint];
+  [circuitBreaker recordSuccessForEndpoint:endpoint];
+  [circuitBreaker recordFailureForEndpoint:endpoint];
+  XCTAssertFalse([circuitBreaker isOpenForEndpoint:endpoint]);
+}
+
+/*! @brief Tests that once the reset timeout has passed, a single trial request is let through,
+        which closes the circuit if it succeeds and opens it again if it fails.
+ */
+- (void)testTrialRequestAfterResetTimeout {
+  NSURL *endpoint = [NSURL URLWithString:kTestEndpoint];
+  SCTKCircuitBreaker *circuitBreaker =
+      [[SCTKCircuitBreaker alloc] initWithFailureThreshold:1 resetTimeout:0];
+  [circuitBreaker recordFailureForEndpoint:endpoint];
+  XCTAssertTrue([circuitBreaker isOpenForEndpoint:endpoint]);
+
+  XCTAssertTrue([circuitBreaker shouldAllowRequestToEndpoint:endpoint]);
+  XCTAssertFalse([circuitBreaker shouldAllowRequestToEndpoint:endpoint]);
+  [circuitBreaker recordFailureForEndpoint:endpoint];
+  XCTAssertTrue([circuitBreaker isOpenForEndpoint:endpoint]);
+
+  XCTAssertTrue([circuitBreaker shouldAllowRequestToEndpoint:endpoint]);
+  [circuitBreaker recordSuccessForEndpoint:endpoint];
+  XCTAssertFalse([circuitBreaker isOpenForEndpoint:endpoint]);
+  XCTAssertTrue([circuitBreaker shouldAllowRequestToEndpoint:endpoint]);
+  XCTAssertTrue([circuitBreaker shouldAllowRequestToEndpoint:endpoint]);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,83 @@
+/*! @file SCTKClockSkewEstimatorTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKClockSkewEstimator.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKClockSkewEstimator.
+ */
+@interface SCTKClockSkewEstimatorTests : XCTestCase
+@end
+
+@implementation SCTKClockSkewEstimatorTests
+
+/*! @brief Tests parsing of the HTTP Date header.
+ */
+- (void)testDateFromHTTPDateHeader {
+  NSDate *date = [SCTKClockSkewEstimator dateFromHTTPDateHeader:@"Sun, 06 Nov 1994 08:49:37 GMT"];
+  XCTAssertEqualObjects(date, [NSDate dateWithTimeIntervalSince1970:784111777]);
+  XCTAssertNil([SCTKClockSkewEstimator dateFromHTTPDateHeader:@"yesterday"]);
+}
+
+/*! @brief Tests that a sample sets the skew of its issuer only.
+ */
+- (void)testRecordsSkewPerIssuer {
+  SCTKClockSkewEstimator *estimator = [[SCTKClockSkewEstimator alloc] init];
+  NSURL *issuer = [NSURL URLWithString:@"https://issuer.example.com"];
+  NSDate *requestDate = [NSDate date];
+  NSDate *responseDate = [requestDate dateByAddingTimeInterval:1];
+  // the server clock is two minutes ahead, and the header is truncated to the second
+  NSDate *serverDate = [requestDate dateByAddingTimeInterval:0.5 + 120];
+  serverDate = [NSDate dateWithTimeIntervalSince1970:floor(serverDate.timeIntervalSince1970)];
+
+  [estimator recordServerDate:serverDate
+                  requestDate:requestDate
+                 responseDate:responseDate
+                    forIssuer:issuer];
+
+  XCTAssertEqualWithAccuracy([estimator clockSkewForIssuer:issuer], 120, 1);
+  XCTAssertEqual([estimator clockSkewForIssuer:[NSURL URLWithString:@"https://other.example"]], 0);
+  XCTAssertEqual([estimator clockSkewForIssuer:nil], 0);
+}
+
+/*! @brief Tests that samples from slow round trips are ignored.
+ */
+- (void)testIgnoresSlowRoundTrips {
+  SCTKClockSkewEstimator *estimator = [[SCTKClockSkewEstimator alloc] init];
+  NSURL *issuer = [NSURL URLWithString:@"https://issuer.example.com"];
+  NSDate *requestDate = [NSDate date];
+  [estimator recordServerDate:[requestDate dateByAddingTimeInterval:600]
+                  requestDate:requestDate
+                 responseDate:[requestDate dateByAddingTimeInterval:60]
+                    forIssuer:issuer];
+  XCTAssertEqual([estimator clockSkewForIssuer:issuer], 0);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,132 @@
+/*! @file SCTKConnectionPrewarmerTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDServiceDiscoveryTests.h"
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKConnectionPrewarmer.h"
+#import "Sources/AppAuthCore/SCTKServiceConfiguration.h"
+#import "Sources/AppAuthCore/SCTKServiceDiscovery.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKConnectionPrewarmer.
+ */
+@interface SCTKConnectionPrewarmerTests : XCTestCase
+@end
+
+@implementation SCTKConnectionPrewarmerTests
+
+- (void)setUp {
+  [super setUp];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+}
+
+- (void)tearDown {
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+  [super tearDown];
+}
+
+/*! @brief Tests that authorization requests only prewarm when asked to.
+ */
+- (void)testPrewarmingDuringAuthorizationIsOptIn {
+  XCTAssertFalse([SCTKConnectionPrewarmer prewarmsDuringAuthorization]);
+}
+
+/*! @brief Tests that only the first URL of each origin is requested.
+ */
+- (void)testOneURLPerOrigin {
+  NSArray<NSURL *> *URLs = @[
+    [NSURL URLWithString:@"https://a.example.com/token"],
+    [NSURL URLWithString:@"https://A.example.com/userinfo"],
+    [NSURL URLWithString:@"https://b.example.com/jwks"],
+    [NSURL URLWithString:@"https://a.example.com:8443/token"],
+    [NSURL URLWithString:@"http://a.example.com/token"],
+  ];
+  SCTKConnectionPrewarmer *prewarmer = [[SCTKConnectionPrewarmer alloc] initWithURLs:URLs];
+  NSArray<NSURL *> *expectedURLs = @[ URLs[0], URLs[2], URLs[3], URLs[4] ];
+  XCTAssertEqualObjects(prewarmer.URLs, expectedURLs);
+}
+
+/*! @brief Tests that the token, userinfo and JWKS endpoints of a configuration are requested, the
+        JWKS endpoint even when it shares the origin of the token endpoint, as it is requested on
+        another session.
+ */
+- (void)testConfigurationEndpoints {
+  NSMutableDictionary *dictionary =
+      [[OIDServiceDiscoveryTests completeServiceDiscoveryDictionary] mutableCopy];
+  dictionary[@"token_endpoint"] = @"https://token.example.com/token";
+  dictionary[@"userinfo_endpoint"] = @"https://userinfo.example.com/userinfo";
+  dictionary[@"jwks_uri"] = @"https://token.example.com/jwks";
+  SCTKServiceDiscovery *discovery = [[SCTKServiceDiscovery alloc] initWithDictionary:dictionary
+                                                                               error:nil];
+  SCTKServiceConfiguration *configuration =
+      [[SCTKServiceConfiguration alloc] initWithDiscoveryDocument:discovery];
+
+  SCTKConnectionPrewarmer *prewarmer =
+      [[SCTKConnectionPrewarmer alloc] initWithConfiguration:configuration];
+  NSArray<NSURL *> *expectedURLs = @[
+    [NSURL URLWithString:@"https://token.example.com/token"],
+    [NSURL URLWithString:@"https://userinfo.example.com/userinfo"],
+    [NSURL URLWithString:@"https://token.example.com/jwks"],
+  ];
+  XCTAssertEqualObjects(prewarmer.URLs, expectedURLs);
+}
+
+/*! @brief Tests that starting sends a HEAD request to each origin.
+ */
+- (void)testStartSendsHeadRequests {
+  NSArray<NSURL *> *URLs = @[
+    [NSURL URLWithString:@"https://a.example.com/token"],
+    [NSURL URLWithString:@"https://b.example.com/userinfo"],
+  ];
+  NSMutableSet<NSURL *> *requestedURLs = [NSMutableSet set];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Both origins requested."];
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    XCTAssertEqualObjects(request.HTTPMethod, @"HEAD");
+    @synchronized(requestedURLs) {
+      [requestedURLs addObject:request.URL];
+      if (requestedURLs.count == URLs.count) {
+        [expectation fulfill];
+      }
+    }
+    return [SCTKTestURLResponse responseWithStatusCode:405 headers:nil data:nil];
+  }];
+
+  SCTKConnectionPrewarmer *prewarmer = [[SCTKConnectionPrewarmer alloc] initWithURLs:URLs];
+  prewarmer.keepAliveInterval = 60;
+  [prewarmer start];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  [prewarmer stop];
+  XCTAssertEqualObjects(requestedURLs, [NSSet setWithArray:URLs]);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,199 @@
+/*! @file SCTKIntrospectionCacheTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthorizationService.h"
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKIntrospectionCache.h"
+#import "Sources/AppAuthCore/SCTKIntrospectionRequest.h"
+#import "Sources/AppAuthCore/SCTKIntrospectionResponse.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The introspection endpoint in the tests.
+ */
+static NSString *const kIntrospectionEndpoint = @"https://www.example.com/introspect";
+
+/*! @brief Unit tests for @c SCTKIntrospectionCache and the introspection requests using it.
+ */
+@interface SCTKIntrospectionCacheTests : XCTestCase
+@end
+
+@implementation SCTKIntrospectionCacheTests
+
+- (void)setUp {
+  [super setUp];
+  [SCTKIntrospectionCache setSharedCache:[[SCTKIntrospectionCache alloc] init]];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+}
+
+- (void)tearDown {
+  [SCTKIntrospectionCache setSharedCache:nil];
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+  [super tearDown];
+}
+
+/*! @brief Returns an active response expiring after the given time.
+    @param expiresIn The time until the token expires.
+ */
++ (SCTKIntrospectionResponse *)activeResponseExpiringIn:(NSTimeInterval)expiresIn {
+  NSTimeInterval exp = [NSDate date].timeIntervalSince1970 + expiresIn;
+  return [[SCTKIntrospectionResponse alloc] initWithParameters:@{
+    @"active" : @YES,
+    @"exp" : @((long long)exp),
+  }];
+}
+
+/*! @brief Introspects a token and waits for the result.
+    @param token The token.
+    @param error Set to the error of the request.
+ */
+- (nullable SCTKIntrospectionResponse *)introspectToken:(NSString *)token
+                                                  error:(NSError **)error {
+  SCTKIntrospectionRequest *request =
+      [[SCTKIntrospectionRequest alloc]
+          initWithIntrospectionEndpoint:[NSURL URLWithString:kIntrospectionEndpoint]
+                                  token:token
+                          tokenTypeHint:nil
+                               clientID:@"resource"
+                           clientSecret:@"secret"
+                   additionalParameters:nil];
+  __block SCTKIntrospectionResponse *result;
+  __block NSError *resultError;
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Introspection completes."];
+  SCTKIntrospectionCallback callback = ^(SCTKIntrospectionResponse *_Nullable response,
+                                         NSError *_Nullable introspectionError) {
+    result = response;
+    resultError = introspectionError;
+    [expectation fulfill];
+  };
+  [SCTKAuthorizationService performIntrospectionRequest:request callback:callback];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  if (error) {
+    *error = resultError;
+  }
+  return result;
+}
+
+/*! @brief Tests that an active result is kept until the token expires, and no longer.
+ */
+- (void)testActiveResultKeptUntilExpiry {
+  SCTKIntrospectionCache *cache = [[SCTKIntrospectionCache alloc] init];
+  SCTKIntrospectionResponse *response = [[self class] activeResponseExpiringIn:60];
+  [cache storeResponse:response forToken:@"token"];
+  XCTAssertEqual([cache responseForToken:@"token"], response);
+
+  [cache storeResponse:[[self class] activeResponseExpiringIn:-1] forToken:@"expired"];
+  XCTAssertNil([cache responseForToken:@"expired"]);
+
+  cache.maximumTimeToLive = 0;
+  [cache storeResponse:response forToken:@"uncached"];
+  XCTAssertNil([cache responseForToken:@"uncached"]);
+}
+
+/*! @brief Tests that an inactive result is kept for the negative time to live only.
+ */
+- (void)testInactiveResultKeptBriefly {
+  SCTKIntrospectionCache *cache = [[SCTKIntrospectionCache alloc] init];
+  SCTKIntrospectionResponse *inactive =
+      [[SCTKIntrospectionResponse alloc] initWithParameters:@{@"active" : @NO}];
+  cache.negativeTimeToLive = 0.1;
+  [cache storeResponse:inactive forToken:@"token"];
+  XCTAssertEqual([cache responseForToken:@"token"], inactive);
+
+  [NSThread sleepForTimeInterval:0.2];
+  XCTAssertNil([cache responseForToken:@"token"]);
+
+  SCTKIntrospectionCacheStatistics *statistics = [cache statistics];
+  XCTAssertEqual(statistics.hitCount, 1u);
+  XCTAssertEqual(statistics.negativeHitCount, 1u);
+  XCTAssertEqual(statistics.missCount, 1u);
+  XCTAssertEqual(statistics.entryCount, 0u);
+}
+
+/*! @brief Tests that the least recently used result is dropped once the count limit is reached.
+ */
+- (void)testCountLimitEvictsLeastRecentlyUsed {
+  SCTKIntrospectionCache *cache = [[SCTKIntrospectionCache alloc] init];
+  cache.countLimit = 2;
+  SCTKIntrospectionResponse *response = [[self class] activeResponseExpiringIn:60];
+  [cache storeResponse:response forToken:@"a"];
+  [cache storeResponse:response forToken:@"b"];
+  XCTAssertNotNil([cache responseForToken:@"a"]);
+  [cache storeResponse:response forToken:@"c"];
+
+  XCTAssertNotNil([cache responseForToken:@"a"]);
+  XCTAssertNil([cache responseForToken:@"b"]);
+  XCTAssertNotNil([cache responseForToken:@"c"]);
+  SCTKIntrospectionCacheStatistics *statistics = [cache statistics];
+  XCTAssertEqual(statistics.evictionCount, 1u);
+  XCTAssertEqual(statistics.entryCount, 2u);
+  XCTAssertEqualWithAccuracy(statistics.hitRate, 0.75, 0.001);
+
+  [cache resetStatistics];
+  XCTAssertEqual([cache statistics].hitCount, 0u);
+  XCTAssertEqual([cache statistics].hitRate, 0.0);
+}
+
+/*! @brief Tests that a repeated introspection of a token is answered from the shared cache.
+ */
+- (void)testRepeatedIntrospectionIsCached {
+  long long exp = (long long)[NSDate date].timeIntervalSince1970 + 3600;
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"active" : @YES, @"exp" : @(exp)}];
+  }];
+
+  NSError *error;
+  SCTKIntrospectionResponse *response = [self introspectToken:@"token" error:&error];
+  XCTAssertNil(error);
+  XCTAssertTrue(response.active);
+  XCTAssertEqual([self introspectToken:@"token" error:NULL], response);
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+  XCTAssertEqual([[SCTKIntrospectionCache sharedCache] statistics].hitCount, 1u);
+}
+
+/*! @brief Tests that a response without an @c active member is an error, and is not cached.
+ */
+- (void)testInvalidResponse {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200 headers:nil JSON:@{@"scope" : @"read"}];
+  }];
+
+  NSError *error;
+  XCTAssertNil([self introspectToken:@"token" error:&error]);
+  XCTAssertEqual(error.code, SCTKErrorCodeJSONDeserializationError);
+  XCTAssertEqual([[SCTKIntrospectionCache sharedCache] statistics].entryCount, 0u);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,125 @@
+/*! @file SCTKIntrospectionResponseTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKIntrospectionRequest.h"
+#import "Sources/AppAuthCore/SCTKIntrospectionResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKIntrospectionRequest and @c SCTKIntrospectionResponse.
+ */
+@interface SCTKIntrospectionResponseTests : XCTestCase
+@end
+
+@implementation SCTKIntrospectionResponseTests
+
+/*! @brief Tests that the members of an active response are mapped to their properties.
+ */
+- (void)testActiveResponse {
+  SCTKIntrospectionResponse *response = [[SCTKIntrospectionResponse alloc] initWithParameters:@{
+    @"active" : @YES,
+    @"scope" : @"read write",
+    @"client_id" : @"client",
+    @"username" : @"jdoe",
+    @"token_type" : @"Bearer",
+    @"exp" : @1419356238,
+    @"iat" : @1419350238,
+    @"sub" : @"Z5O3upPC88QrAjx00dis",
+    @"aud" : @"https://protected.example.net/resource",
+    @"iss" : @"https://server.example.com/",
+    @"extension_field" : @"twenty-seven",
+  }];
+  XCTAssertTrue(response.active);
+  XCTAssertEqualObjects(response.scope, @"read write");
+  XCTAssertEqualObjects(response.clientID, @"client");
+  XCTAssertEqualObjects(response.username, @"jdoe");
+  XCTAssertEqualObjects(response.tokenType, @"Bearer");
+  XCTAssertEqualObjects(response.expirationDate, [NSDate dateWithTimeIntervalSince1970:1419356238]);
+  XCTAssertEqualObjects(response.issuedAt, [NSDate dateWithTimeIntervalSince1970:1419350238]);
+  XCTAssertEqualObjects(response.subject, @"Z5O3upPC88QrAjx00dis");
+  XCTAssertEqualObjects(response.audience, @[ @"https://protected.example.net/resource" ]);
+  XCTAssertEqualObjects(response.issuer, @"https://server.example.com/");
+  XCTAssertEqualObjects(response.additionalParameters, @{@"extension_field" : @"twenty-seven"});
+}
+
+/*! @brief Tests that an inactive response needs no other members, and that a response without a
+        boolean @c active member is rejected.
+ */
+- (void)testActiveMember {
+  SCTKIntrospectionResponse *response =
+      [[SCTKIntrospectionResponse alloc] initWithParameters:@{@"active" : @NO}];
+  XCTAssertNotNil(response);
+  XCTAssertFalse(response.active);
+  XCTAssertNil(response.expirationDate);
+
+  XCTAssertNil([[SCTKIntrospectionResponse alloc] initWithParameters:@{@"scope" : @"read"}]);
+  XCTAssertNil([[SCTKIntrospectionResponse alloc] initWithParameters:@{@"active" : @"true"}]);
+}
+
+/*! @brief Tests that a list of audiences is kept, and that one with other values is not mapped.
+ */
+- (void)testAudiences {
+  SCTKIntrospectionResponse *response = [[SCTKIntrospectionResponse alloc] initWithParameters:@{
+    @"active" : @YES,
+    @"aud" : @[ @"a", @"b" ],
+  }];
+  XCTAssertEqualObjects(response.audience, (@[ @"a", @"b" ]));
+
+  response = [[SCTKIntrospectionResponse alloc] initWithParameters:@{
+    @"active" : @YES,
+    @"aud" : @[ @"a", @1 ],
+  }];
+  XCTAssertNil(response.audience);
+  XCTAssertEqualObjects(response.additionalParameters[@"aud"], (@[ @"a", @1 ]));
+}
+
+/*! @brief Tests the body and authentication of an introspection request.
+ */
+- (void)testURLRequest {
+  NSURL *endpoint = [NSURL URLWithString:@"https://www.example.com/introspect"];
+  SCTKIntrospectionRequest *request =
+      [[SCTKIntrospectionRequest alloc] initWithIntrospectionEndpoint:endpoint
+                                                                token:@"mF_9.B5f-4.1JqM"
+                                                        tokenTypeHint:SCTKTokenTypeHintAccessToken
+                                                             clientID:@"resource"
+                                                         clientSecret:@"secret"
+                                                 additionalParameters:nil];
+  NSURLRequest *URLRequest = [request URLRequest];
+  XCTAssertEqualObjects(URLRequest.HTTPMethod, @"POST");
+  XCTAssertEqualObjects(URLRequest.URL, endpoint);
+  XCTAssertTrue([[URLRequest valueForHTTPHeaderField:@"Authorization"] hasPrefix:@"Basic "]);
+
+  NSString *body = [[NSString alloc] initWithData:URLRequest.HTTPBody
+                                         encoding:NSUTF8StringEncoding];
+  XCTAssertTrue([body containsString:@"token=mF_9.B5f-4.1JqM"]);
+  XCTAssertTrue([body containsString:@"token_type_hint=access_token"]);
+  XCTAssertFalse([body containsString:@"client_id"]);
+}
+
+@end
+
+#pragma GCC diagnostic pop
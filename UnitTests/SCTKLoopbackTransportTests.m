@@ -0,0 +1,275 @@
+/*! @file SCTKLoopbackTransportTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDTokenRequestTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthorizationService.h"
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKLoopbackTransport.h"
+#import "Sources/AppAuthCore/SCTKResponseReader.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The URL requested in the tests.
+ */
+static NSString *const kTestURL = @"https://www.example.com/token";
+
+/*! @brief The number of token requests per iteration of the benchmark.
+ */
+static const NSUInteger kBenchmarkTokenRequestCount = 200;
+
+/*! @brief Unit tests for @c SCTKLoopbackTransport, and the requests of
+        @c SCTKAuthorizationService sent through it.
+ */
+@interface SCTKLoopbackTransportTests : XCTestCase
+@end
+
+@implementation SCTKLoopbackTransportTests
+
+- (void)tearDown {
+  [SCTKURLSessionProvider setTransport:nil];
+  [super tearDown];
+}
+
+/*! @brief Returns a transport answering every request with a successful token response.
+ */
++ (SCTKLoopbackTransport *)tokenTransport {
+  NSDictionary *JSON = @{@"access_token" : @"new123",
+                         @"token_type" : @"Bearer",
+                         @"expires_in" : @3600};
+  NSData *body = [NSJSONSerialization dataWithJSONObject:JSON options:0 error:NULL];
+  return [SCTKLoopbackTransport transportWithStatusCode:200
+                                                headers:@{@"Content-Type" : @"application/json"}
+                                                   body:body];
+}
+
+/*! @brief Tests that the handlers of a request receive the answer of the handler, in order.
+ */
+- (void)testAnswersRequest {
+  NSData *body = [@"hello" dataUsingEncoding:NSUTF8StringEncoding];
+  SCTKLoopbackTransport *transport = [SCTKLoopbackTransport transportWithStatusCode:201
+                                                                            headers:nil
+                                                                               body:body];
+  NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:kTestURL]];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Request completed."];
+  __block NSURLResponse *receivedResponse;
+  NSMutableData *receivedBody = [NSMutableData data];
+  id<SCTKHTTPTransportTask> task =
+      [transport taskWithRequest:request
+                 responseHandler:^BOOL(NSURLResponse *response) {
+    XCTAssertNil(receivedResponse);
+    receivedResponse = response;
+    return YES;
+  }
+                     dataHandler:^BOOL(NSData *data) {
+    XCTAssertNotNil(receivedResponse);
+    [receivedBody appendData:data];
+    return YES;
+  }
+               completionHandler:^(NSError *_Nullable error) {
+    XCTAssertNil(error);
+    [expectation fulfill];
+  }];
+  XCTAssertEqual(transport.requestCount, 0u);
+  [task resume];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertEqual(((NSHTTPURLResponse *)receivedResponse).statusCode, 201);
+  XCTAssertEqualObjects(receivedResponse.URL, request.URL);
+  XCTAssertEqualObjects(receivedBody, body);
+  XCTAssertEqual(transport.requestCount, 1u);
+}
+
+/*! @brief Tests that a cancelled request completes with @c NSURLErrorCancelled, once, even if the
+        handler answers it later.
+ */
+- (void)testCancel {
+  __block SCTKLoopbackTransportResponder pendingResponder;
+  XCTestExpectation *received = [self expectationWithDescription:@"Request received."];
+  SCTKLoopbackTransport *transport =
+      [[SCTKLoopbackTransport alloc] initWithHandler:^(NSURLRequest *request,
+                                                       SCTKLoopbackTransportResponder respond) {
+    pendingResponder = respond;
+    [received fulfill];
+  }];
+  NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:kTestURL]];
+
+  XCTestExpectation *completed = [self expectationWithDescription:@"Request completed."];
+  id<SCTKHTTPTransportTask> task =
+      [transport taskWithRequest:request
+                 responseHandler:^BOOL(NSURLResponse *response) {
+    XCTFail(@"A cancelled request received a response.");
+    return YES;
+  }
+                     dataHandler:^BOOL(NSData *data) { return YES; }
+               completionHandler:^(NSError *_Nullable error) {
+    XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+    XCTAssertEqual(error.code, NSURLErrorCancelled);
+    [completed fulfill];
+  }];
+  [task resume];
+  [self waitForExpectations:@[ received ] timeout:5];
+  [task cancel];
+  [self waitForExpectations:@[ completed ] timeout:5];
+
+  NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL
+                                                            statusCode:200
+                                                           HTTPVersion:@"HTTP/1.1"
+                                                          headerFields:nil];
+  pendingResponder(response, [NSData data], nil);
+}
+
+/*! @brief Tests that a request cancelled by its response handler completes with
+        @c NSURLErrorCancelled, without its body.
+ */
+- (void)testResponseHandlerCancels {
+  NSData *body = [@"hello" dataUsingEncoding:NSUTF8StringEncoding];
+  SCTKLoopbackTransport *transport = [SCTKLoopbackTransport transportWithStatusCode:200
+                                                                            headers:nil
+                                                                               body:body];
+  NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:kTestURL]];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Request completed."];
+  [[transport taskWithRequest:request
+              responseHandler:^BOOL(NSURLResponse *response) { return NO; }
+                  dataHandler:^BOOL(NSData *data) {
+    XCTFail(@"A cancelled request received data.");
+    return YES;
+  }
+            completionHandler:^(NSError *_Nullable error) {
+    XCTAssertEqual(error.code, NSURLErrorCancelled);
+    [expectation fulfill];
+  }] resume];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/*! @brief Tests that the response size limit applies to responses of any transport.
+ */
+- (void)testResponseReaderLimitsBody {
+  NSUInteger maximumBodySize =
+      [SCTKResponseReader maximumBodySizeForEndpoint:SCTKResponseReaderEndpointToken];
+  NSData *body = [NSMutableData dataWithLength:maximumBodySize + 1];
+  SCTKLoopbackTransport *transport = [SCTKLoopbackTransport transportWithStatusCode:200
+                                                                            headers:nil
+                                                                               body:body];
+  NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:kTestURL]];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Response read."];
+  [[SCTKResponseReader taskWithTransport:transport
+                                 request:request
+                                endpoint:SCTKResponseReaderEndpointToken
+                       completionHandler:^(NSData *_Nullable data,
+                                           NSURLResponse *_Nullable response,
+                                           NSError *_Nullable error) {
+    XCTAssertNil(data);
+    XCTAssertTrue([SCTKResponseReader isResponseTooLargeError:error]);
+    [expectation fulfill];
+  }] resume];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/*! @brief Tests that token requests are sent through the transport set on
+        @c SCTKURLSessionProvider.
+ */
+- (void)testTokenRequestThroughTransport {
+  SCTKLoopbackTransport *transport = [[self class] tokenTransport];
+  [SCTKURLSessionProvider setTransport:transport];
+  XCTAssertEqual([SCTKURLSessionProvider transport], transport);
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Token response."];
+  [SCTKAuthorizationService performTokenRequest:[OIDTokenRequestTests testInstance]
+                                       callback:^(SCTKTokenResponse *_Nullable tokenResponse,
+                                                  NSError *_Nullable error) {
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(tokenResponse.accessToken, @"new123");
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual(transport.requestCount, 1u);
+}
+
+/*! @brief Tests that a connection error of the transport is reported as a network error.
+ */
+- (void)testTokenRequestConnectionError {
+  SCTKLoopbackTransport *transport =
+      [[SCTKLoopbackTransport alloc] initWithHandler:^(NSURLRequest *request,
+                                                       SCTKLoopbackTransportResponder respond) {
+    respond(nil, nil, [NSError errorWithDomain:NSURLErrorDomain
+                                          code:NSURLErrorNotConnectedToInternet
+                                      userInfo:nil]);
+  }];
+  [SCTKURLSessionProvider setTransport:transport];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Token request failed."];
+  [SCTKAuthorizationService performTokenRequest:[OIDTokenRequestTests testInstance]
+                                       callback:^(SCTKTokenResponse *_Nullable tokenResponse,
+                                                  NSError *_Nullable error) {
+    XCTAssertNil(tokenResponse);
+    XCTAssertEqual(error.code, SCTKErrorCodeNetworkError);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/*! @brief Tests that clearing the transport restores the default transport on the session.
+ */
+- (void)testDefaultTransport {
+  id<SCTKHTTPTransport> defaultTransport = [SCTKURLSessionProvider transport];
+  [SCTKURLSessionProvider setTransport:[[self class] tokenTransport]];
+  [SCTKURLSessionProvider setTransport:nil];
+  XCTAssertEqual([SCTKURLSessionProvider transport], defaultTransport);
+}
+
+/*! @brief Measures the token pipeline, from request to parsed response, without a network.
+ */
+- (void)testTokenRequestPerformance {
+  [SCTKURLSessionProvider setTransport:[[self class] tokenTransport]];
+  SCTKTokenRequest *request = [OIDTokenRequestTests testInstance];
+  dispatch_queue_t callbackQueue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+
+  [self measureBlock:^{
+    // sequential, so that identical requests are not joined to one in flight
+    for (NSUInteger i = 0; i < kBenchmarkTokenRequestCount; i++) {
+      dispatch_semaphore_t completed = dispatch_semaphore_create(0);
+      [SCTKAuthorizationService performTokenRequest:request
+                      originalAuthorizationResponse:nil
+                                      callbackQueue:callbackQueue
+                                           callback:^(SCTKTokenResponse *_Nullable tokenResponse,
+                                                      NSError *_Nullable error) {
+        dispatch_semaphore_signal(completed);
+      }];
+      dispatch_semaphore_wait(completed, DISPATCH_TIME_FOREVER);
+    }
+  }];
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,300 @@
+/*! @file SCTKPromiseTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDTokenRequestTests.h"
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthorizationService+Promises.h"
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKErrorUtilities.h"
+#import "Sources/AppAuthCore/SCTKIntrospectionRequest.h"
+#import "Sources/AppAuthCore/SCTKIntrospectionResponse.h"
+#import "Sources/AppAuthCore/SCTKPromise.h"
+#import "Sources/AppAuthCore/SCTKRevocationRequest.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKPromise and @c SCTKAuthorizationService(Promises).
+ */
+@interface SCTKPromiseTests : XCTestCase
+@end
+
+@implementation SCTKPromiseTests
+
+/*! @brief Returns an error to reject promises with.
+ */
++ (NSError *)testError {
+  return [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
+                           underlyingError:nil
+                               description:nil];
+}
+
+/*! @brief Tests that values flow through a chain, and that returned promises are adopted.
+ */
+- (void)testThenChainsValuesAndAdoptsPromises {
+  SCTKPromise<NSNumber *> *source = [SCTKPromise pendingPromise];
+  SCTKPromise<NSNumber *> *adopted = [SCTKPromise pendingPromise];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Chain resolved."];
+
+  [[[source then:^id _Nullable(NSNumber *value) {
+    XCTAssertTrue([NSThread isMainThread]);
+    XCTAssertEqualObjects(value, @1);
+    return adopted;
+  }] then:^id _Nullable(NSNumber *value) {
+    XCTAssertEqualObjects(value, @2);
+    return @(value.integerValue + 1);
+  }] then:^id _Nullable(NSNumber *value) {
+    XCTAssertEqualObjects(value, @3);
+    [expectation fulfill];
+    return nil;
+  }];
+
+  [source fulfill:@1];
+  [adopted fulfill:@2];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/*! @brief Tests that a returned error rejects the chain, skips the following @c then: blocks, and
+        can be recovered from.
+ */
+- (void)testReturnedErrorRejectsUntilRecovered {
+  NSError *error = [[self class] testError];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Chain recovered."];
+
+  [[[[SCTKPromise promiseWithValue:@1] then:^id _Nullable(id value) {
+    return error;
+  }] then:^id _Nullable(id value) {
+    XCTFail(@"A rejected promise must not call then: blocks.");
+    return nil;
+  }] recover:^id _Nullable(NSError *recoveredError) {
+    XCTAssertEqualObjects(recoveredError, error);
+    [expectation fulfill];
+    return nil;
+  }];
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/*! @brief Tests that blocks are called on the requested queue.
+ */
+- (void)testOnQueueCallsBlockOnQueue {
+  dispatch_queue_t queue = dispatch_queue_create("SCTKPromiseTests", DISPATCH_QUEUE_SERIAL);
+  static void *kQueueKey = &kQueueKey;
+  dispatch_queue_set_specific(queue, kQueueKey, kQueueKey, NULL);
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Block called."];
+
+  [[SCTKPromise promiseWithValue:@1] onQueue:queue then:^id _Nullable(id value) {
+    XCTAssertEqual(dispatch_get_specific(kQueueKey), kQueueKey);
+    [expectation fulfill];
+    return nil;
+  }];
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/*! @brief Tests that @c all: collects the values in order, with @c NSNull for nil.
+ */
+- (void)testAllCollectsValuesInOrder {
+  SCTKPromise *first = [SCTKPromise pendingPromise];
+  SCTKPromise *second = [SCTKPromise pendingPromise];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"All fulfilled."];
+
+  [[SCTKPromise all:@[ first, second, [SCTKPromise promiseWithValue:nil] ]]
+      then:^id _Nullable(NSArray *values) {
+    XCTAssertEqualObjects(values, (@[ @1, @2, [NSNull null] ]));
+    [expectation fulfill];
+    return nil;
+  }];
+  [second fulfill:@2];
+  [first fulfill:@1];
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/*! @brief Tests that @c all: is rejected by the first error, and cancels the pending promises.
+ */
+- (void)testAllRejectsAndCancelsPendingPromises {
+  SCTKPromise *failing = [SCTKPromise pendingPromise];
+  SCTKPromise *pending = [SCTKPromise pendingPromise];
+  SCTKPromise *combined = [SCTKPromise all:@[ failing, pending ]];
+  NSError *error = [[self class] testError];
+
+  [failing reject:error];
+
+  XCTAssertEqualObjects(combined.error, error);
+  XCTAssertFalse(pending.isPending);
+  XCTAssertEqual(pending.error.code, SCTKErrorCodePromiseCancelledError);
+}
+
+/*! @brief Tests that @c any: takes the first value, and is only rejected if all are rejected.
+ */
+- (void)testAny {
+  SCTKPromise *failing = [SCTKPromise pendingPromise];
+  SCTKPromise *succeeding = [SCTKPromise pendingPromise];
+  SCTKPromise *combined = [SCTKPromise any:@[ failing, succeeding ]];
+  NSError *error = [[self class] testError];
+  [failing reject:error];
+  XCTAssertTrue(combined.isPending);
+  [succeeding fulfill:@2];
+  XCTAssertEqualObjects(combined.value, @2);
+
+  SCTKPromise *rejected = [SCTKPromise any:@[ [SCTKPromise promiseWithError:error] ]];
+  XCTAssertEqualObjects(rejected.error, error);
+}
+
+/*! @brief Tests that @c race: settles with the first result, and cancels the others.
+ */
+- (void)testRaceCancelsLosers {
+  SCTKPromise *winner = [SCTKPromise pendingPromise];
+  SCTKPromise *loser = [SCTKPromise pendingPromise];
+  __block BOOL loserCancelled = NO;
+  [loser onCancel:^{
+    loserCancelled = YES;
+  }];
+  SCTKPromise *combined = [SCTKPromise race:@[ winner, loser ]];
+
+  [winner fulfill:@1];
+
+  XCTAssertEqualObjects(combined.value, @1);
+  XCTAssertTrue(loserCancelled);
+}
+
+/*! @brief Tests that cancellation propagates to a shared promise only once every promise derived
+        from it is cancelled.
+ */
+- (void)testCancellationPropagatesOnceUnused {
+  SCTKPromise *shared = [SCTKPromise pendingPromise];
+  __block NSUInteger cancellationCount = 0;
+  [shared onCancel:^{
+    cancellationCount++;
+  }];
+  SCTKPromise *first = [shared then:^id _Nullable(id value) {
+    return value;
+  }];
+  SCTKPromise *second = [shared then:^id _Nullable(id value) {
+    return value;
+  }];
+
+  [first cancel];
+  XCTAssertEqual(first.error.code, SCTKErrorCodePromiseCancelledError);
+  XCTAssertTrue(shared.isPending);
+
+  [second cancel];
+  XCTAssertFalse(shared.isPending);
+  XCTAssertEqual(cancellationCount, 1u);
+
+  // a resolved promise ignores further resolution
+  [shared fulfill:@1];
+  XCTAssertNil(shared.value);
+  XCTAssertEqual(shared.error.code, SCTKErrorCodePromiseCancelledError);
+}
+
+/*! @brief Tests the promise form of a token request.
+ */
+- (void)testPerformTokenRequest {
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"access_token" : @"new123",
+                                                         @"token_type" : @"Bearer",
+                                                         @"expires_in" : @3600}];
+  }];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Token response."];
+
+  [[SCTKAuthorizationService performTokenRequest:[OIDTokenRequestTests testInstance]]
+      then:^id _Nullable(SCTKTokenResponse *tokenResponse) {
+    XCTAssertEqualObjects(tokenResponse.accessToken, @"new123");
+    [expectation fulfill];
+    return nil;
+  }];
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests the promise form of a revocation request, which is rejected with the error of a
+        failed revocation.
+ */
+- (void)testPerformRevocationRequest {
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:503 headers:nil data:nil];
+  }];
+  SCTKRevocationRequest *request = [[SCTKRevocationRequest alloc]
+      initWithRevocationEndpoint:[NSURL URLWithString:@"https://www.example.com/revoke"]
+                           token:@"refresh123"
+                   tokenTypeHint:nil
+                        clientID:@"client"
+                    clientSecret:nil
+            additionalParameters:nil];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Revocation failed."];
+
+  [[SCTKAuthorizationService performRevocationRequest:request]
+      recover:^id _Nullable(NSError *error) {
+    XCTAssertNotNil(error);
+    [expectation fulfill];
+    return nil;
+  }];
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+/*! @brief Tests the promise form of an introspection request, which is fulfilled for an inactive
+        token.
+ */
+- (void)testPerformIntrospectionRequest {
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200 headers:nil JSON:@{@"active" : @NO}];
+  }];
+  SCTKIntrospectionRequest *request = [[SCTKIntrospectionRequest alloc]
+      initWithIntrospectionEndpoint:[NSURL URLWithString:@"https://www.example.com/introspect"]
+                              token:[NSUUID UUID].UUIDString
+                      tokenTypeHint:nil
+                           clientID:@"resource"
+                       clientSecret:@"secret"
+               additionalParameters:nil];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Introspection response."];
+
+  [[SCTKAuthorizationService performIntrospectionRequest:request]
+      then:^id _Nullable(SCTKIntrospectionResponse *introspectionResponse) {
+    XCTAssertFalse(introspectionResponse.active);
+    [expectation fulfill];
+    return nil;
+  }];
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,173 @@
+/*! @file SCTKResponseReaderTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDTokenRequestTests.h"
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthorizationService.h"
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKResponseReader.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief A URL responses are faked for.
+ */
+static NSString *const kTestURL = @"https://www.example.com/token";
+
+/*! @brief Unit tests for @c SCTKResponseReader.
+ */
+@interface SCTKResponseReaderTests : XCTestCase
+@end
+
+@implementation SCTKResponseReaderTests {
+  /*! @brief The maximum token response size before the test.
+   */
+  NSUInteger _originalMaximumTokenBodySize;
+}
+
+- (void)setUp {
+  [super setUp];
+  _originalMaximumTokenBodySize =
+      [SCTKResponseReader maximumBodySizeForEndpoint:SCTKResponseReaderEndpointToken];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+}
+
+- (void)tearDown {
+  [SCTKResponseReader setMaximumBodySize:_originalMaximumTokenBodySize
+                             forEndpoint:SCTKResponseReaderEndpointToken];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+  [super tearDown];
+}
+
+/*! @brief Makes every request answer with a body of the given size.
+    @param length The size of the body, in bytes.
+ */
++ (void)respondWithBodyOfLength:(NSUInteger)length {
+  NSData *body = [NSMutableData dataWithLength:length];
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200 headers:nil data:body];
+  }];
+}
+
+/*! @brief Reads the response to a request to @c kTestURL.
+    @param data Set to the body read.
+    @param error Set to the error of the request.
+ */
+- (void)readTokenResponseWithData:(NSData *_Nullable *_Nonnull)data
+                            error:(NSError *_Nullable *_Nonnull)error {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Response read."];
+  __block NSData *readData;
+  __block NSError *readError;
+  NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:kTestURL]];
+  [[SCTKResponseReader taskWithTransport:[SCTKURLSessionProvider transport]
+                                 request:request
+                                endpoint:SCTKResponseReaderEndpointToken
+                       completionHandler:^(NSData *_Nullable responseData,
+                                           NSURLResponse *_Nullable response,
+                                           NSError *_Nullable responseError) {
+    readData = responseData;
+    readError = responseError;
+    [expectation fulfill];
+  }] resume];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  *data = readData;
+  *error = readError;
+}
+
+/*! @brief Tests the default maximum sizes.
+ */
+- (void)testDefaultMaximumBodySizes {
+  XCTAssertEqual([SCTKResponseReader maximumBodySizeForEndpoint:
+                     SCTKResponseReaderEndpointDiscovery], 1024u * 1024u);
+  XCTAssertEqual(_originalMaximumTokenBodySize, 256u * 1024u);
+  XCTAssertEqual([SCTKResponseReader maximumBodySizeForEndpoint:
+                     SCTKResponseReaderEndpointRegistration], 256u * 1024u);
+  XCTAssertEqual([SCTKResponseReader maximumBodySizeForEndpoint:
+                     SCTKResponseReaderEndpointUserInfo], 256u * 1024u);
+  XCTAssertEqual([SCTKResponseReader maximumBodySizeForEndpoint:
+                     SCTKResponseReaderEndpointRevocation], 64u * 1024u);
+  XCTAssertEqual([SCTKResponseReader maximumBodySizeForEndpoint:
+                     SCTKResponseReaderEndpointIntrospection], 64u * 1024u);
+}
+
+/*! @brief Tests that a body of the maximum size is read in full.
+ */
+- (void)testReadsBodyWithinLimit {
+  [SCTKResponseReader setMaximumBodySize:1024 forEndpoint:SCTKResponseReaderEndpointToken];
+  [[self class] respondWithBodyOfLength:1024];
+
+  NSData *data;
+  NSError *error;
+  [self readTokenResponseWithData:&data error:&error];
+
+  XCTAssertNil(error);
+  XCTAssertEqual(data.length, 1024u);
+}
+
+/*! @brief Tests that a body over the maximum size is reported with a dedicated error.
+ */
+- (void)testRejectsBodyOverLimit {
+  [SCTKResponseReader setMaximumBodySize:1024 forEndpoint:SCTKResponseReaderEndpointToken];
+  [[self class] respondWithBodyOfLength:1025];
+
+  NSData *data;
+  NSError *error;
+  [self readTokenResponseWithData:&data error:&error];
+
+  XCTAssertNil(data);
+  XCTAssertTrue([SCTKResponseReader isResponseTooLargeError:error]);
+  XCTAssertEqual(error.code, SCTKErrorCodeResponseTooLargeError);
+}
+
+/*! @brief Tests that an oversized token response fails the token request with the dedicated
+        error, rather than a network error.
+ */
+- (void)testTokenRequestReportsOversizedResponse {
+  [SCTKResponseReader setMaximumBodySize:16 forEndpoint:SCTKResponseReaderEndpointToken];
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"access_token" : @"new123",
+                                                         @"token_type" : @"Bearer",
+                                                         @"expires_in" : @3600}];
+  }];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Token request failed."];
+  [SCTKAuthorizationService performTokenRequest:[OIDTokenRequestTests testInstance]
+                                       callback:^(SCTKTokenResponse *_Nullable tokenResponse,
+                                                  NSError *_Nullable error) {
+    XCTAssertNil(tokenResponse);
+    XCTAssertEqual(error.code, SCTKErrorCodeResponseTooLargeError);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,101 @@
+/*! @file SCTKRetryPolicyTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKErrorUtilities.h"
+#import "Sources/AppAuthCore/SCTKRetryPolicy.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKRetryPolicy.
+ */
+@interface SCTKRetryPolicyTests : XCTestCase
+@end
+
+@implementation SCTKRetryPolicyTests
+
+/*! @brief Returns the error @c SCTKAuthorizationService reports for an HTTP error response.
+    @param statusCode The HTTP status code of the response.
+ */
++ (NSError *)serverErrorWithStatusCode:(NSInteger)statusCode {
+  NSError *HTTPError = [NSError errorWithDomain:SCTKHTTPErrorDomain code:statusCode userInfo:nil];
+  return [SCTKErrorUtilities errorWithCode:SCTKErrorCodeServerError
+                           underlyingError:HTTPError
+                               description:nil];
+}
+
+/*! @brief Tests the default values.
+ */
+- (void)testDefaults {
+  SCTKRetryPolicy *retryPolicy = [[SCTKRetryPolicy alloc] init];
+  XCTAssertEqual(retryPolicy.maximumRetryCount, 3u);
+  XCTAssertEqual(retryPolicy.initialDelay, 1);
+  XCTAssertEqual(retryPolicy.maximumDelay, 30);
+}
+
+/*! @brief Tests that each delay lies between zero and the capped exponential backoff.
+ */
+- (void)testDelayIsExponentialWithFullJitter {
+  SCTKRetryPolicy *retryPolicy = [[SCTKRetryPolicy alloc] initWithMaximumRetryCount:10
+                                                                       initialDelay:1
+                                                                       maximumDelay:10];
+  NSTimeInterval expectedBounds[] = {1, 2, 4, 8, 10, 10};
+  for (NSUInteger retry = 0; retry < sizeof(expectedBounds) / sizeof(expectedBounds[0]); retry++) {
+    NSTimeInterval largestDelay = 0;
+    for (NSUInteger i = 0; i < 200; i++) {
+      NSTimeInterval delay = [retryPolicy delayBeforeRetry:retry];
+      XCTAssertGreaterThanOrEqual(delay, 0);
+      XCTAssertLessThanOrEqual(delay, expectedBounds[retry]);
+      largestDelay = MAX(largestDelay, delay);
+    }
+    // the delays are spread over the whole range rather than stuck near zero
+    XCTAssertGreaterThan(largestDelay, expectedBounds[retry] / 2);
+  }
+  XCTAssertLessThanOrEqual([retryPolicy delayBeforeRetry:NSUIntegerMax], 10);
+}
+
+/*! @brief Tests which errors are considered transient.
+ */
+- (void)testIsTransientError {
+  NSError *networkError = [SCTKErrorUtilities errorWithCode:SCTKErrorCodeNetworkError
+                                            underlyingError:nil
+                                                description:nil];
+  XCTAssertTrue([SCTKRetryPolicy isTransientError:networkError]);
+  XCTAssertTrue([SCTKRetryPolicy isTransientError:[[self class] serverErrorWithStatusCode:503]]);
+  XCTAssertTrue([SCTKRetryPolicy isTransientError:[[self class] serverErrorWithStatusCode:429]]);
+  XCTAssertFalse([SCTKRetryPolicy isTransientError:[[self class] serverErrorWithStatusCode:404]]);
+
+  NSError *OAuthError = [SCTKErrorUtilities OAuthErrorWithDomain:SCTKOAuthTokenErrorDomain
+                                                   OAuthResponse:@{@"error" : @"invalid_grant"}
+                                                 underlyingError:nil];
+  XCTAssertFalse([SCTKRetryPolicy isTransientError:OAuthError]);
+  XCTAssertFalse([SCTKRetryPolicy isTransientError:nil]);
+}
+
+@end
+
+#pragma GCC diagnostic pop
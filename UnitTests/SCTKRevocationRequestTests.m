@@ -0,0 +1,295 @@
+/*! @file SCTKRevocationRequestTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDAuthorizationResponseTests.h"
+#import "OIDServiceDiscoveryTests.h"
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthorizationService.h"
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKGrantTypes.h"
+#import "Sources/AppAuthCore/SCTKRevocationRequest.h"
+#import "Sources/AppAuthCore/SCTKServiceConfiguration.h"
+#import "Sources/AppAuthCore/SCTKServiceDiscovery.h"
+#import "Sources/AppAuthCore/SCTKTokenRequest.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#import "Sources/AppAuthCore/SCTKURLQueryComponent.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The revocation endpoint in the tests.
+ */
+static NSString *const kRevocationEndpoint = @"https://www.example.com/revoke";
+
+/*! @brief Unit tests for @c SCTKRevocationRequest and the revocation requests of
+        @c SCTKAuthorizationService.
+ */
+@interface SCTKRevocationRequestTests : XCTestCase
+@end
+
+@implementation SCTKRevocationRequestTests
+
+- (void)setUp {
+  [super setUp];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+}
+
+- (void)tearDown {
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+  [super tearDown];
+}
+
+/*! @brief Returns a revocation request of a public client.
+    @param token The token to revoke.
+    @param endpoint The revocation endpoint.
+ */
++ (SCTKRevocationRequest *)requestWithToken:(NSString *)token endpoint:(NSString *)endpoint {
+  return [[SCTKRevocationRequest alloc] initWithRevocationEndpoint:[NSURL URLWithString:endpoint]
+                                                             token:token
+                                                     tokenTypeHint:SCTKTokenTypeHintAccessToken
+                                                          clientID:@"client"
+                                                      clientSecret:nil
+                                              additionalParameters:nil];
+}
+
+/*! @brief Returns an auth state with a refresh and an access token, whose discovery document has
+        a revocation endpoint if one is given.
+    @param revocationEndpoint The revocation endpoint, if any.
+    @param suffix Appended to the tokens, to keep them distinct between auth states.
+ */
++ (SCTKAuthState *)authStateWithRevocationEndpoint:(nullable NSString *)revocationEndpoint
+                                       tokenSuffix:(NSString *)suffix {
+  NSMutableDictionary *document =
+      [[OIDServiceDiscoveryTests completeServiceDiscoveryDictionary] mutableCopy];
+  document[@"revocation_endpoint"] = revocationEndpoint;
+  SCTKServiceDiscovery *discovery = [[SCTKServiceDiscovery alloc] initWithDictionary:document
+                                                                               error:nil];
+  SCTKServiceConfiguration *configuration =
+      [[SCTKServiceConfiguration alloc] initWithDiscoveryDocument:discovery];
+  SCTKTokenRequest *tokenRequest =
+      [[SCTKTokenRequest alloc] initWithConfiguration:configuration
+                                            grantType:SCTKGrantTypeRefreshToken
+                                    authorizationCode:nil
+                                          redirectURL:nil
+                                             clientID:@"client"
+                                         clientSecret:nil
+                                               scopes:nil
+                                         refreshToken:@"refresh"
+                                         codeVerifier:nil
+                                 additionalParameters:nil];
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:tokenRequest
+                                      parameters:@{
+                                        @"access_token" :
+                                            [@"access" stringByAppendingString:suffix],
+                                        @"refresh_token" :
+                                            [@"refresh" stringByAppendingString:suffix],
+                                        @"expires_in" : @3600,
+                                      }];
+  return [[SCTKAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]
+                      tokenResponse:tokenResponse];
+}
+
+/*! @brief Revokes a token and waits for the result.
+    @param request The revocation request.
+ */
+- (nullable NSError *)errorRevokingWithRequest:(SCTKRevocationRequest *)request {
+  __block NSError *result;
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Revocation completes."];
+  [SCTKAuthorizationService performRevocationRequest:request
+                                            callback:^(NSError *_Nullable error) {
+    result = error;
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  return result;
+}
+
+/*! @brief Tests that a public client identifies itself with its client ID in the body.
+ */
+- (void)testURLRequestOfPublicClient {
+  SCTKRevocationRequest *request = [[self class] requestWithToken:@"abc123"
+                                                         endpoint:kRevocationEndpoint];
+  NSURLRequest *URLRequest = [request URLRequest];
+  XCTAssertEqualObjects(URLRequest.HTTPMethod, @"POST");
+  XCTAssertEqualObjects(URLRequest.URL.absoluteString, kRevocationEndpoint);
+  XCTAssertNil([URLRequest valueForHTTPHeaderField:@"Authorization"]);
+
+  NSString *body = [[NSString alloc] initWithData:URLRequest.HTTPBody
+                                         encoding:NSUTF8StringEncoding];
+  NSURLComponents *components = [[NSURLComponents alloc] init];
+  components.percentEncodedQuery = body;
+  SCTKURLQueryComponent *query = [[SCTKURLQueryComponent alloc] initWithURL:components.URL];
+  XCTAssertEqualObjects([query valuesForParameter:@"token"], @[ @"abc123" ]);
+  XCTAssertEqualObjects([query valuesForParameter:@"token_type_hint"], @[ @"access_token" ]);
+  XCTAssertEqualObjects([query valuesForParameter:@"client_id"], @[ @"client" ]);
+}
+
+/*! @brief Tests that a confidential client authenticates with HTTP Basic authentication.
+ */
+- (void)testURLRequestOfConfidentialClient {
+  SCTKRevocationRequest *request =
+      [[SCTKRevocationRequest alloc] initWithRevocationEndpoint:
+                                         [NSURL URLWithString:kRevocationEndpoint]
+                                                          token:@"refresh123"
+                                                  tokenTypeHint:SCTKTokenTypeHintRefreshToken
+                                                       clientID:@"client"
+                                                   clientSecret:@"secret"
+                                           additionalParameters:nil];
+  NSURLRequest *URLRequest = [request URLRequest];
+  NSData *credentials = [@"client:secret" dataUsingEncoding:NSUTF8StringEncoding];
+  NSString *expectedAuthorization =
+      [@"Basic " stringByAppendingString:[credentials base64EncodedStringWithOptions:0]];
+  XCTAssertEqualObjects([URLRequest valueForHTTPHeaderField:@"Authorization"],
+                        expectedAuthorization);
+
+  NSString *body = [[NSString alloc] initWithData:URLRequest.HTTPBody
+                                         encoding:NSUTF8StringEncoding];
+  XCTAssertFalse([body containsString:@"client_id"]);
+  XCTAssertTrue([body containsString:@"token_type_hint=refresh_token"]);
+}
+
+/*! @brief Tests that HTTP 200 means the token was revoked, whatever the body.
+ */
+- (void)testRevocationSucceeds {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200 headers:nil data:nil];
+  }];
+  SCTKRevocationRequest *request = [[self class] requestWithToken:@"abc123"
+                                                         endpoint:kRevocationEndpoint];
+  XCTAssertNil([self errorRevokingWithRequest:request]);
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+}
+
+/*! @brief Tests that an OAuth error response is reported in the revocation error domain.
+ */
+- (void)testRevocationOAuthError {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:400
+                                               headers:nil
+                                                  JSON:@{@"error" : @"unsupported_token_type"}];
+  }];
+  SCTKRevocationRequest *request = [[self class] requestWithToken:@"abc123"
+                                                         endpoint:kRevocationEndpoint];
+  NSError *error = [self errorRevokingWithRequest:request];
+  XCTAssertEqualObjects(error.domain, SCTKOAuthRevocationErrorDomain);
+  XCTAssertEqual(error.code, SCTKErrorCodeOAuthOther);
+  XCTAssertEqualObjects(error.userInfo[SCTKOAuthErrorResponseErrorKey][@"error"],
+                        @"unsupported_token_type");
+}
+
+/*! @brief Tests that the errors of a batch are reported by token, and that a token is revoked
+        once however many requests name it.
+ */
+- (void)testBatchReportsErrorsByToken {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    NSInteger statusCode = [request.URL.path hasSuffix:@"/unavailable"] ? 503 : 200;
+    return [SCTKTestURLResponse responseWithStatusCode:statusCode headers:nil data:nil];
+  }];
+  NSString *unavailableEndpoint = [kRevocationEndpoint stringByAppendingString:@"/unavailable"];
+  NSArray<SCTKRevocationRequest *> *requests = @[
+    [[self class] requestWithToken:@"token1" endpoint:kRevocationEndpoint],
+    [[self class] requestWithToken:@"token2" endpoint:unavailableEndpoint],
+    [[self class] requestWithToken:@"token3" endpoint:kRevocationEndpoint],
+    [[self class] requestWithToken:@"token1" endpoint:kRevocationEndpoint],
+  ];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Batch completes."];
+  SCTKRevocationBatchCallback callback = ^(NSDictionary<NSString *, NSError *> *errors) {
+    XCTAssertEqualObjects(errors.allKeys, @[ @"token2" ]);
+    XCTAssertEqual(errors[@"token2"].code, SCTKErrorCodeServerError);
+    [expectation fulfill];
+  };
+  [SCTKAuthorizationService performRevocationRequests:requests callback:callback];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 3u);
+}
+
+/*! @brief Tests that no more than the given number of requests are in flight at once.
+ */
+- (void)testBatchLimitsConcurrentRequests {
+  // the endpoint never responds, so the first requests stay in flight
+  [SCTKTestURLProtocol setHandler:nil];
+  NSMutableArray<SCTKRevocationRequest *> *requests = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 5; i++) {
+    NSString *token = [NSString stringWithFormat:@"token%lu", (unsigned long)i];
+    [requests addObject:[[self class] requestWithToken:token endpoint:kRevocationEndpoint]];
+  }
+
+  SCTKRevocationBatchCallback callback = ^(NSDictionary<NSString *, NSError *> *errors) {
+    XCTFail(@"The batch cannot complete while requests are in flight.");
+  };
+  [SCTKAuthorizationService performRevocationRequests:requests
+                            maximumConcurrentRequests:2
+                                        callbackQueue:dispatch_get_main_queue()
+                                             callback:callback];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Requests are in flight."];
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+    XCTAssertEqual([SCTKTestURLProtocol requestCount], 2u);
+    [expectation fulfill];
+  });
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+/*! @brief Tests that both tokens of each auth state are revoked, and that the tokens of an auth
+        state without a revocation endpoint fail without a request.
+ */
+- (void)testRevokeTokensOfAuthStates {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200 headers:nil data:nil];
+  }];
+  NSArray<SCTKAuthState *> *authStates = @[
+    [[self class] authStateWithRevocationEndpoint:kRevocationEndpoint tokenSuffix:@"A"],
+    [[self class] authStateWithRevocationEndpoint:kRevocationEndpoint tokenSuffix:@"B"],
+    [[self class] authStateWithRevocationEndpoint:nil tokenSuffix:@"C"],
+  ];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Batch completes."];
+  SCTKRevocationBatchCallback callback = ^(NSDictionary<NSString *, NSError *> *errors) {
+    NSSet *expectedTokens = [NSSet setWithObjects:@"accessC", @"refreshC", nil];
+    XCTAssertEqualObjects([NSSet setWithArray:errors.allKeys], expectedTokens);
+    for (NSError *error in errors.allValues) {
+      XCTAssertEqual(error.code, SCTKErrorCodeEndpointNotConfiguredError);
+      XCTAssertEqualObjects(error.localizedDescription,
+                            @"The discovery document has no revocation endpoint.");
+    }
+    [expectation fulfill];
+  };
+  [SCTKAuthorizationService revokeTokensOfAuthStates:authStates callback:callback];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 4u);
+}
+
+@end
+
+#pragma GCC diagnostic pop
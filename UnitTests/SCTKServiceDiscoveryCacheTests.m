@@ -0,0 +1,241 @@
+/*! @file SCTKServiceDiscoveryCacheTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDServiceDiscoveryTests.h"
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthorizationService.h"
+#import "Sources/AppAuthCore/SCTKServiceConfiguration.h"
+#import "Sources/AppAuthCore/SCTKServiceDiscovery.h"
+#import "Sources/AppAuthCore/SCTKServiceDiscoveryCache.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The URL of the discovery document in the tests.
+ */
+static NSString *const kDiscoveryURL = @"https://www.example.com/.well-known/openid-configuration";
+
+/*! @brief The entity tag of the discovery document in the tests.
+ */
+static NSString *const kEntityTag = @"\"v1\"";
+
+/*! @brief Unit tests for @c SCTKServiceDiscoveryCache.
+ */
+@interface SCTKServiceDiscoveryCacheTests : XCTestCase
+@end
+
+@implementation SCTKServiceDiscoveryCacheTests {
+  /*! @brief A directory for the entries of the test.
+   */
+  NSURL *_directoryURL;
+}
+
+- (void)setUp {
+  [super setUp];
+  NSString *directoryName = [NSUUID UUID].UUIDString;
+  _directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()]
+      URLByAppendingPathComponent:directoryName];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+}
+
+- (void)tearDown {
+  [SCTKServiceDiscoveryCache setSharedCache:nil];
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+  [[NSFileManager defaultManager] removeItemAtURL:_directoryURL error:nil];
+  [super tearDown];
+}
+
+/*! @brief Returns a response with the given headers.
+    @param headers The headers of the response.
+ */
++ (NSHTTPURLResponse *)responseWithHeaders:(NSDictionary<NSString *, NSString *> *)headers {
+  return [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:kDiscoveryURL]
+                                     statusCode:200
+                                    HTTPVersion:@"HTTP/1.1"
+                                   headerFields:headers];
+}
+
+/*! @brief Returns a valid discovery document.
+ */
++ (SCTKServiceDiscovery *)discovery {
+  return [[SCTKServiceDiscovery alloc]
+      initWithDictionary:[OIDServiceDiscoveryTests completeServiceDiscoveryDictionary]
+                   error:nil];
+}
+
+/*! @brief Discovers the configuration at @c kDiscoveryURL and waits for the result.
+ */
+- (nullable SCTKServiceConfiguration *)discover {
+  __block SCTKServiceConfiguration *discoveredConfiguration;
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Discovery completes."];
+  [SCTKAuthorizationService
+      discoverServiceConfigurationForDiscoveryURL:[NSURL URLWithString:kDiscoveryURL]
+                                       completion:^(SCTKServiceConfiguration *_Nullable
+                                                        configuration,
+                                                    NSError *_Nullable error) {
+    XCTAssertNil(error);
+    discoveredConfiguration = configuration;
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  return discoveredConfiguration;
+}
+
+/*! @brief Makes every request return the discovery document with the given caching headers.
+    @param headers The caching headers of the response.
+ */
++ (void)serveDiscoveryWithHeaders:(NSDictionary<NSString *, NSString *> *)headers {
+  NSDictionary *document = [OIDServiceDiscoveryTests completeServiceDiscoveryDictionary];
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200 headers:headers JSON:document];
+  }];
+}
+
+/*! @brief Tests that the freshness lifetime is the max-age less the age of the response.
+ */
+- (void)testMaxAge {
+  BOOL storable;
+  NSDate *expirationDate = [SCTKServiceDiscoveryCache
+      expirationDateForResponse:[[self class] responseWithHeaders:@{
+        @"Cache-Control" : @"public, max-age=600",
+        @"Age" : @"100",
+        @"Expires" : @"Thu, 01 Jan 1970 00:00:00 GMT",
+      }]
+                       storable:&storable];
+  XCTAssertTrue(storable);
+  XCTAssertEqualWithAccuracy([expirationDate timeIntervalSinceNow], 500, 5);
+}
+
+/*! @brief Tests that Expires is measured against the Date of the response.
+ */
+- (void)testExpiresRelativeToDate {
+  BOOL storable;
+  NSDate *expirationDate = [SCTKServiceDiscoveryCache
+      expirationDateForResponse:[[self class] responseWithHeaders:@{
+        @"Date" : @"Sun, 06 Nov 1994 08:49:37 GMT",
+        @"Expires" : @"Sun, 06 Nov 1994 09:49:37 GMT",
+      }]
+                       storable:&storable];
+  XCTAssertTrue(storable);
+  XCTAssertEqualWithAccuracy([expirationDate timeIntervalSinceNow], 3600, 5);
+}
+
+/*! @brief Tests that no-store responses are not cached and no-cache responses are stale.
+ */
+- (void)testNoStoreAndNoCache {
+  SCTKServiceDiscoveryCache *cache = [[SCTKServiceDiscoveryCache alloc] init];
+  NSURL *URL = [NSURL URLWithString:kDiscoveryURL];
+  NSHTTPURLResponse *noStore =
+      [[self class] responseWithHeaders:@{@"Cache-Control" : @"max-age=600, no-store"}];
+  XCTAssertNil([cache storeDiscovery:[[self class] discovery] response:noStore forURL:URL]);
+  XCTAssertNil([cache entryForURL:URL]);
+
+  NSHTTPURLResponse *noCache =
+      [[self class] responseWithHeaders:@{@"Cache-Control" : @"no-cache, max-age=600"}];
+  XCTAssertNotNil([cache storeDiscovery:[[self class] discovery] response:noCache forURL:URL]);
+  XCTAssertFalse([cache entryForURL:URL].isFresh);
+}
+
+/*! @brief Tests that entries are read back by a new cache on the same directory.
+ */
+- (void)testPersistence {
+  NSURL *URL = [NSURL URLWithString:kDiscoveryURL];
+  SCTKServiceDiscoveryCache *cache =
+      [[SCTKServiceDiscoveryCache alloc] initWithDirectoryURL:_directoryURL];
+  [cache storeDiscovery:[[self class] discovery]
+               response:[[self class] responseWithHeaders:@{
+                 @"Cache-Control" : @"max-age=600",
+                 @"ETag" : kEntityTag,
+               }]
+                 forURL:URL];
+
+  SCTKServiceDiscoveryCache *reopenedCache =
+      [[SCTKServiceDiscoveryCache alloc] initWithDirectoryURL:_directoryURL];
+  SCTKServiceDiscoveryCacheEntry *entry = [reopenedCache entryForURL:URL];
+  XCTAssertEqualObjects(entry.discovery.discoveryDictionary,
+                        [[self class] discovery].discoveryDictionary);
+  XCTAssertEqualObjects(entry.entityTag, kEntityTag);
+  XCTAssertTrue(entry.isFresh);
+
+  [reopenedCache removeAllEntries];
+  SCTKServiceDiscoveryCache *emptiedCache =
+      [[SCTKServiceDiscoveryCache alloc] initWithDirectoryURL:_directoryURL];
+  XCTAssertNil([emptiedCache entryForURL:URL]);
+}
+
+/*! @brief Tests that a fresh document is returned without a request.
+ */
+- (void)testFreshDocumentIsNotRefetched {
+  [SCTKServiceDiscoveryCache setSharedCache:[[SCTKServiceDiscoveryCache alloc] init]];
+  [[self class] serveDiscoveryWithHeaders:@{@"Cache-Control" : @"max-age=600"}];
+
+  XCTAssertNotNil([self discover]);
+  XCTAssertNotNil([self discover]);
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+}
+
+/*! @brief Tests that a stale document is revalidated with its entity tag, and renewed by a 304
+        response.
+ */
+- (void)testStaleDocumentIsRevalidated {
+  SCTKServiceDiscoveryCache *cache = [[SCTKServiceDiscoveryCache alloc] init];
+  cache.revalidatesInBackground = NO;
+  [SCTKServiceDiscoveryCache setSharedCache:cache];
+  [[self class] serveDiscoveryWithHeaders:@{@"Cache-Control" : @"no-cache", @"ETag" : kEntityTag}];
+  XCTAssertNotNil([self discover]);
+
+  __block NSString *ifNoneMatch;
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    ifNoneMatch = [request valueForHTTPHeaderField:@"If-None-Match"];
+    return [SCTKTestURLResponse responseWithStatusCode:304
+                                               headers:@{@"Cache-Control" : @"max-age=600"}
+                                                  data:[NSData data]];
+  }];
+  SCTKServiceConfiguration *configuration = [self discover];
+  XCTAssertNotNil(configuration.discoveryDocument);
+  XCTAssertEqualObjects(ifNoneMatch, kEntityTag);
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+  XCTAssertTrue([cache entryForURL:[NSURL URLWithString:kDiscoveryURL]].isFresh);
+}
+
+/*! @brief Tests that a stale document is returned without waiting for its revalidation.
+ */
+- (void)testStaleDocumentIsReturnedBeforeRevalidation {
+  [SCTKServiceDiscoveryCache setSharedCache:[[SCTKServiceDiscoveryCache alloc] init]];
+  [[self class] serveDiscoveryWithHeaders:@{@"Cache-Control" : @"no-cache", @"ETag" : kEntityTag}];
+  XCTAssertNotNil([self discover]);
+
+  // The revalidation never completes.
+  [SCTKTestURLProtocol setHandler:nil];
+  XCTAssertNotNil([self discover]);
+}
+
+@end
+
+#pragma GCC diagnostic pop
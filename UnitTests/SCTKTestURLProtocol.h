@@ -0,0 +1,92 @@
+/*! @file SCTKTestURLProtocol.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief A canned response served by @c SCTKTestURLProtocol.
+ */
+@interface SCTKTestURLResponse : NSObject
+
+/*! @brief The HTTP status code.
+ */
+@property(nonatomic, readonly) NSInteger statusCode;
+
+/*! @brief The HTTP response headers.
+ */
+@property(nonatomic, readonly, nullable) NSDictionary<NSString *, NSString *> *headers;
+
+/*! @brief The response body.
+ */
+@property(nonatomic, readonly, nullable) NSData *data;
+
+/*! @brief The network error to fail with instead of responding, if any.
+ */
+@property(nonatomic, readonly, nullable) NSError *error;
+
+/*! @brief Creates a response with a JSON body.
+    @param statusCode The HTTP status code.
+    @param headers Additional HTTP response headers.
+    @param JSON The JSON object to serialize as the body.
+ */
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode
+                               headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                  JSON:(id)JSON;
+
+/*! @brief Creates a response with a raw body.
+    @param statusCode The HTTP status code.
+    @param headers HTTP response headers.
+    @param data The body.
+ */
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode
+                               headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                  data:(nullable NSData *)data;
+
+/*! @brief Creates a response that fails the request with a network error.
+    @param error The network error.
+ */
++ (instancetype)responseWithError:(NSError *)error;
+
+@end
+
+/*! @brief Returns the response to a request, or nil to never respond.
+ */
+typedef SCTKTestURLResponse *_Nullable (^SCTKTestURLProtocolHandler)(NSURLRequest *request);
+
+/*! @brief Serves HTTP requests from a handler block, so tests can exercise the network code paths
+        without a server.
+ */
+@interface SCTKTestURLProtocol : NSURLProtocol
+
+/*! @brief Sets the handler that responds to every request, and resets @c requestCount.
+    @param handler The handler, or nil to never respond.
+ */
++ (void)setHandler:(nullable SCTKTestURLProtocolHandler)handler;
+
+/*! @brief The number of requests started since the handler was last set.
+ */
++ (NSUInteger)requestCount;
+
+/*! @brief Returns a new session whose requests are served by this protocol.
+ */
++ (NSURLSession *)session;
+
+@end
+
+NS_ASSUME_NONNULL_END
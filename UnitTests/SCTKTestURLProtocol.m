@@ -0,0 +1,125 @@
+/*! @file SCTKTestURLProtocol.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "SCTKTestURLProtocol.h"
+
+/*! @brief The handler responding to requests. Guarded by the @c SCTKTestURLProtocol class.
+ */
+static SCTKTestURLProtocolHandler gHandler;
+
+/*! @brief The number of requests started. Guarded by the @c SCTKTestURLProtocol class.
+ */
+static NSUInteger gRequestCount;
+
+@implementation SCTKTestURLResponse
+
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode
+                               headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                  JSON:(id)JSON {
+  NSMutableDictionary<NSString *, NSString *> *allHeaders =
+      [NSMutableDictionary dictionaryWithObject:@"application/json" forKey:@"Content-Type"];
+  [allHeaders addEntriesFromDictionary:headers];
+  return [self responseWithStatusCode:statusCode
+                              headers:allHeaders
+                                 data:[NSJSONSerialization dataWithJSONObject:JSON
+                                                                      options:0
+                                                                        error:nil]];
+}
+
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode
+                               headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                  data:(nullable NSData *)data {
+  SCTKTestURLResponse *response = [[self alloc] init];
+  response->_statusCode = statusCode;
+  response->_headers = [headers copy];
+  response->_data = [data copy];
+  return response;
+}
+
++ (instancetype)responseWithError:(NSError *)error {
+  SCTKTestURLResponse *response = [[self alloc] init];
+  response->_error = error;
+  return response;
+}
+
+@end
+
+@implementation SCTKTestURLProtocol
+
++ (void)setHandler:(nullable SCTKTestURLProtocolHandler)handler {
+  @synchronized(self) {
+    gHandler = [handler copy];
+    gRequestCount = 0;
+  }
+}
+
++ (NSUInteger)requestCount {
+  @synchronized(self) {
+    return gRequestCount;
+  }
+}
+
++ (NSURLSession *)session {
+  NSURLSessionConfiguration *configuration =
+      [NSURLSessionConfiguration ephemeralSessionConfiguration];
+  configuration.protocolClasses = @[ self ];
+  return [NSURLSession sessionWithConfiguration:configuration];
+}
+
+#pragma mark - NSURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+  return YES;
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+  return request;
+}
+
+- (void)startLoading {
+  SCTKTestURLProtocolHandler handler;
+  @synchronized([self class]) {
+    handler = gHandler;
+    gRequestCount++;
+  }
+  SCTKTestURLResponse *response = handler ? handler(self.request) : nil;
+  if (!response) {
+    // never responds, as a hung server would
+    return;
+  }
+  if (response.error) {
+    [self.client URLProtocol:self didFailWithError:response.error];
+    return;
+  }
+  NSHTTPURLResponse *HTTPURLResponse = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                                   statusCode:response.statusCode
+                                                                  HTTPVersion:@"HTTP/1.1"
+                                                                 headerFields:response.headers];
+  [self.client URLProtocol:self
+        didReceiveResponse:HTTPURLResponse
+        cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+  if (response.data) {
+    [self.client URLProtocol:self didLoadData:response.data];
+  }
+  [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading {
+}
+
+@end
@@ -0,0 +1,202 @@
+/*! @file SCTKTokenResponsePipelineTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKErrorUtilities.h"
+#import "Sources/AppAuthCore/SCTKTokenResponsePipeline.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKTokenResponsePipeline.
+ */
+@interface SCTKTokenResponsePipelineTests : XCTestCase
+@end
+
+@implementation SCTKTokenResponsePipelineTests
+
+/*! @brief Tests that parsing and validation run off the callback queue, and that the result and
+        then the metrics are delivered on it.
+ */
+- (void)testDeliversResultAndMetricsOnCallbackQueue {
+  SCTKTokenResponsePipeline *pipeline = [[SCTKTokenResponsePipeline alloc] init];
+  NSURL *URL = [NSURL URLWithString:@"https://www.example.com/token"];
+  XCTestExpectation *delivered = [self expectationWithDescription:@"Result delivered."];
+  XCTestExpectation *measured = [self expectationWithDescription:@"Metrics reported."];
+  pipeline.metricsHandler = ^(SCTKTokenResponsePipelineMetrics *metrics) {
+    XCTAssertTrue([NSThread isMainThread]);
+    XCTAssertEqualObjects(metrics.URL, URL);
+    XCTAssertGreaterThanOrEqual(metrics.receiveDuration, 1);
+    XCTAssertGreaterThanOrEqual(metrics.queueDuration, 0);
+    XCTAssertGreaterThanOrEqual(metrics.parseDuration, 0);
+    XCTAssertGreaterThanOrEqual(metrics.validateDuration, 0);
+    XCTAssertGreaterThanOrEqual(metrics.deliverDuration, 0);
+    XCTAssertFalse(metrics.failed);
+    [measured fulfill];
+  };
+
+  [pipeline processResponseForURL:URL
+                      requestDate:[NSDate dateWithTimeIntervalSinceNow:-1]
+                            parse:^id _Nullable(NSError **error) {
+    XCTAssertFalse([NSThread isMainThread]);
+    return @"parsed";
+  }
+                         validate:^NSError *_Nullable(id result) {
+    XCTAssertFalse([NSThread isMainThread]);
+    XCTAssertEqualObjects(result, @"parsed");
+    return nil;
+  }
+                    callbackQueue:dispatch_get_main_queue()
+                         delivery:^(id _Nullable result, NSError *_Nullable error) {
+    XCTAssertTrue([NSThread isMainThread]);
+    XCTAssertEqualObjects(result, @"parsed");
+    XCTAssertNil(error);
+    [delivered fulfill];
+  }];
+
+  [self waitForExpectations:@[ delivered, measured ] timeout:5 enforceOrder:YES];
+}
+
+/*! @brief Tests that a validation error replaces the result of the parse stage.
+ */
+- (void)testValidationErrorIsDelivered {
+  SCTKTokenResponsePipeline *pipeline = [[SCTKTokenResponsePipeline alloc] init];
+  NSError *validationError =
+      [SCTKErrorUtilities errorWithCode:SCTKErrorCodeIDTokenFailedValidationError
+                        underlyingError:nil
+                            description:@"Issuer mismatch"];
+  XCTestExpectation *delivered = [self expectationWithDescription:@"Error delivered."];
+  XCTestExpectation *measured = [self expectationWithDescription:@"Metrics reported."];
+  pipeline.metricsHandler = ^(SCTKTokenResponsePipelineMetrics *metrics) {
+    XCTAssertTrue(metrics.failed);
+    [measured fulfill];
+  };
+
+  [pipeline processResponseForURL:nil
+                      requestDate:[NSDate date]
+                            parse:^id _Nullable(NSError **error) {
+    return @"parsed";
+  }
+                         validate:^NSError *_Nullable(id result) {
+    return validationError;
+  }
+                    callbackQueue:dispatch_get_main_queue()
+                         delivery:^(id _Nullable result, NSError *_Nullable error) {
+    XCTAssertNil(result);
+    XCTAssertEqualObjects(error, validationError);
+    [delivered fulfill];
+  }];
+
+  [self waitForExpectations:@[ delivered, measured ] timeout:5];
+}
+
+/*! @brief Tests that a parse error skips the validate stage.
+ */
+- (void)testParseErrorSkipsValidation {
+  SCTKTokenResponsePipeline *pipeline = [[SCTKTokenResponsePipeline alloc] init];
+  NSError *parseError =
+      [SCTKErrorUtilities errorWithCode:SCTKErrorCodeJSONDeserializationError
+                        underlyingError:nil
+                            description:nil];
+  XCTestExpectation *delivered = [self expectationWithDescription:@"Error delivered."];
+
+  [pipeline processResponseForURL:nil
+                      requestDate:[NSDate date]
+                            parse:^id _Nullable(NSError **error) {
+    *error = parseError;
+    return nil;
+  }
+                         validate:^NSError *_Nullable(id result) {
+    XCTFail(@"The validate stage must not run without a result.");
+    return nil;
+  }
+                    callbackQueue:dispatch_get_main_queue()
+                         delivery:^(id _Nullable result, NSError *_Nullable error) {
+    XCTAssertNil(result);
+    XCTAssertEqualObjects(error, parseError);
+    [delivered fulfill];
+  }];
+
+  [self waitForExpectations:@[ delivered ] timeout:5];
+}
+
+/*! @brief Tests that a full pipeline blocks further submissions until a response is processed.
+ */
+- (void)testSubmissionBlocksWhilePipelineIsFull {
+  SCTKTokenResponsePipeline *pipeline =
+      [[SCTKTokenResponsePipeline alloc] initWithMaximumConcurrentResponses:1];
+  XCTAssertEqual(pipeline.maximumConcurrentResponses, 1u);
+  dispatch_semaphore_t firstParseRelease = dispatch_semaphore_create(0);
+  XCTestExpectation *firstParseStarted = [self expectationWithDescription:@"First parse started."];
+  XCTestExpectation *bothDelivered = [self expectationWithDescription:@"Both delivered."];
+  bothDelivered.expectedFulfillmentCount = 2;
+  __block BOOL firstParseReleased = NO;
+  __block BOOL secondSubmitted = NO;
+
+  SCTKTokenResponsePipelineDelivery delivery = ^(id _Nullable result, NSError *_Nullable error) {
+    [bothDelivered fulfill];
+  };
+  [pipeline processResponseForURL:nil
+                      requestDate:[NSDate date]
+                            parse:^id _Nullable(NSError **error) {
+    [firstParseStarted fulfill];
+    dispatch_semaphore_wait(firstParseRelease, DISPATCH_TIME_FOREVER);
+    return @"first";
+  }
+                         validate:nil
+                    callbackQueue:dispatch_get_main_queue()
+                         delivery:delivery];
+  [self waitForExpectations:@[ firstParseStarted ] timeout:5];
+
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+    [pipeline processResponseForURL:nil
+                        requestDate:[NSDate date]
+                              parse:^id _Nullable(NSError **error) {
+      return @"second";
+    }
+                           validate:nil
+                      callbackQueue:dispatch_get_main_queue()
+                           delivery:delivery];
+    @synchronized(self) {
+      XCTAssertTrue(firstParseReleased);
+      secondSubmitted = YES;
+    }
+  });
+
+  // gives the second submission time to go through if it were not blocked
+  [NSThread sleepForTimeInterval:0.2];
+  @synchronized(self) {
+    XCTAssertFalse(secondSubmitted);
+    firstParseReleased = YES;
+  }
+  dispatch_semaphore_signal(firstParseRelease);
+
+  [self waitForExpectations:@[ bothDelivered ] timeout:5];
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,339 @@
+/*! @file SCTKUserInfoCacheTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDAuthorizationResponseTests.h"
+#import "OIDServiceDiscoveryTests.h"
+#import "SCTKTestURLProtocol.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKAuthState.h"
+#import "Sources/AppAuthCore/SCTKAuthorizationService.h"
+#import "Sources/AppAuthCore/SCTKError.h"
+#import "Sources/AppAuthCore/SCTKGrantTypes.h"
+#import "Sources/AppAuthCore/SCTKServiceConfiguration.h"
+#import "Sources/AppAuthCore/SCTKServiceDiscovery.h"
+#import "Sources/AppAuthCore/SCTKTokenRequest.h"
+#import "Sources/AppAuthCore/SCTKTokenResponse.h"
+#import "Sources/AppAuthCore/SCTKTokenUtilities.h"
+#import "Sources/AppAuthCore/SCTKURLSessionProvider.h"
+#import "Sources/AppAuthCore/SCTKUserInfoCache.h"
+#import "Sources/AppAuthCore/SCTKUserInfoResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The userinfo endpoint in the tests.
+ */
+static NSString *const kUserInfoEndpoint = @"https://www.example.com/userinfo";
+
+/*! @brief The subject of the end-user in the tests.
+ */
+static NSString *const kSubject = @"248289761001";
+
+/*! @brief The issuer of the ID Tokens in the tests.
+ */
+static NSString *const kIssuer = @"https://www.example.com";
+
+/*! @brief The client identifier in the tests.
+ */
+static NSString *const kClientID = @"client";
+
+/*! @brief Unit tests for @c SCTKUserInfoCache and the userinfo requests using it.
+ */
+@interface SCTKUserInfoCacheTests : XCTestCase
+@end
+
+@implementation SCTKUserInfoCacheTests
+
+- (void)setUp {
+  [super setUp];
+  [SCTKUserInfoCache setSharedCache:[[SCTKUserInfoCache alloc] init]];
+  [SCTKURLSessionProvider setSession:[SCTKTestURLProtocol session]];
+}
+
+- (void)tearDown {
+  [SCTKUserInfoCache setSharedCache:nil];
+  [SCTKTestURLProtocol setHandler:nil];
+  [SCTKURLSessionProvider setSession:[NSURLSession sharedSession]];
+  [super tearDown];
+}
+
+/*! @brief Returns an unsigned ID Token for a subject.
+    @param subject The subject of the ID Token.
+    @param issuer The issuer of the ID Token.
+ */
++ (NSString *)IDTokenWithSubject:(NSString *)subject issuer:(NSString *)issuer {
+  NSTimeInterval now = [NSDate date].timeIntervalSince1970;
+  NSDictionary *claims = @{
+    @"iss" : issuer,
+    @"aud" : kClientID,
+    @"sub" : subject,
+    @"iat" : @((long long)now),
+    @"exp" : @((long long)now + 3600),
+  };
+  NSData *header = [@"{\"alg\":\"none\"}" dataUsingEncoding:NSUTF8StringEncoding];
+  NSData *payload = [NSJSONSerialization dataWithJSONObject:claims options:0 error:nil];
+  return [NSString stringWithFormat:@"%@.%@.",
+                                    [SCTKTokenUtilities encodeBase64urlNoPadding:header],
+                                    [SCTKTokenUtilities encodeBase64urlNoPadding:payload]];
+}
+
+/*! @brief Returns an auth state with a fresh access token and an ID Token for @c kSubject, whose
+        discovery document has the userinfo endpoint @c kUserInfoEndpoint.
+ */
++ (SCTKAuthState *)authState {
+  return [self authStateWithIssuer:kIssuer];
+}
+
+/*! @brief Returns an auth state like @c authState whose ID Token has another issuer.
+    @param issuer The issuer of the ID Token.
+ */
++ (SCTKAuthState *)authStateWithIssuer:(NSString *)issuer {
+  NSMutableDictionary *document =
+      [[OIDServiceDiscoveryTests completeServiceDiscoveryDictionary] mutableCopy];
+  document[@"userinfo_endpoint"] = kUserInfoEndpoint;
+  SCTKServiceDiscovery *discovery = [[SCTKServiceDiscovery alloc] initWithDictionary:document
+                                                                               error:nil];
+  SCTKServiceConfiguration *configuration =
+      [[SCTKServiceConfiguration alloc] initWithDiscoveryDocument:discovery];
+  SCTKTokenRequest *tokenRequest =
+      [[SCTKTokenRequest alloc] initWithConfiguration:configuration
+                                            grantType:SCTKGrantTypeRefreshToken
+                                    authorizationCode:nil
+                                          redirectURL:nil
+                                             clientID:@"client"
+                                         clientSecret:nil
+                                               scopes:nil
+                                         refreshToken:@"refresh123"
+                                         codeVerifier:nil
+                                 additionalParameters:nil];
+  NSString *IDToken = [self IDTokenWithSubject:kSubject issuer:issuer];
+  SCTKTokenResponse *tokenResponse =
+      [[SCTKTokenResponse alloc] initWithRequest:tokenRequest
+                                      parameters:@{
+                                        @"access_token" : @"abc123",
+                                        @"expires_in" : @3600,
+                                        @"id_token" : IDToken,
+                                      }];
+  return [[SCTKAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]
+                      tokenResponse:tokenResponse];
+}
+
+/*! @brief Performs a userinfo request with an auth state and waits for the result.
+    @param authState The auth state.
+    @param error Set to the error of the request.
+ */
+- (nullable SCTKUserInfoResponse *)userInfoWithAuthState:(SCTKAuthState *)authState
+                                                   error:(NSError **)error {
+  __block SCTKUserInfoResponse *result;
+  __block NSError *resultError;
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Userinfo request completes."];
+  [SCTKAuthorizationService
+      performUserInfoRequestWithAuthState:authState
+                                 callback:^(SCTKUserInfoResponse *_Nullable userInfo,
+                                            NSError *_Nullable userInfoError) {
+    result = userInfo;
+    resultError = userInfoError;
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  if (error) {
+    *error = resultError;
+  }
+  return result;
+}
+
+/*! @brief Tests that responses are returned for the access token and generation they were stored
+        with only, and that storing one for a new token drops the previous one.
+ */
+- (void)testAccessTokens {
+  SCTKUserInfoCache *cache = [[SCTKUserInfoCache alloc] init];
+  SCTKUserInfoResponse *olderUserInfo =
+      [[SCTKUserInfoResponse alloc] initWithClaims:@{@"sub" : kSubject, @"name" : @"Old"}];
+  SCTKUserInfoResponse *newerUserInfo =
+      [[SCTKUserInfoResponse alloc] initWithClaims:@{@"sub" : kSubject, @"name" : @"New"}];
+
+  [cache storeUserInfo:olderUserInfo
+             forIssuer:kIssuer
+              clientID:kClientID
+           accessToken:@"token1"
+            generation:1];
+  [cache storeUserInfo:newerUserInfo
+             forIssuer:kIssuer
+              clientID:kClientID
+           accessToken:@"token2"
+            generation:2];
+  XCTAssertEqual([cache userInfoForIssuer:kIssuer
+                                 clientID:kClientID
+                                  subject:kSubject
+                              accessToken:@"token2"
+                               generation:2],
+                 newerUserInfo);
+  XCTAssertNil([cache userInfoForIssuer:kIssuer
+                               clientID:kClientID
+                                subject:kSubject
+                            accessToken:@"token1"
+                             generation:1]);
+  XCTAssertNil([cache userInfoForIssuer:kIssuer
+                               clientID:kClientID
+                                subject:kSubject
+                            accessToken:@"token2"
+                             generation:3]);
+
+  [cache removeUserInfoForSubject:kSubject];
+  XCTAssertNil([cache userInfoForIssuer:kIssuer
+                               clientID:kClientID
+                                subject:kSubject
+                            accessToken:@"token2"
+                             generation:2]);
+}
+
+/*! @brief Tests that a response is not returned for the same subject and generation of another
+        issuer or client.
+ */
+- (void)testAccountsAreSeparate {
+  SCTKUserInfoCache *cache = [[SCTKUserInfoCache alloc] init];
+  SCTKUserInfoResponse *userInfo =
+      [[SCTKUserInfoResponse alloc] initWithClaims:@{@"sub" : kSubject}];
+  [cache storeUserInfo:userInfo
+             forIssuer:kIssuer
+              clientID:kClientID
+           accessToken:@"token"
+            generation:1];
+
+  XCTAssertNil([cache userInfoForIssuer:@"https://other.example.com"
+                               clientID:kClientID
+                                subject:kSubject
+                            accessToken:@"token"
+                             generation:1]);
+  XCTAssertNil([cache userInfoForIssuer:kIssuer
+                               clientID:@"other"
+                                subject:kSubject
+                            accessToken:@"token"
+                             generation:1]);
+  XCTAssertEqual([cache userInfoForIssuer:kIssuer
+                                 clientID:kClientID
+                                  subject:kSubject
+                              accessToken:@"token"
+                               generation:1],
+                 userInfo);
+}
+
+/*! @brief Tests that a cache with no time to live keeps nothing.
+ */
+- (void)testZeroTimeToLive {
+  SCTKUserInfoCache *cache = [[SCTKUserInfoCache alloc] init];
+  cache.timeToLive = 0;
+  [cache storeUserInfo:[[SCTKUserInfoResponse alloc] initWithClaims:@{@"sub" : kSubject}]
+             forIssuer:kIssuer
+              clientID:kClientID
+           accessToken:@"token"
+            generation:1];
+  XCTAssertNil([cache userInfoForIssuer:kIssuer
+                               clientID:kClientID
+                                subject:kSubject
+                            accessToken:@"token"
+                             generation:1]);
+}
+
+/*! @brief Tests that the access token is sent as a bearer token, and that a repeated lookup is
+        answered from the cache.
+ */
+- (void)testRepeatedLookupIsCached {
+  __block NSString *authorization;
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    authorization = [request valueForHTTPHeaderField:@"Authorization"];
+    return [SCTKTestURLResponse responseWithStatusCode:200
+                                               headers:nil
+                                                  JSON:@{@"sub" : kSubject, @"name" : @"Jane"}];
+  }];
+  SCTKAuthState *authState = [[self class] authState];
+
+  NSError *error;
+  SCTKUserInfoResponse *userInfo = [self userInfoWithAuthState:authState error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(userInfo.name, @"Jane");
+  XCTAssertEqualObjects(authorization, @"Bearer abc123");
+
+  XCTAssertEqual([self userInfoWithAuthState:authState error:&error], userInfo);
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 1u);
+}
+
+/*! @brief Tests that an auth state whose ID Token has the same subject but another issuer is not
+        answered from the cache.
+ */
+- (void)testSameSubjectOfAnotherIssuerIsNotCached {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200 headers:nil JSON:@{@"sub" : kSubject}];
+  }];
+  NSError *error;
+  XCTAssertNotNil([self userInfoWithAuthState:[[self class] authState] error:&error]);
+  SCTKAuthState *otherAuthState = [[self class] authStateWithIssuer:@"https://other.example.com"];
+  XCTAssertNotNil([self userInfoWithAuthState:otherAuthState error:&error]);
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 2u);
+}
+
+/*! @brief Tests that a response for another subject than the ID Token's is rejected.
+ */
+- (void)testSubjectMismatch {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:200 headers:nil JSON:@{@"sub" : @"other"}];
+  }];
+  NSError *error;
+  XCTAssertNil([self userInfoWithAuthState:[[self class] authState] error:&error]);
+  XCTAssertEqualObjects(error.domain, SCTKGeneralErrorDomain);
+  XCTAssertEqual(error.code, SCTKErrorCodeUserInfoSubjectMismatchError);
+}
+
+/*! @brief Tests that a rejected access token puts the auth state into an error state.
+ */
+- (void)testUnauthorizedInvalidatesAuthState {
+  [SCTKTestURLProtocol setHandler:^SCTKTestURLResponse *_Nullable(NSURLRequest *request) {
+    return [SCTKTestURLResponse responseWithStatusCode:401
+                                               headers:nil
+                                                  JSON:@{@"error" : @"invalid_token"}];
+  }];
+  SCTKAuthState *authState = [[self class] authState];
+  NSError *error;
+  XCTAssertNil([self userInfoWithAuthState:authState error:&error]);
+  XCTAssertEqualObjects(error.domain, SCTKResourceServerAuthorizationErrorDomain);
+  XCTAssertFalse(authState.isAuthorized);
+}
+
+/*! @brief Tests that an auth state without a userinfo endpoint fails without a request.
+ */
+- (void)testMissingEndpoint {
+  SCTKAuthState *authState = [[SCTKAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]];
+  NSError *error;
+  XCTAssertNil([self userInfoWithAuthState:authState error:&error]);
+  XCTAssertEqual(error.code, SCTKErrorCodeEndpointNotConfiguredError);
+  XCTAssertEqual([SCTKTestURLProtocol requestCount], 0u);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,117 @@
+/*! @file SCTKUserInfoResponseTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/SCTKUserInfoResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c SCTKUserInfoResponse.
+ */
+@interface SCTKUserInfoResponseTests : XCTestCase
+@end
+
+@implementation SCTKUserInfoResponseTests
+
+/*! @brief Returns a set of claims covering each kind of property.
+ */
++ (NSDictionary<NSString *, NSObject<NSCopying> *> *)claims {
+  return @{
+    @"sub" : @"248289761001",
+    @"name" : @"Jane Doe",
+    @"given_name" : @"Jane",
+    @"picture" : @"https://www.example.com/janedoe/me.jpg",
+    @"email" : @"janedoe@example.com",
+    @"email_verified" : @YES,
+    @"phone_number_verified" : @"true",
+    @"address" : @{@"country" : @"US"},
+    @"updated_at" : @1311280970,
+    @"https://www.example.com/department" : @"Sales",
+  };
+}
+
+/*! @brief Tests that standard claims are mapped to their properties, and other claims or claims of
+        an unexpected type are kept in @c additionalClaims.
+ */
+- (void)testClaims {
+  SCTKUserInfoResponse *userInfo =
+      [[SCTKUserInfoResponse alloc] initWithClaims:[[self class] claims]];
+  XCTAssertEqualObjects(userInfo.subject, @"248289761001");
+  XCTAssertEqualObjects(userInfo.name, @"Jane Doe");
+  XCTAssertEqualObjects(userInfo.givenName, @"Jane");
+  XCTAssertNil(userInfo.familyName);
+  XCTAssertEqualObjects(userInfo.picture,
+                        [NSURL URLWithString:@"https://www.example.com/janedoe/me.jpg"]);
+  XCTAssertEqualObjects(userInfo.email, @"janedoe@example.com");
+  XCTAssertEqualObjects(userInfo.emailVerified, @YES);
+  XCTAssertNil(userInfo.phoneNumberVerified);
+  XCTAssertEqualObjects(userInfo.address, @{@"country" : @"US"});
+  XCTAssertEqualObjects(userInfo.updatedAt, [NSDate dateWithTimeIntervalSince1970:1311280970]);
+  NSDictionary *expectedAdditionalClaims = @{
+    @"phone_number_verified" : @"true",
+    @"https://www.example.com/department" : @"Sales",
+  };
+  XCTAssertEqualObjects(userInfo.additionalClaims, expectedAdditionalClaims);
+}
+
+/*! @brief Tests that a response without a subject is rejected.
+ */
+- (void)testSubjectIsRequired {
+  XCTAssertNil([[SCTKUserInfoResponse alloc] initWithClaims:@{@"name" : @"Jane Doe"}]);
+  XCTAssertNil([[SCTKUserInfoResponse alloc] initWithClaims:@{@"sub" : @1}]);
+}
+
+/*! @brief Tests the @c NSSecureCoding by round-tripping an instance through the coding process.
+ */
+- (void)testSecureCoding {
+  SCTKUserInfoResponse *userInfo =
+      [[SCTKUserInfoResponse alloc] initWithClaims:[[self class] claims]];
+  SCTKUserInfoResponse *userInfoCopy;
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:userInfo
+                                         requiringSecureCoding:YES
+                                                         error:nil];
+    userInfoCopy = [NSKeyedUnarchiver unarchivedObjectOfClass:[SCTKUserInfoResponse class]
+                                                     fromData:data
+                                                        error:nil];
+  } else {
+#if !TARGET_OS_IOS
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:userInfo];
+    userInfoCopy = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+#endif
+  }
+  XCTAssertEqualObjects(userInfoCopy.subject, userInfo.subject);
+  XCTAssertEqualObjects(userInfoCopy.name, userInfo.name);
+  XCTAssertEqualObjects(userInfoCopy.picture, userInfo.picture);
+  XCTAssertEqualObjects(userInfoCopy.emailVerified, userInfo.emailVerified);
+  XCTAssertEqualObjects(userInfoCopy.address, userInfo.address);
+  XCTAssertEqualObjects(userInfoCopy.updatedAt, userInfo.updatedAt);
+  XCTAssertEqualObjects(userInfoCopy.additionalClaims, userInfo.additionalClaims);
+}
+
+@end
+
+#pragma GCC diagnostic pop